@@ -79,7 +79,7 @@ def make_absolute(f, directory):
 
 def get_tidy_invocation(f, clang_tidy_binary, checks, tmpdir, build_path,
                         header_filter, extra_arg, extra_arg_before, quiet,
-                        config):
+                        config, profile_dir):
   """Gets a command line for clang-tidy."""
   start = [clang_tidy_binary]
   if header_filter is not None:
@@ -102,6 +102,9 @@ def get_tidy_invocation(f, clang_tidy_binary, checks, tmpdir, build_path,
       start.append('-quiet')
   if config:
       start.append('-config=' + config)
+  if profile_dir is not None:
+      start.append('-enable-check-profile')
+      start.append('-store-check-profile=' + profile_dir)
   start.append(f)
   return start
 
@@ -131,6 +134,22 @@ def merge_replacement_files(tmpdir, mergefile):
     open(mergefile, 'w').close()
 
 
+def merge_profile_files(profile_dir, mergefile):
+  """Sum the per-TU check profiles in a directory into a single JSON file"""
+  merged = {}
+  num_files = 0
+  for profile_file in glob.iglob(os.path.join(profile_dir, '*.json')):
+    with open(profile_file, 'r') as f:
+      content = json.load(f)
+    num_files += 1
+    for key, value in content.get('profile', {}).items():
+      merged[key] = merged.get(key, 0) + value
+
+  output = { 'files': num_files, 'profile': merged }
+  with open(mergefile, 'w') as out:
+    json.dump(output, out, indent=2, sort_keys=True)
+
+
 def check_clang_apply_replacements_binary(args):
   """Checks if invoking supplied clang-apply-replacements binary works."""
   try:
@@ -153,14 +172,15 @@ def apply_fixes(args, tmpdir):
   subprocess.call(invocation)
 
 
-def run_tidy(args, tmpdir, build_path, queue, lock, failed_files):
+def run_tidy(args, tmpdir, profile_dir, build_path, queue, lock,
+             failed_files):
   """Takes filenames out of queue and runs clang-tidy on them."""
   while True:
     name = queue.get()
     invocation = get_tidy_invocation(name, args.clang_tidy_binary, args.checks,
                                      tmpdir, build_path, args.header_filter,
                                      args.extra_arg, args.extra_arg_before,
-                                     args.quiet, args.config)
+                                     args.quiet, args.config, profile_dir)
 
     proc = subprocess.Popen(invocation, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
     output, err = proc.communicate()
@@ -205,6 +225,10 @@ def main():
     parser.add_argument('-export-fixes', metavar='filename', dest='export_fixes',
                         help='Create a yaml file to store suggested fixes in, '
                         'which can be applied with clang-apply-replacements.')
+  parser.add_argument('-export-check-profile', metavar='filename',
+                      dest='export_check_profile',
+                      help='Enable per-check timing profiles and store the '
+                      'times summed over all files as JSON in this file.')
   parser.add_argument('-j', type=int, default=0,
                       help='number of tidy instances to be run in parallel.')
   parser.add_argument('files', nargs='*', default=['.*'],
@@ -266,6 +290,10 @@ def main():
     check_clang_apply_replacements_binary(args)
     tmpdir = tempfile.mkdtemp()
 
+  profile_dir = None
+  if args.export_check_profile:
+    profile_dir = tempfile.mkdtemp()
+
   # Build up a big regexy filter from all command line arguments.
   file_name_re = re.compile('|'.join(args.files))
 
@@ -278,7 +306,8 @@ def main():
     lock = threading.Lock()
     for _ in range(max_task):
       t = threading.Thread(target=run_tidy,
-                           args=(args, tmpdir, build_path, task_queue, lock, failed_files))
+                           args=(args, tmpdir, profile_dir, build_path,
+                                 task_queue, lock, failed_files))
       t.daemon = True
       t.start()
 
@@ -298,6 +327,8 @@ def main():
     print('\nCtrl-C detected, goodbye.')
     if tmpdir:
       shutil.rmtree(tmpdir)
+    if profile_dir:
+      shutil.rmtree(profile_dir)
     os.kill(0, 9)
 
   if yaml and args.export_fixes:
@@ -309,6 +340,15 @@ def main():
       traceback.print_exc()
       return_code=1
 
+  if args.export_check_profile:
+    print('Writing check profile to ' + args.export_check_profile + ' ...')
+    try:
+      merge_profile_files(profile_dir, args.export_check_profile)
+    except:
+      print('Error exporting check profile.\n', file=sys.stderr)
+      traceback.print_exc()
+      return_code=1
+
   if args.fix:
     print('Applying fixes ...')
     try:
@@ -320,6 +360,8 @@ def main():
 
   if tmpdir:
     shutil.rmtree(tmpdir)
+  if profile_dir:
+    shutil.rmtree(profile_dir)
   sys.exit(return_code)
 
 if __name__ == '__main__':
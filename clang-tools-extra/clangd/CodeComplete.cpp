@@ -1096,6 +1096,7 @@ bool semaCodeComplete(std::unique_ptr<CodeCompleteConsumer> Consumer,
   PreambleBounds PreambleRegion =
       ComputePreambleBounds(*CI->getLangOpts(), ContentsBuffer.get(), 0);
   bool CompletingInPreamble = PreambleRegion.Size > Input.Offset;
+  SPAN_ATTACH(Tracer, "completing_in_preamble", CompletingInPreamble);
   // NOTE: we must call BeginSourceFile after prepareCompilerInstance. Otherwise
   // the remapped buffers do not get freed.
   auto Clang = prepareCompilerInstance(
@@ -1120,10 +1121,15 @@ bool semaCodeComplete(std::unique_ptr<CodeCompleteConsumer> Consumer,
   if (Includes)
     Clang->getPreprocessor().addPPCallbacks(
         collectIncludeStructureCallback(Clang->getSourceManager(), Includes));
-  if (llvm::Error Err = Action.Execute()) {
-    log("Execute() failed when running codeComplete for {0}: {1}",
-        Input.FileName, toString(std::move(Err)));
-    return false;
+  {
+    // Separates the main-file parse from the cost of setting up the compiler
+    // instance and loading the preamble.
+    trace::Span ParseTracer("Sema completion: parse main file");
+    if (llvm::Error Err = Action.Execute()) {
+      log("Execute() failed when running codeComplete for {0}: {1}",
+          Input.FileName, toString(std::move(Err)));
+      return false;
+    }
   }
   Action.EndSourceFile();
 
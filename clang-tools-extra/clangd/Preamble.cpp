@@ -161,10 +161,20 @@ bool isPreambleCompatible(const PreambleData &Preamble,
       llvm::MemoryBuffer::getMemBuffer(Inputs.Contents, FileName);
   auto Bounds =
       ComputePreambleBounds(*CI.getLangOpts(), ContentsBuffer.get(), 0);
-  return compileCommandsAreEqual(Inputs.CompileCommand,
-                                 Preamble.CompileCommand) &&
-         Preamble.Preamble.CanReuse(CI, ContentsBuffer.get(), Bounds,
-                                    Inputs.FS.get());
+  trace::Span Tracer("PreambleCompatibility");
+  SPAN_ATTACH(Tracer, "File", FileName);
+  const char *Reason = nullptr;
+  if (!compileCommandsAreEqual(Inputs.CompileCommand, Preamble.CompileCommand))
+    Reason = "compile command changed";
+  else if (!Preamble.Preamble.CanReuse(CI, ContentsBuffer.get(), Bounds,
+                                       Inputs.FS.get()))
+    Reason = "preamble or included files changed";
+  if (!Reason)
+    return true;
+  vlog("Rebuilding preamble for {0} version {1}: {2}", FileName,
+       Inputs.Version, Reason);
+  SPAN_ATTACH(Tracer, "RebuildReason", Reason);
+  return false;
 }
 } // namespace clangd
 } // namespace clang
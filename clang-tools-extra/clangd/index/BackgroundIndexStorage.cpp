@@ -60,7 +60,10 @@ public:
   loadShard(llvm::StringRef ShardIdentifier) const override {
     const std::string ShardPath =
         getShardPathFromFilePath(DiskShardRoot, ShardIdentifier);
-    auto Buffer = llvm::MemoryBuffer::getFile(ShardPath);
+    // The reader never relies on a trailing null, so let large shards be
+    // mapped rather than copied.
+    auto Buffer = llvm::MemoryBuffer::getFile(ShardPath, /*FileSize=*/-1,
+                                              /*RequiresNullTerminator=*/false);
     if (!Buffer)
       return nullptr;
     if (auto I = readIndexFile(Buffer->get()->getBuffer()))
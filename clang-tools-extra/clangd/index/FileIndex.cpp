@@ -149,6 +149,12 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle) {
   switch (DuplicateHandle) {
   case DuplicateHandling::Merge: {
     llvm::DenseMap<SymbolID, Symbol> Merged;
+    // Most symbols appear in a single slab, so the total is a close upper
+    // bound. Reserving up front avoids rehashing on every large rebuild.
+    size_t NumSymbols = 0;
+    for (const auto &Slab : SymbolSlabs)
+      NumSymbols += Slab->size();
+    Merged.reserve(NumSymbols);
     for (const auto &Slab : SymbolSlabs) {
       for (const auto &Sym : *Slab) {
         assert(Sym.References == 0 &&
@@ -191,6 +197,10 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle) {
   {
     llvm::DenseMap<SymbolID, llvm::SmallVector<Ref, 4>> MergedRefs;
     size_t Count = 0;
+    size_t NumSymbols = 0;
+    for (const auto &RefSlab : RefSlabs)
+      NumSymbols += RefSlab->size();
+    MergedRefs.reserve(NumSymbols);
     for (const auto &RefSlab : RefSlabs)
       for (const auto &Sym : *RefSlab) {
         MergedRefs[Sym.first].append(Sym.second.begin(), Sym.second.end());
@@ -201,25 +201,28 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
   if (R.err())
     return makeError("Truncated string table");
 
+  // Copy (or decompress) the whole table into the arena in one go. The
+  // strings are null-terminated in place, so they can point straight into it.
+  StringTableIn Table;
   llvm::StringRef Uncompressed;
-  llvm::SmallString<1> UncompressedStorage;
-  if (UncompressedSize == 0) // No compression
-    Uncompressed = R.rest();
-  else {
-    if (llvm::Error E = llvm::zlib::uncompress(R.rest(), UncompressedStorage,
-                                               UncompressedSize))
+  if (UncompressedSize == 0) { // No compression
+    llvm::StringRef Rest = R.rest();
+    char *Storage = Table.Arena.Allocate<char>(Rest.size());
+    std::copy(Rest.begin(), Rest.end(), Storage);
+    Uncompressed = llvm::StringRef(Storage, Rest.size());
+  } else {
+    char *Storage = Table.Arena.Allocate<char>(UncompressedSize);
+    if (llvm::Error E =
+            llvm::zlib::uncompress(R.rest(), Storage, UncompressedSize))
       return std::move(E);
-    Uncompressed = UncompressedStorage;
+    Uncompressed = llvm::StringRef(Storage, UncompressedSize);
   }
 
-  StringTableIn Table;
-  llvm::StringSaver Saver(Table.Arena);
-  R = Reader(Uncompressed);
   for (Reader R(Uncompressed); !R.eof();) {
     auto Len = R.rest().find(0);
     if (Len == llvm::StringRef::npos)
       return makeError("Bad string table: not null terminated");
-    Table.Strings.push_back(Saver.save(R.consume(Len)));
+    Table.Strings.push_back(R.consume(Len));
     R.consume8();
   }
   if (R.err())
@@ -99,12 +99,23 @@ private:
   }
 
   /// Advances CurrentChunk to the chunk which might contain ID.
+  ///
+  /// Intersections usually advance by a short distance, so gallop forward from
+  /// the current chunk to bracket ID before binary searching, rather than
+  /// searching all remaining chunks.
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
-      CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
+      auto Low = CurrentChunk + 1;
+      size_t Step = 1;
+      while (static_cast<size_t>(Chunks.end() - Low) > Step &&
+             Low[Step].Head <= ID) {
+        Low += Step;
+        Step *= 2;
+      }
+      auto High = Low + std::min<size_t>(Step, Chunks.end() - Low);
+      CurrentChunk = std::partition_point(
+          Low, High, [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
       DecompressedChunk = CurrentChunk->decompress();
       CurrentID = DecompressedChunk.begin();
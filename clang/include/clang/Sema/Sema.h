@@ -1237,6 +1237,17 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of class and function template instantiations performed,
+  /// keyed by the template (or member pattern) they were instantiated from.
+  /// Only collected with CollectStats and reported by PrintStats().
+  llvm::DenseMap<const Decl *, unsigned> InstantiationsPerPattern;
+
+  /// Record an instantiation of \p Pattern for PrintStats().
+  void noteInstantiationOf(const Decl *Pattern) {
+    if (CollectStats)
+      ++InstantiationsPerPattern[Pattern];
+  }
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
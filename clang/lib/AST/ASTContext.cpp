@@ -1084,6 +1084,8 @@ void ASTContext::PrintStats() const {
   }
 
   BumpAlloc.PrintStats();
+  llvm::errs() << getSideTableAllocatedMemory()
+               << " bytes used by AST side tables\n";
 }
 
 void ASTContext::mergeDefinitionIntoModule(NamedDecl *ND, Module *M,
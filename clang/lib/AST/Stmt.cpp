@@ -118,6 +118,27 @@ void Stmt::PrintStats() {
   }
 
   llvm::errs() << "Total bytes = " << sum << "\n";
+
+  // List the node kinds that take up the most memory, as the most promising
+  // candidates for a more compact representation.
+  SmallVector<const StmtClassNameTable *, 16> ByBytes;
+  for (int i = 0; i != Stmt::lastStmtConstant+1; i++)
+    if (StmtClassInfo[i].Name && StmtClassInfo[i].Counter)
+      ByBytes.push_back(&StmtClassInfo[i]);
+  llvm::sort(ByBytes, [](const StmtClassNameTable *LHS,
+                         const StmtClassNameTable *RHS) {
+    uint64_t LHSBytes = (uint64_t)LHS->Counter * LHS->Size;
+    uint64_t RHSBytes = (uint64_t)RHS->Counter * RHS->Size;
+    if (LHSBytes != RHSBytes)
+      return LHSBytes > RHSBytes;
+    return StringRef(LHS->Name) < StringRef(RHS->Name);
+  });
+  if (ByBytes.size() > 10)
+    ByBytes.resize(10);
+  llvm::errs() << "  Largest stmt/expr kinds by total size:\n";
+  for (const StmtClassNameTable *Info : ByBytes)
+    llvm::errs() << "    " << Info->Name << ": "
+                 << (uint64_t)Info->Counter * Info->Size << " bytes\n";
 }
 
 void Stmt::addStmtClass(StmtClass s) {
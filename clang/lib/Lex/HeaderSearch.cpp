@@ -90,13 +90,17 @@ void HeaderSearch::PrintStats() {
   llvm::errs() << "\n*** HeaderSearch Stats:\n"
                << FileInfo.size() << " files tracked.\n";
   unsigned NumOnceOnlyFiles = 0, MaxNumIncludes = 0, NumSingleIncludedFiles = 0;
+  unsigned NumGuardedFiles = 0;
   for (unsigned i = 0, e = FileInfo.size(); i != e; ++i) {
     NumOnceOnlyFiles += FileInfo[i].isImport;
+    NumGuardedFiles +=
+        FileInfo[i].ControllingMacro || FileInfo[i].ControllingMacroID;
     if (MaxNumIncludes < FileInfo[i].NumIncludes)
       MaxNumIncludes = FileInfo[i].NumIncludes;
     NumSingleIncludedFiles += FileInfo[i].NumIncludes == 1;
   }
   llvm::errs() << "  " << NumOnceOnlyFiles << " #import/#pragma once files.\n"
+               << "  " << NumGuardedFiles << " files with an include guard.\n"
                << "  " << NumSingleIncludedFiles << " included exactly once.\n"
                << "  " << MaxNumIncludes << " max times a file is included.\n";
 
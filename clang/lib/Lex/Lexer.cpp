@@ -48,6 +48,13 @@
 #include <tuple>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -2270,6 +2277,28 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   char C;
   while (true) {
     C = *CurPtr;
+#ifdef __SSE2__
+    // Skip over 16 characters at a time while none of them can end the
+    // comment. Stop short of BufferEnd so that we never read past the buffer.
+    if (C != 0 && C != '\n' && C != '\r') {
+      __m128i Newlines = _mm_set1_epi8('\n');
+      __m128i Returns = _mm_set1_epi8('\r');
+      __m128i Zeros = _mm_setzero_si128();
+      while (CurPtr + 16 <= BufferEnd) {
+        __m128i Chars = _mm_loadu_si128((const __m128i *)CurPtr);
+        int Cmp = _mm_movemask_epi8(
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, Newlines),
+                                      _mm_cmpeq_epi8(Chars, Returns)),
+                         _mm_cmpeq_epi8(Chars, Zeros)));
+        if (Cmp != 0) {
+          CurPtr += llvm::countTrailingZeros<unsigned>(Cmp);
+          break;
+        }
+        CurPtr += 16;
+      }
+      C = *CurPtr;
+    }
+#endif
     // Skip over characters in the fast loop.
     while (C != 0 &&                // Potentially EOF.
            C != '\n' && C != '\r')  // Newline or DOS-style newline.
@@ -2476,13 +2505,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -485,6 +485,28 @@ void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
 
+  // Report the templates that were instantiated most often.
+  unsigned NumInstantiations = 0;
+  SmallVector<std::pair<const Decl *, unsigned>, 16> Patterns;
+  for (const auto &P : InstantiationsPerPattern) {
+    NumInstantiations += P.second;
+    Patterns.push_back(P);
+  }
+  llvm::errs() << NumInstantiations << " template instantiations of "
+               << Patterns.size() << " templates.\n";
+  llvm::sort(Patterns, [](const std::pair<const Decl *, unsigned> &LHS,
+                          const std::pair<const Decl *, unsigned> &RHS) {
+    if (LHS.second != RHS.second)
+      return LHS.second > RHS.second;
+    return LHS.first->getLocation() < RHS.first->getLocation();
+  });
+  for (const auto &P : makeArrayRef(Patterns).take_front(10)) {
+    llvm::errs() << "  " << P.second << " ";
+    if (const auto *ND = dyn_cast<NamedDecl>(P.first))
+      ND->printQualifiedName(llvm::errs());
+    llvm::errs() << "\n";
+  }
+
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
 }
@@ -2605,6 +2605,10 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
   });
 
   Pattern = PatternDef;
+  if (ClassTemplateDecl *Template = Pattern->getDescribedClassTemplate())
+    noteInstantiationOf(Template);
+  else
+    noteInstantiationOf(Pattern);
 
   // Record the point of instantiation.
   if (MemberSpecializationInfo *MSInfo
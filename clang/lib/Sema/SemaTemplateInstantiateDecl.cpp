@@ -4580,6 +4580,11 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
                                    /*Qualified=*/true);
     return Name;
   });
+  if (FunctionTemplateDecl *Template =
+          PatternDecl->getDescribedFunctionTemplate())
+    noteInstantiationOf(Template);
+  else
+    noteInstantiationOf(PatternDecl);
 
   // If we're performing recursive template instantiation, create our own
   // queue of pending implicit instantiations that we will instantiate later,
@@ -98,6 +98,7 @@
 #include "llvm/Support/OnDiskHashTable.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/VersionTuple.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -4294,6 +4295,7 @@ ASTFileSignature ASTWriter::WriteAST(Sema &SemaRef,
                                      Module *WritingModule, StringRef isysroot,
                                      bool hasErrors,
                                      bool ShouldCacheASTInMemory) {
+  llvm::TimeTraceScope TimeScope("WriteAST", StringRef(OutputFile));
   WritingAST = true;
 
   ASTHasCompilerErrors = hasErrors;
@@ -4682,21 +4684,24 @@ ASTFileSignature ASTWriter::WriteASTCore(Sema &SemaRef, StringRef isysroot,
 
   // Keep writing types, declarations, and declaration update records
   // until we've emitted all of them.
-  Stream.EnterSubblock(DECLTYPES_BLOCK_ID, /*bits for abbreviations*/5);
-  WriteTypeAbbrevs();
-  WriteDeclAbbrevs();
-  do {
-    WriteDeclUpdatesBlocks(DeclUpdatesOffsetsRecord);
-    while (!DeclTypesToEmit.empty()) {
-      DeclOrType DOT = DeclTypesToEmit.front();
-      DeclTypesToEmit.pop();
-      if (DOT.isType())
-        WriteType(DOT.getType());
-      else
-        WriteDecl(Context, DOT.getDecl());
-    }
-  } while (!DeclUpdates.empty());
-  Stream.ExitBlock();
+  {
+    llvm::TimeTraceScope TimeScope("WriteDeclsAndTypes");
+    Stream.EnterSubblock(DECLTYPES_BLOCK_ID, /*bits for abbreviations*/5);
+    WriteTypeAbbrevs();
+    WriteDeclAbbrevs();
+    do {
+      WriteDeclUpdatesBlocks(DeclUpdatesOffsetsRecord);
+      while (!DeclTypesToEmit.empty()) {
+        DeclOrType DOT = DeclTypesToEmit.front();
+        DeclTypesToEmit.pop();
+        if (DOT.isType())
+          WriteType(DOT.getType());
+        else
+          WriteDecl(Context, DOT.getDecl());
+      }
+    } while (!DeclUpdates.empty());
+    Stream.ExitBlock();
+  }
 
   DoneWritingDeclsAndTypes = true;
 
@@ -4705,14 +4710,23 @@ ASTFileSignature ASTWriter::WriteASTCore(Sema &SemaRef, StringRef isysroot,
   if (!DeclUpdatesOffsetsRecord.empty())
     Stream.EmitRecord(DECL_UPDATE_OFFSETS, DeclUpdatesOffsetsRecord);
   WriteFileDeclIDsMap();
-  WriteSourceManagerBlock(Context.getSourceManager(), PP);
+  {
+    llvm::TimeTraceScope TimeScope("WriteSourceManagerBlock");
+    WriteSourceManagerBlock(Context.getSourceManager(), PP);
+  }
   WriteComments();
-  WritePreprocessor(PP, isModule);
+  {
+    llvm::TimeTraceScope TimeScope("WritePreprocessor");
+    WritePreprocessor(PP, isModule);
+  }
   WriteHeaderSearch(PP.getHeaderSearchInfo());
   WriteSelectors(SemaRef);
   WriteReferencedSelectorsPool(SemaRef);
   WriteLateParsedTemplates(SemaRef);
-  WriteIdentifierTable(PP, SemaRef.IdResolver, isModule);
+  {
+    llvm::TimeTraceScope TimeScope("WriteIdentifierTable");
+    WriteIdentifierTable(PP, SemaRef.IdResolver, isModule);
+  }
   WriteFPPragmaOptions(SemaRef.getFPOptions());
   WriteOpenCLExtensions(SemaRef);
   WriteOpenCLExtensionTypes(SemaRef);
@@ -0,0 +1,18 @@
+// RUN: %clangxx -S -ftime-trace -ftime-trace-granularity=0 -ftime-trace-max-events=1 -o %T/check-time-trace-max-events %s
+// RUN: cat %T/check-time-trace-max-events.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s
+
+// CHECK: "otherData": {
+// CHECK: "droppedEvents":
+
+template <typename T>
+struct Struct {
+  T Num;
+};
+
+int main() {
+  Struct<int> S;
+
+  return 0;
+}
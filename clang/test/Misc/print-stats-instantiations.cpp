@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+template <typename T> struct S {
+  void f() {}
+};
+
+template <typename T> T g(T t) { return t; }
+
+void use() {
+  S<int> a;
+  S<char> b;
+  a.f();
+  b.f();
+  g(1);
+  g(2.0);
+  g('c');
+}
+
+// CHECK: *** Semantic Analysis Stats:
+// CHECK: 7 template instantiations of 3 templates.
+// CHECK-NEXT: 3 g
+// CHECK-NEXT: 2 S
+// CHECK-NEXT: 2 S::f
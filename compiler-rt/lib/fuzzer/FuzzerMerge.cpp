@@ -270,7 +270,7 @@ static size_t WriteNewControlFile(const std::string &CFPath,
     FilesToSkip.insert(SF.Name);
 
   Vector<std::string> FilesToUse;
-  auto MaybeUseFile = [=, &FilesToUse](std::string Name) {
+  auto MaybeUseFile = [&FilesToSkip, &FilesToUse](const std::string &Name) {
     if (FilesToSkip.find(Name) == FilesToSkip.end())
       FilesToUse.push_back(Name);
   };
@@ -9,16 +9,44 @@
 #include "src/string/strlen.h"
 
 #include "src/__support/common.h"
+#include <stdint.h> // uintptr_t
 
 namespace __llvm_libc {
 
-// TODO: investigate the performance of this function.
-// There might be potential for compiler optimization.
-size_t LLVM_LIBC_ENTRYPOINT(strlen)(const char *src) {
-  const char *end = src;
-  while (*end != '\0')
-    ++end;
-  return end - src;
+// Returns whether any byte of `word` is zero. Subtracting one from every byte
+// only sets the high bit of a byte that was zero or that already had its high
+// bit set, and `~word` rules out the latter.
+static inline bool has_zero_byte(uintptr_t word) {
+  constexpr uintptr_t kLowBits = ~uintptr_t(0) / 0xff; // 0x0101...01
+  constexpr uintptr_t kHighBits = kLowBits << 7;       // 0x8080...80
+  return ((word - kLowBits) & ~word & kHighBits) != 0;
+}
+
+// The word-at-a-time loop reads the bytes after the terminator that share its
+// word. That is safe, but the address sanitizers would report it, so they are
+// disabled here.
+__attribute__((no_sanitize("address", "hwaddress"))) size_t
+LLVM_LIBC_ENTRYPOINT(strlen)(const char *src) {
+  const char *char_ptr = src;
+  // Step byte by byte until the pointer is aligned to a word.
+  for (; reinterpret_cast<uintptr_t>(char_ptr) % sizeof(uintptr_t) != 0;
+       ++char_ptr) {
+    if (*char_ptr == '\0')
+      return char_ptr - src;
+  }
+  // Then check a word at a time. An aligned word never straddles a page
+  // boundary, so this cannot fault even though it may read past the
+  // terminator.
+  for (;; char_ptr += sizeof(uintptr_t)) {
+    uintptr_t word;
+    __builtin_memcpy(&word, char_ptr, sizeof(word));
+    if (has_zero_byte(word))
+      break;
+  }
+  // Find the terminator within the last word.
+  while (*char_ptr != '\0')
+    ++char_ptr;
+  return char_ptr - src;
 }
 
 } // namespace __llvm_libc
@@ -22,3 +22,23 @@ TEST(StrLenTest, AnyString) {
   size_t result = __llvm_libc::strlen(any);
   ASSERT_EQ((size_t)12, result);
 }
+
+TEST(StrLenTest, EveryLengthAndAlignment) {
+  char buffer[128];
+  for (size_t align = 0; align < 16; ++align) {
+    for (size_t length = 0; length + align + 1 < sizeof(buffer); ++length) {
+      for (size_t i = 0; i < sizeof(buffer); ++i)
+        buffer[i] = 'a';
+      buffer[align + length] = '\0';
+      ASSERT_EQ(length, __llvm_libc::strlen(buffer + align));
+    }
+  }
+}
+
+TEST(StrLenTest, HighBitCharacters) {
+  // Bytes with their high bit set must not be mistaken for the terminator.
+  const char *high = "\x80\xff\x81\xfe\x80\x80\x80\x80\x80\x7f";
+
+  size_t result = __llvm_libc::strlen(high);
+  ASSERT_EQ((size_t)10, result);
+}
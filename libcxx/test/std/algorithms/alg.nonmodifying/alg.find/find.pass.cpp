@@ -23,8 +23,10 @@
 TEST_CONSTEXPR bool test_constexpr() {
     int ia[] = {1, 3, 5, 2, 4, 6};
     int ib[] = {1, 2, 3, 4, 5, 6};
+    char ic[] = {'a', 'b', 'c'};
     return    (std::find(std::begin(ia), std::end(ia), 5) == ia+2)
            && (std::find(std::begin(ib), std::end(ib), 9) == ib+6)
+           && (std::find(std::begin(ic), std::end(ic), 'b') == ic+1)
            ;
     }
 #endif
@@ -39,6 +41,19 @@ int main(int, char**)
     r = std::find(input_iterator<const int*>(ia), input_iterator<const int*>(ia+s), 10);
     assert(r == input_iterator<const int*>(ia+s));
 
+    // Pointers to bytes searched for a byte of the same type.
+    const char ca[] = {'a', 'b', 'c', 'd'};
+    assert(std::find(ca, ca+4, 'c') == ca+2);
+    assert(std::find(ca, ca+4, 'e') == ca+4);
+    assert(std::find(ca, ca, 'a') == ca);
+    unsigned char ua[] = {1, 255, 3};
+    assert(std::find(ua, ua+3, (unsigned char)255) == ua+1);
+    signed char sa[] = {1, -1, 3};
+    assert(std::find(sa, sa+3, (signed char)-1) == sa+1);
+    // A value of another type is compared after promotion, not truncated.
+    assert(std::find(ua, ua+3, 255 + 256) == ua+3);
+    assert(std::find(sa, sa+3, 255) == sa+3);
+
 #if TEST_STD_VER > 17
     static_assert(test_constexpr());
 #endif
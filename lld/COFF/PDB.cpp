@@ -73,6 +73,7 @@ static ExitOnError exitOnErr;
 static Timer totalPdbLinkTimer("PDB Emission (Cumulative)", Timer::root());
 
 static Timer addObjectsTimer("Add Objects", totalPdbLinkTimer);
+static Timer typeHashingTimer("Type Hashing", addObjectsTimer);
 static Timer typeMergingTimer("Type Merging", addObjectsTimer);
 static Timer symbolMergingTimer("Symbol Merging", addObjectsTimer);
 static Timer globalsLayoutTimer("Globals Stream Layout", totalPdbLinkTimer);
@@ -109,6 +110,11 @@ public:
   /// Link info for each import file in the symbol table into the PDB.
   void addImportFilesToPDB(ArrayRef<OutputSection *> outputSections);
 
+  /// Compute global type hashes of the objects that lack a usable .debug$H
+  /// section. This is done for all objects in parallel before the (serial)
+  /// type merging.
+  void computeGlobalHashes();
+
   /// Link CodeView from a single object file into the target (output) PDB.
   /// When a precompiled headers object is linked, its TPI map might be provided
   /// externally.
@@ -187,6 +193,10 @@ private:
   /// far.
   std::map<uint32_t, CVIndexMap> precompTypeIndexMappings;
 
+  /// Global type hashes computed by computeGlobalHashes(). Entries are freed
+  /// as soon as their object has been merged.
+  DenseMap<const ObjFile *, std::vector<GloballyHashedType>> globalHashes;
+
   // For statistics
   uint64_t globalSymbols = 0;
   uint64_t moduleSymbols = 0;
@@ -403,9 +413,14 @@ PDBLinker::mergeDebugT(ObjFile *file, CVIndexMap *objectIndexMap) {
   if (config->debugGHashes) {
     ArrayRef<GloballyHashedType> hashes;
     std::vector<GloballyHashedType> ownedHashes;
-    if (Optional<ArrayRef<uint8_t>> debugH = getDebugH(file))
+    auto it = globalHashes.find(file);
+    if (it != globalHashes.end()) {
+      ownedHashes = std::move(it->second);
+      globalHashes.erase(it);
+      hashes = ownedHashes;
+    } else if (Optional<ArrayRef<uint8_t>> debugH = getDebugH(file)) {
       hashes = getHashesFromDebugH(*debugH);
-    else {
+    } else {
       ownedHashes = GloballyHashedType::hashTypes(types);
       hashes = ownedHashes;
     }
@@ -1310,6 +1325,37 @@ static PublicSym32 createPublic(Defined *def) {
   return pub;
 }
 
+// Compute the global type hashes of all objects concurrently before merging.
+void PDBLinker::computeGlobalHashes() {
+  if (!config->debugGHashes)
+    return;
+  ScopedTimer t(typeHashingTimer);
+
+  // Hashing a type stream depends only on its own records, so it can be done
+  // concurrently. Objects using precompiled headers or type servers are
+  // hashed during merging because their streams are rewritten first.
+  std::vector<ObjFile *> files;
+  for (ObjFile *file : ObjFile::instances)
+    if (file->debugTypesObj && !file->mergedIntoPDB &&
+        (file->debugTypesObj->kind == TpiSource::Regular ||
+         file->debugTypesObj->kind == TpiSource::PCH) &&
+        !getDebugH(file))
+      files.push_back(file);
+
+  std::vector<std::vector<GloballyHashedType>> hashes(files.size());
+  parallelForEachN(0, files.size(), [&](size_t i) {
+    CVTypeArray types;
+    BinaryStreamReader reader(files[i]->debugTypes, support::little);
+    cantFail(reader.readArray(types, reader.getLength()));
+    hashes[i] = GloballyHashedType::hashTypes(types);
+  });
+
+  // The merge itself stays serial and in input order, so type indices are
+  // assigned exactly as before.
+  for (size_t i = 0, e = files.size(); i != e; ++i)
+    globalHashes[files[i]] = std::move(hashes[i]);
+}
+
 // Add all object files to the PDB. Merge .debug$T sections into IpiData and
 // TpiData.
 void PDBLinker::addObjectsToPDB() {
@@ -1317,6 +1363,8 @@ void PDBLinker::addObjectsToPDB() {
 
   createModuleDBI(builder);
 
+  computeGlobalHashes();
+
   for (ObjFile *file : ObjFile::instances)
     addObjFile(file);
 
@@ -51,6 +51,27 @@ ErrorHandler &lld::errorHandler() {
   return handler;
 }
 
+// The diagnostics of this thread go here while DeferredDiagnostics::capture()
+// runs.
+static LLVM_THREAD_LOCAL DeferredDiagnostics *deferred;
+
+void DeferredDiagnostics::capture(function_ref<void()> fn) {
+  DeferredDiagnostics *prev = deferred;
+  deferred = this;
+  fn();
+  deferred = prev;
+}
+
+void DeferredDiagnostics::report() {
+  for (Diagnostic &d : diags) {
+    if (d.isError)
+      error(d.msg);
+    else
+      warn(d.msg);
+  }
+  diags.clear();
+}
+
 void lld::exitLld(int val) {
   // Delete any temporary file, while keeping the memory mapping open.
   if (errorHandler().outputBuffer)
@@ -170,6 +191,10 @@ void ErrorHandler::warn(const Twine &msg) {
     error(msg);
     return;
   }
+  if (deferred) {
+    deferred->diags.push_back({false, msg.str()});
+    return;
+  }
 
   std::lock_guard<std::mutex> lock(mu);
   lld::errs() << sep << getLocation(msg) << ": " << Colors::MAGENTA
@@ -178,6 +203,11 @@ void ErrorHandler::warn(const Twine &msg) {
 }
 
 void ErrorHandler::error(const Twine &msg) {
+  if (deferred) {
+    deferred->diags.push_back({true, msg.str()});
+    return;
+  }
+
   // If Visual Studio-style error message mode is enabled,
   // this particular error is printed out as two errors.
   if (vsDiagnostics) {
@@ -217,6 +247,7 @@ void ErrorHandler::error(const Twine &msg) {
 }
 
 void ErrorHandler::fatal(const Twine &msg) {
+  deferred = nullptr;
   error(msg);
   exitLld(1);
 }
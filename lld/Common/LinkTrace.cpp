@@ -0,0 +1,79 @@
+//===- LinkTrace.cpp ------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lld/Common/LinkTrace.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Config/llvm-config.h"
+#if LLVM_ON_UNIX
+#include <sys/resource.h>
+#endif
+
+using namespace llvm;
+using namespace lld;
+
+// Input files in the order they were read.
+static std::vector<std::pair<std::string, uint64_t>> inputFiles;
+static uint64_t inputBytes;
+
+uint64_t lld::getPeakRSS() {
+#if LLVM_ON_UNIX
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  // ru_maxrss is in kilobytes on Linux and the BSDs.
+  return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void lld::traceMemoryUsage() {
+  if (!timeTraceProfilerEnabled())
+    return;
+  if (uint64_t rss = getPeakRSS())
+    timeTraceProfilerCounter("Peak RSS (KiB)", rss / 1024);
+}
+
+void lld::traceInputFile(StringRef path, uint64_t size) {
+  if (!timeTraceProfilerEnabled())
+    return;
+  inputFiles.push_back({std::string(path), size});
+  inputBytes += size;
+  timeTraceProfilerCounter("Input bytes", inputBytes);
+}
+
+void lld::traceLargest(StringRef prefix,
+                       std::vector<std::pair<std::string, uint64_t>> entries,
+                       size_t n) {
+  if (!timeTraceProfilerEnabled())
+    return;
+  n = std::min(n, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                    [](const std::pair<std::string, uint64_t> &a,
+                       const std::pair<std::string, uint64_t> &b) {
+                      return a.second > b.second;
+                    });
+  for (size_t i = 0; i < n; ++i)
+    timeTraceProfilerAddMetadata((prefix + " " + Twine(i + 1)).str(),
+                                 (entries[i].first + " " +
+                                  Twine(entries[i].second))
+                                     .str());
+}
+
+void lld::traceLargestInputFiles(size_t n) {
+  if (!timeTraceProfilerEnabled())
+    return;
+  timeTraceProfilerAddMetadata("Input files", Twine(inputFiles.size()).str());
+  timeTraceProfilerAddMetadata("Input bytes", Twine(inputBytes).str());
+  traceLargest("Largest input file", inputFiles, n);
+}
@@ -35,7 +35,7 @@ enum ELFKind {
 };
 
 // For --build-id.
-enum class BuildIdKind { None, Fast, Md5, Sha1, Hexstring, Uuid };
+enum class BuildIdKind { None, Fast, Md5, Sha1, Blake3, Hexstring, Uuid };
 
 // For --discard-{all,locals,none}.
 enum class DiscardPolicy { Default, All, Locals, None };
@@ -97,6 +97,7 @@ struct Configuration {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalState;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -179,6 +180,8 @@ struct Configuration {
   bool omagic;
   bool optimizeBBJumps;
   bool optRemarksWithHotness;
+  bool parallelParse;
+  bool parallelRelocScan;
   bool picThunk;
   bool pie;
   bool printGcSections;
@@ -189,6 +192,7 @@ struct Configuration {
   llvm::Optional<uint32_t> shuffleSectionSeed;
   bool singleRoRx;
   bool shared;
+  bool streamOutputFile;
   bool isStatic = false;
   bool sysvHash = false;
   bool target1Rel;
@@ -25,6 +25,7 @@
 #include "Driver.h"
 #include "Config.h"
 #include "ICF.h"
+#include "IncrementalState.h"
 #include "InputFiles.h"
 #include "InputSection.h"
 #include "LinkerScript.h"
@@ -40,6 +41,7 @@
 #include "lld/Common/Driver.h"
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Filesystem.h"
+#include "lld/Common/LinkTrace.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
 #include "lld/Common/TargetOptionsCommandFlags.h"
@@ -489,6 +491,11 @@ void LinkerDriver::main(ArrayRef<const char *> argsArr) {
   if (args.hasArg(OPT_version))
     return;
 
+  // Skip the link if --incremental-state shows that its output would be
+  // the same as the existing one.
+  if (isIncrementalStateUpToDate(args))
+    return;
+
   // Initialize time trace profiler.
   if (config->timeTraceEnabled)
     timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName);
@@ -530,6 +537,8 @@ void LinkerDriver::main(ArrayRef<const char *> argsArr) {
     }
   }
 
+  writeIncrementalState(args);
+
   if (config->timeTraceEnabled) {
     if (auto E = timeTraceProfilerWrite(args.getLastArgValue(OPT_time_trace_file_eq).str(),
                                         config->outputFile)) {
@@ -724,6 +733,8 @@ getBuildId(opt::InputArgList &args) {
     return {BuildIdKind::Md5, {}};
   if (s == "sha1" || s == "tree")
     return {BuildIdKind::Sha1, {}};
+  if (s == "blake3")
+    return {BuildIdKind::Blake3, {}};
   if (s == "uuid")
     return {BuildIdKind::Uuid, {}};
   if (s.startswith("0x"))
@@ -748,25 +759,36 @@ static std::pair<bool, bool> getPackDynRelocs(opt::InputArgList &args) {
   return {false, false};
 }
 
-static void readCallGraph(MemoryBufferRef mb) {
-  // Build a map from symbol name to section
+// Builds a map from symbol name to symbol for reading profiles.
+static DenseMap<StringRef, Symbol *> getProfileSymbolMap() {
   DenseMap<StringRef, Symbol *> map;
   for (InputFile *file : objectFiles)
     for (Symbol *sym : file->getSymbols())
       map[sym->getName()] = sym;
+  return map;
+}
 
-  auto findSection = [&](StringRef name) -> InputSectionBase * {
-    Symbol *sym = map.lookup(name);
-    if (!sym) {
-      if (config->warnSymbolOrdering)
-        warn(mb.getBufferIdentifier() + ": no such symbol: " + name);
-      return nullptr;
-    }
-    maybeWarnUnorderableSymbol(sym);
-
-    if (Defined *dr = dyn_cast_or_null<Defined>(sym))
-      return dyn_cast_or_null<InputSectionBase>(dr->section);
+// Returns the section defining a symbol named in a profile.
+static InputSectionBase *
+findProfileSection(const DenseMap<StringRef, Symbol *> &map,
+                   MemoryBufferRef mb, StringRef name) {
+  Symbol *sym = map.lookup(name);
+  if (!sym) {
+    if (config->warnSymbolOrdering)
+      warn(mb.getBufferIdentifier() + ": no such symbol: " + name);
     return nullptr;
+  }
+  maybeWarnUnorderableSymbol(sym);
+
+  if (Defined *dr = dyn_cast_or_null<Defined>(sym))
+    return dyn_cast_or_null<InputSectionBase>(dr->section);
+  return nullptr;
+}
+
+static void readCallGraph(MemoryBufferRef mb) {
+  DenseMap<StringRef, Symbol *> map = getProfileSymbolMap();
+  auto findSection = [&](StringRef name) {
+    return findProfileSection(map, mb, name);
   };
 
   for (StringRef line : args::getLines(mb)) {
@@ -785,6 +807,53 @@ static void readCallGraph(MemoryBufferRef mb) {
   }
 }
 
+// Reads a branch profile aggregated from sampled branch records, such as
+// LBR samples collected by perf. Each line describes a taken branch and
+// the number of times it was sampled:
+//
+//   <from-symbol>[+<offset>] <to-symbol>[+<offset>] <count>
+//
+// Sections are the unit of ordering, so offsets are accepted, as emitted
+// by common aggregators, but ignored. Unlike a call graph profile, this
+// includes branches within a function; with -fbasic-block-sections these
+// connect the sections of a function, so that its sampled blocks are
+// clustered together and blocks that were never sampled are left out of
+// the hot part of the layout.
+static void readBranchProfile(MemoryBufferRef mb) {
+  DenseMap<StringRef, Symbol *> map = getProfileSymbolMap();
+  auto findSection = [&](StringRef name) {
+    return findProfileSection(map, mb, name);
+  };
+
+  auto getSymbolName = [&](StringRef field) -> Optional<StringRef> {
+    size_t pos = field.rfind('+');
+    if (pos == StringRef::npos)
+      return field;
+    uint64_t offset;
+    if (!to_integer(field.substr(pos + 1), offset))
+      return None;
+    return field.substr(0, pos);
+  };
+
+  for (StringRef line : args::getLines(mb)) {
+    SmallVector<StringRef, 3> fields;
+    line.split(fields, ' ', -1, false);
+    Optional<StringRef> fromName, toName;
+    uint64_t count;
+
+    if (fields.size() != 3 || !(fromName = getSymbolName(fields[0])) ||
+        !(toName = getSymbolName(fields[1])) ||
+        !to_integer(fields[2], count)) {
+      error(mb.getBufferIdentifier() + ": parse error: " + line);
+      return;
+    }
+
+    if (InputSectionBase *from = findSection(*fromName))
+      if (InputSectionBase *to = findSection(*toName))
+        config->callGraphProfile[std::make_pair(from, to)] += count;
+  }
+}
+
 template <class ELFT> static void readCallGraphsFromObjectFiles() {
   for (auto file : objectFiles) {
     auto *obj = cast<ObjFile<ELFT>>(file);
@@ -914,6 +983,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incrementalState = args.getLastArgValue(OPT_incremental_state);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -950,6 +1020,10 @@ static void readConfigs(opt::InputArgList &args) {
   config->optimize = args::getInteger(args, OPT_O, 1);
   config->orphanHandling = getOrphanHandling(args);
   config->outputFile = args.getLastArgValue(OPT_o);
+  config->parallelParse =
+      args.hasFlag(OPT_parallel_parse, OPT_no_parallel_parse, false);
+  config->parallelRelocScan =
+      args.hasFlag(OPT_parallel_reloc_scan, OPT_no_parallel_reloc_scan, false);
   config->pie = args.hasFlag(OPT_pie, OPT_no_pie, false);
   config->printIcfSections =
       args.hasFlag(OPT_print_icf_sections, OPT_no_print_icf_sections, false);
@@ -969,6 +1043,16 @@ static void readConfigs(opt::InputArgList &args) {
   config->soName = args.getLastArgValue(OPT_soname);
   config->sortSection = getSortSection(args);
   config->splitStackAdjustSize = args::getInteger(args, OPT_split_stack_adjust_size, 16384);
+  config->streamOutputFile =
+      args.hasFlag(OPT_stream_output_file, OPT_no_stream_output_file, false);
+#ifdef _WIN32
+  // The streaming writer unmaps parts of an anonymous mapping, which
+  // VirtualFree cannot do.
+  if (config->streamOutputFile) {
+    warn("--stream-output-file is not supported on Windows; ignoring");
+    config->streamOutputFile = false;
+  }
+#endif
   config->strip = getStrip(args);
   config->sysroot = args.getLastArgValue(OPT_sysroot);
   config->target1Rel = args.hasFlag(OPT_target1_rel, OPT_target1_abs, false);
@@ -1115,6 +1199,9 @@ static void readConfigs(opt::InputArgList &args) {
     if (args.hasArg(OPT_call_graph_ordering_file))
       error("--symbol-ordering-file and --call-graph-order-file "
             "may not be used together");
+    if (args.hasArg(OPT_branch_profile))
+      error("--symbol-ordering-file and --branch-profile "
+            "may not be used together");
     if (Optional<MemoryBufferRef> buffer = readFile(arg->getValue())){
       config->symbolOrderingFile = getSymbolOrderingFile(*buffer);
       // Also need to disable CallGraphProfileSort to prevent
@@ -1655,7 +1742,7 @@ static Symbol *addUndefined(StringRef name) {
 // Because all bitcode files that the program consists of are passed to
 // the compiler at once, it can do a whole-program optimization.
 template <class ELFT> void LinkerDriver::compileBitcodeFiles() {
-  llvm::TimeTraceScope timeScope("LTO");
+  PhaseTraceScope timeScope("LTO");
   // Compile bitcode files and replace bitcode symbols.
   lto.reset(new BitcodeCompiler);
   for (BitcodeFile *file : bitcodeFiles)
@@ -1787,7 +1874,7 @@ template <class ELFT> static uint32_t getAndFeatures() {
 // Do actual linking. Note that when this function is called,
 // all linker scripts have already been parsed.
 template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
-  llvm::TimeTraceScope timeScope("Link", StringRef("LinkerDriver::Link"));
+  PhaseTraceScope timeScope("Link", "LinkerDriver::Link");
   // If a -hash-style option was not given, set to a default value,
   // which varies depending on the target.
   if (!args.hasArg(OPT_hash_style)) {
@@ -1828,7 +1915,9 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // add files to the link, via autolinking, these files are always
   // appended to the Files vector.
   {
-    llvm::TimeTraceScope timeScope("Parse input files");
+    PhaseTraceScope timeScope("Parse input files");
+    if (config->parallelParse)
+      preParseFiles(files);
     for (size_t i = 0; i < files.size(); ++i)
       parseFile(files[i]);
   }
@@ -2075,11 +2164,22 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
     if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
       if (Optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
         readCallGraph(*buffer);
+    if (auto *arg = args.getLastArg(OPT_branch_profile))
+      if (Optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
+        readBranchProfile(*buffer);
     readCallGraphsFromObjectFiles<ELFT>();
   }
 
   // Write the result to the file.
   writeResult<ELFT>();
+
+  if (config->timeTraceEnabled) {
+    std::vector<std::pair<std::string, uint64_t>> sections;
+    for (OutputSection *sec : outputSections)
+      sections.push_back({sec->name.str(), sec->size});
+    traceLargest("Largest output section", std::move(sections), 10);
+    traceLargestInputFiles(10);
+  }
 }
 
 } // namespace elf
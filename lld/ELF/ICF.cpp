@@ -80,6 +80,7 @@
 #include "Symbols.h"
 #include "SyntheticSections.h"
 #include "Writer.h"
+#include "lld/Common/LinkTrace.h"
 #include "lld/Common/Threads.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/BinaryFormat/ELF.h"
@@ -121,8 +122,19 @@ private:
 
   void forEachClass(llvm::function_ref<void(size_t, size_t)> fn);
 
+  void moveSettledClasses();
+
+  bool isParallel() const {
+    return parallel::strategy.ThreadsRequested != 1 &&
+           sections.size() - activeBegin >= 1024;
+  }
+
   std::vector<InputSection *> sections;
 
+  // Sections in [0, activeBegin) belong to equivalence classes that can no
+  // longer be split, so the main loop skips them.
+  size_t activeBegin = 0;
+
   // We repeat the main loop while `Repeat` is true.
   std::atomic<bool> repeat;
 
@@ -400,8 +412,8 @@ template <class ELFT>
 void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   // If threading is disabled or the number of sections are
   // too small to use threading, call Fn sequentially.
-  if (parallel::strategy.ThreadsRequested == 1 || sections.size() < 1024) {
-    forEachClassRange(0, sections.size(), fn);
+  if (!isParallel()) {
+    forEachClassRange(activeBegin, sections.size(), fn);
     ++cnt;
     return;
   }
@@ -412,15 +424,20 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   // Shard into non-overlapping intervals, and call Fn in parallel.
   // The sharding must be completed before any calls to Fn are made
   // so that Fn can modify the Chunks in its shard without causing data
-  // races.
-  const size_t numShards = 256;
-  size_t step = sections.size() / numShards;
-  size_t boundaries[numShards + 1];
-  boundaries[0] = 0;
+  // races. Shards are small compared to the number of threads, so that
+  // threads that finish early pick up the remaining ones and a few large
+  // classes do not hold up the whole iteration.
+  size_t size = sections.size() - activeBegin;
+  size_t numShards =
+      std::min<size_t>(4096, std::max<size_t>(256, size / 256));
+  size_t step = size / numShards;
+  std::vector<size_t> boundaries(numShards + 1);
+  boundaries[0] = activeBegin;
   boundaries[numShards] = sections.size();
 
   parallelForEachN(1, numShards, [&](size_t i) {
-    boundaries[i] = findBoundary((i - 1) * step, sections.size());
+    boundaries[i] =
+        findBoundary(activeBegin + (i - 1) * step, sections.size());
   });
 
   parallelForEachN(1, numShards + 1, [&](size_t i) {
@@ -430,6 +447,87 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Equivalence classes whose sections do not refer to any InputSection cannot
+// be split by equalsVariable(). Neither can classes with a single section.
+// Move them in front of the other classes so that the main loop does not
+// revisit them, and renumber all classes by their new positions.
+template <class ELFT> void ICF<ELFT>::moveSettledClasses() {
+  if (isParallel())
+    current = next = cnt % 2;
+
+  auto refersToInputSection = [](InputSection *isec) {
+    auto refers = [&](auto rels) {
+      return llvm::any_of(rels, [&](const auto &rel) {
+        auto *d = dyn_cast<Defined>(
+            &isec->template getFile<ELFT>()->getRelocTargetSym(rel));
+        return d && d->section && isa<InputSection>(d->section);
+      });
+    };
+    if (isec->areRelocsRela)
+      return refers(isec->template relas<ELFT>());
+    return refers(isec->template rels<ELFT>());
+  };
+
+  // Sections that are constant-equal have the same kinds of relocation
+  // targets, so it is enough to look at the first section of each class.
+  std::vector<InputSection *> settled, active;
+  forEachClassRange(0, sections.size(), [&](size_t begin, size_t end) {
+    bool isSettled =
+        end - begin == 1 || !refersToInputSection(sections[begin]);
+    std::vector<InputSection *> &v = isSettled ? settled : active;
+    v.insert(v.end(), sections.begin() + begin, sections.begin() + end);
+  });
+
+  // An equivalence class ID must be unique, so we use the end index of each
+  // class as its ID, as segregate() does.
+  activeBegin = settled.size();
+  sections = std::move(settled);
+  sections.insert(sections.end(), active.begin(), active.end());
+  forEachClassRange(0, sections.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      sections[i]->eqClass[0] = sections[i]->eqClass[1] = end;
+  });
+}
+
+// Returns a hash value of the target of a relocation. The hash values of
+// two relocations are equal if constantEq() considers them equal, except
+// for their offsets and types.
+template <class ELFT, class RelTy>
+static hash_code getRelocTargetHash(InputSection *isec, const RelTy &rel) {
+  enum { Absolute, Section, Merge, Other };
+  uint64_t addend = getAddend<ELFT>(rel);
+  Symbol &s = isec->template getFile<ELFT>()->getRelocTargetSym(rel);
+  auto *d = dyn_cast<Defined>(&s);
+  if (d && !d->scriptDefined && !d->isPreemptible) {
+    if (!d->section)
+      return hash_combine(Absolute, d->value + addend);
+    if (isa<InputSection>(d->section))
+      return hash_combine(Section, d->section->kind(), d->value + addend);
+    // Out-of-range offsets are diagnosed by constantEq() if needed.
+    auto *ms = dyn_cast<MergeInputSection>(d->section);
+    if (ms && (s.isSection() ? addend : d->value) < ms->data().size())
+      return hash_combine(Merge, ms->getParent()->name,
+                          s.isSection() ? ms->getOffset(addend)
+                                        : ms->getOffset(d->value) + addend);
+  }
+  // Other relocations are equal only if they refer to the same symbol.
+  // Symbol names are used instead of addresses to make the order of
+  // equivalence classes deterministic.
+  return hash_combine(Other, s.getName(), addend);
+}
+
+// Returns a hash value of everything equalsConstant() compares.
+template <class ELFT, class RelTy>
+static uint32_t getContentHash(InputSection *isec, ArrayRef<RelTy> rels) {
+  hash_code hash = hash_combine(xxHash64(isec->data()), isec->flags,
+                                isec->getParent()->name, rels.size());
+  for (const RelTy &rel : rels)
+    hash = hash_combine(hash, uint64_t(rel.r_offset),
+                        rel.getType(config->isMips64EL),
+                        getRelocTargetHash<ELFT>(isec, rel));
+  return hash;
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class ELFT, class RelTy>
@@ -466,9 +564,15 @@ template <class ELFT> void ICF<ELFT>::run() {
       sections.push_back(s);
   }
 
-  // Initially, we use hash values to partition sections.
+  // Initially, we use hash values to partition sections. The hash values
+  // cover section contents and relocations except for the equivalence
+  // classes of relocation targets, so most sections that are not
+  // constant-equal end up in different classes without being compared.
   parallelForEach(sections, [&](InputSection *s) {
-    s->eqClass[0] = xxHash64(s->data());
+    if (s->areRelocsRela)
+      s->eqClass[0] = getContentHash<ELFT>(s, s->template relas<ELFT>());
+    else
+      s->eqClass[0] = getContentHash<ELFT>(s, s->template rels<ELFT>());
   });
 
   for (unsigned cnt = 0; cnt != 2; ++cnt) {
@@ -488,6 +592,9 @@ template <class ELFT> void ICF<ELFT>::run() {
 
   // Compare static contents and assign unique IDs for each static content.
   forEachClass([&](size_t begin, size_t end) { segregate(begin, end, true); });
+  moveSettledClasses();
+  log("ICF settled " + Twine(activeBegin) + " of " + Twine(sections.size()) +
+      " sections after comparing contents");
 
   // Split groups by comparing relocations until convergence is obtained.
   do {
@@ -527,7 +634,7 @@ template <class ELFT> void ICF<ELFT>::run() {
 
 // ICF entry point function.
 template <class ELFT> void doIcf() {
-  llvm::TimeTraceScope timeScope("ICF");
+  PhaseTraceScope timeScope("ICF");
   ICF<ELFT>().run();
 }
 
@@ -0,0 +1,322 @@
+//===- IncrementalState.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the --incremental-state option. After a successful
+// link, the linker writes a state file describing the link:
+//
+//   lld-incremental-state 1
+//   args 5D41402ABC4B2A76
+//   output 7D793037A0760186 a.out
+//   input 6F1ED002AB559585 main.o
+//   input 1F3870BE274F6C49 libfoo.a
+//   section 201000 1000 15E 0,1 .text
+//
+// "input" lines contain the xxHash64 of each file read by the linker, and
+// "section" lines list the address, file offset, size and contributing
+// inputs of each output section.
+//
+// When the linker is invoked again from the same directory with the same
+// command line, including the contents of response files, it compares the
+// recorded hashes with the current files. If no input has changed and
+// the output file is intact, the link is skipped. It is not skipped if a map
+// file, a --reproduce archive, a time trace or another report is requested,
+// since those would not be written. Otherwise, the output sections that
+// contain changed inputs are logged with --verbose and the file is linked
+// from scratch.
+//
+// All files that may affect the output must be read through readFile(),
+// which records them. Members of thin archives are read by the archive
+// reader instead; links using them do not get a state file. Library search
+// is not repeated either, so a library added to an earlier search path
+// directory is not noticed until the command line or an input changes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "IncrementalState.h"
+#include "Config.h"
+#include "Driver.h"
+#include "InputFiles.h"
+#include "LinkerScript.h"
+#include "OutputSections.h"
+#include "lld/Common/ErrorHandler.h"
+#include "lld/Common/Version.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Option/ArgList.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace llvm;
+
+namespace lld {
+namespace elf {
+namespace {
+struct IncrementalInput {
+  std::string path;
+  uint64_t hash;
+  // The buffer that was hashed. This is valid only during the link that
+  // read the file.
+  StringRef data;
+};
+
+struct IncrementalSection {
+  std::string name;
+  std::vector<unsigned> inputs;
+};
+
+struct State {
+  uint64_t argsHash = 0;
+  uint64_t outputHash = 0;
+  std::string outputPath;
+  std::vector<IncrementalInput> inputs;
+  std::vector<IncrementalSection> sections;
+};
+} // namespace
+
+static const unsigned stateVersion = 1;
+
+// Files read by this link in the order they were read.
+static std::vector<IncrementalInput> recordedInputs;
+
+// Hashes the command line after response files have been expanded, so that
+// editing a response file is noticed, along with the working directory that
+// relative paths on it are resolved against. The program name does not
+// affect the output; the linker version does.
+static uint64_t hashArgs(const opt::InputArgList &args) {
+  std::string s = getLLDVersion();
+  SmallString<128> cwd;
+  if (!sys::fs::current_path(cwd)) {
+    s += '\0';
+    s += cwd.str();
+  }
+  for (unsigned i = 0, e = args.getNumInputArgStrings(); i != e; ++i) {
+    s += '\0';
+    s += args.getArgString(i);
+  }
+  return xxHash64(s);
+}
+
+static Optional<uint64_t> hashFile(StringRef path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(path, -1, false);
+  if (!mbOrErr)
+    return None;
+  return xxHash64((*mbOrErr)->getBuffer());
+}
+
+void recordIncrementalInput(StringRef path, MemoryBufferRef mb) {
+  if (config->incrementalState.empty())
+    return;
+  recordedInputs.push_back(
+      {std::string(path), xxHash64(mb.getBuffer()), mb.getBuffer()});
+}
+
+// Parses a state file. Returns None if the file does not exist or was not
+// written by this version of the linker.
+static Optional<State> readState(StringRef path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(path, -1, false);
+  if (!mbOrErr)
+    return None;
+
+  State state;
+  SmallVector<StringRef, 0> lines;
+  (*mbOrErr)->getBuffer().split(lines, '\n', -1, false);
+  if (lines.empty() ||
+      lines[0] != "lld-incremental-state " + Twine(stateVersion).str())
+    return None;
+
+  for (StringRef line : makeArrayRef(lines).drop_front()) {
+    StringRef kind, hash, rest;
+    std::tie(kind, rest) = line.split(' ');
+    if (kind == "args") {
+      if (!to_integer(rest, state.argsHash, 16))
+        return None;
+    } else if (kind == "output") {
+      std::tie(hash, rest) = rest.split(' ');
+      if (!to_integer(hash, state.outputHash, 16))
+        return None;
+      state.outputPath = std::string(rest);
+    } else if (kind == "input") {
+      std::tie(hash, rest) = rest.split(' ');
+      IncrementalInput in{std::string(rest), 0, StringRef()};
+      if (!to_integer(hash, in.hash, 16))
+        return None;
+      state.inputs.push_back(std::move(in));
+    } else if (kind == "section") {
+      // Skip the address, the file offset and the size, which are recorded
+      // only for tools inspecting the layout.
+      for (int i = 0; i < 3; ++i)
+        rest = rest.split(' ').second;
+      StringRef inputs;
+      std::tie(inputs, rest) = rest.split(' ');
+      IncrementalSection sec{std::string(rest), {}};
+      SmallVector<StringRef, 8> indices;
+      if (inputs != "-")
+        inputs.split(indices, ',');
+      for (StringRef s : indices) {
+        unsigned idx;
+        if (!to_integer(s, idx, 10) || idx >= state.inputs.size())
+          return None;
+        sec.inputs.push_back(idx);
+      }
+      state.sections.push_back(std::move(sec));
+    } else {
+      return None;
+    }
+  }
+  return state;
+}
+
+bool isIncrementalStateUpToDate(const opt::InputArgList &args) {
+  if (config->incrementalState.empty())
+    return false;
+
+  // A skipped link would not write the map file, the --reproduce archive, the
+  // time trace or the other reports, so link as usual if any is requested.
+  if (tar || !config->mapFile.empty() || config->cref ||
+      !config->printSymbolOrder.empty() || config->timeTraceEnabled ||
+      config->printGcSections || config->printIcfSections || config->trace ||
+      args.hasArg(OPT_trace_symbol)) {
+    log("incremental state: other outputs requested, not skipping the link");
+    return false;
+  }
+
+  Optional<State> state = readState(config->incrementalState);
+  if (!state) {
+    log("incremental state: " + config->incrementalState +
+        " is missing or invalid");
+    return false;
+  }
+  if (state->argsHash != hashArgs(args)) {
+    log("incremental state: command line changed");
+    return false;
+  }
+
+  std::vector<bool> changed(state->inputs.size());
+  bool anyChanged = false;
+  for (size_t i = 0, e = state->inputs.size(); i != e; ++i) {
+    Optional<uint64_t> hash = hashFile(state->inputs[i].path);
+    if (!hash || *hash != state->inputs[i].hash) {
+      log("incremental state: input changed: " + state->inputs[i].path);
+      changed[i] = true;
+      anyChanged = true;
+    }
+  }
+
+  if (!anyChanged) {
+    Optional<uint64_t> hash = hashFile(state->outputPath);
+    if (hash && *hash == state->outputHash) {
+      log("incremental state: " + state->outputPath + " is up to date");
+      return true;
+    }
+    log("incremental state: output changed: " + state->outputPath);
+    return false;
+  }
+
+  for (const IncrementalSection &sec : state->sections)
+    if (llvm::any_of(sec.inputs, [&](unsigned i) { return changed[i]; }))
+      log("incremental state: output section changed: " + sec.name);
+  return false;
+}
+
+// Returns the name of the file read by readFile() that an input file was
+// created from.
+static StringRef getSourcePath(const InputFile *file) {
+  return file->archiveName.empty() ? file->getName()
+                                   : StringRef(file->archiveName);
+}
+
+// Returns true if the contents of a given file were read by readFile().
+// Buffers must be sorted by their start addresses.
+static bool isRecorded(ArrayRef<StringRef> buffers, const InputFile *file) {
+  const char *p = file->mb.getBufferStart();
+  auto it = llvm::upper_bound(buffers, p, [](const char *p, StringRef buf) {
+    return p < buf.begin();
+  });
+  return it != buffers.begin() && p < std::prev(it)->end();
+}
+
+void writeIncrementalState(const opt::InputArgList &args) {
+  if (config->incrementalState.empty() || errorCount())
+    return;
+
+  // A stale state file must not outlive a link that cannot be described by
+  // a new one.
+  auto discard = [&](const Twine &msg) {
+    log("incremental state: " + msg);
+    sys::fs::remove(config->incrementalState);
+  };
+
+  if (config->outputFile == "-")
+    return discard("output is not a regular file");
+  std::vector<StringRef> buffers;
+  for (const IncrementalInput &in : recordedInputs)
+    buffers.push_back(in.data);
+  llvm::sort(buffers, [](StringRef a, StringRef b) {
+    return a.begin() < b.begin();
+  });
+  auto isThinMember = [&](InputFile *file) {
+    return !file->archiveName.empty() && !isRecorded(buffers, file);
+  };
+  for (InputFile *file : objectFiles)
+    if (isThinMember(file))
+      return discard("thin archive members are not tracked: " +
+                     toString(file));
+  for (BitcodeFile *file : bitcodeFiles)
+    if (isThinMember(file))
+      return discard("thin archive members are not tracked: " +
+                     toString(file));
+
+  Optional<uint64_t> outputHash = hashFile(config->outputFile);
+  if (!outputHash)
+    return discard("cannot read " + config->outputFile);
+
+  StringMap<unsigned> inputIndex;
+  for (size_t i = 0, e = recordedInputs.size(); i != e; ++i)
+    inputIndex.insert({recordedInputs[i].path, i});
+
+  std::error_code ec;
+  raw_fd_ostream os(config->incrementalState, ec, sys::fs::OF_None);
+  if (ec) {
+    error("cannot open " + config->incrementalState + ": " + ec.message());
+    return;
+  }
+
+  os << "lld-incremental-state " << stateVersion << '\n';
+  os << "args " << utohexstr(hashArgs(args)) << '\n';
+  os << "output " << utohexstr(*outputHash) << ' ' << config->outputFile
+     << '\n';
+  for (const IncrementalInput &in : recordedInputs)
+    os << "input " << utohexstr(in.hash) << ' ' << in.path << '\n';
+
+  for (OutputSection *osec : outputSections) {
+    SetVector<unsigned> inputs;
+    for (BaseCommand *base : osec->sectionCommands)
+      if (auto *isd = dyn_cast<InputSectionDescription>(base))
+        for (InputSection *isec : isd->sections)
+          if (isec->file) {
+            auto it = inputIndex.find(getSourcePath(isec->file));
+            if (it != inputIndex.end())
+              inputs.insert(it->second);
+          }
+
+    os << "section " << utohexstr(osec->addr) << ' '
+       << utohexstr(osec->offset) << ' ' << utohexstr(osec->size) << ' ';
+    if (inputs.empty())
+      os << '-';
+    for (size_t i = 0, e = inputs.size(); i != e; ++i)
+      os << (i ? "," : "") << inputs[i];
+    os << ' ' << osec->name << '\n';
+  }
+}
+} // namespace elf
+} // namespace lld
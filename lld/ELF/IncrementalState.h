@@ -0,0 +1,35 @@
+//===- IncrementalState.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_ELF_INCREMENTAL_STATE_H
+#define LLD_ELF_INCREMENTAL_STATE_H
+
+#include "lld/Common/LLVM.h"
+
+namespace llvm {
+namespace opt {
+class InputArgList;
+}
+} // namespace llvm
+
+namespace lld {
+namespace elf {
+// Records the contents of a file read by the linker.
+void recordIncrementalInput(StringRef path, MemoryBufferRef mb);
+
+// Returns true if the --incremental-state file shows that the previous link
+// used the same expanded command line, working directory and input files, and
+// that its output file has not been modified since.
+bool isIncrementalStateUpToDate(const llvm::opt::InputArgList &args);
+
+// Writes the --incremental-state file after a successful link.
+void writeIncrementalState(const llvm::opt::InputArgList &args);
+} // namespace elf
+} // namespace lld
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "InputFiles.h"
 #include "Driver.h"
+#include "IncrementalState.h"
 #include "InputSection.h"
 #include "LinkerScript.h"
 #include "SymbolTable.h"
@@ -15,7 +16,9 @@
 #include "SyntheticSections.h"
 #include "lld/Common/DWARF.h"
 #include "lld/Common/ErrorHandler.h"
+#include "lld/Common/LinkTrace.h"
 #include "lld/Common/Memory.h"
+#include "lld/Common/Threads.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/CodeGen/Analysis.h"
 #include "llvm/IR/LLVMContext.h"
@@ -121,9 +124,19 @@ Optional<MemoryBufferRef> readFile(StringRef path) {
 
   if (tar)
     tar->append(relativeToRoot(path), mbref.getBuffer());
+  recordIncrementalInput(path, mbref);
+  traceInputFile(path, mbref.getBufferSize());
   return mbref;
 }
 
+// Returns true if an ELF or bitcode file is for the target being linked.
+static bool matchesTarget(InputFile *file) {
+  if (file->ekind != config->ekind || file->emachine != config->emachine)
+    return false;
+  return config->emachine != EM_MIPS ||
+         isMipsN32Abi(file) == config->mipsN32Abi;
+}
+
 // All input object files must be for the same architecture
 // (e.g. it does not make sense to link x86 object files with
 // MIPS object files.) This function checks for that error.
@@ -131,12 +144,8 @@ static bool isCompatible(InputFile *file) {
   if (!file->isElf() && !isa<BitcodeFile>(file))
     return true;
 
-  if (file->ekind == config->ekind && file->emachine == config->emachine) {
-    if (config->emachine != EM_MIPS)
-      return true;
-    if (isMipsN32Abi(file) == config->mipsN32Abi)
-      return true;
-  }
+  if (matchesTarget(file))
+    return true;
 
   StringRef target =
       !config->bfdname.empty() ? config->bfdname : config->emulation;
@@ -225,6 +234,33 @@ void parseFile(InputFile *file) {
   }
 }
 
+void preParseFiles(ArrayRef<InputFile *> files) {
+  // Lazy object files, archives and bitcode files are resolved differently,
+  // and shared objects are cheap to parse, so only regular object files are
+  // handled here. Files for another target are left for parseFile() to
+  // diagnose.
+  parallelForEach(files, [](InputFile *file) {
+    if (file->kind() != InputFile::ObjKind || !matchesTarget(file))
+      return;
+    switch (file->ekind) {
+    case ELF32LEKind:
+      cast<ObjFile<ELF32LE>>(file)->preParse();
+      return;
+    case ELF32BEKind:
+      cast<ObjFile<ELF32BE>>(file)->preParse();
+      return;
+    case ELF64LEKind:
+      cast<ObjFile<ELF64LE>>(file)->preParse();
+      return;
+    case ELF64BEKind:
+      cast<ObjFile<ELF64BE>>(file)->preParse();
+      return;
+    default:
+      llvm_unreachable("unknown ELFT");
+    }
+  });
+}
+
 // Concatenates arguments to construct a string representing an error location.
 static std::string createFileLineMsg(StringRef path, unsigned line) {
   std::string filename = std::string(path::filename(path));
@@ -1048,10 +1084,16 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
 
   // Our symbol table may have already been partially initialized
   // because of LazyObjFile.
-  for (size_t i = 0, end = eSyms.size(); i != end; ++i)
-    if (!this->symbols[i] && eSyms[i].getBinding() != STB_LOCAL)
+  for (size_t i = 0, end = eSyms.size(); i != end; ++i) {
+    if (this->symbols[i] || eSyms[i].getBinding() == STB_LOCAL)
+      continue;
+    if (i < symbolKeys.size() && symbolKeys[i])
+      this->symbols[i] = symtab->insert(*symbolKeys[i]);
+    else
       this->symbols[i] =
           symtab->insert(CHECK(eSyms[i].getName(this->stringTable), this));
+  }
+  symbolKeys = {};
 
   // Fill this->Symbols. A symbol is either local or global.
   for (size_t i = 0, end = eSyms.size(); i != end; ++i) {
@@ -1131,6 +1173,22 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
   }
 }
 
+template <class ELFT> void ObjFile<ELFT>::preParse() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  symbolKeys.resize(eSyms.size());
+  for (size_t i = this->firstGlobal, end = eSyms.size(); i != end; ++i) {
+    if (eSyms[i].getBinding() == STB_LOCAL)
+      continue;
+    // Errors are not reported here, so that they are reported by
+    // initializeSymbols() in the same order as without preParse().
+    Expected<StringRef> name = eSyms[i].getName(this->stringTable);
+    if (name)
+      symbolKeys[i] = SymbolTable::getKey(*name);
+    else
+      consumeError(name.takeError());
+  }
+}
+
 ArchiveFile::ArchiveFile(std::unique_ptr<Archive> &&file)
     : InputFile(ArchiveKind, file->getMemoryBufferRef()),
       file(std::move(file)) {}
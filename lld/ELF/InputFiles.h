@@ -55,6 +55,11 @@ llvm::Optional<MemoryBufferRef> readFile(StringRef path);
 // Add symbols in File to the symbol table.
 void parseFile(InputFile *file);
 
+// Does the part of parseFile() that does not depend on the symbol table for
+// the given files using multiple threads. Calling this is optional; the
+// result of parseFile() is the same either way.
+void preParseFiles(ArrayRef<InputFile *> files);
+
 // The root class of input files.
 class InputFile {
 public:
@@ -205,6 +210,10 @@ public:
 
   void parse(bool ignoreComdats = false);
 
+  // Computes the symbol table keys of this file's global symbols. This reads
+  // only this file, so it is safe to call for many files concurrently.
+  void preParse();
+
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
 
@@ -281,6 +290,11 @@ private:
   // .shstrtab contents.
   StringRef sectionStringTable;
 
+  // Symbol table keys computed by preParse(), indexed by symbol index. An
+  // entry is None for local symbols and for symbols with a broken name, so
+  // that initializeSymbols() reports the latter as usual.
+  std::vector<llvm::Optional<llvm::CachedHashStringRef>> symbolKeys;
+
   // Debugging information to retrieve source file and line for error
   // reporting. Linker may find reasonable number of errors in a
   // single object file, so we cache debugging information in order to
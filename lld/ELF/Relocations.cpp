@@ -52,6 +52,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
+#include "lld/Common/Threads.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/Support/Endian.h"
@@ -1261,24 +1262,47 @@ static void processRelocAux(InputSectionBase &sec, RelExpr expr, RelType type,
               getLocation(sec, sym, offset));
 }
 
+namespace {
+// The part of a relocation's scan result that depends only on the relocation,
+// the section containing it and its target symbol. It does not touch any
+// global linker state, so it can be computed for many sections concurrently.
+// See scanRelocationsParallel.
+struct PreScannedReloc {
+  uint64_t offset;
+  int64_t addend;
+  RelType type;
+  RelExpr expr;
+  // False if the target symbol is undefined. maybeReportUndefined() has to
+  // see such a relocation before its expression is computed.
+  bool hasExpr;
+};
+} // namespace
+
 template <class ELFT, class RelTy>
 static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
-                      RelTy *end) {
+                      RelTy *end, const PreScannedReloc *pre = nullptr) {
   const RelTy &rel = *i;
   uint32_t symIndex = rel.getSymbol(config->isMips64EL);
   Symbol &sym = sec.getFile<ELFT>()->getSymbol(symIndex);
   RelType type;
+  uint64_t offset;
 
-  // Deal with MIPS oddity.
-  if (config->mipsN32Abi) {
-    type = getMipsN32RelType(i, end);
-  } else {
-    type = rel.getType(config->isMips64EL);
+  if (pre) {
+    type = pre->type;
+    offset = pre->offset;
     ++i;
-  }
+  } else {
+    // Deal with MIPS oddity.
+    if (config->mipsN32Abi) {
+      type = getMipsN32RelType(i, end);
+    } else {
+      type = rel.getType(config->isMips64EL);
+      ++i;
+    }
 
-  // Get an offset in an output section this relocation is applied to.
-  uint64_t offset = getOffset.get(rel.r_offset);
+    // Get an offset in an output section this relocation is applied to.
+    offset = getOffset.get(rel.r_offset);
+  }
   if (offset == uint64_t(-1))
     return;
 
@@ -1288,7 +1312,9 @@ static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
     return;
 
   const uint8_t *relocatedAddr = sec.data().begin() + rel.r_offset;
-  RelExpr expr = target->getRelExpr(type, sym, relocatedAddr);
+  RelExpr expr = (pre && pre->hasExpr)
+                     ? pre->expr
+                     : target->getRelExpr(type, sym, relocatedAddr);
 
   // Ignore R_*_NONE and other marker relocations.
   if (expr == R_NONE)
@@ -1316,7 +1342,9 @@ static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
   }
 
   // Read an addend.
-  int64_t addend = computeAddend<ELFT>(rel, end, sec, expr, sym.isLocal());
+  int64_t addend = (pre && pre->hasExpr)
+                       ? pre->addend
+                       : computeAddend<ELFT>(rel, end, sec, expr, sym.isLocal());
 
   // Relax relocations.
   //
@@ -1484,14 +1512,16 @@ static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
 }
 
 template <class ELFT, class RelTy>
-static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
+static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels,
+                       ArrayRef<PreScannedReloc> pre = {}) {
   OffsetGetter getOffset(sec);
 
   // Not all relocations end up in Sec.Relocations, but a lot do.
   sec.relocations.reserve(rels.size());
 
   for (auto i = rels.begin(), end = rels.end(); i != end;)
-    scanReloc<ELFT>(sec, getOffset, i, end);
+    scanReloc<ELFT>(sec, getOffset, i, end,
+                    pre.empty() ? nullptr : &pre[i - rels.begin()]);
 
   // Sort relocations by offset for more efficient searching for
   // R_RISCV_PCREL_HI20 and R_PPC64_ADDR64.
@@ -1510,6 +1540,90 @@ template <class ELFT> void scanRelocations(InputSectionBase &s) {
     scanRelocs<ELFT>(s, s.rels<ELFT>());
 }
 
+// Computes the PreScannedReloc of each relocation in a given section. This
+// mirrors the first half of scanReloc().
+template <class ELFT, class RelTy>
+static void preScanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels,
+                          std::vector<PreScannedReloc> &out) {
+  OffsetGetter getOffset(sec);
+  ObjFile<ELFT> *file = sec.getFile<ELFT>();
+  const uint8_t *buf = sec.data().begin();
+
+  out.resize(rels.size());
+  for (size_t i = 0, e = rels.size(); i != e; ++i) {
+    const RelTy &rel = rels[i];
+    PreScannedReloc &p = out[i];
+    uint32_t symIndex = rel.getSymbol(config->isMips64EL);
+    Symbol &sym = file->getSymbol(symIndex);
+    p.type = rel.getType(config->isMips64EL);
+    p.offset = getOffset.get(rel.r_offset);
+    p.hasExpr = p.offset != uint64_t(-1) && !(symIndex != 0 && sym.isUndefined());
+    if (!p.hasExpr)
+      continue;
+    p.expr = target->getRelExpr(p.type, sym, buf + rel.r_offset);
+    if (p.expr != R_NONE)
+      p.addend = computeAddend<ELFT>(rel, rels.end(), sec, p.expr,
+                                     sym.isLocal());
+  }
+}
+
+template <class ELFT>
+static void preScanRelocations(InputSectionBase &s,
+                               std::vector<PreScannedReloc> &out) {
+  if (s.areRelocsRela)
+    preScanRelocs<ELFT>(s, s.relas<ELFT>(), out);
+  else
+    preScanRelocs<ELFT>(s, s.rels<ELFT>(), out);
+}
+
+template <class ELFT>
+void scanRelocationsParallel(ArrayRef<InputSectionBase *> sections) {
+  // MIPS computes addends and relocation types from neighboring relocations
+  // and from symbol state that changes during the scan, so it can only be
+  // scanned one relocation at a time.
+  if (config->emachine == EM_MIPS) {
+    for (InputSectionBase *s : sections)
+      scanRelocations<ELFT>(*s);
+    return;
+  }
+
+  // Sections are processed in windows of roughly maxRelocs relocations to
+  // bound the memory used by the pre-scanned buffers. Within a window, the
+  // side-effect-free part of the scan runs concurrently. Then the rest of
+  // the scan, which creates GOT, PLT, copy and dynamic relocations, runs
+  // serially in input order, so the output is identical to that of
+  // scanRelocations().
+  //
+  // Diagnostics from the concurrent part are saved per section and reported
+  // in input order, so that they do not depend on thread scheduling.
+  const size_t maxRelocs = 1 << 20;
+  std::vector<std::vector<PreScannedReloc>> pre;
+  std::vector<DeferredDiagnostics> diags;
+  for (size_t begin = 0, e = sections.size(); begin != e;) {
+    size_t end = begin;
+    size_t numRelocs = 0;
+    while (end != e && (end == begin || numRelocs < maxRelocs))
+      numRelocs += sections[end++]->numRelocations;
+
+    pre.resize(end - begin);
+    diags.resize(end - begin);
+    parallelForEachN(begin, end, [&](size_t i) {
+      diags[i - begin].capture(
+          [&] { preScanRelocations<ELFT>(*sections[i], pre[i - begin]); });
+    });
+
+    for (size_t i = begin; i != end; ++i) {
+      diags[i - begin].report();
+      InputSectionBase &s = *sections[i];
+      if (s.areRelocsRela)
+        scanRelocs<ELFT>(s, s.relas<ELFT>(), pre[i - begin]);
+      else
+        scanRelocs<ELFT>(s, s.rels<ELFT>(), pre[i - begin]);
+    }
+    begin = end;
+  }
+}
+
 static bool mergeCmp(const InputSection *a, const InputSection *b) {
   // std::merge requires a strict weak ordering.
   if (a->outSecOff < b->outSecOff)
@@ -2026,6 +2140,10 @@ template void scanRelocations<ELF32LE>(InputSectionBase &);
 template void scanRelocations<ELF32BE>(InputSectionBase &);
 template void scanRelocations<ELF64LE>(InputSectionBase &);
 template void scanRelocations<ELF64BE>(InputSectionBase &);
+template void scanRelocationsParallel<ELF32LE>(ArrayRef<InputSectionBase *>);
+template void scanRelocationsParallel<ELF32BE>(ArrayRef<InputSectionBase *>);
+template void scanRelocationsParallel<ELF64LE>(ArrayRef<InputSectionBase *>);
+template void scanRelocationsParallel<ELF64BE>(ArrayRef<InputSectionBase *>);
 template void reportUndefinedSymbols<ELF32LE>();
 template void reportUndefinedSymbols<ELF32BE>();
 template void reportUndefinedSymbols<ELF64LE>();
@@ -123,6 +123,12 @@ struct JumpInstrMod {
 // the diagnostics.
 template <class ELFT> void scanRelocations(InputSectionBase &);
 
+// Same as calling scanRelocations() on each of the given sections in order,
+// but computes the parts of the scan that do not depend on global state using
+// multiple threads.
+template <class ELFT>
+void scanRelocationsParallel(ArrayRef<InputSectionBase *> sections);
+
 template <class ELFT> void reportUndefinedSymbols();
 
 void hexagonTLSSymbolUpdate(ArrayRef<OutputSection *> outputSections);
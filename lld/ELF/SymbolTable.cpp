@@ -49,7 +49,7 @@ void SymbolTable::wrap(Symbol *sym, Symbol *real, Symbol *wrap) {
 }
 
 // Find an existing symbol or create a new one.
-Symbol *SymbolTable::insert(StringRef name) {
+CachedHashStringRef SymbolTable::getKey(StringRef name) {
   // <name>@@<version> means the symbol is the default version. In that
   // case <name>@@<version> will be used to resolve references to <name>.
   //
@@ -59,8 +59,14 @@ Symbol *SymbolTable::insert(StringRef name) {
   size_t pos = name.find('@');
   if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
     name = name.take_front(pos);
+  return CachedHashStringRef(name);
+}
+
+Symbol *SymbolTable::insert(StringRef name) { return insert(getKey(name)); }
 
-  auto p = symMap.insert({CachedHashStringRef(name), (int)symVector.size()});
+Symbol *SymbolTable::insert(CachedHashStringRef key) {
+  StringRef name = key.val();
+  auto p = symMap.insert({key, (int)symVector.size()});
   int &symIndex = p.first->second;
   bool isNew = p.second;
 
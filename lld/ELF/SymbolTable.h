@@ -47,6 +47,13 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as insert(StringRef), but takes a key computed by getKey(). Keys
+  // can be computed on worker threads ahead of time; see preParseFiles().
+  Symbol *insert(llvm::CachedHashStringRef key);
+
+  // Returns the key under which a symbol with a given name is stored.
+  static llvm::CachedHashStringRef getKey(StringRef name);
+
   Symbol *addSymbol(const Symbol &newSym);
 
   void scanVersionScript();
@@ -280,6 +280,8 @@ static size_t getHashSize() {
     return 16;
   case BuildIdKind::Sha1:
     return 20;
+  case BuildIdKind::Blake3:
+    return 32;
   case BuildIdKind::Hexstring:
     return config->buildIdVector.size();
   default:
@@ -2727,41 +2729,52 @@ readPubNamesAndTypes(const LLDDwarfObj<ELFT> &obj,
   return ret;
 }
 
-// Create a list of symbols from a given list of symbol names and types
-// by uniquifying them by name.
-static std::vector<GdbIndexSection::GdbSymbol>
-createSymbols(ArrayRef<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
-              const std::vector<GdbIndexSection::GdbChunk> &chunks) {
+namespace {
+// Creates a list of symbols from lists of symbol names and types by
+// uniquifying them by name. Names are added in batches of input files, so
+// the names of a batch can be freed as soon as they have been added.
+class GdbSymbolBuilder {
+public:
   using GdbSymbol = GdbIndexSection::GdbSymbol;
   using NameAttrEntry = GdbIndexSection::NameAttrEntry;
 
-  // For each chunk, compute the number of compilation units preceding it.
-  uint32_t cuIdx = 0;
-  std::vector<uint32_t> cuIdxs(chunks.size());
-  for (uint32_t i = 0, e = chunks.size(); i != e; ++i) {
-    cuIdxs[i] = cuIdx;
-    cuIdx += chunks[i].compilationUnits.size();
-  }
+  GdbSymbolBuilder();
 
-  // The number of symbols we will handle in this function is of the order
-  // of millions for very large executables, so we use multi-threading to
-  // speed it up.
-  constexpr size_t numShards = 32;
-  size_t concurrency = PowerOf2Floor(
-      std::min<size_t>(hardware_concurrency(parallel::strategy.ThreadsRequested)
-                           .compute_thread_count(),
-                       numShards));
+  // Adds the names of consecutive input files. cuIdxs[i] is the number of
+  // compilation units preceding the file of nameAttrs[i].
+  void add(ArrayRef<std::vector<NameAttrEntry>> nameAttrs,
+           ArrayRef<uint32_t> cuIdxs);
+  std::vector<GdbSymbol> finish();
 
-  // A sharded map to uniquify symbols by name.
-  std::vector<DenseMap<CachedHashStringRef, size_t>> map(numShards);
+private:
+  static constexpr size_t numShards = 32;
+
+  size_t concurrency;
   size_t shift = 32 - countTrailingZeros(numShards);
 
-  // Instantiate GdbSymbols while uniqufying them by name.
-  std::vector<std::vector<GdbSymbol>> symbols(numShards);
+  // A sharded map to uniquify symbols by name.
+  std::vector<DenseMap<CachedHashStringRef, size_t>> map;
+  std::vector<std::vector<GdbSymbol>> symbols;
+};
+} // namespace
+
+GdbSymbolBuilder::GdbSymbolBuilder() : map(numShards), symbols(numShards) {
+  // The number of symbols we will handle is of the order of millions for
+  // very large executables, so we use multi-threading to speed it up.
+  concurrency = PowerOf2Floor(
+      std::min(hardware_concurrency(parallel::strategy.ThreadsRequested)
+                   .compute_thread_count(),
+               (unsigned)numShards));
+}
+
+void GdbSymbolBuilder::add(ArrayRef<std::vector<NameAttrEntry>> nameAttrs,
+                           ArrayRef<uint32_t> cuIdxs) {
+  // Instantiate GdbSymbols while uniqufying them by name. Each thread owns
+  // a fixed set of shards, and entries are visited in input order, so the
+  // result does not depend on the batch size or the number of threads.
   parallelForEachN(0, concurrency, [&](size_t threadId) {
-    uint32_t i = 0;
-    for (ArrayRef<NameAttrEntry> entries : nameAttrs) {
-      for (const NameAttrEntry &ent : entries) {
+    for (size_t i = 0, e = nameAttrs.size(); i != e; ++i) {
+      for (const NameAttrEntry &ent : nameAttrs[i]) {
         size_t shardId = ent.name.hash() >> shift;
         if ((shardId & (concurrency - 1)) != threadId)
           continue;
@@ -2776,9 +2789,12 @@ createSymbols(ArrayRef<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
         idx = symbols[shardId].size() + 1;
         symbols[shardId].push_back({ent.name, {v}, 0, 0});
       }
-      ++i;
     }
   });
+}
+
+std::vector<GdbIndexSection::GdbSymbol> GdbSymbolBuilder::finish() {
+  map.clear();
 
   size_t numSymbols = 0;
   for (ArrayRef<GdbSymbol> v : symbols)
@@ -2788,9 +2804,11 @@ createSymbols(ArrayRef<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
   // contents to Ret.
   std::vector<GdbSymbol> ret;
   ret.reserve(numSymbols);
-  for (std::vector<GdbSymbol> &vec : symbols)
+  for (std::vector<GdbSymbol> &vec : symbols) {
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
+    vec = {};
+  }
 
   // CU vectors and symbol names are adjacent in the output file.
   // We can compute their offsets in the output file now.
@@ -2819,25 +2837,45 @@ template <class ELFT> GdbIndexSection *GdbIndexSection::create() {
       s->markDead();
 
   std::vector<GdbChunk> chunks(sections.size());
-  std::vector<std::vector<NameAttrEntry>> nameAttrs(sections.size());
-
-  parallelForEachN(0, sections.size(), [&](size_t i) {
-    // To keep memory usage low, we don't want to keep cached DWARFContext, so
-    // avoid getDwarf() here.
-    ObjFile<ELFT> *file = sections[i]->getFile<ELFT>();
-    DWARFContext dwarf(std::make_unique<LLDDwarfObj<ELFT>>(file));
-
-    chunks[i].sec = sections[i];
-    chunks[i].compilationUnits = readCuList(dwarf);
-    chunks[i].addressAreas = readAddressAreas(dwarf, sections[i]);
-    nameAttrs[i] = readPubNamesAndTypes<ELFT>(
-        static_cast<const LLDDwarfObj<ELFT> &>(dwarf.getDWARFObj()),
-        chunks[i].compilationUnits);
-  });
+  GdbSymbolBuilder builder;
+
+  // Name and type tuples of all input files together can be much larger
+  // than the resulting index, so input files are read in batches and each
+  // batch is reduced into the symbol table before the next one is read.
+  // DWARF contexts are not cached; each one is freed as soon as its file
+  // has been read.
+  const size_t batchSize = 256;
+  uint32_t cuIdx = 0;
+  for (size_t begin = 0; begin < sections.size(); begin += batchSize) {
+    size_t end = std::min(begin + batchSize, sections.size());
+    std::vector<std::vector<NameAttrEntry>> nameAttrs(end - begin);
+
+    parallelForEachN(begin, end, [&](size_t i) {
+      // To keep memory usage low, we don't want to keep cached DWARFContext,
+      // so avoid getDwarf() here.
+      ObjFile<ELFT> *file = sections[i]->getFile<ELFT>();
+      DWARFContext dwarf(std::make_unique<LLDDwarfObj<ELFT>>(file));
+
+      chunks[i].sec = sections[i];
+      chunks[i].compilationUnits = readCuList(dwarf);
+      chunks[i].addressAreas = readAddressAreas(dwarf, sections[i]);
+      nameAttrs[i - begin] = readPubNamesAndTypes<ELFT>(
+          static_cast<const LLDDwarfObj<ELFT> &>(dwarf.getDWARFObj()),
+          chunks[i].compilationUnits);
+    });
+
+    // For each chunk, compute the number of compilation units preceding it.
+    std::vector<uint32_t> cuIdxs(end - begin);
+    for (size_t i = begin; i != end; ++i) {
+      cuIdxs[i - begin] = cuIdx;
+      cuIdx += chunks[i].compilationUnits.size();
+    }
+    builder.add(nameAttrs, cuIdxs);
+  }
 
   auto *ret = make<GdbIndexSection>();
   ret->chunks = std::move(chunks);
-  ret->symbols = createSymbols(nameAttrs, ret->chunks);
+  ret->symbols = builder.finish();
   ret->initOutputSize();
   return ret;
 }
@@ -3174,8 +3212,13 @@ void MergeTailSection::finalizeContents() {
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
-  for (size_t i = 0; i < numShards; ++i)
-    shards[i].write(buf + shardOffsets[i]);
+  parallelForEachN(0, numShards, [&](size_t shardId) {
+    for (std::pair<uint32_t, uint32_t> p : shards[shardId]) {
+      MergeInputSection *sec = sections[p.first];
+      StringRef data = sec->getData(p.second).val();
+      memcpy(buf + sec->pieces[p.second].outputOff, data.data(), data.size());
+    }
+  });
 }
 
 // This function is very hot (i.e. it can take several seconds to finish)
@@ -3184,13 +3227,15 @@ void MergeNoTailSection::writeTo(uint8_t *buf) {
 //
 // For any strings S and T, we know S is not mergeable with T if S's hash
 // value is different from T's. If that's the case, we can safely put S and
-// T into different string builders without worrying about merge misses.
-// We do it in parallel.
+// T into different shards without worrying about merge misses. We do it in
+// parallel.
+//
+// Sections such as .debug_str can have hundreds of millions of pieces, so
+// each shard is deduplicated with an open-addressing table of 32-bit indices
+// into the shard's unique pieces. Strings and their hashes are read from the
+// pieces themselves instead of being copied into the table. A first pass
+// counts the live pieces of each shard, which bounds the size of its table.
 void MergeNoTailSection::finalizeContents() {
-  // Initializes string table builders.
-  for (size_t i = 0; i < numShards; ++i)
-    shards.emplace_back(StringTableBuilder::RAW, alignment);
-
   // Concurrency level. Must be a power of 2 to avoid expensive modulo
   // operations in the following tight loop.
   size_t concurrency = PowerOf2Floor(
@@ -3198,27 +3243,89 @@ void MergeNoTailSection::finalizeContents() {
                            .compute_thread_count(),
                        numShards));
 
-  // Add section pieces to the builders.
+  size_t numLive[numShards] = {};
+  size_t tableBytes[numShards] = {};
+  uint64_t shardSizes[numShards] = {};
+
   parallelForEachN(0, concurrency, [&](size_t threadId) {
-    for (MergeInputSection *sec : sections) {
+    // Count live pieces in the shards owned by this thread.
+    for (MergeInputSection *sec : sections)
+      for (const SectionPiece &piece : sec->pieces)
+        if (piece.live) {
+          size_t shardId = getShardId(piece.hash);
+          if ((shardId & (concurrency - 1)) == threadId)
+            ++numLive[shardId];
+        }
+
+    // The maximum load factor of the tables is 3/4.
+    std::vector<uint32_t> tables[numShards];
+    auto grow = [&](size_t shardId) {
+      std::vector<uint32_t> &table = tables[shardId];
+      size_t maxSize = PowerOf2Ceil(numLive[shardId] * 4 / 3 + 1);
+      table.assign(std::min<size_t>(std::max<size_t>(table.size() * 2, 1024),
+                                    maxSize),
+                   0);
+      size_t mask = table.size() - 1;
+      for (size_t i = 0, e = shards[shardId].size(); i != e; ++i) {
+        std::pair<uint32_t, uint32_t> p = shards[shardId][i];
+        size_t slot = sections[p.first]->pieces[p.second].hash & mask;
+        while (table[slot])
+          slot = (slot + 1) & mask;
+        table[slot] = i + 1;
+      }
+    };
+
+    for (size_t secIdx = 0, e = sections.size(); secIdx != e; ++secIdx) {
+      MergeInputSection *sec = sections[secIdx];
       for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
-        if (!sec->pieces[i].live)
+        SectionPiece &piece = sec->pieces[i];
+        if (!piece.live)
+          continue;
+        size_t shardId = getShardId(piece.hash);
+        if ((shardId & (concurrency - 1)) != threadId)
           continue;
-        size_t shardId = getShardId(sec->pieces[i].hash);
-        if ((shardId & (concurrency - 1)) == threadId)
-          sec->pieces[i].outputOff = shards[shardId].add(sec->getData(i));
+
+        std::vector<std::pair<uint32_t, uint32_t>> &uniq = shards[shardId];
+        std::vector<uint32_t> &table = tables[shardId];
+        if ((uniq.size() + 1) * 4 > table.size() * 3)
+          grow(shardId);
+
+        StringRef data = sec->getData(i).val();
+        size_t mask = table.size() - 1;
+        for (size_t slot = piece.hash & mask;; slot = (slot + 1) & mask) {
+          if (table[slot] == 0) {
+            table[slot] = uniq.size() + 1;
+            uniq.push_back({secIdx, i});
+            piece.outputOff = alignTo(shardSizes[shardId], alignment);
+            shardSizes[shardId] = piece.outputOff + data.size();
+            break;
+          }
+          std::pair<uint32_t, uint32_t> p = uniq[table[slot] - 1];
+          MergeInputSection *other = sections[p.first];
+          if (other->pieces[p.second].hash == piece.hash &&
+              other->getData(p.second).val() == data) {
+            piece.outputOff = other->pieces[p.second].outputOff;
+            break;
+          }
+        }
       }
     }
+
+    for (size_t shardId = threadId; shardId < numShards;
+         shardId += concurrency)
+      tableBytes[shardId] = tables[shardId].size() * sizeof(uint32_t) +
+                            shards[shardId].capacity() *
+                                sizeof(std::pair<uint32_t, uint32_t>);
   });
 
   // Compute an in-section offset for each shard.
+  uint64_t shardOffsets[numShards];
   size_t off = 0;
   for (size_t i = 0; i < numShards; ++i) {
-    shards[i].finalizeInOrder();
-    if (shards[i].getSize() > 0)
+    if (shardSizes[i] > 0)
       off = alignTo(off, alignment);
     shardOffsets[i] = off;
-    off += shards[i].getSize();
+    off += shardSizes[i];
   }
   size = off;
 
@@ -3230,6 +3337,25 @@ void MergeNoTailSection::finalizeContents() {
         sec->pieces[i].outputOff +=
             shardOffsets[getShardId(sec->pieces[i].hash)];
   });
+
+  if (!errorHandler().verbose)
+    return;
+
+  // Report the memory used for deduplication. A StringTableBuilder, which
+  // was used before, keeps a DenseMap of 24-byte buckets.
+  size_t pieces = 0, uniq = 0, bytes = 0, builderBytes = 0;
+  for (size_t i = 0; i < numShards; ++i) {
+    pieces += numLive[i];
+    uniq += shards[i].size();
+    bytes += tableBytes[i];
+    if (!shards[i].empty())
+      builderBytes +=
+          NextPowerOf2(shards[i].size() * 4 / 3 + 1) *
+          sizeof(std::pair<CachedHashStringRef, size_t>);
+  }
+  log(name + ": merged " + Twine(pieces) + " pieces into " + Twine(uniq) +
+      " unique pieces using " + Twine(bytes / 1024) + " KiB (" +
+      Twine(builderBytes / 1024) + " KiB with StringTableBuilder)");
 }
 
 MergeSyntheticSection *createMergeSynthetic(StringRef name, uint32_t type,
@@ -923,10 +923,11 @@ private:
   // Section size
   size_t size;
 
-  // String table contents
+  // The unique pieces of each shard in output order. Each piece is
+  // identified by its section's index in `sections` and its own index in
+  // that section, and its output offset is kept in the SectionPiece.
   constexpr static size_t numShards = 32;
-  std::vector<llvm::StringTableBuilder> shards;
-  size_t shardOffsets[numShards];
+  std::vector<std::pair<uint32_t, uint32_t>> shards[numShards];
 };
 
 // .MIPS.abiflags section.
@@ -20,13 +20,19 @@
 #include "SyntheticSections.h"
 #include "Target.h"
 #include "lld/Common/Filesystem.h"
+#include "lld/Common/LinkTrace.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
 #include "lld/Common/Threads.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/Memory.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
 #include <climits>
@@ -42,6 +48,40 @@ using namespace llvm::support::endian;
 namespace lld {
 namespace elf {
 namespace {
+// With --stream-output-file, the output image is built in anonymous memory
+// and each output section is written to the file as soon as it has been
+// written to memory. A background thread does the writes, so I/O overlaps
+// with writing the following sections. If nothing needs to read the image
+// afterwards, the pages of written sections are unmapped, which keeps
+// memory usage close to the working set instead of the whole image.
+class StreamedOutputFile {
+public:
+  StreamedOutputFile() : pool(hardware_concurrency(1)) {}
+  ~StreamedOutputFile();
+
+  Error open(StringRef path, uint64_t size, bool executable);
+  uint8_t *getBufferStart() { return (uint8_t *)mem.base(); }
+
+  // Queues the bytes at [off, off + size) of the image to be written. If
+  // release is true, the pages within the range are unmapped afterwards.
+  void write(uint64_t off, uint64_t size, bool release);
+
+  // Writes all bytes that have not been written yet, such as the file
+  // headers and padding, and renames the file to its final name.
+  Error commit(StringRef path);
+
+private:
+  ThreadPool pool;
+  sys::MemoryBlock mem;
+  uint64_t fileSize = 0;
+  Optional<sys::fs::TempFile> temp;
+  std::unique_ptr<raw_fd_ostream> os;
+  std::vector<std::pair<uint64_t, uint64_t>> written;
+  // Cleared if unmapping part of the image fails. Only accessed by the
+  // background thread.
+  bool canRelease = true;
+};
+
 // The writer writes a SymbolTable result to a file.
 template <class ELFT> class Writer {
 public:
@@ -81,6 +121,7 @@ private:
   void writeBuildId();
 
   std::unique_ptr<FileOutputBuffer> &buffer;
+  std::unique_ptr<StreamedOutputFile> streamedFile;
 
   void addRelIpltSymbols();
   void addStartEndSymbols();
@@ -91,6 +132,82 @@ private:
 };
 } // anonymous namespace
 
+StreamedOutputFile::~StreamedOutputFile() {
+  pool.wait();
+  os.reset();
+  if (temp)
+    consumeError(temp->discard());
+  sys::Memory::releaseMappedMemory(mem);
+}
+
+Error StreamedOutputFile::open(StringRef path, uint64_t size,
+                               bool executable) {
+  unsigned mode = sys::fs::all_read | sys::fs::all_write;
+  if (executable)
+    mode |= sys::fs::all_exe;
+  Expected<sys::fs::TempFile> file =
+      sys::fs::TempFile::create(path + ".tmp%%%%%%%", mode);
+  if (!file)
+    return file.takeError();
+  temp = std::move(*file);
+  if (std::error_code ec = sys::fs::resize_file(temp->FD, size))
+    return errorCodeToError(ec);
+  os = std::make_unique<raw_fd_ostream>(temp->FD, /*shouldClose=*/false);
+
+  std::error_code ec;
+  mem = sys::Memory::allocateMappedMemory(
+      size, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, ec);
+  if (ec)
+    return errorCodeToError(ec);
+  fileSize = size;
+  return Error::success();
+}
+
+void StreamedOutputFile::write(uint64_t off, uint64_t size, bool release) {
+  if (size == 0)
+    return;
+  written.push_back({off, off + size});
+  pool.async([=] {
+    os->pwrite((const char *)getBufferStart() + off, size, off);
+    if (!release || !canRelease)
+      return;
+    uint64_t pageSize = sys::Process::getPageSizeEstimate();
+    uint64_t begin = alignTo((uint64_t)getBufferStart() + off, pageSize);
+    uint64_t end = alignDown((uint64_t)getBufferStart() + off + size, pageSize);
+    if (begin >= end)
+      return;
+    // Failing to unmap only costs memory, so keep the rest of the image
+    // mapped and carry on.
+    sys::MemoryBlock block((void *)begin, end - begin);
+    if (std::error_code ec = sys::Memory::releaseMappedMemory(block)) {
+      warn("--stream-output-file: cannot release written pages: " +
+           ec.message());
+      canRelease = false;
+    }
+  });
+}
+
+Error StreamedOutputFile::commit(StringRef path) {
+  llvm::sort(written);
+  uint64_t pos = 0;
+  for (std::pair<uint64_t, uint64_t> range : written) {
+    if (pos < range.first)
+      write(pos, range.first - pos, /*release=*/false);
+    pos = std::max(pos, range.second);
+  }
+  if (pos < fileSize)
+    write(pos, fileSize - pos, /*release=*/false);
+  pool.wait();
+
+  os->flush();
+  if (os->has_error())
+    return errorCodeToError(os->error());
+  os.reset();
+  Error e = temp->keep(path);
+  temp.reset();
+  return e;
+}
+
 static bool isSectionPrefix(StringRef prefix, StringRef name) {
   return name.startswith(prefix) || name == prefix.drop_back();
 }
@@ -148,7 +265,7 @@ static bool needsInterpSection() {
 }
 
 template <class ELFT> void writeResult() {
-  llvm::TimeTraceScope timeScope("Write output file");
+  PhaseTraceScope timeScope("Write output file");
   Writer<ELFT>().run();
 }
 
@@ -577,9 +694,10 @@ template <class ELFT> void Writer<ELFT>::run() {
 
   // If -compressed-debug-sections is specified, we need to compress
   // .debug_* sections. Do it right now because it changes the size of
-  // output sections.
-  for (OutputSection *sec : outputSections)
-    sec->maybeCompress<ELFT>();
+  // output sections. Sections are compressed independently of each other, so
+  // do them in parallel.
+  parallelForEach(outputSections,
+                  [](OutputSection *sec) { sec->maybeCompress<ELFT>(); });
 
   if (script->hasSectionsCommand)
     script->allocateHeaders(mainPart->phdrs);
@@ -634,6 +752,14 @@ template <class ELFT> void Writer<ELFT>::run() {
   if (errorCount())
     return;
 
+  if (streamedFile) {
+    // Sections containing build IDs are written here along with the file
+    // headers because they are not complete until now.
+    if (auto e = streamedFile->commit(config->outputFile))
+      error("failed to write to the output file: " + toString(std::move(e)));
+    return;
+  }
+
   if (auto e = buffer->commit())
     error("failed to write to the output file: " + toString(std::move(e)));
 }
@@ -1880,7 +2006,13 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
   // after processSymbolAssignments() because it needs to know whether a
   // linker-script-defined symbol is absolute.
   if (!config->relocatable) {
-    forEachRelSec(scanRelocations<ELFT>);
+    if (config->parallelRelocScan) {
+      std::vector<InputSectionBase *> sections;
+      forEachRelSec([&](InputSectionBase &s) { sections.push_back(&s); });
+      scanRelocationsParallel<ELFT>(sections);
+    } else {
+      forEachRelSec(scanRelocations<ELFT>);
+    }
     reportUndefinedSymbols<ELFT>();
   }
 
@@ -2752,6 +2884,19 @@ template <class ELFT> void Writer<ELFT>::openFile() {
     flags |= FileOutputBuffer::F_executable;
   if (!config->mmapOutputFile)
     flags |= FileOutputBuffer::F_no_mmap;
+
+  if (config->streamOutputFile && !config->oFormatBinary) {
+    streamedFile = std::make_unique<StreamedOutputFile>();
+    if (Error e = streamedFile->open(config->outputFile, fileSize,
+                                     !config->relocatable)) {
+      error("failed to open " + config->outputFile + ": " +
+            llvm::toString(std::move(e)));
+      return;
+    }
+    Out::bufferStart = streamedFile->getBufferStart();
+    return;
+  }
+
   Expected<std::unique_ptr<FileOutputBuffer>> bufferOrErr =
       FileOutputBuffer::create(config->outputFile, fileSize, flags);
 
@@ -2807,16 +2952,50 @@ template <class ELFT> void Writer<ELFT>::writeTrapInstr() {
 
 // Write section contents to a mmap'ed file.
 template <class ELFT> void Writer<ELFT>::writeSections() {
+  // With --stream-output-file, each section is queued for writing once it
+  // is complete. A section's pages can be dropped after that unless they are
+  // read again to compute a build ID or rewritten to store it.
+  bool canRelease = config->buildId == BuildIdKind::None ||
+                    config->buildId == BuildIdKind::Hexstring ||
+                    config->buildId == BuildIdKind::Uuid;
+
+  // Some sections are filled in by the writer of another section rather than
+  // by their own writeTo: .eh_frame_hdr is written by .eh_frame, which comes
+  // after it. Hold those back until all sections have been written.
+  SmallPtrSet<OutputSection *, 4> filledLater;
+  std::vector<OutputSection *> heldBack;
+  for (Partition &part : partitions)
+    if (part.ehFrameHdr && part.ehFrameHdr->getParent())
+      filledLater.insert(part.ehFrameHdr->getParent());
+
+  auto write = [&](OutputSection *sec) {
+    sec->writeTo<ELFT>(Out::bufferStart + sec->offset);
+    if (!streamedFile || sec->type == SHT_NOBITS)
+      return;
+    bool hasBuildId = llvm::any_of(partitions, [&](Partition &part) {
+      return part.buildId && part.buildId->getParent() == sec;
+    });
+    if (hasBuildId)
+      return;
+    if (filledLater.count(sec))
+      heldBack.push_back(sec);
+    else
+      streamedFile->write(sec->offset, sec->size, canRelease);
+  };
+
   // In -r or -emit-relocs mode, write the relocation sections first as in
   // ELf_Rel targets we might find out that we need to modify the relocated
   // section while doing it.
   for (OutputSection *sec : outputSections)
     if (sec->type == SHT_REL || sec->type == SHT_RELA)
-      sec->writeTo<ELFT>(Out::bufferStart + sec->offset);
+      write(sec);
 
   for (OutputSection *sec : outputSections)
     if (sec->type != SHT_REL && sec->type != SHT_RELA)
-      sec->writeTo<ELFT>(Out::bufferStart + sec->offset);
+      write(sec);
+
+  for (OutputSection *sec : heldBack)
+    streamedFile->write(sec->offset, sec->size, canRelease);
 }
 
 // Split one uint8 array into small pieces of uint8 arrays.
@@ -2883,6 +3062,11 @@ template <class ELFT> void Writer<ELFT>::writeBuildId() {
       memcpy(dest, SHA1::hash(arr).data(), hashSize);
     });
     break;
+  case BuildIdKind::Blake3:
+    // BLAKE3 is a tree hash itself, so it does not need computeHash() to
+    // hash the output on multiple threads.
+    memcpy(buildId.data(), BLAKE3::parallelHash(buf).data(), hashSize);
+    break;
   case BuildIdKind::Uuid:
     if (auto ec = llvm::getRandomBytes(buildId.data(), hashSize))
       error("entropy source failure: " + ec.message());
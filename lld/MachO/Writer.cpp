@@ -17,6 +17,7 @@
 
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
+#include "lld/Common/Threads.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MathExtras.h"
@@ -331,10 +332,15 @@ void Writer::writeHeader() {
 void Writer::writeSections() {
   uint8_t *buf = buffer->getBufferStart();
 
+  // Input sections don't overlap in the output, so each of them can be copied
+  // and relocated independently.
+  std::vector<InputSection *> sections;
   for (OutputSegment *seg : outputSegments)
     for (auto &sect : seg->sections)
-      for (InputSection *isec : sect.second)
-        isec->writeTo(buf + isec->addr - ImageBase);
+      sections.insert(sections.end(), sect.second.begin(), sect.second.end());
+  parallelForEach(sections, [&](InputSection *isec) {
+    isec->writeTo(buf + isec->addr - ImageBase);
+  });
 
   memcpy(buf + linkEditSeg->fileOff, linkEditSeg->contents.data(),
          linkEditSeg->contents.size());
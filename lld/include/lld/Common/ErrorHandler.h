@@ -117,6 +117,26 @@ private:
 /// Returns the default error handler.
 ErrorHandler &errorHandler();
 
+// Holds errors and warnings that were reported on some thread instead of being
+// printed, so that work split across threads can report its diagnostics in a
+// deterministic order. fatal() is never deferred.
+class DeferredDiagnostics {
+public:
+  // Runs fn, saving the errors and warnings it reports on this thread.
+  void capture(llvm::function_ref<void()> fn);
+
+  // Reports the saved diagnostics in the order they were saved.
+  void report();
+
+private:
+  friend class ErrorHandler;
+  struct Diagnostic {
+    bool isError;
+    std::string msg;
+  };
+  std::vector<Diagnostic> diags;
+};
+
 inline void error(const Twine &msg) { errorHandler().error(msg); }
 inline LLVM_ATTRIBUTE_NORETURN void fatal(const Twine &msg) {
   errorHandler().fatal(msg);
@@ -0,0 +1,62 @@
+//===- LinkTrace.h ----------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Helpers to add link statistics to the --time-trace output, so that traces
+// of many links can be aggregated to find regressions. With --time-trace,
+// the trace contains these counters in addition to the time sections:
+//
+//   "Peak RSS (KiB)"          recorded at the end of each link phase
+//   "Input bytes"             the total size of input files read so far
+//   "Thread utilization (%)"  recorded at the end of each parallel loop
+//
+// and its "otherData" dictionary lists the largest input files and output
+// sections.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_COMMON_LINKTRACE_H
+#define LLD_COMMON_LINKTRACE_H
+
+#include "lld/Common/LLVM.h"
+#include "llvm/Support/TimeProfiler.h"
+#include <vector>
+
+namespace lld {
+// Returns the peak resident set size of this process in bytes, or 0 if it is
+// not available on this platform.
+uint64_t getPeakRSS();
+
+// Records the peak resident set size if --time-trace is enabled.
+void traceMemoryUsage();
+
+// Records that an input file has been read if --time-trace is enabled.
+void traceInputFile(StringRef path, uint64_t size);
+
+// Adds the names and sizes of the n largest input files to the trace.
+void traceLargestInputFiles(size_t n);
+
+// Adds a list of (name, size) pairs to the trace as entries named
+// "<prefix> <rank>", largest first.
+void traceLargest(StringRef prefix,
+                  std::vector<std::pair<std::string, uint64_t>> entries,
+                  size_t n);
+
+// A time section for a link phase that also records the peak resident set
+// size when the phase ends.
+class PhaseTraceScope {
+public:
+  PhaseTraceScope(StringRef name) : scope(name) {}
+  PhaseTraceScope(StringRef name, StringRef detail) : scope(name, detail) {}
+  ~PhaseTraceScope() { traceMemoryUsage(); }
+
+private:
+  llvm::TimeTraceScope scope;
+};
+} // namespace lld
+
+#endif
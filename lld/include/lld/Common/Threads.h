@@ -59,23 +59,68 @@
 #define LLD_COMMON_THREADS_H
 
 #include "llvm/Support/Parallel.h"
+#include "llvm/Support/TimeProfiler.h"
+#include <atomic>
+#include <chrono>
 #include <functional>
 
 namespace lld {
 
+// With --time-trace, measures the fraction of time the worker threads spend
+// running tasks of a parallel loop, and records it as the counter
+// "Thread utilization (%)" when the loop ends.
+class ParallelUtilization {
+public:
+  ParallelUtilization() : start(clock::now()) {}
+
+  ~ParallelUtilization() {
+    int64_t wall = (clock::now() - start).count();
+    unsigned threads = llvm::parallel::strategy.compute_thread_count();
+    if (wall > 0 && threads > 0)
+      llvm::timeTraceProfilerCounter("Thread utilization (%)",
+                                     busy * 100 / (wall * threads));
+  }
+
+  template <class FuncTy> void run(FuncTy fn) {
+    clock::time_point t = clock::now();
+    fn();
+    busy += (clock::now() - t).count();
+  }
+
+private:
+  using clock = std::chrono::steady_clock;
+  clock::time_point start;
+  std::atomic<int64_t> busy{0};
+};
+
 template <typename R, class FuncTy> void parallelForEach(R &&range, FuncTy fn) {
-  if (llvm::parallel::strategy.ThreadsRequested != 1)
-    for_each(llvm::parallel::par, std::begin(range), std::end(range), fn);
-  else
+  if (llvm::parallel::strategy.ThreadsRequested == 1) {
     for_each(llvm::parallel::seq, std::begin(range), std::end(range), fn);
+  } else if (llvm::timeTraceProfilerEnabled()) {
+    ParallelUtilization u;
+    for_each(llvm::parallel::par, std::begin(range), std::end(range),
+             [&](auto &&x) { u.run([&] { fn(x); }); });
+  } else {
+    for_each(llvm::parallel::par, std::begin(range), std::end(range), fn);
+  }
 }
 
+// Calls fn for each index in [begin, end). If grainSize is given, each task
+// processes at least that many indices, which reduces the scheduling
+// overhead of loops whose bodies are cheap.
 inline void parallelForEachN(size_t begin, size_t end,
-                             llvm::function_ref<void(size_t)> fn) {
-  if (llvm::parallel::strategy.ThreadsRequested != 1)
-    for_each_n(llvm::parallel::par, begin, end, fn);
-  else
+                             llvm::function_ref<void(size_t)> fn,
+                             size_t grainSize = 0) {
+  if (llvm::parallel::strategy.ThreadsRequested == 1) {
     for_each_n(llvm::parallel::seq, begin, end, fn);
+  } else if (llvm::timeTraceProfilerEnabled()) {
+    ParallelUtilization u;
+    for_each_n(
+        llvm::parallel::par, begin, end,
+        [&](size_t i) { u.run([&] { fn(i); }); }, grainSize);
+  } else {
+    for_each_n(llvm::parallel::par, begin, end, fn, grainSize);
+  }
 }
 
 template <typename R, class FuncTy> void parallelSort(R &&range, FuncTy fn) {
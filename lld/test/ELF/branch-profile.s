@@ -0,0 +1,64 @@
+# REQUIRES: x86
+## --branch-profile feeds the same sorter as --call-graph-ordering-file.
+## Offsets are accepted and ignored, and branches within a section are
+## allowed.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+# RUN: echo "A+0x4 B 10" > %t.branches
+# RUN: echo "A+8 C 40" >> %t.branches
+# RUN: echo "B+0x1 C+0x0 30" >> %t.branches
+# RUN: echo "C D 90" >> %t.branches
+# RUN: echo "D+2 D 100" >> %t.branches
+# RUN: echo "A B 10" > %t.call_graph
+# RUN: echo "A C 40" >> %t.call_graph
+# RUN: echo "B C 30" >> %t.call_graph
+# RUN: echo "C D 90" >> %t.call_graph
+# RUN: echo "D D 100" >> %t.call_graph
+
+# RUN: ld.lld -e A %t.o --branch-profile=%t.branches -o %t
+# RUN: ld.lld -e A %t.o --call-graph-ordering-file=%t.call_graph -o %t.cg
+# RUN: cmp %t %t.cg
+# RUN: llvm-nm --numeric-sort %t | FileCheck %s
+
+# CHECK:      {{[Tt]}} A{{$}}
+# CHECK-NEXT: {{[Tt]}} C{{$}}
+# CHECK-NEXT: {{[Tt]}} D{{$}}
+# CHECK-NEXT: {{[Tt]}} B{{$}}
+
+# RUN: echo "A B" > %t.bad
+# RUN: not ld.lld -e A %t.o --branch-profile=%t.bad -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=PARSE %s
+# RUN: echo "A+x B 1" > %t.bad
+# RUN: not ld.lld -e A %t.o --branch-profile=%t.bad -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=PARSE %s
+# PARSE: error: {{.*}}: parse error
+
+# RUN: echo "A" > %t.order
+# RUN: not ld.lld -e A %t.o --branch-profile=%t.branches \
+# RUN:   --symbol-ordering-file=%t.order -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=ORDER %s
+# ORDER: error: --symbol-ordering-file and --branch-profile may not be used together
+
+    .section .text.D,"ax",@progbits
+D:
+    .fill 1000, 1, 0
+    retq
+
+    .section .text.C,"ax",@progbits
+    .globl C
+C:
+    .fill 1000, 1, 0
+    retq
+
+    .section .text.B,"ax",@progbits
+    .globl B
+B:
+    .fill 1000, 1, 0
+    retq
+
+    .section .text.A,"ax",@progbits
+    .globl A
+A:
+    .fill 1000, 1, 0
+    retq
@@ -0,0 +1,17 @@
+# REQUIRES: x86
+## --build-id=blake3 writes a 32-byte BLAKE3 hash of the output.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld --build-id=blake3 %t.o -o %t
+# RUN: llvm-readelf -n %t | FileCheck %s
+# RUN: ld.lld --build-id=blake3 --threads=1 %t.o -o %t.1
+# RUN: cmp %t %t.1
+
+# CHECK: Build ID: {{[0-9a-f]{64}$}}
+
+.globl _start
+_start:
+  nop
+
+.section .data
+  .fill 0x300000, 1, 0x5a
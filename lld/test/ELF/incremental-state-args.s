@@ -0,0 +1,29 @@
+# REQUIRES: x86
+## The command line recorded by --incremental-state is the one after response
+## file expansion, and it is tied to the working directory.
+
+# RUN: rm -rf %t && mkdir -p %t/a %t/b
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t/a.o
+# RUN: echo "%t/a.o -o %t/out" > %t/rsp
+
+# RUN: cd %t/a && ld.lld --incremental-state=%t/state @%t/rsp
+# RUN: cd %t/a && ld.lld --incremental-state=%t/state @%t/rsp --verbose 2>&1 | \
+# RUN:   FileCheck --check-prefix=SKIP %s
+# SKIP: incremental state: {{.*}}out is up to date
+
+## Editing the response file relinks.
+# RUN: echo "%t/a.o -o %t/out --no-rosegment" > %t/rsp
+# RUN: cd %t/a && ld.lld --incremental-state=%t/state @%t/rsp --verbose 2>&1 | \
+# RUN:   FileCheck --check-prefix=CHANGED %s
+# RUN: cd %t/a && ld.lld --incremental-state=%t/state @%t/rsp --verbose 2>&1 | \
+# RUN:   FileCheck --check-prefix=SKIP %s
+
+## The same command line from another directory relinks.
+# RUN: cd %t/b && ld.lld --incremental-state=%t/state @%t/rsp --verbose 2>&1 | \
+# RUN:   FileCheck --check-prefix=CHANGED %s
+# CHANGED: incremental state: command line changed
+# CHANGED-NOT: is up to date
+
+.globl _start
+_start:
+  ret
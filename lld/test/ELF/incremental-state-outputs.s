@@ -0,0 +1,49 @@
+# REQUIRES: x86
+## --incremental-state does not skip a link that has to write other outputs,
+## such as a map file, a --reproduce archive or a time trace.
+
+# RUN: rm -rf %t && mkdir %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o a.o
+
+# RUN: ld.lld --incremental-state=state -Map=out.map a.o -o out
+# RUN: rm out.map
+# RUN: ld.lld --incremental-state=state -Map=out.map a.o -o out --verbose \
+# RUN:   2>&1 | FileCheck --check-prefix=LINK %s
+# RUN: FileCheck --check-prefix=MAP %s < out.map
+# MAP: .text
+
+# RUN: ld.lld --incremental-state=state --print-map a.o -o out
+# RUN: ld.lld --incremental-state=state --print-map a.o -o out | \
+# RUN:   FileCheck --check-prefix=MAP %s
+
+# RUN: ld.lld --incremental-state=state --cref a.o -o out
+# RUN: ld.lld --incremental-state=state --cref a.o -o out | \
+# RUN:   FileCheck --check-prefix=CREF %s
+# CREF: Symbol File
+
+# RUN: ld.lld --incremental-state=state --reproduce=repro.tar a.o -o out
+# RUN: rm repro.tar
+# RUN: ld.lld --incremental-state=state --reproduce=repro.tar a.o -o out
+# RUN: tar tf repro.tar | FileCheck --check-prefix=TAR %s
+# TAR: response.txt
+
+# RUN: ld.lld --incremental-state=state --time-trace \
+# RUN:   --time-trace-file=out.json a.o -o out
+# RUN: rm out.json
+# RUN: ld.lld --incremental-state=state --time-trace \
+# RUN:   --time-trace-file=out.json a.o -o out
+# RUN: FileCheck --check-prefix=TIME %s < out.json
+# TIME: "traceEvents"
+
+## Without any of them, the repeated link is skipped.
+# RUN: ld.lld --incremental-state=state a.o -o out
+# RUN: ld.lld --incremental-state=state a.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck --check-prefix=SKIP %s
+
+# LINK: incremental state: other outputs requested, not skipping the link
+# LINK-NOT: is up to date
+# SKIP: incremental state: {{.*}}out is up to date
+
+.globl _start
+_start:
+  ret
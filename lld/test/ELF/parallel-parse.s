@@ -0,0 +1,66 @@
+# REQUIRES: x86
+## --parallel-parse reads symbol tables concurrently, but symbol resolution
+## and archive member selection happen in command-line order as before.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: echo '.globl foo, bar; foo: bar: ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64 - -o %t1.o
+# RUN: echo '.globl baz; baz: ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64 - -o %t2.o
+# RUN: echo '.globl baz, unused; baz: unused: nop; ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64 - -o %t3.o
+# RUN: rm -f %t.a && llvm-ar rc %t.a %t2.o %t3.o
+# RUN: echo 'v1 { global: ver; }; v2 { global: ver; };' > %t.ver
+
+# RUN: ld.lld --version-script=%t.ver %t.o %t1.o %t.a -o %t
+# RUN: ld.lld --parallel-parse --version-script=%t.ver %t.o %t1.o %t.a \
+# RUN:   -o %t.parallel
+# RUN: cmp %t %t.parallel
+# RUN: ld.lld --parallel-parse --version-script=%t.ver -shared %t.o %t1.o %t.a \
+# RUN:   -o %t.so
+# RUN: llvm-readelf --dyn-syms %t.so | FileCheck %s
+
+# CHECK-DAG: foo{{$}}
+# CHECK-DAG: bar{{$}}
+# CHECK-DAG: baz{{$}}
+# CHECK-DAG: ver@@v2
+# CHECK-DAG: ver@v1
+# CHECK-NOT: unused
+
+## Duplicate definitions are reported in the same order.
+# RUN: not ld.lld %t.o %t1.o %t1.o %t2.o %t2.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=DUP %s
+# RUN: not ld.lld --parallel-parse %t.o %t1.o %t1.o %t2.o %t2.o -o /dev/null \
+# RUN:   2>&1 | FileCheck --check-prefix=DUP %s
+
+# DUP-DAG: error: duplicate symbol: foo
+# DUP-DAG: error: duplicate symbol: bar
+# DUP:     error: duplicate symbol: baz
+
+## Objects of another ELF class are not pre-parsed as the output's class, and
+## are diagnosed as usual.
+# RUN: echo '.globl foo; foo: ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=i386 - -o %t32.o
+# RUN: not ld.lld --parallel-parse %t.o %t32.o %t1.o %t2.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=INCOMPAT %s
+# RUN: not ld.lld --parallel-parse %t32.o %t.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=INCOMPAT2 %s
+# RUN: not ld.lld --parallel-parse -m elf_i386 %t.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=INCOMPAT3 %s
+
+# INCOMPAT:  error: {{.*}}32.o is incompatible with {{.*}}.o
+# INCOMPAT2: error: {{.*}}.o is incompatible with {{.*}}32.o
+# INCOMPAT3: error: {{.*}}.o is incompatible with elf_i386
+
+.globl _start
+_start:
+  call foo
+  call bar
+  call baz
+
+.globl ver_v1, ver_v2
+.symver ver_v1, ver@v1
+.symver ver_v2, ver@@v2
+ver_v1:
+ver_v2:
+  ret
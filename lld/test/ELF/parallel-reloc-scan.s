@@ -0,0 +1,42 @@
+# REQUIRES: x86
+## --parallel-reloc-scan produces the same output as the serial scan.
+
+# RUN: echo '.globl foo, bar, zed; .type foo, @function; .type bar, @function; \
+# RUN:   foo: bar: ret; .data; zed: .quad 0' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64 - -o %t1.o
+# RUN: ld.lld -shared -soname=t1.so %t1.o -o %t1.so
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+# RUN: ld.lld %t.o %t1.so -o %t.serial
+# RUN: ld.lld --parallel-reloc-scan %t.o %t1.so -o %t.parallel
+# RUN: cmp %t.serial %t.parallel
+# RUN: ld.lld -pie %t.o %t1.so -o %t.serial.pie
+# RUN: ld.lld -pie --parallel-reloc-scan %t.o %t1.so -o %t.parallel.pie
+# RUN: cmp %t.serial.pie %t.parallel.pie
+
+# RUN: ld.lld --parallel-reloc-scan --no-parallel-reloc-scan %t.o %t1.so \
+# RUN:   -o %t.no
+# RUN: cmp %t.serial %t.no
+
+.globl _start
+_start:
+  call foo@PLT
+  call bar
+  movq zed@GOTPCREL(%rip), %rax
+  movl $local, %eax
+  leaq data(%rip), %rcx
+
+.section .text.a,"ax",@progbits
+  call foo@PLT
+  movq bar@GOTPCREL(%rip), %rax
+
+.section .text.b,"ax",@progbits
+  call zed@PLT
+  leaq local(%rip), %rdx
+
+.data
+data:
+  .quad foo
+  .quad zed
+local:
+  .quad data
@@ -0,0 +1,14 @@
+# REQUIRES: x86, system-windows
+## --stream-output-file needs to unmap parts of a mapping, which Windows cannot
+## do, so it is ignored there.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld --stream-output-file %t.o -o %t.streamed 2>&1 | FileCheck %s
+# RUN: ld.lld %t.o -o %t
+# RUN: cmp %t %t.streamed
+
+# CHECK: warning: --stream-output-file is not supported on Windows; ignoring
+
+.globl _start
+_start:
+  ret
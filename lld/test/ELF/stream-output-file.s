@@ -0,0 +1,53 @@
+# REQUIRES: x86
+# UNSUPPORTED: system-windows
+## --stream-output-file writes the same file as the default writer.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+# RUN: ld.lld %t.o -o %t
+# RUN: ld.lld --stream-output-file %t.o -o %t.streamed
+# RUN: cmp %t %t.streamed
+# RUN: ld.lld -shared %t.o -o %t.so
+# RUN: ld.lld -shared --stream-output-file %t.o -o %t.streamed.so
+# RUN: cmp %t.so %t.streamed.so
+
+## With a content hash build ID, the image stays mapped until the hash has been
+## written.
+# RUN: ld.lld --build-id=sha1 %t.o -o %t.sha1
+# RUN: ld.lld --build-id=sha1 --stream-output-file %t.o -o %t.streamed.sha1
+# RUN: cmp %t.sha1 %t.streamed.sha1
+
+## .eh_frame_hdr is filled in while writing .eh_frame, which follows it, so it
+## must not be written out before that.
+# RUN: ld.lld --eh-frame-hdr %t.o -o %t.hdr
+# RUN: ld.lld --eh-frame-hdr --stream-output-file %t.o -o %t.streamed.hdr
+# RUN: cmp %t.hdr %t.streamed.hdr
+# RUN: llvm-readelf -S %t.streamed.hdr | FileCheck %s --check-prefix=HDR
+# HDR: .eh_frame_hdr
+# HDR: .eh_frame
+
+## --oformat=binary ignores the option.
+# RUN: ld.lld --oformat=binary %t.o -o %t.bin
+# RUN: ld.lld --oformat=binary --stream-output-file %t.o -o %t.streamed.bin
+# RUN: cmp %t.bin %t.streamed.bin
+
+.globl _start
+_start:
+  .cfi_startproc
+  call foo
+  ret
+  .cfi_endproc
+
+.section .text.foo,"ax",@progbits
+foo:
+  .cfi_startproc
+  .fill 0x3000, 1, 0x90
+  ret
+  .cfi_endproc
+
+.data
+  .quad foo
+  .fill 0x2000, 1, 0xcc
+
+.bss
+  .zero 0x1000
@@ -109,9 +109,11 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
+  // Write code section bodies. Their offsets were assigned in
+  // finalizeContents, so they can be written and relocated in parallel.
+  parallelForEach(functions, [&](const InputChunk *chunk) {
     chunk->writeTo(buf);
+  });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -193,8 +195,9 @@ void DataSection::writeTo(uint8_t *buf) {
     memcpy(segStart, segment->header.data(), segment->header.size());
 
     // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
+    parallelForEach(segment->inputSegments, [&](const InputChunk *chunk) {
       chunk->writeTo(buf);
+    });
   }
 }
 
@@ -248,8 +251,9 @@ void CustomSection::writeTo(uint8_t *buf) {
   buf += nameData.size();
 
   // Write custom sections payload
-  for (const InputSection *section : inputSections)
+  parallelForEach(inputSections, [&](const InputSection *section) {
     section->writeTo(buf);
+  });
 }
 
 uint32_t CustomSection::getNumRelocations() const {
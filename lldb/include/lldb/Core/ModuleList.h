@@ -57,6 +57,8 @@ public:
 
   FileSpec GetClangModulesCachePath() const;
   bool SetClangModulesCachePath(llvm::StringRef path);
+  FileSpec GetDWARFIndexCachePath() const;
+  bool SetDWARFIndexCachePath(llvm::StringRef path);
   bool GetEnableExternalLookup() const;
   bool SetEnableExternalLookup(bool new_value);
 
@@ -14,6 +14,7 @@
 #include "lldb/Symbol/LineEntry.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/ArrayRef.h"
 #include <vector>
 
 namespace lldb_private {
@@ -336,6 +337,17 @@ protected:
 
   bool ConvertEntryAtIndexToLineEntry(uint32_t idx, LineEntry &line_entry);
 
+  /// Indexes of all non-terminal entries, sorted by file index, line and
+  /// then entry index. Built on the first file and line lookup, so that
+  /// setting breakpoints by file and line doesn't scan the whole table.
+  const std::vector<uint32_t> &GetFileLineIndex();
+
+  uint32_t FindLineEntryIndexByFileIndexImpl(
+      uint32_t start_idx, llvm::ArrayRef<uint32_t> file_indexes,
+      uint32_t line, bool exact, LineEntry *line_entry_ptr);
+
+  std::vector<uint32_t> m_file_line_index;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(LineTable);
 };
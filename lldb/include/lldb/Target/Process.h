@@ -1483,6 +1483,31 @@ public:
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  /// Find the first occurrence of a byte sequence in a memory range.
+  ///
+  /// The range is read in large chunks and each chunk is searched in the
+  /// debugger's memory, so this is much faster than reading the memory a
+  /// byte at a time.
+  ///
+  /// \param[in] low
+  ///     The virtual load address to start the search at.
+  ///
+  /// \param[in] high
+  ///     The virtual load address to end the search at (exclusive).
+  ///
+  /// \param[in] buf
+  ///     The bytes to search for.
+  ///
+  /// \param[in] size
+  ///     The number of bytes in \a buf.
+  ///
+  /// \return
+  ///     The address of the first match, or LLDB_INVALID_ADDRESS if there is
+  ///     none, or if memory that would have to be searched could not be
+  ///     read.
+  lldb::addr_t FindInMemory(lldb::addr_t low, lldb::addr_t high,
+                            const uint8_t *buf, size_t size);
+
   /// Read a NULL terminated string from memory
   ///
   /// This function will read a cache page at a time until a NULL string
@@ -12,6 +12,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -90,6 +91,8 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -139,6 +142,8 @@ public:
 
   bool GetEnableNotifyAboutFixIts() const;
 
+  uint64_t GetExpressionCacheSize() const;
+
   bool GetEnableSaveObjects() const;
 
   bool GetEnableSyntheticValue() const;
@@ -1054,6 +1059,27 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  // Removes a user expression for \a expr that was parsed with the same
+  // settings and can be executed in \a exe_ctx from the expression cache and
+  // returns it. Returns nullptr if there is none. Expressions are taken out of
+  // the cache while they run, so that nested evaluations never share one.
+  lldb::UserExpressionSP TakeCachedUserExpression(
+      llvm::StringRef expr, llvm::StringRef prefix, lldb::LanguageType language,
+      Expression::ResultType desired_type, ExecutionPolicy execution_policy,
+      bool generate_debug_info, ExecutionContext &exe_ctx);
+
+  // Puts a successfully parsed and executed user expression into the
+  // expression cache, evicting the least recently used one if the cache is
+  // full.
+  void CacheUserExpression(lldb::UserExpressionSP expr_sp,
+                           llvm::StringRef prefix,
+                           ExecutionPolicy execution_policy,
+                           bool generate_debug_info);
+
+  // Drops all cached user expressions. Called whenever the set of decls an
+  // expression could bind to changes.
+  void ClearUserExpressionCache();
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1315,6 +1341,16 @@ protected:
   PathMappingList m_image_search_paths;
   TypeSystemMap m_scratch_type_system_map;
 
+  struct CachedUserExpression {
+    std::string prefix;
+    ExecutionPolicy execution_policy;
+    bool generate_debug_info;
+    lldb::UserExpressionSP expr_sp;
+  };
+  /// Parsed user expressions, from least to most recently used.
+  std::vector<CachedUserExpression> m_user_expression_cache;
+  std::mutex m_user_expression_cache_mutex;
+
   typedef std::map<lldb::LanguageType, lldb::REPLSP> REPLMap;
   REPLMap m_repl_map;
 
@@ -219,22 +219,42 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
-  }
-
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
-
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
 
+  // Reuse the parsed code if the same expression was already evaluated in
+  // this context. Expressions that can declare persistent variables or
+  // top-level code change what later expressions see when they are parsed,
+  // and expressions evaluated against a context object depend on the type of
+  // that object, so none of them are cached.
+  const bool cacheable = !ctx_obj &&
+                         execution_policy != eExecutionPolicyTopLevel &&
+                         !expr.contains('$');
+  lldb::UserExpressionSP user_expression_sp;
+  if (cacheable)
+    user_expression_sp = target->TakeCachedUserExpression(
+        expr, full_prefix, language, desired_type, execution_policy,
+        generate_debug_info, exe_ctx);
+  const bool from_cache = bool(user_expression_sp);
+
+  if (!from_cache) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail()) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+  }
+
+  if (from_cache)
+    LLDB_LOG(log,
+             "== [UserExpression::Evaluate] Reusing parsed expression {0} ==",
+             expr.str());
+  else
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
+             expr.str());
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
     error.SetErrorString("expression interrupted by callback before parse");
     result_valobj_sp = ValueObjectConstResult::Create(
@@ -245,6 +265,7 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      from_cache ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -325,6 +346,9 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
         error.SetExpressionError(lldb::eExpressionSetupError,
                                  "expression needed to run but couldn't");
     } else if (execution_policy == eExecutionPolicyTopLevel) {
+      // The new top-level decls may change how cached expressions would
+      // have been parsed.
+      target->ClearUserExpressionCache();
       error.SetError(UserExpression::kNoResult, lldb::eErrorTypeGeneric);
       return lldb::eExpressionCompleted;
     } else {
@@ -356,6 +380,11 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
           error.SetExpressionError(execution_results,
                                    diagnostic_manager.GetString().c_str());
       } else {
+        // Only cache the expression as typed, not one with fix-its applied.
+        if (cacheable && expr == user_expression_sp->GetUserText())
+          target->CacheUserExpression(user_expression_sp, full_prefix,
+                                      execution_policy, generate_debug_info);
+
         if (expr_result) {
           result_valobj_sp = expr_result->GetValueObject();
 
@@ -14,6 +14,7 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/MemoryRegionInfo.h"
@@ -23,6 +24,8 @@
 #include "lldb/Target/ThreadPlanRunToAddress.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/ProcessInfo.h"
+#include "lldb/Utility/Timer.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 
@@ -421,7 +424,12 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   if (m_rendezvous.ModulesDidLoad()) {
     ModuleList new_modules;
 
+    std::vector<FileSpec> module_names;
     E = m_rendezvous.loaded_end();
+    for (I = m_rendezvous.loaded_begin(); I != E; ++I)
+      module_names.push_back(I->file_spec);
+    PreloadModules(module_names);
+
     for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
       ModuleSP module_sp =
           LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -502,6 +510,45 @@ DynamicLoaderPOSIXDYLD::GetStepThroughTrampolinePlan(Thread &thread,
   return thread_plan_sp;
 }
 
+void DynamicLoaderPOSIXDYLD::PreloadModules(
+    const std::vector<FileSpec> &files) {
+  Target &target = m_process->GetTarget();
+  // Remote platforms may have to resolve or download the files first, which
+  // is left to Target::GetOrCreateModule.
+  if (files.size() < 2 || !target.GetParallelModuleLoad() ||
+      !target.GetPlatform() || !target.GetPlatform()->IsHost())
+    return;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "DynamicLoaderPOSIXDYLD::PreloadModules (%zu)",
+                     files.size());
+
+  const ArchSpec arch = target.GetArchitecture();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  ModuleList &images = target.GetImages();
+  auto preload_fn = [&](const FileSpec &file) {
+    ModuleSpec module_spec(file, arch);
+    if (!FileSystem::Instance().Exists(file) ||
+        images.FindFirstModule(module_spec))
+      return;
+    static Timer::Category preload_cat("DynamicLoaderPOSIXDYLD::PreloadModule");
+    Timer preload_timer(preload_cat, "%s", file.GetPath().c_str());
+    ModuleSP module_sp;
+    ModuleList::GetSharedModule(module_spec, module_sp, nullptr, nullptr,
+                                nullptr);
+    if (module_sp && preload_symbols)
+      module_sp->PreloadSymbols();
+  };
+
+  // Indexing DWARF while preloading symbols runs on the TaskPool and waits
+  // for its tasks, so run these on a pool of their own rather than on the
+  // TaskPool, where they could take all the workers that indexing needs.
+  llvm::ThreadPool pool;
+  for (const FileSpec &file : files)
+    pool.async(preload_fn, file);
+  pool.wait();
+}
+
 void DynamicLoaderPOSIXDYLD::LoadVDSO() {
   if (m_vdso_base == LLDB_INVALID_ADDRESS)
     return;
@@ -575,6 +622,7 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
     module_names.push_back(I->file_spec);
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
+  PreloadModules(module_names);
 
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
@@ -99,6 +99,12 @@ protected:
   /// of loaded modules.
   void RefreshModules();
 
+  /// Creates the modules for \p files that exist on the host, and preloads
+  /// their symbols, on several threads at once. The modules end up in the
+  /// shared module list, where the serial LoadModuleAtAddress calls that
+  /// follow find them.
+  void PreloadModules(const std::vector<lldb_private::FileSpec> &files);
+
   /// Updates the load address of every allocatable section in \p module.
   ///
   /// \param module The module to traverse.
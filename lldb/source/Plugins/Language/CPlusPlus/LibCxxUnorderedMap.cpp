@@ -47,7 +47,16 @@ private:
   ValueObject *m_tree;
   size_t m_num_elements;
   ValueObject *m_next_element;
-  std::vector<std::pair<ValueObject *, uint64_t>> m_elements_cache;
+  /// Once the first node has been looked at, the type of the values and
+  /// where the value and the next pointer are within a node. The remaining
+  /// nodes are walked by reading their next pointers from memory, instead of
+  /// building ValueObjects for every node.
+  CompilerType m_value_type;
+  lldb::addr_t m_value_offset = 0;
+  lldb::addr_t m_next_offset = 0;
+  lldb::addr_t m_next_node = 0;
+  /// The addresses of the values found so far.
+  std::vector<lldb::addr_t> m_elements_cache;
 };
 } // namespace formatters
 } // namespace lldb_private
@@ -75,6 +84,21 @@ lldb::ValueObjectSP lldb_private::formatters::
     return lldb::ValueObjectSP();
 
   while (idx >= m_elements_cache.size()) {
+    if (m_value_type) {
+      if (m_next_node == 0)
+        return lldb::ValueObjectSP();
+      ProcessSP process_sp = m_backend.GetProcessSP();
+      if (!process_sp)
+        return lldb::ValueObjectSP();
+      m_elements_cache.push_back(m_next_node + m_value_offset);
+      Status error;
+      m_next_node =
+          process_sp->ReadPointerFromMemory(m_next_node + m_next_offset, error);
+      if (error.Fail())
+        m_next_node = 0;
+      continue;
+    }
+
     if (m_next_element == nullptr)
       return lldb::ValueObjectSP();
 
@@ -133,35 +157,45 @@ lldb::ValueObjectSP lldb_private::formatters::
       if (!value_sp || !hash_sp)
         return nullptr;
     }
-    m_elements_cache.push_back(
-        {value_sp.get(), hash_sp->GetValueAsUnsigned(0)});
-    m_next_element =
-        node_sp->GetChildMemberWithName(ConstString("__next_"), true).get();
-    if (!m_next_element || m_next_element->GetValueAsUnsigned(0) == 0)
-      m_next_element = nullptr;
+    ValueObjectSP next_sp =
+        node_sp->GetChildMemberWithName(ConstString("__next_"), true);
+    if (!next_sp)
+      return nullptr;
+
+    AddressType node_addr_type, value_addr_type, next_addr_type;
+    const lldb::addr_t node_addr = node_sp->GetAddressOf(true, &node_addr_type);
+    const lldb::addr_t value_addr =
+        value_sp->GetAddressOf(true, &value_addr_type);
+    const lldb::addr_t next_addr = next_sp->GetAddressOf(true, &next_addr_type);
+    if (node_addr_type != eAddressTypeLoad ||
+        value_addr_type != eAddressTypeLoad ||
+        next_addr_type != eAddressTypeLoad ||
+        node_addr == LLDB_INVALID_ADDRESS ||
+        value_addr == LLDB_INVALID_ADDRESS || next_addr == LLDB_INVALID_ADDRESS)
+      return nullptr;
+
+    m_value_type = value_sp->GetCompilerType();
+    m_value_offset = value_addr - node_addr;
+    m_next_offset = next_addr - node_addr;
+    m_elements_cache.push_back(value_addr);
+    m_next_node = next_sp->GetValueAsUnsigned(0);
   }
 
-  std::pair<ValueObject *, uint64_t> val_hash = m_elements_cache[idx];
-  if (!val_hash.first)
-    return lldb::ValueObjectSP();
   StreamString stream;
   stream.Printf("[%" PRIu64 "]", (uint64_t)idx);
-  DataExtractor data;
-  Status error;
-  val_hash.first->GetData(data, error);
-  if (error.Fail())
-    return lldb::ValueObjectSP();
   const bool thread_and_frame_only_if_stopped = true;
-  ExecutionContext exe_ctx = val_hash.first->GetExecutionContextRef().Lock(
-      thread_and_frame_only_if_stopped);
-  return CreateValueObjectFromData(stream.GetString(), data, exe_ctx,
-                                   val_hash.first->GetCompilerType());
+  ExecutionContext exe_ctx =
+      m_backend.GetExecutionContextRef().Lock(thread_and_frame_only_if_stopped);
+  return CreateValueObjectFromAddress(stream.GetString(), m_elements_cache[idx],
+                                      exe_ctx, m_value_type);
 }
 
 bool lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::
     Update() {
   m_num_elements = UINT32_MAX;
   m_next_element = nullptr;
+  m_value_type.Clear();
+  m_next_node = 0;
   m_elements_cache.clear();
   ValueObjectSP table_sp =
       m_backend.GetChildMemberWithName(ConstString("__table_"), true);
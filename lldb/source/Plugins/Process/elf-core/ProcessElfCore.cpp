@@ -287,7 +287,7 @@ size_t ProcessElfCore::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                                   Status &error) {
   // Don't allow the caching that lldb_private::Process::ReadMemory does since
   // in core files we have it all cached our our core file anyway.
-  return DoReadMemory(addr, buf, size, error);
+  return ReadMemoryFromInferior(addr, buf, size, error);
 }
 
 Status ProcessElfCore::GetMemoryRegionInfo(lldb::addr_t load_addr,
@@ -350,7 +350,10 @@ size_t ProcessElfCore::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
   const lldb::addr_t offset = addr - address_range->GetRangeBase();
   const lldb::addr_t file_start = address_range->data.GetRangeBase();
   const lldb::addr_t file_end = address_range->data.GetRangeEnd();
-  size_t bytes_to_read = size; // Number of bytes to read from the core file
+  // Number of bytes to read from the core file. Reads that go past the end of
+  // this segment return early, so that the rest is read from the next one.
+  size_t bytes_to_read =
+      std::min<lldb::addr_t>(size, address_range->GetRangeEnd() - addr);
   size_t bytes_copied = 0;   // Number of bytes actually read from the core file
   size_t zero_fill_size = 0; // Padding
   lldb::addr_t bytes_left =
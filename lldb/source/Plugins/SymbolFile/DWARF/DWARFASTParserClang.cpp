@@ -2578,8 +2578,11 @@ void DWARFASTParserClang::ParseSingleMember(
       if (var_type) {
         if (accessibility == eAccessNone)
           accessibility = eAccessPublic;
+        // A static data member does not contribute to the layout of the
+        // class, and C++ allows it to be declared with an incomplete type, so
+        // leave its type to be completed on demand.
         TypeSystemClang::AddVariableToRecordType(
-            class_clang_type, name, var_type->GetLayoutCompilerType(),
+            class_clang_type, name, var_type->GetForwardCompilerType(),
             accessibility);
       }
       return;
@@ -13,10 +13,18 @@
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 
 using namespace lldb_private;
 using namespace lldb;
@@ -57,6 +65,10 @@ void ManualDWARFIndex::Index() {
   if (units_to_index.empty())
     return;
 
+  std::string cache_path = GetCacheFilePath(main_dwarf);
+  if (!cache_path.empty() && LoadFromCache(cache_path))
+    return;
+
   std::vector<IndexSet> sets(units_to_index.size());
 
   // Keep memory down by clearing DIEs for any units if indexing
@@ -101,6 +113,124 @@ void ManualDWARFIndex::Index() {
                      [&]() { finalize_fn(&IndexSet::globals); },
                      [&]() { finalize_fn(&IndexSet::types); },
                      [&]() { finalize_fn(&IndexSet::namespaces); });
+
+  // DIEs in dwo files are indexed too, but the cache key only covers the main
+  // file, so an index that depends on split DWARF units is not cached.
+  if (cache_path.empty() || dwp_dwarf)
+    return;
+  for (DWARFUnit *unit : units_to_index)
+    if (unit->GetDwoSymbolFile())
+      return;
+  SaveToCache(cache_path);
+}
+
+// Every index cache entry starts with this magic, followed by a version and
+// the encoded indexes.
+static constexpr llvm::StringLiteral g_cache_magic("LLDBDWIX");
+static constexpr uint32_t g_cache_version = 1;
+
+std::string ManualDWARFIndex::GetCacheFilePath(SymbolFileDWARF &dwarf) {
+  FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetDWARFIndexCachePath();
+  ObjectFile *objfile = dwarf.GetObjectFile();
+  if (!cache_dir || !objfile)
+    return "";
+  const FileSpec &file = objfile->GetFileSpec();
+  llvm::sys::TimePoint<> mod_time =
+      FileSystem::Instance().GetModificationTime(file);
+  if (mod_time == llvm::sys::TimePoint<>())
+    return "";
+
+  // Key the entry on everything that determines the contents of the index, so
+  // that a rebuilt file never picks up a stale entry.
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  os << file.GetPath() << '\0' << objfile->GetFileOffset() << '\0'
+     << objfile->GetUUID().GetAsString() << '\0'
+     << mod_time.time_since_epoch().count();
+  std::vector<dw_offset_t> units_to_avoid(m_units_to_avoid.begin(),
+                                          m_units_to_avoid.end());
+  llvm::sort(units_to_avoid);
+  for (dw_offset_t offset : units_to_avoid)
+    os << '\0' << offset;
+
+  llvm::MD5 hash;
+  hash.update(os.str());
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+
+  llvm::SmallString<128> path(cache_dir.GetPath());
+  llvm::sys::path::append(path, file.GetFilename().GetStringRef() + "-" +
+                                    result.digest() + ".dwarfindex");
+  return std::string(path.str());
+}
+
+bool ManualDWARFIndex::LoadFromCache(llvm::StringRef path) {
+  auto buffer_or_err = llvm::MemoryBuffer::getFile(
+      path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (!buffer_or_err)
+    return false;
+  llvm::StringRef contents = (*buffer_or_err)->getBuffer();
+  if (!contents.startswith(g_cache_magic))
+    return false;
+
+  DataExtractor data(contents.data(), contents.size(), eByteOrderLittle,
+                     sizeof(void *));
+  lldb::offset_t offset = g_cache_magic.size();
+  if (!data.ValidOffsetForDataOfSize(offset, 4) ||
+      data.GetU32(&offset) != g_cache_version)
+    return false;
+
+  std::array<NameToDIE *, 8> indexes = m_set.GetIndexes();
+  for (NameToDIE *index : indexes) {
+    if (!index->Decode(data, &offset)) {
+      Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
+      LLDB_LOG(log, "Ignoring corrupt DWARF index cache entry {0}", path);
+      m_set = IndexSet();
+      return false;
+    }
+  }
+
+  // The entries have to be sorted again, as NameToDIE orders them by the
+  // address of their ConstString.
+  TaskMapOverInt(0, indexes.size(),
+                 [&indexes](size_t i) { indexes[i]->Finalize(); });
+  return true;
+}
+
+void ManualDWARFIndex::SaveToCache(llvm::StringRef path) {
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
+  llvm::StringRef cache_dir = llvm::sys::path::parent_path(path);
+  if (std::error_code ec = llvm::sys::fs::create_directories(cache_dir)) {
+    LLDB_LOG(log, "Cannot create DWARF index cache directory for {0}: {1}",
+             path, ec.message());
+    return;
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // debug sessions never read a partial entry.
+  llvm::Expected<llvm::sys::fs::TempFile> temp =
+      llvm::sys::fs::TempFile::create(path + "-%%%%%%.tmp");
+  if (!temp) {
+    LLDB_LOG_ERROR(log, temp.takeError(),
+                   "Cannot create DWARF index cache entry: {0}");
+    return;
+  }
+
+  {
+    llvm::raw_fd_ostream os(temp->FD, /*shouldClose=*/false);
+    os << g_cache_magic;
+    llvm::support::endian::write<uint32_t>(os, g_cache_version,
+                                           llvm::support::little);
+    for (NameToDIE *index : m_set.GetIndexes())
+      index->Encode(os);
+  }
+
+  if (llvm::Error error = temp->keep(path)) {
+    LLDB_LOG_ERROR(log, std::move(error),
+                   "Cannot commit DWARF index cache entry: {0}");
+    llvm::consumeError(temp->discard());
+  }
 }
 
 void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp,
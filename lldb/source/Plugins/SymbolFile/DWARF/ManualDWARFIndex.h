@@ -12,6 +12,7 @@
 #include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
 #include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "llvm/ADT/DenseSet.h"
+#include <array>
 
 class DWARFDebugInfo;
 class SymbolFileDWARFDwo;
@@ -55,6 +56,14 @@ private:
     NameToDIE globals;
     NameToDIE types;
     NameToDIE namespaces;
+
+    /// All the indexes, in the order in which they are stored in the index
+    /// cache.
+    std::array<NameToDIE *, 8> GetIndexes() {
+      return {{&function_basenames, &function_fullnames, &function_methods,
+               &function_selectors, &objc_class_selectors, &globals, &types,
+               &namespaces}};
+    }
   };
   void Index();
   void IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp, IndexSet &set);
@@ -63,6 +72,16 @@ private:
                             const lldb::LanguageType cu_language,
                             IndexSet &set);
 
+  /// Returns the path of the index cache entry for \p dwarf, or an empty
+  /// string if the cache is disabled or the file cannot be identified.
+  std::string GetCacheFilePath(SymbolFileDWARF &dwarf);
+  /// Fill m_set from the index cache entry at \p path. Returns false, leaving
+  /// m_set empty, if the entry does not exist or cannot be read.
+  bool LoadFromCache(llvm::StringRef path);
+  /// Write m_set to the index cache entry at \p path. Failures are logged and
+  /// otherwise ignored.
+  void SaveToCache(llvm::StringRef path);
+
   /// The DWARF file which we are indexing. Set to nullptr after the index is
   /// built.
   SymbolFileDWARF *m_dwarf;
@@ -10,9 +10,11 @@
 #include "DWARFUnit.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StreamString.h"
+#include "llvm/Support/EndianStream.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -76,3 +78,46 @@ void NameToDIE::Append(const NameToDIE &other) {
                  other.m_map.GetValueAtIndexUnchecked(i));
   }
 }
+
+// Each entry is encoded as the NUL terminated name followed by the dwo number
+// (UINT32_MAX for the main file), the section and the DIE offset, all little
+// endian.
+void NameToDIE::Encode(llvm::raw_ostream &os) const {
+  llvm::support::endian::Writer writer(os, llvm::support::little);
+  const uint32_t size = m_map.GetSize();
+  writer.write<uint32_t>(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    os << m_map.GetCStringAtIndexUnchecked(i).GetStringRef() << '\0';
+    const DIERef &die_ref = m_map.GetValueAtIndexUnchecked(i);
+    writer.write<uint32_t>(die_ref.dwo_num().getValueOr(UINT32_MAX));
+    writer.write<uint8_t>(die_ref.section());
+    writer.write<uint32_t>(die_ref.die_offset());
+  }
+}
+
+bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr) {
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+    return false;
+  const uint32_t size = data.GetU32(offset_ptr);
+  // Every entry takes at least ten bytes, which bounds the reservation when the
+  // data is corrupt.
+  m_map.Reserve(m_map.GetSize() +
+                std::min<size_t>(size, data.BytesLeft(*offset_ptr) / 10));
+  for (uint32_t i = 0; i < size; ++i) {
+    const char *name = data.GetCStr(offset_ptr);
+    if (!name || !data.ValidOffsetForDataOfSize(*offset_ptr, 9))
+      return false;
+    const uint32_t dwo_num = data.GetU32(offset_ptr);
+    const uint8_t section = data.GetU8(offset_ptr);
+    const dw_offset_t die_offset = data.GetU32(offset_ptr);
+    if (section > DIERef::DebugTypes)
+      return false;
+    llvm::Optional<uint32_t> dwo;
+    if (dwo_num != UINT32_MAX)
+      dwo = dwo_num;
+    m_map.Append(ConstString(name),
+                 DIERef(dwo, static_cast<DIERef::Section>(section),
+                        die_offset));
+  }
+  return true;
+}
@@ -15,9 +15,14 @@
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/Support/raw_ostream.h"
 
 class DWARFUnit;
 
+namespace lldb_private {
+class DataExtractor;
+}
+
 class NameToDIE {
 public:
   NameToDIE() : m_map() {}
@@ -46,6 +51,16 @@ public:
                              const DIERef &die_ref)> const
               &callback) const;
 
+  /// Write all entries to \p os. Names are written as strings, since the
+  /// ConstString pool is only valid for the current process.
+  void Encode(llvm::raw_ostream &os) const;
+
+  /// Append the entries written by Encode, read from \p data starting at
+  /// \p *offset_ptr. The map must be finalized afterwards. Returns false if
+  /// the data is truncated.
+  bool Decode(const lldb_private::DataExtractor &data,
+              lldb::offset_t *offset_ptr);
+
 protected:
   lldb_private::UniqueCStringMap<DIERef> m_map;
 };
@@ -13,6 +13,7 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Utility/Stream.h"
 #include <algorithm>
+#include <tuple>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -54,6 +55,7 @@ void LineTable::InsertLineEntry(lldb::addr_t file_addr, uint32_t line,
   //  s << "\n\nBefore:\n";
   //  Dump (&s, Address::DumpStyleFileAddress);
   m_entries.insert(pos, entry);
+  m_file_line_index.clear();
   //  s << "After:\n";
   //  Dump (&s, Address::DumpStyleFileAddress);
 }
@@ -107,6 +109,7 @@ void LineTable::InsertSequence(LineSequence *sequence) {
   LineSequenceImpl *seq = reinterpret_cast<LineSequenceImpl *>(sequence);
   if (seq->m_entries.empty())
     return;
+  m_file_line_index.clear();
   Entry &entry = seq->m_entries.front();
 
   // If the first entry address in this sequence is greater than or equal to
@@ -302,92 +305,90 @@ bool LineTable::ConvertEntryAtIndexToLineEntry(uint32_t idx,
   return true;
 }
 
-uint32_t LineTable::FindLineEntryIndexByFileIndex(
-    uint32_t start_idx, const std::vector<uint32_t> &file_indexes,
-    uint32_t line, bool exact, LineEntry *line_entry_ptr) {
+const std::vector<uint32_t> &LineTable::GetFileLineIndex() {
+  if (!m_file_line_index.empty())
+    return m_file_line_index;
 
-  const size_t count = m_entries.size();
-  size_t best_match = UINT32_MAX;
-
-  for (size_t idx = start_idx; idx < count; ++idx) {
+  m_file_line_index.reserve(m_entries.size());
+  for (uint32_t idx = 0, count = m_entries.size(); idx < count; ++idx) {
     // Skip line table rows that terminate the previous row (is_terminal_entry
     // is non-zero)
-    if (m_entries[idx].is_terminal_entry)
-      continue;
-
-    if (llvm::find(file_indexes, m_entries[idx].file_idx) == file_indexes.end())
-      continue;
-
-    // Exact match always wins.  Otherwise try to find the closest line > the
-    // desired line.
-    // FIXME: Maybe want to find the line closest before and the line closest
-    // after and
-    // if they're not in the same function, don't return a match.
-
-    if (m_entries[idx].line < line) {
-      continue;
-    } else if (m_entries[idx].line == line) {
-      if (line_entry_ptr)
-        ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
-      return idx;
-    } else if (!exact) {
-      if (best_match == UINT32_MAX)
-        best_match = idx;
-      else if (m_entries[idx].line < m_entries[best_match].line)
-        best_match = idx;
-    }
+    if (!m_entries[idx].is_terminal_entry)
+      m_file_line_index.push_back(idx);
   }
+  llvm::sort(m_file_line_index, [this](uint32_t lhs, uint32_t rhs) {
+    const Entry &a = m_entries[lhs];
+    const Entry &b = m_entries[rhs];
+    return std::make_tuple(uint32_t(a.file_idx), uint32_t(a.line), lhs) <
+           std::make_tuple(uint32_t(b.file_idx), uint32_t(b.line), rhs);
+  });
+  return m_file_line_index;
+}
 
-  if (best_match != UINT32_MAX) {
-    if (line_entry_ptr)
-      ConvertEntryAtIndexToLineEntry(best_match, *line_entry_ptr);
-    return best_match;
+uint32_t LineTable::FindLineEntryIndexByFileIndexImpl(
+    uint32_t start_idx, llvm::ArrayRef<uint32_t> file_indexes, uint32_t line,
+    bool exact, LineEntry *line_entry_ptr) {
+  typedef std::tuple<uint32_t, uint32_t, uint32_t> Key;
+  auto less_than_key = [this](uint32_t idx, const Key &key) {
+    const Entry &entry = m_entries[idx];
+    return Key(entry.file_idx, uint32_t(entry.line), idx) < key;
+  };
+
+  const std::vector<uint32_t> &index = GetFileLineIndex();
+  uint32_t exact_match = UINT32_MAX;
+  uint32_t best_match = UINT32_MAX;
+
+  for (uint32_t file_idx : file_indexes) {
+    auto pos = std::lower_bound(index.begin(), index.end(),
+                                Key(file_idx, line, start_idx), less_than_key);
+    while (pos != index.end() && m_entries[*pos].file_idx == file_idx) {
+      const uint32_t idx = *pos;
+      const Entry &entry = m_entries[idx];
+      if (idx < start_idx) {
+        // Every entry for this line comes before start_idx, skip ahead to
+        // the first one that doesn't.
+        pos = std::lower_bound(pos, index.end(),
+                               Key(file_idx, uint32_t(entry.line), start_idx),
+                               less_than_key);
+        continue;
+      }
+
+      // Exact match always wins.  Otherwise try to find the closest line > the
+      // desired line.
+      // FIXME: Maybe want to find the line closest before and the line closest
+      // after and
+      // if they're not in the same function, don't return a match.
+      if (entry.line == line) {
+        exact_match = std::min(exact_match, idx);
+      } else if (!exact) {
+        if (best_match == UINT32_MAX ||
+            entry.line < m_entries[best_match].line ||
+            (entry.line == m_entries[best_match].line && idx < best_match))
+          best_match = idx;
+      }
+      break;
+    }
   }
-  return UINT32_MAX;
+
+  const uint32_t match = exact_match != UINT32_MAX ? exact_match : best_match;
+  if (match != UINT32_MAX && line_entry_ptr)
+    ConvertEntryAtIndexToLineEntry(match, *line_entry_ptr);
+  return match;
+}
+
+uint32_t LineTable::FindLineEntryIndexByFileIndex(
+    uint32_t start_idx, const std::vector<uint32_t> &file_indexes,
+    uint32_t line, bool exact, LineEntry *line_entry_ptr) {
+  return FindLineEntryIndexByFileIndexImpl(start_idx, file_indexes, line, exact,
+                                           line_entry_ptr);
 }
 
 uint32_t LineTable::FindLineEntryIndexByFileIndex(uint32_t start_idx,
                                                   uint32_t file_idx,
                                                   uint32_t line, bool exact,
                                                   LineEntry *line_entry_ptr) {
-  const size_t count = m_entries.size();
-  size_t best_match = UINT32_MAX;
-
-  for (size_t idx = start_idx; idx < count; ++idx) {
-    // Skip line table rows that terminate the previous row (is_terminal_entry
-    // is non-zero)
-    if (m_entries[idx].is_terminal_entry)
-      continue;
-
-    if (m_entries[idx].file_idx != file_idx)
-      continue;
-
-    // Exact match always wins.  Otherwise try to find the closest line > the
-    // desired line.
-    // FIXME: Maybe want to find the line closest before and the line closest
-    // after and
-    // if they're not in the same function, don't return a match.
-
-    if (m_entries[idx].line < line) {
-      continue;
-    } else if (m_entries[idx].line == line) {
-      if (line_entry_ptr)
-        ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
-      return idx;
-    } else if (!exact) {
-      if (best_match == UINT32_MAX)
-        best_match = idx;
-      else if (m_entries[idx].line < m_entries[best_match].line)
-        best_match = idx;
-    }
-  }
-
-  if (best_match != UINT32_MAX) {
-    if (line_entry_ptr)
-      ConvertEntryAtIndexToLineEntry(best_match, *line_entry_ptr);
-    return best_match;
-  }
-  return UINT32_MAX;
+  return FindLineEntryIndexByFileIndexImpl(start_idx, file_idx, line, exact,
+                                           line_entry_ptr);
 }
 
 size_t LineTable::FineLineEntriesForFileIndex(uint32_t file_idx, bool append,
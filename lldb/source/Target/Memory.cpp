@@ -224,22 +224,46 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
 
       if (bytes_left > 0) {
         assert((curr_addr % cache_line_byte_size) == 0);
-        std::unique_ptr<DataBufferHeap> data_buffer_heap_up(
-            new DataBufferHeap(cache_line_byte_size, 0));
+        // Reads larger than a cache line were handled above, so this read
+        // needs at most the next line as well, when it straddles a line
+        // boundary. Fetch both with a single read from the inferior instead
+        // of paying a round trip per line, which is expensive for remote
+        // targets.
+        size_t num_lines = 1;
+        while (num_lines * cache_line_byte_size < cache_offset + bytes_left) {
+          const addr_t next_line_addr =
+              curr_addr + num_lines * cache_line_byte_size;
+          if (m_L2_cache.count(next_line_addr) ||
+              m_invalid_ranges.FindEntryThatContains(next_line_addr))
+            break;
+          ++num_lines;
+        }
+
+        DataBufferHeap data_buffer(num_lines * cache_line_byte_size, 0);
         size_t process_bytes_read = m_process.ReadMemoryFromInferior(
-            curr_addr, data_buffer_heap_up->GetBytes(),
-            data_buffer_heap_up->GetByteSize(), error);
+            curr_addr, data_buffer.GetBytes(), data_buffer.GetByteSize(),
+            error);
+        // The later lines may not be readable even if the first one is, so
+        // fall back to reading just that one.
+        if (process_bytes_read == 0 && num_lines > 1) {
+          error.Clear();
+          process_bytes_read = m_process.ReadMemoryFromInferior(
+              curr_addr, data_buffer.GetBytes(), cache_line_byte_size, error);
+        }
         if (process_bytes_read == 0)
           return dst_len - bytes_left;
 
-        if (process_bytes_read != cache_line_byte_size) {
-          if (process_bytes_read < data_buffer_heap_up->GetByteSize()) {
-            dst_len -= data_buffer_heap_up->GetByteSize() - process_bytes_read;
-            bytes_left = process_bytes_read;
-          }
-          data_buffer_heap_up->SetByteSize(process_bytes_read);
+        if (process_bytes_read < cache_line_byte_size) {
+          dst_len -= cache_line_byte_size - process_bytes_read;
+          bytes_left = process_bytes_read;
+        }
+        for (size_t offset = 0; offset < process_bytes_read;
+             offset += cache_line_byte_size) {
+          const size_t line_size = std::min<size_t>(
+              cache_line_byte_size, process_bytes_read - offset);
+          m_L2_cache[curr_addr + offset] = DataBufferSP(
+              new DataBufferHeap(data_buffer.GetBytes() + offset, line_size));
         }
-        m_L2_cache[curr_addr] = DataBufferSP(data_buffer_heap_up.release());
         // We have read data and put it into the cache, continue through the
         // loop again to get the data out of the cache...
       }
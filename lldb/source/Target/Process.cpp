@@ -2119,6 +2119,36 @@ size_t Process::ReadCStringFromMemory(addr_t addr, char *dst,
   return total_cstr_len;
 }
 
+lldb::addr_t Process::FindInMemory(lldb::addr_t low, lldb::addr_t high,
+                                   const uint8_t *buf, size_t size) {
+  if (buf == nullptr || size == 0 || high <= low || high - low < size)
+    return LLDB_INVALID_ADDRESS;
+
+  // Consecutive chunks overlap by size - 1 bytes, so that matches that
+  // straddle a chunk boundary are found too. The chunks bypass the memory
+  // cache, which would otherwise keep a copy of the whole range.
+  const size_t chunk_size = 1024 * 1024;
+  std::vector<char> chunk(std::min<addr_t>(high - low, chunk_size + size - 1));
+  const llvm::StringRef needle(reinterpret_cast<const char *>(buf), size);
+  addr_t addr = low;
+  while (high - addr >= size) {
+    const size_t read_size = std::min<addr_t>(high - addr, chunk.size());
+    Status error;
+    const size_t bytes_read =
+        ReadMemoryFromInferior(addr, chunk.data(), read_size, error);
+    if (bytes_read < size)
+      return LLDB_INVALID_ADDRESS;
+
+    const size_t pos = llvm::StringRef(chunk.data(), bytes_read).find(needle);
+    if (pos != llvm::StringRef::npos)
+      return addr + pos;
+    if (bytes_read < read_size)
+      return LLDB_INVALID_ADDRESS;
+    addr += bytes_read - (size - 1);
+  }
+  return LLDB_INVALID_ADDRESS;
+}
+
 size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
                                        Status &error) {
   if (buf == nullptr || size == 0)
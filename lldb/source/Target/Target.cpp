@@ -261,6 +261,7 @@ void Target::SetREPL(lldb::LanguageType language, lldb::REPLSP repl_sp) {
 void Target::Destroy() {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   m_valid = false;
+  ClearUserExpressionCache();
   DeleteCurrentProcess();
   m_platform_sp.reset();
   m_arch = ArchSpec();
@@ -1609,6 +1610,7 @@ void Target::NotifyModulesRemoved(lldb_private::ModuleList &module_list) {
 void Target::ModulesDidLoad(ModuleList &module_list) {
   const size_t num_images = module_list.GetSize();
   if (m_valid && num_images) {
+    ClearUserExpressionCache();
     for (size_t idx = 0; idx < num_images; ++idx) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
@@ -1640,6 +1642,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
+    ClearUserExpressionCache();
     UnloadModuleSections(module_list);
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, false,
@@ -2213,6 +2216,50 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+lldb::UserExpressionSP Target::TakeCachedUserExpression(
+    llvm::StringRef expr, llvm::StringRef prefix, lldb::LanguageType language,
+    Expression::ResultType desired_type, ExecutionPolicy execution_policy,
+    bool generate_debug_info, ExecutionContext &exe_ctx) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  for (auto it = m_user_expression_cache.rbegin(),
+            end = m_user_expression_cache.rend();
+       it != end; ++it) {
+    UserExpression &user_expr = *it->expr_sp;
+    if (expr == user_expr.GetUserText() && prefix == it->prefix &&
+        language == user_expr.Language() &&
+        desired_type == user_expr.DesiredResultType() &&
+        execution_policy == it->execution_policy &&
+        generate_debug_info == it->generate_debug_info &&
+        user_expr.MatchesContext(exe_ctx)) {
+      lldb::UserExpressionSP expr_sp = std::move(it->expr_sp);
+      m_user_expression_cache.erase(std::next(it).base());
+      return expr_sp;
+    }
+  }
+  return nullptr;
+}
+
+void Target::CacheUserExpression(lldb::UserExpressionSP expr_sp,
+                                 llvm::StringRef prefix,
+                                 ExecutionPolicy execution_policy,
+                                 bool generate_debug_info) {
+  const uint64_t max_size = GetExpressionCacheSize();
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  if (max_size == 0) {
+    m_user_expression_cache.clear();
+    return;
+  }
+  while (m_user_expression_cache.size() >= max_size)
+    m_user_expression_cache.erase(m_user_expression_cache.begin());
+  m_user_expression_cache.push_back({std::string(prefix), execution_policy,
+                                     generate_debug_info, std::move(expr_sp)});
+}
+
+void Target::ClearUserExpressionCache() {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  m_user_expression_cache.clear();
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
@@ -3559,6 +3606,12 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   m_collection_sp->SetPropertyAtIndexAsBoolean(nullptr, idx, b);
 }
 
+bool TargetProperties::GetParallelModuleLoad() const {
+  const uint32_t idx = ePropertyParallelModuleLoad;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -3752,6 +3805,12 @@ bool TargetProperties::GetEnableNotifyAboutFixIts() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+uint64_t TargetProperties::GetExpressionCacheSize() const {
+  const uint32_t idx = ePropertyExpressionCacheSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
+}
+
 bool TargetProperties::GetEnableSaveObjects() const {
   const uint32_t idx = ePropertySaveObjects;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -0,0 +1,61 @@
+"""
+Test that target.expression-cache-size lets an expression evaluated twice in
+the same frame reuse its parsed code, and that loading a module or setting the
+size to 0 stops that.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def evaluate(self, frame):
+        value = frame.EvaluateExpression("add(x, 1)")
+        self.assertTrue(value.GetError().Success(), value.GetError().GetCString())
+        self.assertEqual(value.GetValueAsSigned(), 42)
+
+    def test_expression_cache(self):
+        self.build()
+        target, process, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.c"))
+        frame = thread.GetFrameAtIndex(0)
+
+        log_file = self.getBuildArtifact("expr.log")
+        self.runCmd("log enable -f '%s' lldb expr" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr"))
+
+        # The second evaluation in the same frame reuses the parsed expression.
+        self.evaluate(frame)
+        self.evaluate(frame)
+
+        # Loading a module may change what the expression binds to, so it
+        # clears the cache.
+        lib = self.getBuildArtifact(self.platformContext.shlib_prefix +
+                                    "other." +
+                                    self.platformContext.shlib_extension)
+        self.assertTrue(target.AddModule(lib, None, None).IsValid())
+        self.evaluate(frame)
+        self.evaluate(frame)
+
+        # A size of 0 disables the cache.
+        self.runCmd("settings set target.expression-cache-size 0")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.expression-cache-size"))
+        self.evaluate(frame)
+        self.evaluate(frame)
+
+        self.runCmd("log disable lldb expr")
+        events = []
+        with open(log_file, "r") as f:
+            for line in f:
+                if "Parsing expression add(x, 1)" in line:
+                    events.append("parse")
+                elif "Reusing parsed expression add(x, 1)" in line:
+                    events.append("reuse")
+        self.assertEqual(events,
+                         ["parse", "reuse", "parse", "reuse", "parse", "parse"])
@@ -0,0 +1,6 @@
+int add(int a, int b) { return a + b; }
+
+int main(void) {
+  int x = 41;
+  return add(x, 1); // break here
+}
@@ -0,0 +1,63 @@
+//===-- TestLineTable.cpp -------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Symbol/LineTable.h"
+
+using namespace lldb_private;
+
+static void InsertRow(LineTable &table, lldb::addr_t addr, uint32_t line,
+                      uint16_t file_idx, bool is_terminal_entry = false) {
+  table.InsertLineEntry(addr, line, /*column=*/0, file_idx,
+                        /*is_start_of_statement=*/true,
+                        /*is_start_of_basic_block=*/false,
+                        /*is_prologue_end=*/false,
+                        /*is_epilogue_begin=*/false, is_terminal_entry);
+}
+
+TEST(LineTableTest, FindLineEntryIndexByFileIndex) {
+  LineTable table(nullptr);
+  InsertRow(table, 0x1000, 10, 1); // 0
+  InsertRow(table, 0x1004, 12, 1); // 1
+  InsertRow(table, 0x1008, 10, 2); // 2
+  InsertRow(table, 0x100c, 10, 1); // 3
+  InsertRow(table, 0x1010, 15, 1); // 4
+  InsertRow(table, 0x1014, 13, 2); // 5
+  InsertRow(table, 0x1018, 11, 1, /*is_terminal_entry=*/true); // 6
+
+  // Exact matches are found in table order.
+  EXPECT_EQ(0u, table.FindLineEntryIndexByFileIndex(0, 1, 10, true, nullptr));
+  EXPECT_EQ(3u, table.FindLineEntryIndexByFileIndex(1, 1, 10, true, nullptr));
+  EXPECT_EQ(UINT32_MAX,
+            table.FindLineEntryIndexByFileIndex(4, 1, 10, true, nullptr));
+  EXPECT_EQ(2u, table.FindLineEntryIndexByFileIndex(0, 2, 10, true, nullptr));
+
+  // Terminal entries never match.
+  EXPECT_EQ(UINT32_MAX,
+            table.FindLineEntryIndexByFileIndex(0, 1, 11, true, nullptr));
+
+  // Otherwise the closest following line wins.
+  EXPECT_EQ(1u, table.FindLineEntryIndexByFileIndex(0, 1, 11, false, nullptr));
+  EXPECT_EQ(4u, table.FindLineEntryIndexByFileIndex(2, 1, 11, false, nullptr));
+  EXPECT_EQ(UINT32_MAX,
+            table.FindLineEntryIndexByFileIndex(0, 1, 16, false, nullptr));
+
+  // An exact match in any of the files wins over a closer inexact one.
+  std::vector<uint32_t> files = {1, 2};
+  EXPECT_EQ(1u,
+            table.FindLineEntryIndexByFileIndex(0, files, 12, false, nullptr));
+  EXPECT_EQ(2u,
+            table.FindLineEntryIndexByFileIndex(1, files, 10, false, nullptr));
+  EXPECT_EQ(5u,
+            table.FindLineEntryIndexByFileIndex(2, files, 13, true, nullptr));
+
+  // Inserting rows invalidates the index.
+  InsertRow(table, 0x1020, 11, 1);
+  EXPECT_EQ(7u, table.FindLineEntryIndexByFileIndex(0, 1, 11, true, nullptr));
+}
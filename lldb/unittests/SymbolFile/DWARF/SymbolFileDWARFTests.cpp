@@ -19,6 +19,7 @@
 #include "Plugins/SymbolFile/DWARF/DWARFDataExtractor.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugAbbrev.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugArangeSet.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
 #include "Plugins/SymbolFile/PDB/SymbolFilePDB.h"
 #include "Plugins/TypeSystem/Clang/TypeSystemClang.h"
@@ -346,3 +347,40 @@ TEST_F(SymbolFileDWARFTests, ParseArangesNonzeroSegmentSize) {
             llvm::toString(std::move(error)));
   EXPECT_EQ(off, 12U); // Parser should read no further than the segment size
 }
+
+TEST_F(SymbolFileDWARFTests, NameToDIEEncodeDecode) {
+  NameToDIE original;
+  original.Insert(ConstString("foo"), DIERef(llvm::None, DIERef::DebugInfo, 4));
+  original.Insert(ConstString("bar"), DIERef(3, DIERef::DebugTypes, 8));
+  original.Insert(ConstString("foo"),
+                  DIERef(llvm::None, DIERef::DebugInfo, 12));
+  original.Finalize();
+
+  std::string encoded;
+  {
+    llvm::raw_string_ostream os(encoded);
+    original.Encode(os);
+  }
+
+  DataExtractor data(encoded.data(), encoded.size(), eByteOrderLittle, 8);
+  offset_t off = 0;
+  NameToDIE decoded;
+  ASSERT_TRUE(decoded.Decode(data, &off));
+  decoded.Finalize();
+  EXPECT_EQ(off, encoded.size());
+
+  DIEArray foo;
+  EXPECT_EQ(2U, decoded.Find(ConstString("foo"), foo));
+  DIEArray bar;
+  ASSERT_EQ(1U, decoded.Find(ConstString("bar"), bar));
+  EXPECT_EQ(llvm::Optional<uint32_t>(3), bar[0].dwo_num());
+  EXPECT_EQ(DIERef::DebugTypes, bar[0].section());
+  EXPECT_EQ(8U, bar[0].die_offset());
+
+  // Truncated data is rejected.
+  DataExtractor truncated(encoded.data(), encoded.size() - 1, eByteOrderLittle,
+                          8);
+  off = 0;
+  NameToDIE partial;
+  EXPECT_FALSE(partial.Decode(truncated, &off));
+}
@@ -0,0 +1,123 @@
+//===-- MemoryTest.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/Platform.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/Reproducer.h"
+#include "gtest/gtest.h"
+#include <cstring>
+
+using namespace lldb_private;
+using namespace lldb_private::repro;
+using namespace lldb;
+
+namespace {
+class MemoryTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    llvm::cantFail(Reproducer::Initialize(ReproducerMode::Off, llvm::None));
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    platform_linux::PlatformLinux::Initialize();
+  }
+  void TearDown() override {
+    platform_linux::PlatformLinux::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+    Reproducer::Terminate();
+  }
+};
+
+// A process whose only memory is m_memory, mapped at m_base.
+class DummyProcess : public Process {
+public:
+  DummyProcess(lldb::TargetSP target_sp, lldb::ListenerSP listener_sp,
+               lldb::addr_t base, size_t size)
+      : Process(target_sp, listener_sp), m_base(base), m_memory(size, 0) {}
+
+  bool CanDebug(lldb::TargetSP target, bool plugin_specified_by_name) override {
+    return true;
+  }
+  Status DoDestroy() override { return {}; }
+  void RefreshStateAfterStop() override {}
+  size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
+                      Status &error) override {
+    if (vm_addr < m_base || vm_addr >= m_base + m_memory.size()) {
+      error.SetErrorString("unmapped");
+      return 0;
+    }
+    size = std::min<size_t>(size, m_base + m_memory.size() - vm_addr);
+    memcpy(buf, m_memory.data() + (vm_addr - m_base), size);
+    return size;
+  }
+  bool UpdateThreadList(ThreadList &old_thread_list,
+                        ThreadList &new_thread_list) override {
+    return false;
+  }
+  ConstString GetPluginName() override { return ConstString("Dummy"); }
+  uint32_t GetPluginVersion() override { return 0; }
+
+  void Write(lldb::addr_t addr, llvm::StringRef bytes) {
+    memcpy(m_memory.data() + (addr - m_base), bytes.data(), bytes.size());
+  }
+
+private:
+  lldb::addr_t m_base;
+  std::vector<uint8_t> m_memory;
+};
+} // namespace
+
+TEST_F(MemoryTest, FindInMemory) {
+  ArchSpec arch("x86_64-pc-linux");
+
+  Platform::SetHostPlatform(
+      platform_linux::PlatformLinux::CreateInstance(true, &arch));
+
+  DebuggerSP debugger_sp = Debugger::CreateInstance();
+  ASSERT_TRUE(debugger_sp);
+
+  TargetSP target_sp;
+  PlatformSP platform_sp;
+  Status error = debugger_sp->GetTargetList().CreateTarget(
+      *debugger_sp, "", arch, eLoadDependentsNo, platform_sp, target_sp);
+  ASSERT_TRUE(target_sp);
+
+  const lldb::addr_t base = 0x10000;
+  const size_t size = 3 * 1024 * 1024;
+  ListenerSP listener_sp(Listener::MakeListener("dummy"));
+  auto process_sp =
+      std::make_shared<DummyProcess>(target_sp, listener_sp, base, size);
+
+  auto find = [&](lldb::addr_t low, lldb::addr_t high, llvm::StringRef str) {
+    return process_sp->FindInMemory(
+        low, high, reinterpret_cast<const uint8_t *>(str.data()), str.size());
+  };
+
+  // A match that straddles the boundary between two chunks of the search.
+  const lldb::addr_t straddling = base + 1024 * 1024 - 3;
+  process_sp->Write(straddling, "needle");
+  const lldb::addr_t later = base + 2 * 1024 * 1024 + 5;
+  process_sp->Write(later, "needle");
+
+  EXPECT_EQ(straddling, find(base, base + size, "needle"));
+  EXPECT_EQ(later, find(straddling + 1, base + size, "needle"));
+  EXPECT_EQ(LLDB_INVALID_ADDRESS, find(later + 1, base + size, "needle"));
+  // The whole match has to be below the end of the range.
+  EXPECT_EQ(LLDB_INVALID_ADDRESS, find(later - 16, later + 5, "needle"));
+  EXPECT_EQ(later, find(later - 16, later + 6, "needle"));
+  // Single bytes.
+  EXPECT_EQ(straddling + 1, find(base, base + size, "e"));
+  // Memory that cannot be read ends the search.
+  EXPECT_EQ(LLDB_INVALID_ADDRESS, find(base - 16, base + size, "needle"));
+}
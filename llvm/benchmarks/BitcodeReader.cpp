@@ -0,0 +1,123 @@
+//===- BitcodeReader.cpp - Bitcode reading benchmarks ---------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures reading bitcode back into IR, both all at once (as opt and the
+// ThinLTO backends do) and lazily one function at a time (as the JIT and
+// llvm-link do). The input is a module of the given number of copies of a
+// function that mixes loops, memory accesses and calls.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+static const char *const FunctionTemplate = R"IR(
+define i64 @f{0}(i64* %a, i64 %n, %struct.node* %s) {{
+entry:
+  %cmp0 = icmp sgt i64 %n, 0
+  br i1 %cmp0, label %loop, label %exit
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %latch ]
+  %sum = phi i64 [ 0, %entry ], [ %sum.next, %latch ]
+  %p = getelementptr inbounds i64, i64* %a, i64 %i
+  %v = load i64, i64* %p, align 8
+  %odd = and i64 %v, 1
+  %isodd = icmp ne i64 %odd, 0
+  br i1 %isodd, label %then, label %latch
+
+then:
+  %f = getelementptr inbounds %struct.node, %struct.node* %s, i64 0, i32 1
+  %w = load i32, i32* %f, align 4
+  %wx = sext i32 %w to i64
+  %c = call i64 @ext(i64 %v, i64 %wx)
+  store i64 %c, i64* %p, align 8
+  br label %latch
+
+latch:
+  %t = phi i64 [ %v, %loop ], [ %c, %then ]
+  %sum.next = add nsw i64 %sum, %t
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %r = phi i64 [ 0, %entry ], [ %sum.next, %latch ]
+  %big = icmp ugt i64 %r, 1000
+  %sel = select i1 %big, i64 %r, i64 -1
+  ret i64 %sel
+}
+)IR";
+
+static std::unique_ptr<Module> createModule(LLVMContext &Ctx,
+                                            unsigned NumFunctions) {
+  std::string IR = "%struct.node = type { %struct.node*, i32, [4 x i8] }\n"
+                   "declare i64 @ext(i64, i64)\n";
+  for (unsigned I = 0; I != NumFunctions; ++I)
+    IR += formatv(FunctionTemplate, I).str();
+
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Ctx);
+  if (!M)
+    report_fatal_error("Cannot parse the benchmark input");
+  return M;
+}
+
+static SmallVector<char, 0> createBitcode(unsigned NumFunctions) {
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = createModule(Ctx, NumFunctions);
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(*M, OS);
+  return Bitcode;
+}
+
+static void BM_ParseBitcodeFile(benchmark::State &State) {
+  SmallVector<char, 0> Bitcode = createBitcode(State.range(0));
+  MemoryBufferRef Buffer(StringRef(Bitcode.data(), Bitcode.size()), "bench");
+  for (auto _ : State) {
+    LLVMContext Ctx;
+    Expected<std::unique_ptr<Module>> M = parseBitcodeFile(Buffer, Ctx);
+    if (!M)
+      report_fatal_error(M.takeError());
+    benchmark::DoNotOptimize(M->get());
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+  State.SetBytesProcessed(State.iterations() * Bitcode.size());
+}
+BENCHMARK(BM_ParseBitcodeFile)->Range(16, 4096);
+
+static void BM_MaterializeOneFunction(benchmark::State &State) {
+  SmallVector<char, 0> Bitcode = createBitcode(State.range(0));
+  MemoryBufferRef Buffer(StringRef(Bitcode.data(), Bitcode.size()), "bench");
+  std::string Name = "f" + std::to_string(State.range(0) / 2);
+  for (auto _ : State) {
+    LLVMContext Ctx;
+    Expected<std::unique_ptr<Module>> M = getLazyBitcodeModule(Buffer, Ctx);
+    if (!M)
+      report_fatal_error(M.takeError());
+    if (Error E = (*M)->getFunction(Name)->materialize())
+      report_fatal_error(std::move(E));
+    benchmark::DoNotOptimize(M->get());
+  }
+}
+BENCHMARK(BM_MaterializeOneFunction)->Range(16, 4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+//===- CodeGen.cpp - Native code generation benchmarks --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the codegen pipeline for the host target at -O2 on a module of the
+// given number of copies of a function with loops, a switch and calls. Both
+// emitting assembly and emitting an object file run instruction selection and
+// the machine passes; only the latter runs the MCAssembler, so the difference
+// between the two is the cost of encoding and layout.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Target/TargetOptions.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+using namespace llvm;
+
+static const char *const FunctionTemplate = R"IR(
+define i32 @f{0}(i32* %a, i32 %n, i32 %k) {{
+entry:
+  %cmp0 = icmp sgt i32 %n, 0
+  br i1 %cmp0, label %loop, label %exit
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %latch ]
+  %acc = phi i32 [ %k, %entry ], [ %acc.next, %latch ]
+  %idx = sext i32 %i to i64
+  %p = getelementptr inbounds i32, i32* %a, i64 %idx
+  %v = load i32, i32* %p, align 4
+  %sel = and i32 %v, 3
+  switch i32 %sel, label %latch [
+    i32 0, label %case0
+    i32 1, label %case1
+    i32 2, label %case2
+  ]
+
+case0:
+  %m = mul nsw i32 %v, %acc
+  br label %latch
+
+case1:
+  %d = sdiv i32 %v, 7
+  store i32 %d, i32* %p, align 4
+  br label %latch
+
+case2:
+  %c = call i32 @ext(i32 %v, i32 %i)
+  br label %latch
+
+latch:
+  %t = phi i32 [ %v, %loop ], [ %m, %case0 ], [ %d, %case1 ], [ %c, %case2 ]
+  %acc.next = xor i32 %acc, %t
+  %i.next = add nuw nsw i32 %i, 1
+  %done = icmp eq i32 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %r = phi i32 [ %k, %entry ], [ %acc.next, %latch ]
+  ret i32 %r
+}
+)IR";
+
+static std::unique_ptr<Module> createModule(LLVMContext &Ctx,
+                                            unsigned NumFunctions) {
+  std::string IR = "declare i32 @ext(i32, i32)\n";
+  for (unsigned I = 0; I != NumFunctions; ++I)
+    IR += formatv(FunctionTemplate, I).str();
+
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Ctx);
+  if (!M)
+    report_fatal_error("Cannot parse the benchmark input");
+  return M;
+}
+
+static std::unique_ptr<TargetMachine> createTargetMachine() {
+  if (InitializeNativeTarget() || InitializeNativeTargetAsmPrinter())
+    return nullptr;
+  std::string TripleStr = sys::getProcessTriple();
+  std::string Error;
+  const Target *T = TargetRegistry::lookupTarget(TripleStr, Error);
+  if (!T)
+    return nullptr;
+  return std::unique_ptr<TargetMachine>(T->createTargetMachine(
+      TripleStr, sys::getHostCPUName(), "", TargetOptions(), None, None,
+      CodeGenOpt::Default));
+}
+
+static void runCodeGen(benchmark::State &State, CodeGenFileType FileType) {
+  std::unique_ptr<TargetMachine> TM = createTargetMachine();
+  if (!TM) {
+    State.SkipWithError("No native target available");
+    return;
+  }
+
+  LLVMContext Ctx;
+  std::unique_ptr<Module> Input = createModule(Ctx, State.range(0));
+  Input->setTargetTriple(TM->getTargetTriple().str());
+  Input->setDataLayout(TM->createDataLayout());
+
+  SmallString<0> Output;
+  for (auto _ : State) {
+    State.PauseTiming();
+    std::unique_ptr<Module> M = CloneModule(*Input);
+    Output.clear();
+    State.ResumeTiming();
+
+    raw_svector_ostream OS(Output);
+    legacy::PassManager PM;
+    if (TM->addPassesToEmitFile(PM, OS, nullptr, FileType)) {
+      State.SkipWithError("Target cannot emit this file type");
+      return;
+    }
+    PM.run(*M);
+    benchmark::DoNotOptimize(Output.data());
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+static void BM_EmitAssembly(benchmark::State &State) {
+  runCodeGen(State, CGFT_AssemblyFile);
+}
+BENCHMARK(BM_EmitAssembly)->Range(16, 1024);
+
+static void BM_EmitObject(benchmark::State &State) {
+  runCodeGen(State, CGFT_ObjectFile);
+}
+BENCHMARK(BM_EmitObject)->Range(16, 1024);
+
+BENCHMARK_MAIN();
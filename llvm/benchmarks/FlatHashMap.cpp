@@ -0,0 +1,140 @@
+//===- FlatHashMap.cpp - FlatHashMap and DenseMap benchmarks --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Compares FlatHashMap with DenseMap on the key distributions of typical
+// large maps: pointers to objects allocated from a BumpPtrAllocator (like
+// DenseMap<const Value *, ...>), small consecutive integers (instruction and
+// value numbers) and random integers.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/Support/Allocator.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+// Roughly the size of an llvm::Instruction.
+struct Object {
+  char Data[64];
+};
+
+struct PointerKeys {
+  using KeyT = const Object *;
+  static std::vector<KeyT> get(size_t N, BumpPtrAllocator &Alloc) {
+    std::vector<KeyT> Keys;
+    for (size_t I = 0; I != N; ++I)
+      Keys.push_back(new (Alloc) Object());
+    return Keys;
+  }
+};
+
+struct ConsecutiveKeys {
+  using KeyT = unsigned;
+  static std::vector<KeyT> get(size_t N, BumpPtrAllocator &) {
+    std::vector<KeyT> Keys;
+    for (size_t I = 0; I != N; ++I)
+      Keys.push_back(I);
+    return Keys;
+  }
+};
+
+struct RandomKeys {
+  using KeyT = unsigned;
+  static std::vector<KeyT> get(size_t N, BumpPtrAllocator &) {
+    std::mt19937 Gen(42);
+    // Stay below the keys DenseMap reserves.
+    std::uniform_int_distribution<unsigned> Dist(0, ~0U - 2);
+    std::vector<KeyT> Keys;
+    for (size_t I = 0; I != N; ++I)
+      Keys.push_back(Dist(Gen));
+    return Keys;
+  }
+};
+
+// Returns twice the requested number of keys: the first half is inserted and
+// the second half is used for unsuccessful lookups.
+template <typename KeysT>
+std::vector<typename KeysT::KeyT> getKeys(size_t N, BumpPtrAllocator &Alloc) {
+  std::vector<typename KeysT::KeyT> Keys = KeysT::get(2 * N, Alloc);
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(7));
+  return Keys;
+}
+} // namespace
+
+template <template <typename...> class MapT, typename KeysT>
+static void BM_Insert(benchmark::State &State) {
+  BumpPtrAllocator Alloc;
+  auto Keys = getKeys<KeysT>(State.range(0), Alloc);
+  Keys.resize(State.range(0));
+  for (auto _ : State) {
+    MapT<typename KeysT::KeyT, unsigned> Map;
+    for (auto Key : Keys)
+      Map[Key] = 0;
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <template <typename...> class MapT, typename KeysT>
+static void BM_FindHit(benchmark::State &State) {
+  BumpPtrAllocator Alloc;
+  auto Keys = getKeys<KeysT>(State.range(0), Alloc);
+  Keys.resize(State.range(0));
+  MapT<typename KeysT::KeyT, unsigned> Map;
+  for (auto Key : Keys)
+    Map[Key] = 1;
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(13));
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    for (auto Key : Keys)
+      Sum += Map.find(Key)->second;
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <template <typename...> class MapT, typename KeysT>
+static void BM_FindMiss(benchmark::State &State) {
+  BumpPtrAllocator Alloc;
+  auto Keys = getKeys<KeysT>(State.range(0), Alloc);
+  size_t N = State.range(0);
+  MapT<typename KeysT::KeyT, unsigned> Map;
+  for (size_t I = 0; I != N; ++I)
+    Map[Keys[I]] = 1;
+  for (auto _ : State) {
+    unsigned Count = 0;
+    for (size_t I = N; I != 2 * N; ++I)
+      Count += Map.count(Keys[I]);
+    benchmark::DoNotOptimize(Count);
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+template <typename KeyT, typename ValueT> using DenseMapT = DenseMap<KeyT, ValueT>;
+template <typename KeyT, typename ValueT>
+using FlatHashMapT = FlatHashMap<KeyT, ValueT>;
+
+#define MAP_BENCHMARKS(Keys)                                                   \
+  BENCHMARK_TEMPLATE(BM_Insert, DenseMapT, Keys)->Range(1 << 10, 1 << 20);     \
+  BENCHMARK_TEMPLATE(BM_Insert, FlatHashMapT, Keys)->Range(1 << 10, 1 << 20);  \
+  BENCHMARK_TEMPLATE(BM_FindHit, DenseMapT, Keys)->Range(1 << 10, 1 << 20);    \
+  BENCHMARK_TEMPLATE(BM_FindHit, FlatHashMapT, Keys)->Range(1 << 10, 1 << 20); \
+  BENCHMARK_TEMPLATE(BM_FindMiss, DenseMapT, Keys)->Range(1 << 10, 1 << 20);   \
+  BENCHMARK_TEMPLATE(BM_FindMiss, FlatHashMapT, Keys)->Range(1 << 10, 1 << 20)
+
+MAP_BENCHMARKS(PointerKeys);
+MAP_BENCHMARKS(ConsecutiveKeys);
+MAP_BENCHMARKS(RandomKeys);
+
+BENCHMARK_MAIN();
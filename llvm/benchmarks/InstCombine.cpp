@@ -0,0 +1,114 @@
+//===- InstCombine.cpp - InstCombine benchmarks ---------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures InstCombine on a module of the given number of copies of a
+// function full of the redundancies front ends and earlier passes leave
+// behind: bit manipulation with known bits, casts of casts, compares of
+// selects and address arithmetic.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Transforms/InstCombine/InstCombine.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+using namespace llvm;
+
+static const char *const FunctionTemplate = R"IR(
+define i32 @f{0}(i32 %x, i32 %y, i8 %b, i32* %p, i1 %c) {{
+entry:
+  %x.lo = and i32 %x, 255
+  %x.hi = shl i32 %x, 8
+  %x.m = or i32 %x.hi, %x.lo
+  %x.k = and i32 %x.m, 255
+  %b.z = zext i8 %b to i16
+  %b.zz = zext i16 %b.z to i32
+  %b.t = trunc i32 %b.zz to i8
+  %b.s = sext i8 %b.t to i32
+  %sel = select i1 %c, i32 %x.k, i32 %b.s
+  %cmp = icmp eq i32 %sel, %x.k
+  %sub = sub i32 %y, %y
+  %add = add i32 %sub, %x
+  %mul = mul i32 %add, 8
+  %div = udiv i32 %mul, 4
+  %neg = sub i32 0, %div
+  %neg2 = sub i32 0, %neg
+  %gep0 = getelementptr inbounds i32, i32* %p, i64 1
+  %gep1 = getelementptr inbounds i32, i32* %gep0, i64 2
+  %pi = ptrtoint i32* %gep1 to i64
+  %pp = inttoptr i64 %pi to i32*
+  %v = load i32, i32* %pp, align 4
+  %xor0 = xor i32 %v, -1
+  %xor1 = xor i32 %xor0, -1
+  %r0 = add i32 %neg2, %xor1
+  %r1 = select i1 %cmp, i32 %r0, i32 %x.lo
+  br i1 %c, label %then, label %exit
+
+then:
+  %lshr = lshr i32 %r1, 31
+  %tr = trunc i32 %lshr to i1
+  %z = zext i1 %tr to i32
+  %s2 = shl nuw i32 %z, 1
+  br label %exit
+
+exit:
+  %phi = phi i32 [ %r1, %entry ], [ %s2, %then ]
+  %ret = or i32 %phi, 0
+  ret i32 %ret
+}
+)IR";
+
+static std::unique_ptr<Module> createModule(LLVMContext &Ctx,
+                                            unsigned NumFunctions) {
+  std::string IR;
+  for (unsigned I = 0; I != NumFunctions; ++I)
+    IR += formatv(FunctionTemplate, I).str();
+
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Ctx);
+  if (!M)
+    report_fatal_error("Cannot parse the benchmark input");
+  return M;
+}
+
+static void BM_InstCombine(benchmark::State &State) {
+  LLVMContext Ctx;
+  std::unique_ptr<Module> Input = createModule(Ctx, State.range(0));
+  for (auto _ : State) {
+    State.PauseTiming();
+    std::unique_ptr<Module> M = CloneModule(*Input);
+    PassBuilder PB;
+    LoopAnalysisManager LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager CGAM;
+    ModuleAnalysisManager MAM;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    ModulePassManager MPM;
+    MPM.addPass(createModuleToFunctionPassAdaptor(InstCombinePass()));
+    State.ResumeTiming();
+
+    MPM.run(*M, MAM);
+    benchmark::DoNotOptimize(M.get());
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_InstCombine)->Range(16, 4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+// Values with a mix of digit counts, as seen in assembly and IR dumps.
+static std::vector<uint64_t> getValues(uint64_t Max) {
+  std::vector<uint64_t> Values;
+  uint64_t X = 0x9E3779B97F4A7C15ULL;
+  for (int I = 0; I < 4096; ++I) {
+    X ^= X << 13;
+    X ^= X >> 7;
+    X ^= X << 17;
+    Values.push_back(X % (Max >> (I % 24)));
+  }
+  return Values;
+}
+
+template <typename Fn>
+static void runFormat(benchmark::State &State, uint64_t Max, Fn Write) {
+  std::vector<uint64_t> Values = getValues(Max);
+  SmallString<0> Buffer;
+  raw_svector_ostream OS(Buffer);
+  for (auto _ : State) {
+    Buffer.clear();
+    for (uint64_t V : Values)
+      Write(OS, V);
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+
+static void BM_FormatDecimal32(benchmark::State &State) {
+  runFormat(State, UINT32_MAX,
+            [](raw_ostream &OS, uint64_t V) { OS << V << ' '; });
+}
+BENCHMARK(BM_FormatDecimal32);
+
+static void BM_FormatDecimal64(benchmark::State &State) {
+  runFormat(State, UINT64_MAX,
+            [](raw_ostream &OS, uint64_t V) { OS << V << ' '; });
+}
+BENCHMARK(BM_FormatDecimal64);
+
+static void BM_FormatSigned(benchmark::State &State) {
+  runFormat(State, UINT32_MAX,
+            [](raw_ostream &OS, uint64_t V) { OS << -int64_t(V) << ' '; });
+}
+BENCHMARK(BM_FormatSigned);
+
+static void BM_FormatHex(benchmark::State &State) {
+  runFormat(State, UINT64_MAX, [](raw_ostream &OS, uint64_t V) {
+    OS << format_hex(V, 18) << ' ';
+  });
+}
+BENCHMARK(BM_FormatHex);
+
+static void BM_EncodeULEB128(benchmark::State &State) {
+  runFormat(State, UINT64_MAX,
+            [](raw_ostream &OS, uint64_t V) { encodeULEB128(V, OS); });
+}
+BENCHMARK(BM_EncodeULEB128);
+
+static void BM_EncodeSLEB128(benchmark::State &State) {
+  runFormat(State, UINT64_MAX,
+            [](raw_ostream &OS, uint64_t V) { encodeSLEB128(-V, OS); });
+}
+BENCHMARK(BM_EncodeSLEB128);
+
+BENCHMARK_MAIN();
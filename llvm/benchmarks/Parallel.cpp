@@ -0,0 +1,102 @@
+//===- Parallel.cpp - parallel::for_each benchmarks -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the parallel loops the linkers use to write and hash sections,
+// against the same loops run sequentially. Each element is a chunk of bytes
+// that gets hashed, standing in for an input section; the chunk size is the
+// second benchmark argument.
+//
+// The default executor uses all hardware threads. Run with taskset or a
+// restricted cpuset to measure scaling at lower thread counts.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/xxhash.h"
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+struct Chunk {
+  std::vector<uint8_t> Data;
+  uint64_t Hash = 0;
+};
+} // namespace
+
+static std::vector<Chunk> getChunks(size_t NumChunks, size_t ChunkSize) {
+  std::vector<Chunk> Chunks(NumChunks);
+  uint8_t X = 1;
+  for (Chunk &C : Chunks) {
+    C.Data.resize(ChunkSize);
+    for (uint8_t &B : C.Data)
+      B = X = X * 33 + 7;
+  }
+  return Chunks;
+}
+
+template <class PolicyT>
+static void BM_ForEach(benchmark::State &State, PolicyT Policy) {
+  std::vector<Chunk> Chunks = getChunks(State.range(0), State.range(1));
+  for (auto _ : State) {
+    parallel::for_each(Policy, Chunks.begin(), Chunks.end(),
+                       [](Chunk &C) { C.Hash = xxHash64(C.Data); });
+    benchmark::ClobberMemory();
+  }
+  State.SetItemsProcessed(State.iterations() * Chunks.size());
+  State.SetBytesProcessed(State.iterations() * Chunks.size() *
+                          State.range(1));
+}
+BENCHMARK_CAPTURE(BM_ForEach, seq, parallel::seq)
+    ->Ranges({{1 << 8, 1 << 16}, {64, 16 << 10}});
+BENCHMARK_CAPTURE(BM_ForEach, par, parallel::par)
+    ->Ranges({{1 << 8, 1 << 16}, {64, 16 << 10}})
+    ->UseRealTime();
+
+// Cheap loop bodies, where the cost of creating tasks dominates unless the
+// grain size (the second argument) is large enough.
+static void BM_ForEachN(benchmark::State &State) {
+  size_t N = State.range(0);
+  std::vector<uint64_t> Values(N);
+  for (auto _ : State) {
+    parallel::for_each_n(
+        parallel::par, size_t(0), N,
+        [&](size_t I) { Values[I] = I * 0x9E3779B97F4A7C15ULL; },
+        State.range(1));
+    benchmark::ClobberMemory();
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_ForEachN)
+    ->Ranges({{1 << 12, 1 << 22}, {0, 4096}})
+    ->UseRealTime();
+
+static void BM_Sort(benchmark::State &State) {
+  size_t N = State.range(0);
+  std::vector<uint64_t> Input(N);
+  uint64_t X = 0x9E3779B97F4A7C15ULL;
+  for (uint64_t &V : Input) {
+    X ^= X << 13;
+    X ^= X >> 7;
+    X ^= X << 17;
+    V = X;
+  }
+  std::vector<uint64_t> Values;
+  for (auto _ : State) {
+    State.PauseTiming();
+    Values = Input;
+    State.ResumeTiming();
+    parallel::sort(parallel::par, Values.begin(), Values.end());
+    benchmark::ClobberMemory();
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_Sort)->Range(1 << 12, 1 << 22)->UseRealTime();
+
+BENCHMARK_MAIN();
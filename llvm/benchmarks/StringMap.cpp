@@ -0,0 +1,83 @@
+//===- StringMap.cpp - StringMap benchmarks -------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures StringMap on keys shaped like symbol names: a few common prefixes
+// followed by a unique suffix, as in mangled C++ names or "__cxx_global_var"
+// style globals.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/Twine.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+// Returns twice the requested number of keys: the first half is inserted and
+// the second half is used for unsuccessful lookups.
+static std::vector<std::string> getKeys(size_t N) {
+  static const char *const Prefixes[] = {"_ZN4llvm", "_ZNSt3__1", "__cxx_",
+                                         "llvm.", ".str."};
+  std::vector<std::string> Keys;
+  for (size_t I = 0; I != 2 * N; ++I)
+    Keys.push_back((Twine(Prefixes[I % 5]) + "name" + Twine(I)).str());
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(7));
+  return Keys;
+}
+
+static void BM_StringMapInsert(benchmark::State &State) {
+  std::vector<std::string> Keys = getKeys(State.range(0));
+  Keys.resize(State.range(0));
+  for (auto _ : State) {
+    StringMap<unsigned> Map;
+    for (const std::string &Key : Keys)
+      Map[Key] = 0;
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_StringMapInsert)->Range(1 << 10, 1 << 18);
+
+static void BM_StringMapFindHit(benchmark::State &State) {
+  std::vector<std::string> Keys = getKeys(State.range(0));
+  Keys.resize(State.range(0));
+  StringMap<unsigned> Map;
+  for (const std::string &Key : Keys)
+    Map[Key] = 1;
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(13));
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    for (const std::string &Key : Keys)
+      Sum += Map.find(Key)->second;
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_StringMapFindHit)->Range(1 << 10, 1 << 18);
+
+static void BM_StringMapFindMiss(benchmark::State &State) {
+  std::vector<std::string> Keys = getKeys(State.range(0));
+  size_t N = State.range(0);
+  StringMap<unsigned> Map;
+  for (size_t I = 0; I != N; ++I)
+    Map[Keys[I]] = 1;
+  for (auto _ : State) {
+    unsigned Count = 0;
+    for (size_t I = N; I != 2 * N; ++I)
+      Count += Map.count(Keys[I]);
+    benchmark::DoNotOptimize(Count);
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_StringMapFindMiss)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,579 @@
+//===- llvm/ADT/FlatHashMap.h - Group-probed hash table ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the FlatHashMap class, an open addressing hash table in
+// the style of Abseil's SwissTable.
+//
+// Next to the bucket array, the table keeps one control byte per bucket that
+// holds seven bits of the key's hash, or marks the bucket as empty or deleted.
+// Buckets are probed in aligned groups of 16: a lookup compares the control
+// bytes of a whole group with the hash bits at once (with SSE2 where
+// available) and touches the buckets themselves only on a likely match. Most
+// lookups therefore read one cache line of control bytes and one bucket,
+// which helps large maps whose buckets do not fit in the cache.
+//
+// FlatHashMap uses the same DenseMapInfo traits as DenseMap, but only
+// getHashValue and isEqual: there are no reserved empty or tombstone keys.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/EpochTracker.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/MathExtras.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Control byte values. The control byte of a full bucket holds the low seven
+/// bits of the hash, so it is never negative.
+enum : int8_t { FlatHashEmpty = -128, FlatHashDeleted = -2 };
+
+/// A group of control bytes that are matched together. Bit I of a returned
+/// mask is set if byte I of the group matches.
+class FlatHashGroup {
+public:
+  enum : unsigned { Width = 16 };
+
+#ifdef __SSE2__
+  explicit FlatHashGroup(const int8_t *P)
+      : Ctrl(_mm_load_si128(reinterpret_cast<const __m128i *>(P))) {}
+
+  unsigned match(int8_t H2) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(H2)));
+  }
+
+  unsigned matchEmpty() const { return match(FlatHashEmpty); }
+
+  /// Empty and deleted are the only negative control bytes.
+  unsigned matchEmptyOrDeleted() const { return _mm_movemask_epi8(Ctrl); }
+
+private:
+  __m128i Ctrl;
+#else
+  explicit FlatHashGroup(const int8_t *P) : Ctrl(P) {}
+
+  unsigned match(int8_t H2) const {
+    unsigned Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= unsigned(Ctrl[I] == H2) << I;
+    return Mask;
+  }
+
+  unsigned matchEmpty() const { return match(FlatHashEmpty); }
+
+  unsigned matchEmptyOrDeleted() const {
+    unsigned Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= unsigned(Ctrl[I] < 0) << I;
+    return Mask;
+  }
+
+private:
+  const int8_t *Ctrl;
+#endif
+};
+
+} // end namespace detail
+
+template <typename KeyT, typename ValueT, typename KeyInfoT, bool IsConst>
+class FlatHashMapIterator;
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap : public DebugEpochBase {
+  template <typename T>
+  using const_arg_type_t = typename const_pointer_or_const_ref<T>::type;
+
+  using Group = detail::FlatHashGroup;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = detail::DenseMapPair<KeyT, ValueT>;
+
+  using iterator = FlatHashMapIterator<KeyT, ValueT, KeyInfoT, false>;
+  using const_iterator = FlatHashMapIterator<KeyT, ValueT, KeyInfoT, true>;
+
+  explicit FlatHashMap(unsigned InitialReserve = 0) { reserve(InitialReserve); }
+
+  FlatHashMap(const FlatHashMap &Other) : DebugEpochBase() { copyFrom(Other); }
+
+  FlatHashMap(FlatHashMap &&Other) : DebugEpochBase() { swap(Other); }
+
+  FlatHashMap(std::initializer_list<value_type> Vals) {
+    reserve(Vals.size());
+    for (const value_type &V : Vals)
+      insert(V);
+  }
+
+  ~FlatHashMap() {
+    destroyAll();
+    deallocateBuckets();
+  }
+
+  FlatHashMap &operator=(const FlatHashMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocateBuckets();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  FlatHashMap &operator=(FlatHashMap &&Other) {
+    destroyAll();
+    deallocateBuckets();
+    swap(Other);
+    return *this;
+  }
+
+  void swap(FlatHashMap &RHS) {
+    incrementEpoch();
+    RHS.incrementEpoch();
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Buckets, RHS.Buckets);
+    std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(NumEntries, RHS.NumEntries);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  inline iterator begin() { return makeIterator(0, true); }
+  inline iterator end() { return makeIterator(NumBuckets, false); }
+  inline const_iterator begin() const { return makeConstIterator(0, true); }
+  inline const_iterator end() const {
+    return makeConstIterator(NumBuckets, false);
+  }
+
+  LLVM_NODISCARD bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Grow the table so that it can hold \p NumEntries entries without
+  /// rehashing.
+  void reserve(size_type NumEntries) {
+    unsigned Num = getMinBucketsForEntries(NumEntries);
+    if (Num > NumBuckets)
+      rehash(Num);
+  }
+
+  void clear() {
+    incrementEpoch();
+    if (NumEntries == 0 && GrowthLeft == getMaxLoad(NumBuckets))
+      return;
+    destroyAll();
+    if (NumBuckets)
+      std::memset(Ctrl, detail::FlatHashEmpty, NumBuckets);
+    NumEntries = 0;
+    GrowthLeft = getMaxLoad(NumBuckets);
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const_arg_type_t<KeyT> Val) const {
+    return findIndex(Val) != NumBuckets ? 1 : 0;
+  }
+
+  iterator find(const_arg_type_t<KeyT> Val) {
+    unsigned I = findIndex(Val);
+    return I == NumBuckets ? end() : makeIterator(I, false);
+  }
+  const_iterator find(const_arg_type_t<KeyT> Val) const {
+    unsigned I = findIndex(Val);
+    return I == NumBuckets ? end() : makeConstIterator(I, false);
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const_arg_type_t<KeyT> Val) const {
+    unsigned I = findIndex(Val);
+    return I == NumBuckets ? ValueT() : Buckets[I].getSecond();
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  /// insert - Range insertion of pairs.
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // The value is constructed in-place if the key is not in the map, otherwise
+  // it is not moved.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&... Args) {
+    uint64_t Hash = getHash(Key);
+    unsigned I = findIndex(Key, Hash);
+    if (I != NumBuckets)
+      return std::make_pair(makeIterator(I, false), false);
+    I = prepareInsert(Hash);
+    ::new (&Buckets[I]) value_type(std::piecewise_construct,
+                                   std::forward_as_tuple(std::move(Key)),
+                                   std::forward_as_tuple(
+                                       std::forward<Ts>(Args)...));
+    return std::make_pair(makeIterator(I, false), true);
+  }
+
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&... Args) {
+    uint64_t Hash = getHash(Key);
+    unsigned I = findIndex(Key, Hash);
+    if (I != NumBuckets)
+      return std::make_pair(makeIterator(I, false), false);
+    I = prepareInsert(Hash);
+    ::new (&Buckets[I]) value_type(std::piecewise_construct,
+                                   std::forward_as_tuple(Key),
+                                   std::forward_as_tuple(
+                                       std::forward<Ts>(Args)...));
+    return std::make_pair(makeIterator(I, false), true);
+  }
+
+  ValueT &operator[](const KeyT &Key) {
+    return try_emplace(Key).first->getSecond();
+  }
+
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->getSecond();
+  }
+
+  bool erase(const KeyT &Val) {
+    unsigned I = findIndex(Val);
+    if (I == NumBuckets)
+      return false;
+    eraseIndex(I);
+    return true;
+  }
+
+  void erase(iterator I) { eraseIndex(I.Bucket - Buckets); }
+
+  /// Return the approximate size (in bytes) of the actual map.
+  /// This is just the raw memory used by the map, it doesn't include memory
+  /// owned by keys or values.
+  size_t getMemorySize() const {
+    return NumBuckets * (sizeof(value_type) + 1);
+  }
+
+private:
+  friend class FlatHashMapIterator<KeyT, ValueT, KeyInfoT, false>;
+  friend class FlatHashMapIterator<KeyT, ValueT, KeyInfoT, true>;
+
+  /// The number of entries that fit in a table of \p Num buckets. Keeping an
+  /// eighth of the buckets empty bounds the length of probe sequences.
+  static unsigned getMaxLoad(unsigned Num) { return Num - Num / 8; }
+
+  static unsigned getMinBucketsForEntries(unsigned NumEntries) {
+    if (NumEntries == 0)
+      return 0;
+    unsigned Num = Group::Width;
+    while (getMaxLoad(Num) < NumEntries)
+      Num *= 2;
+    return Num;
+  }
+
+  /// DenseMapInfo hashes are often weak in their low bits (pointers are
+  /// aligned), so mix all of them before splitting the hash into the group
+  /// index and the seven control bits.
+  template <typename LookupKeyT>
+  static uint64_t getHash(const LookupKeyT &Key) {
+    uint64_t H = uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+    return H ^ (H >> 32);
+  }
+
+  static int8_t getH2(uint64_t Hash) { return int8_t(Hash & 0x7F); }
+
+  unsigned getFirstGroup(uint64_t Hash) const {
+    return unsigned(Hash >> 7) & (NumBuckets / Group::Width - 1);
+  }
+
+  /// Groups are probed quadratically. The number of groups is a power of two,
+  /// so the triangular steps visit every group.
+  unsigned getNextGroup(unsigned G, unsigned Step) const {
+    return (G + Step) & (NumBuckets / Group::Width - 1);
+  }
+
+  template <typename LookupKeyT>
+  unsigned findIndex(const LookupKeyT &Val) const {
+    return NumBuckets ? findIndex(Val, getHash(Val)) : 0;
+  }
+
+  /// Returns the bucket holding \p Val, or NumBuckets if there is none.
+  template <typename LookupKeyT>
+  unsigned findIndex(const LookupKeyT &Val, uint64_t Hash) const {
+    if (NumBuckets == 0)
+      return 0;
+    int8_t H2 = getH2(Hash);
+    unsigned G = getFirstGroup(Hash);
+    for (unsigned Step = 1;; ++Step) {
+      Group Grp(Ctrl + G * Group::Width);
+      for (unsigned Mask = Grp.match(H2); Mask; Mask &= Mask - 1) {
+        unsigned I = G * Group::Width + countTrailingZeros(Mask);
+        if (LLVM_LIKELY(KeyInfoT::isEqual(Val, Buckets[I].getFirst())))
+          return I;
+      }
+      // Insertion fills the first free bucket of the probe sequence, so the
+      // key cannot be past a group that has never been full.
+      if (LLVM_LIKELY(Grp.matchEmpty()))
+        return NumBuckets;
+      G = getNextGroup(G, Step);
+    }
+  }
+
+  /// Returns the first empty or deleted bucket in the probe sequence of
+  /// \p Hash.
+  unsigned findFreeIndex(uint64_t Hash) const {
+    unsigned G = getFirstGroup(Hash);
+    for (unsigned Step = 1;; ++Step) {
+      if (unsigned Mask =
+              Group(Ctrl + G * Group::Width).matchEmptyOrDeleted())
+        return G * Group::Width + countTrailingZeros(Mask);
+      G = getNextGroup(G, Step);
+    }
+  }
+
+  /// Claims a bucket for a new entry with hash \p Hash, rehashing first if
+  /// the table is full. The caller constructs the entry.
+  unsigned prepareInsert(uint64_t Hash) {
+    incrementEpoch();
+    if (NumBuckets == 0)
+      rehash(Group::Width);
+    unsigned I = findFreeIndex(Hash);
+    if (LLVM_UNLIKELY(GrowthLeft == 0 && Ctrl[I] == detail::FlatHashEmpty)) {
+      // Double the table unless most of the used buckets are deleted, in
+      // which case rehashing in place reclaims them.
+      rehash(NumEntries >= getMaxLoad(NumBuckets) / 2 ? NumBuckets * 2
+                                                      : NumBuckets);
+      I = findFreeIndex(Hash);
+    }
+    if (Ctrl[I] == detail::FlatHashEmpty)
+      --GrowthLeft;
+    Ctrl[I] = getH2(Hash);
+    ++NumEntries;
+    return I;
+  }
+
+  void eraseIndex(unsigned I) {
+    incrementEpoch();
+    Buckets[I].~value_type();
+    --NumEntries;
+    // If the group still has an empty bucket, it has never been full, so no
+    // probe sequence continues past it and the bucket can become empty again.
+    unsigned G = I / Group::Width;
+    if (Group(Ctrl + G * Group::Width).matchEmpty()) {
+      Ctrl[I] = detail::FlatHashEmpty;
+      ++GrowthLeft;
+    } else {
+      Ctrl[I] = detail::FlatHashDeleted;
+    }
+  }
+
+  void rehash(unsigned Num) {
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldBuckets = Buckets;
+    unsigned OldNumBuckets = NumBuckets;
+
+    allocateBuckets(Num);
+    GrowthLeft = getMaxLoad(NumBuckets) - NumEntries;
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      uint64_t Hash = getHash(OldBuckets[I].getFirst());
+      unsigned J = findFreeIndex(Hash);
+      Ctrl[J] = getH2(Hash);
+      ::new (&Buckets[J]) value_type(std::move(OldBuckets[I]));
+      OldBuckets[I].~value_type();
+    }
+
+    if (OldNumBuckets) {
+      deallocate_buffer(OldCtrl, OldNumBuckets, Group::Width);
+      deallocate_buffer(OldBuckets, sizeof(value_type) * OldNumBuckets,
+                        alignof(value_type));
+    }
+  }
+
+  void allocateBuckets(unsigned Num) {
+    assert(isPowerOf2_32(Num) && Num >= Group::Width &&
+           "invalid number of buckets");
+    NumBuckets = Num;
+    Ctrl = static_cast<int8_t *>(allocate_buffer(Num, Group::Width));
+    std::memset(Ctrl, detail::FlatHashEmpty, Num);
+    Buckets = static_cast<value_type *>(
+        allocate_buffer(sizeof(value_type) * Num, alignof(value_type)));
+  }
+
+  void deallocateBuckets() {
+    if (NumBuckets == 0)
+      return;
+    deallocate_buffer(Ctrl, NumBuckets, Group::Width);
+    deallocate_buffer(Buckets, sizeof(value_type) * NumBuckets,
+                      alignof(value_type));
+    Ctrl = nullptr;
+    Buckets = nullptr;
+    NumBuckets = 0;
+    NumEntries = 0;
+    GrowthLeft = 0;
+  }
+
+  void destroyAll() {
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (Ctrl[I] >= 0)
+        Buckets[I].~value_type();
+  }
+
+  void copyFrom(const FlatHashMap &Other) {
+    if (Other.NumBuckets == 0)
+      return;
+    allocateBuckets(Other.NumBuckets);
+    std::memcpy(Ctrl, Other.Ctrl, NumBuckets);
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (Ctrl[I] >= 0)
+        ::new (&Buckets[I]) value_type(Other.Buckets[I]);
+    NumEntries = Other.NumEntries;
+    GrowthLeft = Other.GrowthLeft;
+  }
+
+  /// Returns an iterator to bucket \p I, or with \p SkipFree to the first
+  /// full bucket at or after it.
+  iterator makeIterator(unsigned I, bool SkipFree) {
+    return iterator(Ctrl + I, Ctrl + NumBuckets, Buckets + I, *this,
+                    SkipFree);
+  }
+
+  const_iterator makeConstIterator(unsigned I, bool SkipFree) const {
+    return const_iterator(Ctrl + I, Ctrl + NumBuckets, Buckets + I, *this,
+                          SkipFree);
+  }
+
+  int8_t *Ctrl = nullptr;
+  value_type *Buckets = nullptr;
+  /// Zero or a power of two that is at least Group::Width.
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  /// The number of entries that can be inserted into empty buckets before
+  /// the table is rehashed.
+  unsigned GrowthLeft = 0;
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT, bool IsConst>
+class FlatHashMapIterator : DebugEpochBase::HandleBase {
+  friend class FlatHashMap<KeyT, ValueT, KeyInfoT>;
+  friend class FlatHashMapIterator<KeyT, ValueT, KeyInfoT, true>;
+  friend class FlatHashMapIterator<KeyT, ValueT, KeyInfoT, false>;
+
+  using BucketT = detail::DenseMapPair<KeyT, ValueT>;
+
+public:
+  using difference_type = ptrdiff_t;
+  using value_type =
+      typename std::conditional<IsConst, const BucketT, BucketT>::type;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using iterator_category = std::forward_iterator_tag;
+
+  FlatHashMapIterator() = default;
+
+  // Converting ctor from non-const iterators to const iterators. SFINAE'd out
+  // for const iterator destinations so it doesn't end up as a user defined
+  // copy constructor.
+  template <bool IsConstSrc,
+            typename = typename std::enable_if<!IsConstSrc && IsConst>::type>
+  FlatHashMapIterator(
+      const FlatHashMapIterator<KeyT, ValueT, KeyInfoT, IsConstSrc> &I)
+      : DebugEpochBase::HandleBase(I), Ctrl(I.Ctrl), End(I.End),
+        Bucket(I.Bucket) {}
+
+  reference operator*() const {
+    assert(isHandleInSync() && "invalid iterator access!");
+    return *Bucket;
+  }
+  pointer operator->() const {
+    assert(isHandleInSync() && "invalid iterator access!");
+    return Bucket;
+  }
+
+  friend bool operator==(const FlatHashMapIterator &LHS,
+                         const FlatHashMapIterator &RHS) {
+    assert((!LHS.Ctrl || LHS.isHandleInSync()) && "handle not in sync!");
+    assert((!RHS.Ctrl || RHS.isHandleInSync()) && "handle not in sync!");
+    assert(LHS.getEpochAddress() == RHS.getEpochAddress() &&
+           "comparing incomparable iterators!");
+    return LHS.Ctrl == RHS.Ctrl;
+  }
+  friend bool operator!=(const FlatHashMapIterator &LHS,
+                         const FlatHashMapIterator &RHS) {
+    return !(LHS == RHS);
+  }
+
+  inline FlatHashMapIterator &operator++() { // Preincrement
+    assert(isHandleInSync() && "invalid iterator access!");
+    ++Ctrl;
+    ++Bucket;
+    skipFree();
+    return *this;
+  }
+  FlatHashMapIterator operator++(int) { // Postincrement
+    assert(isHandleInSync() && "invalid iterator access!");
+    FlatHashMapIterator Tmp = *this;
+    ++*this;
+    return Tmp;
+  }
+
+private:
+  using CtrlPtr = const int8_t *;
+  using BucketPtr =
+      typename std::conditional<IsConst, const BucketT *, BucketT *>::type;
+
+  FlatHashMapIterator(CtrlPtr C, CtrlPtr E, BucketPtr B,
+                      const DebugEpochBase &Epoch, bool SkipFree)
+      : DebugEpochBase::HandleBase(&Epoch), Ctrl(C), End(E), Bucket(B) {
+    if (SkipFree)
+      skipFree();
+  }
+
+  void skipFree() {
+    while (Ctrl != End && *Ctrl < 0) {
+      ++Ctrl;
+      ++Bucket;
+    }
+  }
+
+  CtrlPtr Ctrl = nullptr;
+  CtrlPtr End = nullptr;
+  BucketPtr Bucket = nullptr;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_FLATHASHMAP_H
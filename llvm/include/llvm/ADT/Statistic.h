@@ -58,56 +58,68 @@ public:
   const char *getDesc() const { return Desc; }
 };
 
+/// A statistic that counts at runtime.
+///
+/// Increments and decrements from threads are added to per-thread counters
+/// once the statistic is registered, so threads that bump the same statistic
+/// do not contend for its cache line. getValue() merges them. Assigning a
+/// value and updateMax() are rare and operate on Value directly.
 class TrackingStatistic : public StatisticBase {
 public:
+  /// The value of the statistic apart from the per-thread counts.
   std::atomic<unsigned> Value;
   std::atomic<bool> Initialized;
+  /// The slot of this statistic in the per-thread counters, assigned on
+  /// registration. Statistics without a slot are counted in Value.
+  std::atomic<unsigned> ShardIndex;
+
+  enum : unsigned { NoShard = ~0U };
 
   TrackingStatistic(const char *DebugType, const char *Name, const char *Desc)
-      : StatisticBase(DebugType, Name, Desc), Value(0), Initialized(false) {}
+      : StatisticBase(DebugType, Name, Desc), Value(0), Initialized(false),
+        ShardIndex(NoShard) {}
 
-  unsigned getValue() const { return Value.load(std::memory_order_relaxed); }
+  /// Returns the sum of Value and the per-thread counts. Updates from other
+  /// threads that happen concurrently may or may not be included.
+  unsigned getValue() const;
 
   // Allow use of this class as the value itself.
   operator unsigned() const { return getValue(); }
 
   const TrackingStatistic &operator=(unsigned Val) {
-    Value.store(Val, std::memory_order_relaxed);
-    return init();
+    init();
+    setValue(Val);
+    return *this;
   }
 
   const TrackingStatistic &operator++() {
-    Value.fetch_add(1, std::memory_order_relaxed);
-    return init();
+    add(1);
+    return *this;
   }
 
-  unsigned operator++(int) {
-    init();
-    return Value.fetch_add(1, std::memory_order_relaxed);
-  }
+  // The postfix operators do not return the previous value. Reading it would
+  // require merging the counts of all threads on every update.
+  void operator++(int) { add(1); }
 
   const TrackingStatistic &operator--() {
-    Value.fetch_sub(1, std::memory_order_relaxed);
-    return init();
+    add(-1U);
+    return *this;
   }
 
-  unsigned operator--(int) {
-    init();
-    return Value.fetch_sub(1, std::memory_order_relaxed);
-  }
+  void operator--(int) { add(-1U); }
 
   const TrackingStatistic &operator+=(unsigned V) {
     if (V == 0)
       return *this;
-    Value.fetch_add(V, std::memory_order_relaxed);
-    return init();
+    add(V);
+    return *this;
   }
 
   const TrackingStatistic &operator-=(unsigned V) {
     if (V == 0)
       return *this;
-    Value.fetch_sub(V, std::memory_order_relaxed);
-    return init();
+    add(-V);
+    return *this;
   }
 
   void updateMax(unsigned V) {
@@ -127,7 +139,17 @@ protected:
     return *this;
   }
 
+  void add(unsigned V) {
+    init();
+    addToShard(V);
+  }
+
   void RegisterStatistic();
+  void addToShard(unsigned V);
+
+public:
+  /// Sets the value without registering the statistic.
+  void setValue(unsigned V);
 };
 
 class NoopStatistic : public StatisticBase {
@@ -143,11 +165,11 @@ public:
 
   const NoopStatistic &operator++() { return *this; }
 
-  unsigned operator++(int) { return 0; }
+  void operator++(int) {}
 
   const NoopStatistic &operator--() { return *this; }
 
-  unsigned operator--(int) { return 0; }
+  void operator--(int) {}
 
   const NoopStatistic &operator+=(const unsigned &V) { return *this; }
 
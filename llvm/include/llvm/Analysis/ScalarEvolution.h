@@ -1125,6 +1125,11 @@ private:
   /// thare are guards present in the IR.
   bool HasGuards;
 
+  /// Has the number of unique SCEV expressions reached
+  /// -scalar-evolution-max-expressions? From then on, new values are modeled
+  /// as SCEVUnknowns.
+  bool ExpressionBudgetExhausted = false;
+
   /// The target library information for the target we are targeting.
   TargetLibraryInfo &TLI;
 
@@ -1471,6 +1476,10 @@ private:
   /// expression.
   const SCEV *createSCEV(Value *V);
 
+  /// Returns true if no more SCEV expressions should be built for new values
+  /// because -scalar-evolution-max-expressions has been reached.
+  bool isExpressionBudgetExhausted();
+
   /// Provide the special handling we need to analyze PHI SCEVs.
   const SCEV *createNodeForPHI(PHINode *PN);
 
@@ -348,6 +348,7 @@ class MachineFunction {
 
   /// With Basic Block Sections, this stores the bb ranges of cold and
   /// exception sections.
+  std::pair<int, int> EntrySectionRange = {-1, -1};
   std::pair<int, int> ColdSectionRange = {-1, -1};
   std::pair<int, int> ExceptionSectionRange = {-1, -1};
 
@@ -510,15 +511,18 @@ public:
 
   void setSectionRange();
 
-  /// Returns true if this basic block number starts a cold or exception
-  /// section.
+  /// Returns true if this basic block number starts the function, cold or
+  /// exception section.
   bool isSectionStartMBB(int N) const {
-    return (N == ColdSectionRange.first || N == ExceptionSectionRange.first);
+    return (N == EntrySectionRange.first || N == ColdSectionRange.first ||
+            N == ExceptionSectionRange.first);
   }
 
-  /// Returns true if this basic block ends a cold or exception section.
+  /// Returns true if this basic block ends the function, cold or exception
+  /// section.
   bool isSectionEndMBB(int N) const {
-    return (N == ColdSectionRange.second || N == ExceptionSectionRange.second);
+    return (N == EntrySectionRange.second || N == ColdSectionRange.second ||
+            N == ExceptionSectionRange.second);
   }
 
   /// Creates basic block Labels for this function.
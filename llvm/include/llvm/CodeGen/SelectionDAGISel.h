@@ -175,7 +175,10 @@ public:
     OPC_MorphNodeTo0, OPC_MorphNodeTo1, OPC_MorphNodeTo2,
     OPC_CompleteMatch,
     // Contains offset in table for pattern being selected
-    OPC_Coverage
+    OPC_Coverage,
+    // Space-optimized forms of OPC_CheckType for the most common types. They
+    // are kept after the existing opcodes so that those keep their values.
+    OPC_CheckTypeI32, OPC_CheckTypeI64
   };
 
   enum {
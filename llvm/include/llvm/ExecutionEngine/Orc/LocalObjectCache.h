@@ -0,0 +1,66 @@
+//===- LocalObjectCache.h - On-disk object cache for the JIT ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps compiled objects in a directory on disk, so that
+// they can be reused across processes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+/// An ObjectCache that stores objects as files in a cache directory, keyed by
+/// a hash of the module's bitcode and a caller-provided configuration key.
+///
+/// The configuration key must identify everything besides the IR that affects
+/// the generated code, e.g. the target triple, CPU, features and optimization
+/// level. Entries are written atomically, so several processes may share one
+/// directory. The directory is pruned according to the given policy when the
+/// cache is created; see pruneCache() in llvm/Support/CachePruning.h.
+///
+/// Pass an instance to SimpleCompiler or ConcurrentIRCompiler, e.g. through
+/// LLJITBuilder::setCompileFunctionCreator.
+class LocalObjectCache : public ObjectCache {
+public:
+  static Expected<std::unique_ptr<LocalObjectCache>>
+  Create(StringRef CacheDir, StringRef ConfigKey,
+         CachePruningPolicy Policy = CachePruningPolicy());
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+private:
+  LocalObjectCache(StringRef CacheDir, StringRef ConfigKey)
+      : CacheDir(CacheDir), ConfigKey(ConfigKey) {}
+
+  std::string computeEntryPath(const Module &M) const;
+
+  std::string CacheDir;
+  std::string ConfigKey;
+
+  // Entry paths of modules that missed in getObject, so notifyObjectCompiled
+  // does not have to hash them again.
+  std::mutex PendingMutex;
+  DenseMap<const Module *, std::string> PendingEntries;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
@@ -24,6 +24,7 @@
 namespace llvm {
 
 class DiagnosticInfo;
+class DiagnosticInfoOptimizationBase;
 enum DiagnosticSeverity : char;
 class Function;
 class Instruction;
@@ -138,6 +139,14 @@ public:
   /// especially in release mode.
   void setDiscardValueNames(bool Discard);
 
+  /// Whether types can be created and looked up from multiple threads at the
+  /// same time. Off by default. Only the type factories, such as
+  /// IntegerType::get() and StructType::create(), and type name lookups are
+  /// synchronized; constants, metadata and all other IR still must not be
+  /// created concurrently.
+  bool hasThreadSafeTypes() const;
+  void setThreadSafeTypes(bool ThreadSafe);
+
   /// Whether there is a string map for uniquing debug info
   /// identifiers across the context.  Off by default.
   bool isODRUniquingDebugTypes() const;
@@ -260,6 +269,12 @@ public:
   /// "warning: " for \a DS_Warning, and "note: " for \a DS_Note.
   void diagnose(const DiagnosticInfo &DI);
 
+  /// Return true if diagnose() would drop \p Remark: the remark streamer's
+  /// filter rejects it, the remark is not enabled, and the diagnostic handler
+  /// only gets enabled remarks. Callers can then skip the work to emit it,
+  /// e.g. computing its hotness.
+  bool isRemarkDiscarded(const DiagnosticInfoOptimizationBase &Remark) const;
+
   /// Registers a yield callback with the given context.
   ///
   /// The yield callback function may be called by LLVM to transfer control back
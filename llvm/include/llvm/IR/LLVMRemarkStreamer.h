@@ -35,6 +35,10 @@ public:
   LLVMRemarkStreamer(remarks::RemarkStreamer &RS) : RS(RS) {}
   /// Emit a diagnostic through the streamer.
   void emit(const DiagnosticInfoOptimizationBase &Diag);
+  /// Check whether remarks emitted by \p PassName are kept by the filter.
+  bool matchesFilter(StringRef PassName) const {
+    return RS.matchesFilter(PassName);
+  }
 };
 
 template <typename ThisError>
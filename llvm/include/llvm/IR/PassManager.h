@@ -1178,6 +1178,13 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// Functions are visited one at a time. Running the function pipeline on
+/// several functions concurrently is not supported: passes create constants,
+/// types and metadata in the shared LLVMContext, and they update the use lists
+/// of constants and globals, none of which is synchronized. The
+/// FunctionAnalysisManager cache and the PassInstrumentation callbacks are
+/// shared between functions as well.
 template <typename FunctionPassT>
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor<FunctionPassT>> {
@@ -0,0 +1,84 @@
+//===- BLAKE3.h - BLAKE3 hash function --------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the BLAKE3 hash function. BLAKE3 splits its input into
+// 1 KiB chunks and combines their hashes in a binary tree, so the chunks of a
+// large input can be hashed with SIMD instructions and on multiple threads
+// without changing the result.
+//
+// See https://github.com/BLAKE3-team/BLAKE3-specs for the specification.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_BLAKE3_H
+#define LLVM_SUPPORT_BLAKE3_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <array>
+#include <cstdint>
+
+namespace llvm {
+
+class BLAKE3 {
+public:
+  BLAKE3() { init(); }
+
+  /// Reinitialize the internal state.
+  void init();
+
+  /// Digest more data.
+  void update(ArrayRef<uint8_t> Data);
+
+  /// Digest more data.
+  void update(StringRef Str) {
+    update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(Str.data()),
+                             Str.size()));
+  }
+
+  /// Return the 256-bit BLAKE3 hash of the data digested since the last call
+  /// to init(). The internal state is not modified, so more data can be
+  /// digested afterwards.
+  std::array<uint8_t, 32> final() const;
+
+  /// Returns the 256-bit BLAKE3 hash of the given data.
+  static std::array<uint8_t, 32> hash(ArrayRef<uint8_t> Data);
+
+  /// Returns the same hash as hash(), but hashes large inputs using the
+  /// threads of llvm::parallel.
+  static std::array<uint8_t, 32> parallelHash(ArrayRef<uint8_t> Data);
+
+private:
+  enum { BLOCK_LENGTH = 64 };
+  enum { CHUNK_LENGTH = 1024 };
+  // Enough for 2^54 chunks, which is 2^64 bytes.
+  enum { MAX_DEPTH = 54 };
+
+  void resetChunk(uint64_t Counter);
+  void pushChainingValue(const uint32_t CV[8], uint64_t TotalSubtrees);
+  size_t chunkLength() const {
+    return BlocksCompressed * BLOCK_LENGTH + BlockLength;
+  }
+
+  // The chunk being hashed.
+  uint32_t ChunkCV[8];
+  uint64_t ChunkCounter;
+  uint8_t Block[BLOCK_LENGTH];
+  unsigned BlockLength;
+  unsigned BlocksCompressed;
+
+  // The chaining values of the completed subtrees, from the largest to the
+  // smallest.
+  uint32_t CVStack[MAX_DEPTH][8];
+  unsigned CVStackLength;
+};
+
+} // end namespace llvm
+
+#endif
@@ -18,12 +18,12 @@
 
 namespace llvm {
 
-/// Utility function to encode a SLEB128 value to an output stream. Returns
+/// Utility function to encode a SLEB128 value to a buffer. Returns
 /// the length in bytes of the encoded value.
-inline unsigned encodeSLEB128(int64_t Value, raw_ostream &OS,
-                              unsigned PadTo = 0) {
-  bool More;
+inline unsigned encodeSLEB128(int64_t Value, uint8_t *p, unsigned PadTo = 0) {
+  uint8_t *orig_p = p;
   unsigned Count = 0;
+  bool More;
   do {
     uint8_t Byte = Value & 0x7f;
     // NOTE: this assumes that this signed shift is an arithmetic right shift.
@@ -33,26 +33,33 @@ inline unsigned encodeSLEB128(int64_t Value, raw_ostream &OS,
     Count++;
     if (More || Count < PadTo)
       Byte |= 0x80; // Mark this byte to show that more bytes will follow.
-    OS << char(Byte);
+    *p++ = Byte;
   } while (More);
 
   // Pad with 0x80 and emit a terminating byte at the end.
   if (Count < PadTo) {
     uint8_t PadValue = Value < 0 ? 0x7f : 0x00;
     for (; Count < PadTo - 1; ++Count)
-      OS << char(PadValue | 0x80);
-    OS << char(PadValue);
-    Count++;
+      *p++ = (PadValue | 0x80);
+    *p++ = PadValue;
   }
-  return Count;
+  return (unsigned)(p - orig_p);
 }
 
-/// Utility function to encode a SLEB128 value to a buffer. Returns
+/// Utility function to encode a SLEB128 value to an output stream. Returns
 /// the length in bytes of the encoded value.
-inline unsigned encodeSLEB128(int64_t Value, uint8_t *p, unsigned PadTo = 0) {
-  uint8_t *orig_p = p;
-  unsigned Count = 0;
+inline unsigned encodeSLEB128(int64_t Value, raw_ostream &OS,
+                              unsigned PadTo = 0) {
+  // Encode into a local buffer so that the value is written with one call.
+  uint8_t Buffer[16];
+  if (PadTo <= sizeof(Buffer)) {
+    unsigned Count = encodeSLEB128(Value, Buffer, PadTo);
+    OS.write(reinterpret_cast<const char *>(Buffer), Count);
+    return Count;
+  }
+
   bool More;
+  unsigned Count = 0;
   do {
     uint8_t Byte = Value & 0x7f;
     // NOTE: this assumes that this signed shift is an arithmetic right shift.
@@ -62,23 +69,25 @@ inline unsigned encodeSLEB128(int64_t Value, uint8_t *p, unsigned PadTo = 0) {
     Count++;
     if (More || Count < PadTo)
       Byte |= 0x80; // Mark this byte to show that more bytes will follow.
-    *p++ = Byte;
+    OS << char(Byte);
   } while (More);
 
   // Pad with 0x80 and emit a terminating byte at the end.
   if (Count < PadTo) {
     uint8_t PadValue = Value < 0 ? 0x7f : 0x00;
     for (; Count < PadTo - 1; ++Count)
-      *p++ = (PadValue | 0x80);
-    *p++ = PadValue;
+      OS << char(PadValue | 0x80);
+    OS << char(PadValue);
+    Count++;
   }
-  return (unsigned)(p - orig_p);
+  return Count;
 }
 
-/// Utility function to encode a ULEB128 value to an output stream. Returns
+/// Utility function to encode a ULEB128 value to a buffer. Returns
 /// the length in bytes of the encoded value.
-inline unsigned encodeULEB128(uint64_t Value, raw_ostream &OS,
+inline unsigned encodeULEB128(uint64_t Value, uint8_t *p,
                               unsigned PadTo = 0) {
+  uint8_t *orig_p = p;
   unsigned Count = 0;
   do {
     uint8_t Byte = Value & 0x7f;
@@ -86,24 +95,31 @@ inline unsigned encodeULEB128(uint64_t Value, raw_ostream &OS,
     Count++;
     if (Value != 0 || Count < PadTo)
       Byte |= 0x80; // Mark this byte to show that more bytes will follow.
-    OS << char(Byte);
+    *p++ = Byte;
   } while (Value != 0);
 
   // Pad with 0x80 and emit a null byte at the end.
   if (Count < PadTo) {
     for (; Count < PadTo - 1; ++Count)
-      OS << '\x80';
-    OS << '\x00';
-    Count++;
+      *p++ = '\x80';
+    *p++ = '\x00';
   }
-  return Count;
+
+  return (unsigned)(p - orig_p);
 }
 
-/// Utility function to encode a ULEB128 value to a buffer. Returns
+/// Utility function to encode a ULEB128 value to an output stream. Returns
 /// the length in bytes of the encoded value.
-inline unsigned encodeULEB128(uint64_t Value, uint8_t *p,
+inline unsigned encodeULEB128(uint64_t Value, raw_ostream &OS,
                               unsigned PadTo = 0) {
-  uint8_t *orig_p = p;
+  // Encode into a local buffer so that the value is written with one call.
+  uint8_t Buffer[16];
+  if (PadTo <= sizeof(Buffer)) {
+    unsigned Count = encodeULEB128(Value, Buffer, PadTo);
+    OS.write(reinterpret_cast<const char *>(Buffer), Count);
+    return Count;
+  }
+
   unsigned Count = 0;
   do {
     uint8_t Byte = Value & 0x7f;
@@ -111,17 +127,17 @@ inline unsigned encodeULEB128(uint64_t Value, uint8_t *p,
     Count++;
     if (Value != 0 || Count < PadTo)
       Byte |= 0x80; // Mark this byte to show that more bytes will follow.
-    *p++ = Byte;
+    OS << char(Byte);
   } while (Value != 0);
 
   // Pad with 0x80 and emit a null byte at the end.
   if (Count < PadTo) {
     for (; Count < PadTo - 1; ++Count)
-      *p++ = '\x80';
-    *p++ = '\x00';
+      OS << '\x80';
+    OS << '\x00';
+    Count++;
   }
-
-  return (unsigned)(p - orig_p);
+  return Count;
 }
 
 /// Utility function to decode a ULEB128 value.
@@ -0,0 +1,84 @@
+//===- MappedFileCache.h - Shared buffers of unchanged files ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines MappedFileCache, which lets code in one process share the
+/// memory buffers of files that are opened repeatedly, such as headers read by
+/// several in-process compilations.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_MAPPEDFILECACHE_H
+#define LLVM_SUPPORT_MAPPEDFILECACHE_H
+
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace llvm {
+
+class MemoryBuffer;
+class Twine;
+
+/// A cache of file buffers keyed by file identity, modification time and size.
+///
+/// A buffer returned by getOpenFile() shares its memory with every other live
+/// buffer of the same unchanged file, so opening a file that is still in use
+/// costs a stat instead of a new mapping. The cache holds no reference of its
+/// own: the memory is released when the last buffer of a file is destroyed.
+///
+/// As with any non-volatile MemoryBuffer, files must not be modified in place
+/// while they are in use. A file that is rewritten gets a new modification
+/// time and is mapped again.
+class MappedFileCache {
+public:
+  MappedFileCache() = default;
+  MappedFileCache(const MappedFileCache &) = delete;
+  MappedFileCache &operator=(const MappedFileCache &) = delete;
+  ~MappedFileCache();
+
+  /// Returns the cache shared by the whole process.
+  static MappedFileCache &getProcessCache();
+
+  /// Returns a buffer with the contents of the already-open regular file
+  /// \p FD. Files that are not regular files are read without caching.
+  ErrorOr<std::unique_ptr<MemoryBuffer>>
+  getOpenFile(sys::fs::file_t FD, const Twine &Filename,
+              bool RequiresNullTerminator = true);
+
+  /// Returns the number of files whose buffers are in use.
+  size_t size() const;
+
+private:
+  struct Entry;
+  class SharedBuffer;
+
+  struct Key {
+    sys::fs::UniqueID ID;
+    sys::TimePoint<> ModificationTime;
+    uint64_t Size;
+
+    bool operator<(const Key &Other) const {
+      return std::tie(ID, ModificationTime, Size) <
+             std::tie(Other.ID, Other.ModificationTime, Other.Size);
+    }
+  };
+
+  void erase(const Key &K);
+
+  mutable std::mutex Mutex;
+  std::map<Key, std::weak_ptr<Entry>> Entries;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_MAPPEDFILECACHE_H
@@ -15,6 +15,7 @@
 #include "llvm/Support/Threading.h"
 
 #include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -67,19 +68,25 @@ public:
     std::unique_lock<std::mutex> lock(Mutex);
     Cond.wait(lock, [&] { return Count == 0; });
   }
+
+  /// Waits for at most \p Timeout. Returns true if the count is zero.
+  bool syncFor(std::chrono::microseconds Timeout) const {
+    std::unique_lock<std::mutex> lock(Mutex);
+    return Cond.wait_for(lock, Timeout, [&] { return Count == 0; });
+  }
 };
 
 class TaskGroup {
   Latch L;
-  bool Parallel;
 
 public:
-  TaskGroup();
   ~TaskGroup();
 
   void spawn(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  /// Waits for all spawned tasks. On a worker thread of the default executor,
+  /// this runs pending tasks while waiting.
+  void sync() const;
 };
 
 const ptrdiff_t MinParallelSize = 1024;
@@ -150,8 +157,11 @@ void parallel_for_each(IterTy Begin, IterTy End, FuncTy Fn) {
 }
 
 template <class IndexTy, class FuncTy>
-void parallel_for_each_n(IndexTy Begin, IndexTy End, FuncTy Fn) {
-  ptrdiff_t TaskSize = (End - Begin) / 1024;
+void parallel_for_each_n(IndexTy Begin, IndexTy End, FuncTy Fn,
+                         size_t GrainSize) {
+  // Each task processes at least GrainSize indices, so that loops with cheap
+  // bodies are not dominated by the cost of creating tasks.
+  ptrdiff_t TaskSize = std::max<ptrdiff_t>((End - Begin) / 1024, GrainSize);
   if (TaskSize == 0)
     TaskSize = 1;
 
@@ -193,7 +203,8 @@ void for_each(Policy policy, IterTy Begin, IterTy End, FuncTy Fn) {
 }
 
 template <class Policy, class IndexTy, class FuncTy>
-void for_each_n(Policy policy, IndexTy Begin, IndexTy End, FuncTy Fn) {
+void for_each_n(Policy policy, IndexTy Begin, IndexTy End, FuncTy Fn,
+                size_t GrainSize = 0) {
   static_assert(is_execution_policy<Policy>::value,
                 "Invalid execution policy!");
   for (IndexTy I = Begin; I != End; ++I)
@@ -216,10 +227,12 @@ void for_each(parallel_execution_policy policy, IterTy Begin, IterTy End,
   detail::parallel_for_each(Begin, End, Fn);
 }
 
+/// Calls \p Fn for each index in [\p Begin, \p End). Indices are processed
+/// in tasks of at least \p GrainSize indices.
 template <class IndexTy, class FuncTy>
 void for_each_n(parallel_execution_policy policy, IndexTy Begin, IndexTy End,
-                FuncTy Fn) {
-  detail::parallel_for_each_n(Begin, End, Fn);
+                FuncTy Fn, size_t GrainSize = 0) {
+  detail::parallel_for_each_n(Begin, End, Fn, GrainSize);
 }
 #endif
 
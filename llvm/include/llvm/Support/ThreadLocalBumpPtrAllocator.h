@@ -0,0 +1,95 @@
+//===- ThreadLocalBumpPtrAllocator.h - Per-thread bump allocation -*- C++ -*-=//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines ThreadLocalBumpPtrAllocator, a BumpPtrAllocator that can
+/// be used by several threads at once. Each thread allocates from its own
+/// BumpPtrAllocator, so allocation does not take a lock. As with
+/// BumpPtrAllocator, the lifetime of all objects is tied to the lifetime of
+/// the allocator.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_THREADLOCALBUMPPTRALLOCATOR_H
+#define LLVM_SUPPORT_THREADLOCALBUMPPTRALLOCATOR_H
+
+#include "llvm/Support/Allocator.h"
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+
+/// A bump pointer allocator with one arena per thread.
+///
+/// Allocate() may be called concurrently from any number of threads. Each
+/// thread remembers the arena it used last, so a thread that keeps using the
+/// same allocator finds its arena without taking a lock. Reset() and the
+/// statistics functions aggregate over all arenas and must not be called
+/// while other threads allocate.
+class ThreadLocalBumpPtrAllocator
+    : public AllocatorBase<ThreadLocalBumpPtrAllocator> {
+public:
+  ThreadLocalBumpPtrAllocator();
+  ThreadLocalBumpPtrAllocator(const ThreadLocalBumpPtrAllocator &) = delete;
+  ThreadLocalBumpPtrAllocator &
+  operator=(const ThreadLocalBumpPtrAllocator &) = delete;
+  ~ThreadLocalBumpPtrAllocator();
+
+  /// Allocate space at the specified alignment from the arena of the calling
+  /// thread.
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                Align Alignment) {
+    return getThreadAllocator().Allocate(Size, Alignment);
+  }
+
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                size_t Alignment) {
+    assert(Alignment > 0 && "0-byte alignment is not allowed. Use 1 instead.");
+    return Allocate(Size, Align(Alignment));
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<ThreadLocalBumpPtrAllocator>::Allocate;
+
+  // Bump pointer allocators are expected to never free their storage; and
+  // clients expect pointers to remain valid for non-dereferencing uses even
+  // after deallocation.
+  void Deallocate(const void *Ptr, size_t Size) {}
+
+  // Pull in base class overloads.
+  using AllocatorBase<ThreadLocalBumpPtrAllocator>::Deallocate;
+
+  /// Returns the arena of the calling thread.
+  BumpPtrAllocator &getThreadAllocator();
+
+  /// Frees all memory allocated so far by all threads.
+  void Reset();
+
+  size_t getTotalMemory() const;
+  size_t getBytesAllocated() const;
+  unsigned getNumThreadAllocators() const;
+  void PrintStats() const;
+
+private:
+  BumpPtrAllocator &getThreadAllocatorSlow();
+
+  /// A unique identifier of this allocator, which is never reused. Threads
+  /// cache the arena of the allocator they used last by this identifier.
+  const uint64_t ID;
+
+  mutable std::mutex Mutex;
+  std::vector<std::pair<std::thread::id, std::unique_ptr<BumpPtrAllocator>>>
+      Allocators;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_THREADLOCALBUMPPTRALLOCATOR_H
@@ -13,6 +13,7 @@
 #ifndef LLVM_SUPPORT_THREAD_POOL_H
 #define LLVM_SUPPORT_THREAD_POOL_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/BitVector.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Threading.h"
@@ -27,6 +28,7 @@
 #include <mutex>
 #include <queue>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -35,11 +37,40 @@ namespace llvm {
 ///
 /// The pool keeps a vector of threads alive, waiting on a condition variable
 /// for some work to become available.
+///
+/// Tasks can be given a priority and a list of tasks they depend on. A task
+/// becomes ready when all of its dependencies have finished. Among the ready
+/// tasks, the ones with the highest priority run first, and tasks of equal
+/// priority run in submission order. This allows pipelines to be expressed
+/// without blocking worker threads at dependency boundaries.
 class ThreadPool {
+  struct TaskNode;
+
 public:
   using TaskTy = std::function<void()>;
   using PackagedTaskTy = std::packaged_task<void()>;
 
+  enum class Priority { Low, Normal, High };
+
+  /// A handle to a task submitted with schedule(), which can be used as a
+  /// dependency of other tasks and to wait for the task to finish.
+  class TaskRef {
+  public:
+    TaskRef() = default;
+
+    const std::shared_future<void> &getFuture() const { return Future; }
+    void wait() const { Future.wait(); }
+    bool valid() const { return Future.valid(); }
+
+  private:
+    friend class ThreadPool;
+    TaskRef(std::shared_ptr<TaskNode> Node, std::shared_future<void> Future)
+        : Node(std::move(Node)), Future(std::move(Future)) {}
+
+    std::shared_ptr<TaskNode> Node;
+    std::shared_future<void> Future;
+  };
+
   /// Construct a pool using the hardware strategy \p S for mapping hardware
   /// execution resources (threads, cores, CPUs)
   /// Defaults to using the maximum execution resources in the system, but
@@ -65,34 +96,74 @@ public:
     return asyncImpl(std::forward<Function>(F));
   }
 
+  /// Submit \p F to run with priority \p P once all tasks in \p Deps have
+  /// finished. Dependencies must have been scheduled on this pool.
+  TaskRef schedule(TaskTy F, ArrayRef<TaskRef> Deps = {},
+                   Priority P = Priority::Normal);
+
+  /// Submit \p F to run once \p Dep has finished.
+  TaskRef then(const TaskRef &Dep, TaskTy F, Priority P = Priority::Normal) {
+    return schedule(std::move(F), Dep, P);
+  }
+
   /// Blocking wait for all the threads to complete and the queue to be empty.
-  /// It is an error to try to add new tasks while blocking on this call.
+  /// Tasks waiting for their dependencies are waited for as well. It is an
+  /// error to try to add new tasks while blocking on this call.
   void wait();
 
   unsigned getThreadCount() const { return ThreadCount; }
 
 private:
+  struct TaskNode {
+    PackagedTaskTy Task;
+    Priority P;
+    uint64_t Seq;
+    /// Number of dependencies that have not finished yet.
+    unsigned PendingDeps = 0;
+    bool Done = false;
+    /// Tasks waiting for this task.
+    std::vector<std::shared_ptr<TaskNode>> Successors;
+  };
+
+  /// Orders the ready queue so that the top is the task to run next.
+  struct CompareNodes {
+    bool operator()(const std::shared_ptr<TaskNode> &A,
+                    const std::shared_ptr<TaskNode> &B) const {
+      if (A->P != B->P)
+        return A->P < B->P;
+      return A->Seq > B->Seq;
+    }
+  };
+
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
   std::shared_future<void> asyncImpl(TaskTy F);
 
+  /// Runs a ready task and releases the tasks depending on it.
+  void runTask(std::shared_ptr<TaskNode> Node);
+
   /// Threads in flight
   std::vector<llvm::thread> Threads;
 
-  /// Tasks waiting for execution in the pool.
-  std::queue<PackagedTaskTy> Tasks;
+  /// Tasks ready for execution in the pool.
+  std::priority_queue<std::shared_ptr<TaskNode>,
+                      std::vector<std::shared_ptr<TaskNode>>, CompareNodes>
+      Tasks;
 
-  /// Locking and signaling for accessing the Tasks queue.
+  /// Number of submitted tasks that have not finished, including tasks
+  /// waiting for dependencies and running tasks.
+  size_t Unfinished = 0;
+
+  /// Submission counter, used to keep FIFO order among equal priorities.
+  uint64_t NextSeq = 0;
+
+  /// Locking and signaling for accessing the Tasks queue and the task graph.
   std::mutex QueueLock;
   std::condition_variable QueueCondition;
 
-  /// Locking and signaling for job completion
-  std::mutex CompletionLock;
+  /// Signaling for job completion, guarded by QueueLock.
   std::condition_variable CompletionCondition;
 
-  /// Keep track of the number of thread actually busy
-  std::atomic<unsigned> ActiveThreads;
-
 #if LLVM_ENABLE_THREADS // avoids warning for unused variable
   /// Signal for the destruction of the pool, asking thread to exit.
   bool EnableFlag;
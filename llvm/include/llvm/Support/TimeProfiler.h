@@ -19,9 +19,12 @@ TimeTraceProfiler *getTimeTraceProfilerInstance();
 
 /// Initialize the time trace profiler.
 /// This sets up the global \p TimeTraceProfilerInstance
-/// variable to be the profiler instance.
+/// variable to be the profiler instance. If \p MaxEntries is not zero, only
+/// the most recent \p MaxEntries sections are kept, which bounds the memory
+/// used by a profiler that is always enabled. The totals per section name
+/// still cover the whole run.
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                 StringRef ProcName);
+                                 StringRef ProcName, size_t MaxEntries = 0);
 
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
@@ -58,6 +61,16 @@ void timeTraceProfilerBegin(StringRef Name,
 /// Manually end the last time section.
 void timeTraceProfilerEnd();
 
+/// Record the current value of the counter \p Name. Counters are emitted as
+/// Chrome "C" events and displayed as a graph over time.
+void timeTraceProfilerCounter(StringRef Name, int64_t Value);
+
+/// Add an entry to the "otherData" dictionary of the trace, which is used to
+/// attach information about the profiled process as a whole. An existing
+/// entry with the same \p Key is replaced. Only entries added on the thread
+/// that initialized the profiler are written.
+void timeTraceProfilerAddMetadata(StringRef Key, StringRef Value);
+
 /// The TimeTraceScope is a helper class to call the begin and end functions
 /// of the time trace profiler.  When the object is constructed, it begins
 /// the section; and when it is destroyed, it stops it. If the time profiler
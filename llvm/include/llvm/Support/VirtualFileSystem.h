@@ -18,6 +18,7 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/Chrono.h"
@@ -37,6 +38,7 @@
 
 namespace llvm {
 
+class MappedFileCache;
 class MemoryBuffer;
 
 namespace vfs {
@@ -306,7 +308,10 @@ IntrusiveRefCntPtr<FileSystem> getRealFileSystem();
 /// the operating system.
 /// It has its own working directory, independent of (but initially equal to)
 /// that of the process.
-std::unique_ptr<FileSystem> createPhysicalFileSystem();
+/// If \p Cache is set, buffers of files that are not volatile are shared
+/// through it, e.g. with MappedFileCache::getProcessCache().
+std::unique_ptr<FileSystem>
+createPhysicalFileSystem(MappedFileCache *Cache = nullptr);
 
 /// A file system that allows overlaying one \p AbstractFileSystem on top
 /// of another.
@@ -593,21 +598,40 @@ public:
     std::vector<std::unique_ptr<Entry>> Contents;
     Status S;
 
+    /// The entries in Contents by their lowercased name, in the order they
+    /// were added, so that directories with many entries can be searched
+    /// without comparing against every name.
+    StringMap<SmallVector<Entry *, 1>> ContentsByName;
+    /// Whether some entry is named in a way that only a walk of all the
+    /// contents finds, e.g. with an empty name.
+    bool HasUnindexedContents = false;
+
+    void indexContent(Entry *Content);
+
   public:
     RedirectingDirectoryEntry(StringRef Name,
                               std::vector<std::unique_ptr<Entry>> Contents,
                               Status S)
         : Entry(EK_Directory, Name), Contents(std::move(Contents)),
-          S(std::move(S)) {}
+          S(std::move(S)) {
+      for (const std::unique_ptr<Entry> &Content : this->Contents)
+        indexContent(Content.get());
+    }
     RedirectingDirectoryEntry(StringRef Name, Status S)
         : Entry(EK_Directory, Name), S(std::move(S)) {}
 
     Status getStatus() { return S; }
 
     void addContent(std::unique_ptr<Entry> Content) {
+      indexContent(Content.get());
       Contents.push_back(std::move(Content));
     }
 
+    /// Returns the entries whose name matches \p Name ignoring case, in the
+    /// order they were added, or None if all the contents have to be walked
+    /// instead.
+    Optional<ArrayRef<Entry *>> lookupContents(StringRef Name) const;
+
     Entry *getLastContent() const { return Contents.back().get(); }
 
     using iterator = decltype(Contents)::iterator;
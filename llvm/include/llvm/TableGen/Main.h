@@ -24,6 +24,16 @@ using TableGenMainFn = bool (raw_ostream &OS, RecordKeeper &Records);
 
 int TableGenMain(char *argv0, TableGenMainFn *MainFn);
 
+/// Perform the action with index ActionIdx using Records, and write output to
+/// OS. Returns true on error, false otherwise.
+using TableGenMultiMainFn = bool(raw_ostream &OS, RecordKeeper &Records,
+                                 unsigned ActionIdx);
+
+/// Parse the input once and perform NumActions actions on the result. The
+/// output of the first action goes to the -o file, and the output of each
+/// further action goes to the next -extra-output file.
+int TableGenMain(char *argv0, TableGenMultiMainFn *MainFn, unsigned NumActions);
+
 } // end namespace llvm
 
 #endif // LLVM_TABLEGEN_MAIN_H
@@ -1874,6 +1874,10 @@ struct AbstractAttribute {
   virtual const std::string getAsStr() const = 0;
   ///}
 
+  /// This function should return the name of the abstract attribute kind, e.g.
+  /// for time trace entries.
+  virtual StringRef getName() const = 0;
+
   /// Allow the Attributor access to the protected methods.
   friend struct Attributor;
 
@@ -1980,6 +1984,9 @@ struct AAReturnedValues
   static AAReturnedValues &createForPosition(const IRPosition &IRP,
                                              Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAReturnedValues"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -1998,6 +2005,9 @@ struct AANoUnwind
   /// Create an abstract attribute view for the position \p IRP.
   static AANoUnwind &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoUnwind"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2016,6 +2026,9 @@ struct AANoSync
   /// Create an abstract attribute view for the position \p IRP.
   static AANoSync &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoSync"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2035,6 +2048,9 @@ struct AANonNull
   /// Create an abstract attribute view for the position \p IRP.
   static AANonNull &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANonNull"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2054,6 +2070,9 @@ struct AANoRecurse
   /// Create an abstract attribute view for the position \p IRP.
   static AANoRecurse &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoRecurse"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2073,6 +2092,9 @@ struct AAWillReturn
   /// Create an abstract attribute view for the position \p IRP.
   static AAWillReturn &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAWillReturn"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2102,6 +2124,9 @@ struct AAUndefinedBehavior
   static AAUndefinedBehavior &createForPosition(const IRPosition &IRP,
                                                 Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAUndefinedBehavior"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2133,6 +2158,9 @@ struct AAReachability : public StateWrapper<BooleanState, AbstractAttribute>,
   static AAReachability &createForPosition(const IRPosition &IRP,
                                            Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAReachability"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2152,6 +2180,9 @@ struct AANoAlias
   /// Create an abstract attribute view for the position \p IRP.
   static AANoAlias &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoAlias"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2171,6 +2202,9 @@ struct AANoFree
   /// Create an abstract attribute view for the position \p IRP.
   static AANoFree &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoFree"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2190,6 +2224,9 @@ struct AANoReturn
   /// Create an abstract attribute view for the position \p IRP.
   static AANoReturn &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoReturn"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2247,6 +2284,9 @@ public:
     return F.hasPersonalityFn() && !canSimplifyInvokeNoUnwind(&F);
   }
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAIsDead"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 
@@ -2427,6 +2467,9 @@ struct AADereferenceable
   static AADereferenceable &createForPosition(const IRPosition &IRP,
                                               Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AADereferenceable"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2448,6 +2491,9 @@ struct AAAlign : public IRAttribute<
   /// Create an abstract attribute view for the position \p IRP.
   static AAAlign &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAAlign"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2499,6 +2545,9 @@ struct AANoCapture
   /// Create an abstract attribute view for the position \p IRP.
   static AANoCapture &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AANoCapture"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2520,6 +2569,9 @@ struct AAValueSimplify : public StateWrapper<BooleanState, AbstractAttribute>,
   static AAValueSimplify &createForPosition(const IRPosition &IRP,
                                             Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAValueSimplify"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2540,6 +2592,9 @@ struct AAHeapToStack : public StateWrapper<BooleanState, AbstractAttribute>,
   /// Create an abstract attribute view for the position \p IRP.
   static AAHeapToStack &createForPosition(const IRPosition &IRP, Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAHeapToStack"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2579,6 +2634,9 @@ struct AAPrivatizablePtr : public StateWrapper<BooleanState, AbstractAttribute>,
   static AAPrivatizablePtr &createForPosition(const IRPosition &IRP,
                                               Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAPrivatizablePtr"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2630,6 +2688,9 @@ struct AAMemoryBehavior
   static AAMemoryBehavior &createForPosition(const IRPosition &IRP,
                                              Attributor &A);
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAMemoryBehavior"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2788,6 +2849,9 @@ struct AAMemoryLocation
     return getMemoryLocationsAsStr(getAssumedNotAccessedLocation());
   }
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAMemoryLocation"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
@@ -2837,6 +2901,9 @@ struct AAValueConstantRange : public IntegerRangeState,
     return nullptr;
   }
 
+  /// See AbstractAttribute::getName()
+  StringRef getName() const override { return "AAValueConstantRange"; }
+
   /// Unique ID (due to the unique address)
   static const char ID;
 };
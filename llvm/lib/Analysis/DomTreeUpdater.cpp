@@ -13,6 +13,7 @@
 
 #include "llvm/Analysis/DomTreeUpdater.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/Support/GenericDomTree.h"
@@ -20,6 +21,13 @@
 #include <functional>
 #include <utility>
 
+#define DEBUG_TYPE "domtree-updater"
+
+STATISTIC(NumRecalculations,
+          "Number of dominator trees recalculated by DomTreeUpdater");
+STATISTIC(NumIncrementalUpdates,
+          "Number of CFG updates applied incrementally by DomTreeUpdater");
+
 namespace llvm {
 
 bool DomTreeUpdater::isUpdateValid(
@@ -65,6 +73,7 @@ void DomTreeUpdater::applyDomTreeUpdates() {
     const auto I = PendUpdates.begin() + PendDTUpdateIndex;
     const auto E = PendUpdates.end();
     assert(I < E && "Iterator range invalid; there should be DomTree updates.");
+    NumIncrementalUpdates += E - I;
     DT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
     PendDTUpdateIndex = PendUpdates.size();
   }
@@ -87,6 +96,7 @@ void DomTreeUpdater::applyPostDomTreeUpdates() {
     const auto E = PendUpdates.end();
     assert(I < E &&
            "Iterator range invalid; there should be PostDomTree updates.");
+    NumIncrementalUpdates += E - I;
     PDT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
     PendPDTUpdateIndex = PendUpdates.size();
   }
@@ -119,6 +129,7 @@ bool DomTreeUpdater::forceFlushDeletedBB() {
 }
 
 void DomTreeUpdater::recalculate(Function &F) {
+  NumRecalculations += bool(DT) + bool(PDT);
 
   if (Strategy == UpdateStrategy::Eager) {
     if (DT)
@@ -240,6 +251,7 @@ void DomTreeUpdater::applyUpdates(ArrayRef<DominatorTree::UpdateType> Updates) {
     return;
   }
 
+  NumIncrementalUpdates += Updates.size() * (bool(DT) + bool(PDT));
   if (DT)
     DT->applyUpdates(Updates);
   if (PDT)
@@ -294,6 +306,8 @@ void DomTreeUpdater::applyUpdatesPermissive(
   if (Strategy == UpdateStrategy::Lazy)
     return;
 
+  NumIncrementalUpdates +=
+      DeduplicatedUpdates.size() * (bool(DT) + bool(PDT));
   if (DT)
     DT->applyUpdates(DeduplicatedUpdates);
   if (PDT)
@@ -249,7 +249,6 @@ protected:
     return false;
   }
 
-  bool IsCallerRecursive = false;
   bool IsRecursiveCall = false;
   bool ExposesReturnsTwice = false;
   bool HasDynamicAlloca = false;
@@ -261,6 +260,8 @@ protected:
 
   /// Number of bytes allocated statically by the callee.
   uint64_t AllocatedSize = 0;
+  /// Whether the caller calls itself, computed on first use.
+  Optional<bool> CallerRecursive;
   unsigned NumInstructions = 0;
   unsigned NumVectorInstructions = 0;
 
@@ -331,6 +332,9 @@ protected:
   /// Return true if size growth is allowed when inlining the callee at \p Call.
   bool allowSizeGrowth(CallBase &Call);
 
+  /// Return true if the function containing the call site calls itself.
+  bool isCallerRecursive();
+
   // Custom analysis routines.
   InlineResult analyzeBlock(BasicBlock *BB,
                             SmallPtrSetImpl<const Value *> &EphValues);
@@ -1881,8 +1885,8 @@ CallAnalyzer::analyzeBlock(BasicBlock *BB,
     // If the caller is a recursive function then we don't want to inline
     // functions which allocate a lot of stack space because it would increase
     // the caller stack usage dramatically.
-    if (IsCallerRecursive &&
-        AllocatedSize > InlineConstants::TotalAllocaSizeRecursiveCaller) {
+    if (AllocatedSize > InlineConstants::TotalAllocaSizeRecursiveCaller &&
+        isCallerRecursive()) {
       auto IR =
           InlineResult::failure("recursive and allocates too much stack space");
       if (ORE)
@@ -1981,6 +1985,19 @@ void CallAnalyzer::findDeadBlocks(BasicBlock *CurrBB, BasicBlock *NextBB) {
   }
 }
 
+bool CallAnalyzer::isCallerRecursive() {
+  // This walks all the users of the caller, so it is only done when the
+  // answer matters, and at most once per analysis.
+  if (!CallerRecursive) {
+    Function *Caller = CandidateCall.getFunction();
+    CallerRecursive = llvm::any_of(Caller->users(), [&](User *U) {
+      auto *Call = dyn_cast<CallBase>(U);
+      return Call && Call->getFunction() == Caller;
+    });
+  }
+  return *CallerRecursive;
+}
+
 /// Analyze a call site for potential inlining.
 ///
 /// Returns true if inlining this call is viable, and false if it is not
@@ -1998,16 +2015,6 @@ InlineResult CallAnalyzer::analyze() {
   if (F.empty())
     return InlineResult::success();
 
-  Function *Caller = CandidateCall.getFunction();
-  // Check if the caller function is recursive itself.
-  for (User *U : Caller->users()) {
-    CallBase *Call = dyn_cast<CallBase>(U);
-    if (Call && Call->getFunction() == Caller) {
-      IsCallerRecursive = true;
-      break;
-    }
-  }
-
   // Populate our simplified values by mapping from function arguments to call
   // arguments with known important simplifications.
   auto CAI = CandidateCall.arg_begin();
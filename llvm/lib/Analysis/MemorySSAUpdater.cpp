@@ -1344,22 +1344,33 @@ void MemorySSAUpdater::removeMemoryAccess(MemoryAccess *MA, bool OptimizePhis) {
 
 void MemorySSAUpdater::removeBlocks(
     const SmallSetVector<BasicBlock *, 8> &DeadBlocks) {
-  // First delete all uses of BB in MemoryPhis.
+  // First delete all uses of the dead blocks in MemoryPhis. A block may have
+  // many dead predecessors, e.g. when a whole loop is removed, so collect its
+  // phi once and drop all of its dead incoming blocks in a single pass.
+  SmallSetVector<MemoryPhi *, 8> PhisToUpdate;
   for (BasicBlock *BB : DeadBlocks) {
     Instruction *TI = BB->getTerminator();
     assert(TI && "Basic block expected to have a terminator instruction");
     for (BasicBlock *Succ : successors(TI))
       if (!DeadBlocks.count(Succ))
-        if (MemoryPhi *MP = MSSA->getMemoryAccess(Succ)) {
-          MP->unorderedDeleteIncomingBlock(BB);
-          tryRemoveTrivialPhi(MP);
-        }
+        if (MemoryPhi *MP = MSSA->getMemoryAccess(Succ))
+          PhisToUpdate.insert(MP);
     // Drop all references of all accesses in BB
     if (MemorySSA::AccessList *Acc = MSSA->getWritableBlockAccesses(BB))
       for (MemoryAccess &MA : *Acc)
         MA.dropAllReferences();
   }
 
+  SmallVector<WeakVH, 8> UpdatedPhis;
+  for (MemoryPhi *MP : PhisToUpdate) {
+    MP->unorderedDeleteIncomingIf([&](const MemoryAccess *, BasicBlock *B) {
+      return DeadBlocks.count(B);
+    });
+    UpdatedPhis.push_back(MP);
+  }
+  // Only look for trivial phis once no phi refers to a dead block anymore.
+  tryRemoveTrivialPhis(UpdatedPhis);
+
   // Next, delete all memory accesses in each block
   for (BasicBlock *BB : DeadBlocks) {
     MemorySSA::AccessList *Acc = MSSA->getWritableBlockAccesses(BB);
@@ -18,6 +18,7 @@
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/InitializePasses.h"
 
 using namespace llvm;
@@ -74,9 +75,21 @@ void OptimizationRemarkEmitter::computeHotness(
     OptDiag.setHotness(computeHotness(V));
 }
 
+bool OptimizationRemarkEmitter::allowExtraAnalysis(StringRef PassName) const {
+  LLVMContext &Ctx = F->getContext();
+  if (LLVMRemarkStreamer *RS = Ctx.getLLVMRemarkStreamer())
+    if (RS->matchesFilter(PassName))
+      return true;
+  return Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled(PassName);
+}
+
 void OptimizationRemarkEmitter::emit(
     DiagnosticInfoOptimizationBase &OptDiagBase) {
   auto &OptDiag = cast<DiagnosticInfoIROptimization>(OptDiagBase);
+  // Don't compute the hotness of a remark that neither the remark file nor
+  // the diagnostic handler is going to keep.
+  if (F->getContext().isRemarkDiscarded(OptDiag))
+    return;
   computeHotness(OptDiag);
 
   // Only emit it if its hotness meets the threshold.
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Analysis/PostDominators.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/PassManager.h"
@@ -22,6 +23,10 @@ using namespace llvm;
 
 #define DEBUG_TYPE "postdomtree"
 
+STATISTIC(NumPostDomTreesComputed,
+          "Number of post-dominator trees computed from scratch for an "
+          "analysis");
+
 #ifdef EXPENSIVE_CHECKS
 static constexpr bool ExpensiveChecksEnabled = true;
 #else
@@ -74,6 +79,7 @@ bool PostDominatorTree::dominates(const Instruction *I1,
 }
 
 bool PostDominatorTreeWrapperPass::runOnFunction(Function &F) {
+  ++NumPostDomTreesComputed;
   DT.recalculate(F);
   return false;
 }
@@ -97,6 +103,7 @@ AnalysisKey PostDominatorTreeAnalysis::Key;
 
 PostDominatorTree PostDominatorTreeAnalysis::run(Function &F,
                                                  FunctionAnalysisManager &) {
+  ++NumPostDomTreesComputed;
   PostDominatorTree PDT(F);
   return PDT;
 }
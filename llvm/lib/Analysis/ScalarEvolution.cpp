@@ -146,6 +146,8 @@ STATISTIC(NumTripCountsNotComputed,
           "Number of loops without predictable loop counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumExpressionBudgetsExhausted,
+          "Number of functions that exhausted the SCEV expression budget");
 
 static cl::opt<unsigned>
 MaxBruteForceIterations("scalar-evolution-max-iterations", cl::ReallyHidden,
@@ -221,6 +223,12 @@ static cl::opt<unsigned>
                   cl::desc("Size of the expression which is considered huge"),
                   cl::init(4096));
 
+static cl::opt<unsigned> MaxSCEVExpressions(
+    "scalar-evolution-max-expressions", cl::Hidden,
+    cl::desc("Maximum number of unique SCEV expressions per function before "
+             "new values are treated as unknown (0 = no limit)"),
+    cl::init(0));
+
 static cl::opt<bool>
 ClassifyExpressions("scalar-evolution-classify-expressions",
     cl::Hidden, cl::init(true),
@@ -3942,6 +3950,18 @@ static bool SCEVLostPoisonFlags(const SCEV *S, const Value *V) {
   return false;
 }
 
+bool ScalarEvolution::isExpressionBudgetExhausted() {
+  if (ExpressionBudgetExhausted)
+    return true;
+  if (!MaxSCEVExpressions || UniqueSCEVs.size() < MaxSCEVExpressions)
+    return false;
+  ExpressionBudgetExhausted = true;
+  ++NumExpressionBudgetsExhausted;
+  LLVM_DEBUG(dbgs() << "SCEV: expression budget of " << MaxSCEVExpressions
+                    << " exhausted in function " << F.getName() << "\n");
+  return true;
+}
+
 /// Return an existing SCEV if it exists, otherwise analyze the expression and
 /// create a new one.
 const SCEV *ScalarEvolution::getSCEV(Value *V) {
@@ -3949,7 +3969,9 @@ const SCEV *ScalarEvolution::getSCEV(Value *V) {
 
   const SCEV *S = getExistingSCEV(V);
   if (S == nullptr) {
-    S = createSCEV(V);
+    // Modeling a value as unknown is always correct, just less precise.
+    S = isExpressionBudgetExhausted() && !isa<Constant>(V) ? getUnknown(V)
+                                                           : createSCEV(V);
     // During PHI resolution, it is possible to create two SCEVs for the same
     // V, so it is needed to double check whether V->S is inserted into
     // ValueExprMap before insert S->{V, 0} into ExprValueMap.
@@ -11570,7 +11592,9 @@ ScalarEvolution::ScalarEvolution(Function &F, TargetLibraryInfo &TLI,
 }
 
 ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
-    : F(Arg.F), HasGuards(Arg.HasGuards), TLI(Arg.TLI), AC(Arg.AC), DT(Arg.DT),
+    : F(Arg.F), HasGuards(Arg.HasGuards),
+      ExpressionBudgetExhausted(Arg.ExpressionBudgetExhausted), TLI(Arg.TLI),
+      AC(Arg.AC), DT(Arg.DT),
       LI(Arg.LI), CouldNotCompute(std::move(Arg.CouldNotCompute)),
       ValueExprMap(std::move(Arg.ValueExprMap)),
       PendingLoopPredicates(std::move(Arg.PendingLoopPredicates)),
@@ -143,6 +143,9 @@ public:
   // vector compatibility methods
   unsigned size() const { return MetadataPtrs.size(); }
   void resize(unsigned N) { MetadataPtrs.resize(N); }
+  void reserve(uint64_t N) {
+    MetadataPtrs.reserve(std::min<uint64_t>(N, RefsUpperBound));
+  }
   void push_back(Metadata *MD) { MetadataPtrs.emplace_back(MD); }
   void clear() { MetadataPtrs.clear(); }
   Metadata *back() const { return MetadataPtrs.back(); }
@@ -1897,6 +1900,10 @@ Error MetadataLoader::MetadataLoaderImpl::parseOneMetadata(
     break;
   }
   case bitc::METADATA_STRINGS: {
+    // The strings record comes first, so make room for the strings up front.
+    // Growing MetadataPtrs later moves every TrackingMDRef in it.
+    if (!Record.empty())
+      MetadataList.reserve(NextMetadataNo + Record[0]);
     auto CreateNextMDString = [&](StringRef Str) {
       ++NumMDStringLoaded;
       MetadataList.assignValue(MDString::get(Context, Str), NextMetadataNo);
@@ -12,7 +12,10 @@
 // -fbasicblock-sections= option is used.  Exception landing pad blocks are
 // specially handled by grouping them in a single section.  Further, with
 // profile information only the subset of basic blocks with profiles are placed
-// in a separate section and the rest are grouped in a cold section.
+// in a separate section and the rest are grouped in a cold section.  With
+// -bbsections-cold-from-profile, functions missing from the list but carrying
+// PGO counts get the same hot/cold split computed from their block
+// frequencies.
 //
 // Basic Block Sections
 // ====================
@@ -73,12 +76,15 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
+#include "llvm/CodeGen/MachineBlockFrequencyInfo.h"
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/CodeGen/TargetInstrInfo.h"
 #include "llvm/InitializePasses.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/LineIterator.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Target/TargetMachine.h"
@@ -90,6 +96,11 @@ using llvm::StringMap;
 using llvm::StringRef;
 using namespace llvm;
 
+static cl::opt<bool> BBSectionsColdFromProfile(
+    "bbsections-cold-from-profile", cl::Hidden, cl::init(false),
+    cl::desc("With -basicblock-sections=<list>, move the profile-cold blocks "
+             "of functions that are not in the list into the cold section"));
+
 namespace {
 
 class BBSectionsPrepare : public MachineFunctionPass {
@@ -119,14 +130,26 @@ public:
   /// Identify basic blocks that need separate sections and prepare to emit them
   /// accordingly.
   bool runOnMachineFunction(MachineFunction &MF) override;
+
+private:
+  /// Collect the numbers of the blocks of MF which are not cold according to
+  /// the profile into HotBlocks. Returns false if MF has no profile or no cold
+  /// blocks, in which case MF is left alone.
+  bool getHotBlocksFromProfile(MachineFunction &MF,
+                               SmallSet<unsigned, 4> &HotBlocks);
 };
 
 } // end anonymous namespace
 
 char BBSectionsPrepare::ID = 0;
-INITIALIZE_PASS(BBSectionsPrepare, "bbsections-prepare",
-                "Determine if a basic block needs a special section", false,
-                false)
+INITIALIZE_PASS_BEGIN(BBSectionsPrepare, "bbsections-prepare",
+                      "Determine if a basic block needs a special section",
+                      false, false)
+INITIALIZE_PASS_DEPENDENCY(MachineBlockFrequencyInfo)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_END(BBSectionsPrepare, "bbsections-prepare",
+                    "Determine if a basic block needs a special section",
+                    false, false)
 
 // This inserts an unconditional branch at the end of MBB to the next basic
 // block S if and only if the control-flow implicitly falls through from MBB to
@@ -165,11 +188,11 @@ static void insertUnconditionalFallthroughBranch(MachineBasicBlock &MBB) {
 /// 1) Exception section - basic blocks that are landing pads
 /// 2) Cold section - basic blocks that will not have unique sections.
 /// 3) Unique section - one per basic block that is emitted in a unique section.
-static bool assignSectionsAndSortBasicBlocks(
-    MachineFunction &MF,
-    const StringMap<SmallSet<unsigned, 4>> &BBSectionsList) {
-  SmallSet<unsigned, 4> S = BBSectionsList.lookup(MF.getName());
-
+/// With HotInEntrySection, the blocks in S stay in the function section along
+/// with the entry block instead of getting unique sections.
+static bool assignSectionsAndSortBasicBlocks(MachineFunction &MF,
+                                             const SmallSet<unsigned, 4> &S,
+                                             bool HotInEntrySection) {
   bool HasHotEHPads = false;
 
   for (auto &MBB : MF) {
@@ -192,6 +215,8 @@ static bool assignSectionsAndSortBasicBlocks(
     } else if (MBB.isEHPad()) {
       // We handle non-cold basic eh blocks later.
       HasHotEHPads = true;
+    } else if (HotInEntrySection) {
+      MBB.setSectionType(MachineBasicBlockSection::MBBS_Entry);
     } else {
       // Place this MBB in a unique section.  A unique section begins and ends
       // that section by definition.
@@ -226,6 +251,27 @@ static bool assignSectionsAndSortBasicBlocks(
   return true;
 }
 
+bool BBSectionsPrepare::getHotBlocksFromProfile(
+    MachineFunction &MF, SmallSet<unsigned, 4> &HotBlocks) {
+  if (!MF.getFunction().hasProfileData())
+    return false;
+  ProfileSummaryInfo *PSI =
+      &getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+  if (!PSI->hasProfileSummary())
+    return false;
+  auto &MBFI = getAnalysis<MachineBlockFrequencyInfo>();
+
+  bool HasColdBlocks = false;
+  for (auto &MBB : MF) {
+    Optional<uint64_t> Count = MBFI.getBlockProfileCount(&MBB);
+    if (&MBB != &MF.front() && Count && PSI->isColdCount(*Count))
+      HasColdBlocks = true;
+    else
+      HotBlocks.insert(MBB.getNumber());
+  }
+  return HasColdBlocks;
+}
+
 bool BBSectionsPrepare::runOnMachineFunction(MachineFunction &MF) {
   auto BBSectionsType = MF.getTarget().getBBSectionsType();
   assert(BBSectionsType != BasicBlockSection::None &&
@@ -243,13 +289,24 @@ bool BBSectionsPrepare::runOnMachineFunction(MachineFunction &MF) {
     return true;
   }
 
-  if (BBSectionsType == BasicBlockSection::List &&
-      BBSectionsList.find(MF.getName()) == BBSectionsList.end())
-    return true;
+  // A function that is not in the list can still be split by its profile.
+  // Its hot blocks are kept together in the function section and only the
+  // cold blocks are moved out, into the cold section.
+  bool FromProfile = false;
+  SmallSet<unsigned, 4> S;
+  if (BBSectionsType == BasicBlockSection::List) {
+    auto It = BBSectionsList.find(MF.getName());
+    if (It != BBSectionsList.end())
+      S = It->second;
+    else if (BBSectionsColdFromProfile && getHotBlocksFromProfile(MF, S))
+      FromProfile = true;
+    else
+      return true;
+  }
 
   MF.setBBSectionsType(BBSectionsType);
   MF.createBBLabels();
-  assignSectionsAndSortBasicBlocks(MF, BBSectionsList);
+  assignSectionsAndSortBasicBlocks(MF, S, FromProfile);
 
   return true;
 }
@@ -307,6 +364,10 @@ bool BBSectionsPrepare::doInitialization(Module &M) {
 void BBSectionsPrepare::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.setPreservesAll();
   AU.addRequired<MachineModuleInfoWrapperPass>();
+  if (BBSectionsColdFromProfile) {
+    AU.addRequired<MachineBlockFrequencyInfo>();
+    AU.addRequired<ProfileSummaryInfoWrapperPass>();
+  }
 }
 
 MachineFunctionPass *
@@ -580,13 +580,13 @@ const MachineBasicBlock *MachineBasicBlock::getSectionEndMBB() const {
 
 // Returns true if this block begins any section.
 bool MachineBasicBlock::isBeginSection() const {
-  return (SectionType == MBBS_Entry || SectionType == MBBS_Unique ||
+  return (SectionType == MBBS_Unique ||
           getParent()->isSectionStartMBB(getNumber()));
 }
 
 // Returns true if this block begins any section.
 bool MachineBasicBlock::isEndSection() const {
-  return (SectionType == MBBS_Entry || SectionType == MBBS_Unique ||
+  return (SectionType == MBBS_Unique ||
           getParent()->isSectionEndMBB(getNumber()));
 }
 
@@ -340,11 +340,11 @@ void MachineFunction::RenumberBlocks(MachineBasicBlock *MBB) {
   MBBNumbering.resize(BlockNo);
 }
 
-/// This sets the section ranges of cold or exception section with basic block
-/// sections.
+/// This sets the section ranges of the function, cold or exception section with
+/// basic block sections.
 void MachineFunction::setSectionRange() {
-  // Compute the Section Range of cold and exception basic blocks.  Find the
-  // first and last block of each range.
+  // Compute the Section Range of entry, cold and exception basic blocks.  Find
+  // the first and last block of each range.
   auto SectionRange =
       ([&](llvm::MachineBasicBlockSection S) -> std::pair<int, int> {
         auto MBBP =
@@ -362,6 +362,7 @@ void MachineFunction::setSectionRange() {
         return std::make_pair(MBBP->getNumber(), MBBQ->getNumber());
       });
 
+  EntrySectionRange = SectionRange(MBBS_Entry);
   ExceptionSectionRange = SectionRange(MBBS_Exception);
   ColdSectionRange = SectionRange(llvm::MBBS_Cold);
 }
@@ -17,6 +17,7 @@
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/InitializePasses.h"
 
 using namespace llvm;
@@ -46,13 +47,26 @@ void MachineOptimizationRemarkEmitter::computeHotness(
     Remark.setHotness(computeHotness(*MBB));
 }
 
+bool MachineOptimizationRemarkEmitter::allowExtraAnalysis(
+    StringRef PassName) const {
+  LLVMContext &Ctx = MF.getFunction().getContext();
+  if (LLVMRemarkStreamer *RS = Ctx.getLLVMRemarkStreamer())
+    if (RS->matchesFilter(PassName))
+      return true;
+  return Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled(PassName);
+}
+
 void MachineOptimizationRemarkEmitter::emit(
     DiagnosticInfoOptimizationBase &OptDiagCommon) {
   auto &OptDiag = cast<DiagnosticInfoMIROptimization>(OptDiagCommon);
-  computeHotness(OptDiag);
-
   LLVMContext &Ctx = MF.getFunction().getContext();
 
+  // Don't compute the hotness of a remark that neither the remark file nor
+  // the diagnostic handler is going to keep.
+  if (Ctx.isRemarkDiscarded(OptDiag))
+    return;
+  computeHotness(OptDiag);
+
   // Only emit it if its hotness meets the threshold.
   if (OptDiag.getHotness().getValueOr(0) <
       Ctx.getDiagnosticsHotnessThreshold()) {
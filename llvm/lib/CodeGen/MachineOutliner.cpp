@@ -311,8 +311,14 @@ private:
     unsigned *E = new (InternalEndIdxAllocator) unsigned(EndIdx);
     SuffixTreeNode *N =
         new (NodeAllocator.Allocate()) SuffixTreeNode(StartIdx, E, Root);
-    if (Parent)
+    if (Parent) {
+      // A split node starts out with exactly two children and most never get
+      // more. Size the map for that up front; otherwise the first insertion
+      // would allocate DenseMap's default of 64 buckets for every internal
+      // node in the tree.
+      N->Children = DenseMap<unsigned, SuffixTreeNode *>(2);
       Parent->Children[Edge] = N;
+    }
 
     return N;
   }
@@ -377,7 +383,8 @@ private:
       unsigned FirstChar = Str[Active.Idx];
 
       // Have we inserted anything starting with FirstChar at the current node?
-      if (Active.Node->Children.count(FirstChar) == 0) {
+      auto ChildIt = Active.Node->Children.find(FirstChar);
+      if (ChildIt == Active.Node->Children.end()) {
         // If not, then we can just insert a leaf and move too the next step.
         insertLeaf(*Active.Node, EndIdx, FirstChar);
 
@@ -390,7 +397,7 @@ private:
       } else {
         // There's a match with FirstChar, so look for the point in the tree to
         // insert a new node.
-        SuffixTreeNode *NextNode = Active.Node->Children[FirstChar];
+        SuffixTreeNode *NextNode = ChildIt->second;
 
         unsigned SubstringLen = NextNode->size();
 
@@ -530,6 +537,9 @@ public:
       // Each leaf node represents a repeat of a string.
       std::vector<SuffixTreeNode *> LeafChildren;
 
+      // The children of the current node, ordered by their edge labels.
+      SmallVector<std::pair<unsigned, SuffixTreeNode *>, 8> SortedChildren;
+
       // Continue visiting nodes until we find one which repeats more than once.
       while (!ToVisit.empty()) {
         SuffixTreeNode *Curr = ToVisit.back();
@@ -543,7 +553,14 @@ public:
         // Iterate over each child, saving internal nodes for visiting, and
         // leaf nodes in LeafChildren. Internal nodes represent individual
         // strings, which may repeat.
-        for (auto &ChildPair : Curr->Children) {
+        //
+        // The order in which repeated substrings are found breaks ties between
+        // equally beneficial candidates, so visit the children in the order of
+        // their edge labels rather than in the order of Children, which depends
+        // on its number of buckets.
+        SortedChildren.assign(Curr->Children.begin(), Curr->Children.end());
+        llvm::sort(SortedChildren, less_first());
+        for (auto &ChildPair : SortedChildren) {
           // Save all of this node's children for processing.
           if (!ChildPair.second->isLeaf())
             ToVisit.push_back(ChildPair.second);
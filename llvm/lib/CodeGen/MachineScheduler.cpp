@@ -18,6 +18,7 @@
 #include "llvm/ADT/PriorityQueue.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/CodeGen/LiveInterval.h"
@@ -57,6 +58,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/GraphWriter.h"
 #include "llvm/Support/MachineValueType.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -73,6 +75,9 @@ using namespace llvm;
 
 #define DEBUG_TYPE "machine-scheduler"
 
+STATISTIC(NumRegionsScheduled, "Number of scheduling regions scheduled");
+STATISTIC(NumRegionWindows, "Number of regions cut at -misched-max-region");
+
 namespace llvm {
 
 cl::opt<bool> ForceTopDown("misched-topdown", cl::Hidden,
@@ -117,6 +122,13 @@ static const bool PrintDAGs = false;
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Avoid quadratic DAG construction in huge basic blocks by scheduling them as
+/// a series of windows of at most N instructions. The instruction between two
+/// windows is left in place, as if it were a scheduling boundary.
+static cl::opt<unsigned> MaxRegionInstrs("misched-max-region", cl::Hidden,
+  cl::desc("Split scheduling regions larger than N instructions (0 = no "
+           "limit)"), cl::init(0));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -492,6 +504,12 @@ getSchedRegions(MachineBasicBlock *MBB,
       if (isSchedBoundary(&MI, &*MBB, MF, TII))
         break;
       if (!MI.isDebugInstr()) {
+        // Cut the region short here. MI becomes the bottom of the next region
+        // and so stays where it is, just like a real scheduling boundary.
+        if (MaxRegionInstrs && NumRegionInstrs == MaxRegionInstrs) {
+          ++NumRegionWindows;
+          break;
+        }
         // MBB::size() uses instr_iterator to count. Here we need a bundle to
         // count as a single instruction.
         ++NumRegionInstrs;
@@ -576,7 +594,15 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
 
       // Schedule a region: possibly reorder instructions.
       // This invalidates the original region iterators.
-      Scheduler.schedule();
+      {
+        llvm::TimeTraceScope TimeScope("ScheduleRegion", [&]() {
+          return (MF->getName() + ":" + MBB->getName() + " (" +
+                  Twine(NumRegionInstrs) + " instrs)")
+              .str();
+        });
+        Scheduler.schedule();
+      }
+      ++NumRegionsScheduled;
 
       // Close the current region.
       Scheduler.exitRegion();
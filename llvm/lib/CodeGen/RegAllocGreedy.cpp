@@ -136,6 +136,12 @@ static cl::opt<bool> ConsiderLocalIntervalCost(
              "candidate when choosing the best split candidate."),
     cl::init(false));
 
+static cl::opt<unsigned> HugeFunctionVirtRegs(
+    "regalloc-huge-function-vregs", cl::Hidden,
+    cl::desc("Do not try region splitting in functions with more virtual "
+             "registers than this (0 = no limit)"),
+    cl::init(0));
+
 static RegisterRegAlloc greedyRegAlloc("greedy", "greedy register allocator",
                                        createGreedyRegisterAllocator);
 
@@ -402,6 +408,10 @@ class RAGreedy : public MachineFunctionPass,
   /// by a split candidate when choosing the best split candidate.
   bool EnableAdvancedRASplitCost;
 
+  /// Skip region splitting in this function because it has more virtual
+  /// registers than -regalloc-huge-function-vregs.
+  bool SkipRegionSplit;
+
   /// Set of broken hints that may be reconciled later because of eviction.
   SmallSetVector<LiveInterval *, 8> SetOfBrokenHints;
 
@@ -2476,7 +2486,7 @@ unsigned RAGreedy::trySplit(LiveInterval &VirtReg, AllocationOrder &Order,
   // First try to split around a region spanning multiple blocks. RS_Split2
   // ranges already made dubious progress with region splitting, so they go
   // straight to single block splitting.
-  if (getStage(VirtReg) < RS_Split2) {
+  if (getStage(VirtReg) < RS_Split2 && !SkipRegionSplit) {
     unsigned PhysReg = tryRegionSplit(VirtReg, Order, NewVRegs);
     if (PhysReg || !NewVRegs.empty())
       return PhysReg;
@@ -3231,6 +3241,23 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
 
   initializeCSRCost();
 
+  // Region splitting dominates the allocation time of very large functions.
+  // Fall back to splitting around single blocks there.
+  SkipRegionSplit =
+      HugeFunctionVirtRegs && MRI->getNumVirtRegs() > HugeFunctionVirtRegs;
+  if (SkipRegionSplit) {
+    using namespace ore;
+
+    ORE->emit([&]() {
+      return MachineOptimizationRemarkAnalysis(
+                 DEBUG_TYPE, "HugeFunction",
+                 MF->getFunction().getSubprogram(), &MF->front())
+             << "region splitting disabled in function with "
+             << NV("NumVirtRegs", MRI->getNumVirtRegs())
+             << " virtual registers";
+    });
+  }
+
   calculateSpillWeightsAndHints(*LIS, mf, VRM, *Loops, *MBFI);
 
   LLVM_DEBUG(LIS->dump());
@@ -1050,8 +1050,14 @@ bool SelectionDAG::shouldOptForSize() const {
 void SelectionDAG::allnodes_clear() {
   assert(&*AllNodes.begin() == &EntryNode);
   AllNodes.remove(AllNodes.begin());
-  while (!AllNodes.empty())
-    DeallocateNode(&AllNodes.front());
+  // Both callers release all operand arrays and debug values wholesale right
+  // after this, so unlike DeallocateNode() only return the nodes themselves.
+  while (!AllNodes.empty()) {
+    SDNode *N = AllNodes.remove(AllNodes.begin());
+    NodeAllocator.Deallocate(N);
+    __asan_unpoison_memory_region(&N->NodeType, sizeof(N->NodeType));
+    N->NodeType = ISD::DELETED_NODE;
+  }
 #ifndef NDEBUG
   NextPersistentId = 0;
 #endif
@@ -133,6 +133,11 @@ static cl::opt<bool> EnableFastISelFallbackReport(
     cl::desc("Emit a diagnostic when \"fast\" instruction selection "
              "falls back to SelectionDAG."));
 
+static cl::opt<bool> ColdFunctionsAtO0(
+    "cold-functions-isel-o0", cl::Hidden, cl::init(false),
+    cl::desc("Select instructions for functions that the profile marks as "
+             "cold as if they were compiled at -O0"));
+
 static cl::opt<bool>
 UseMBPI("use-mbpi",
         cl::desc("use Machine Branch Probability Info"),
@@ -424,9 +429,13 @@ bool SelectionDAGISel::runOnMachineFunction(MachineFunction &mf) {
   // codegen looking at the optimization level explicitly when
   // it wants to look at it.
   TM.resetTargetOptions(Fn);
-  // Reset OptLevel to None for optnone functions.
+  auto *PSI = &getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+  // Reset OptLevel to None for optnone functions, and for cold functions if
+  // requested: they are not worth the compile time of the optimizing selector.
   CodeGenOpt::Level NewOptLevel = OptLevel;
-  if (OptLevel != CodeGenOpt::None && skipFunction(Fn))
+  if (OptLevel != CodeGenOpt::None &&
+      (skipFunction(Fn) || (ColdFunctionsAtO0 && PSI->hasProfileSummary() &&
+                            PSI->isFunctionEntryCold(&Fn))))
     NewOptLevel = CodeGenOpt::None;
   OptLevelChanger OLC(*this, NewOptLevel);
 
@@ -440,7 +449,6 @@ bool SelectionDAGISel::runOnMachineFunction(MachineFunction &mf) {
   DominatorTree *DT = DTWP ? &DTWP->getDomTree() : nullptr;
   auto *LIWP = getAnalysisIfAvailable<LoopInfoWrapperPass>();
   LoopInfo *LI = LIWP ? &LIWP->getLoopInfo() : nullptr;
-  auto *PSI = &getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
   auto *BFI = (PSI && PSI->hasProfileSummary()) ?
               &getAnalysis<LazyBlockFrequencyInfoPass>().getBFI() :
               nullptr;
@@ -2669,6 +2677,12 @@ static unsigned IsPredicateKnownToFail(const unsigned char *Table,
     Result = !::CheckType(Table, Index, N, SDISel.TLI,
                           SDISel.CurDAG->getDataLayout());
     return Index;
+  case SelectionDAGISel::OPC_CheckTypeI32:
+    Result = N.getValueType() != MVT::i32;
+    return Index;
+  case SelectionDAGISel::OPC_CheckTypeI64:
+    Result = N.getValueType() != MVT::i64;
+    return Index;
   case SelectionDAGISel::OPC_CheckTypeRes: {
     unsigned Res = Table[Index++];
     Result = !::CheckType(Table, Index, N.getValue(Res), SDISel.TLI,
@@ -3099,6 +3113,12 @@ void SelectionDAGISel::SelectCodeCommon(SDNode *NodeToMatch,
                        CurDAG->getDataLayout()))
         break;
       continue;
+    case OPC_CheckTypeI32:
+      if (N.getValueType() != MVT::i32) break;
+      continue;
+    case OPC_CheckTypeI64:
+      if (N.getValueType() != MVT::i64) break;
+      continue;
 
     case OPC_CheckTypeRes: {
       unsigned Res = MatcherTable[MatcherIndex++];
@@ -0,0 +1,117 @@
+//===------ LocalObjectCache.cpp - On-disk object cache for the JIT -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+Expected<std::unique_ptr<LocalObjectCache>>
+LocalObjectCache::Create(StringRef CacheDir, StringRef ConfigKey,
+                         CachePruningPolicy Policy) {
+  if (std::error_code EC = sys::fs::create_directories(CacheDir))
+    return createFileError(CacheDir, EC);
+  pruneCache(CacheDir, Policy);
+  return std::unique_ptr<LocalObjectCache>(
+      new LocalObjectCache(CacheDir, ConfigKey));
+}
+
+std::string LocalObjectCache::computeEntryPath(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(ConfigKey);
+  // Separate the configuration key from the bitcode.
+  Hasher.update(StringRef("\0", 1));
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+
+  // This choice of file name allows the cache to be pruned (see pruneCache()
+  // in include/llvm/Support/CachePruning.h).
+  SmallString<128> EntryPath;
+  sys::path::append(EntryPath, CacheDir,
+                    "llvmcache-" + toHex(Hasher.final()));
+  return std::string(EntryPath.str());
+}
+
+std::unique_ptr<MemoryBuffer> LocalObjectCache::getObject(const Module *M) {
+  std::string EntryPath = computeEntryPath(*M);
+  auto MBOrErr = MemoryBuffer::getFile(EntryPath, /*FileSize=*/-1,
+                                       /*RequiresNullTerminator=*/false);
+  if (MBOrErr) {
+    LLVM_DEBUG(dbgs() << "Object cache hit for " << M->getModuleIdentifier()
+                      << ": " << EntryPath << "\n");
+    return std::move(*MBOrErr);
+  }
+
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  PendingEntries[M] = std::move(EntryPath);
+  return nullptr;
+}
+
+void LocalObjectCache::notifyObjectCompiled(const Module *M,
+                                            MemoryBufferRef Obj) {
+  std::string EntryPath;
+  {
+    std::lock_guard<std::mutex> Lock(PendingMutex);
+    auto I = PendingEntries.find(M);
+    if (I != PendingEntries.end()) {
+      EntryPath = std::move(I->second);
+      PendingEntries.erase(I);
+    }
+  }
+  if (EntryPath.empty())
+    EntryPath = computeEntryPath(*M);
+
+  // Write to a temporary file, then rename it into place, so that concurrent
+  // readers in other processes never see a partial entry.
+  SmallString<128> TempFileModel;
+  sys::path::append(TempFileModel, CacheDir, "Jit-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempFileModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    // Failing to cache an object is not fatal, it just has to be compiled
+    // again next time.
+    LLVM_DEBUG(dbgs() << "Cannot create object cache entry in " << CacheDir
+                      << "\n");
+    consumeError(Temp.takeError());
+    return;
+  }
+
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+  }
+
+  // If another process raced us to the same entry, its object is equivalent.
+  if (Error E = Temp->keep(EntryPath)) {
+    LLVM_DEBUG(dbgs() << "Cannot commit object cache entry " << EntryPath
+                      << "\n");
+    consumeError(std::move(E));
+    consumeError(Temp->discard());
+  }
+}
+
+} // end namespace orc
+} // end namespace llvm
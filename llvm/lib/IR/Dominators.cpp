@@ -16,6 +16,7 @@
 #include "llvm/IR/Dominators.h"
 #include "llvm/ADT/DepthFirstIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/IR/CFG.h"
 #include "llvm/IR/Constants.h"
@@ -29,6 +30,11 @@
 #include <algorithm>
 using namespace llvm;
 
+#define DEBUG_TYPE "domtree"
+
+STATISTIC(NumDomTreesComputed,
+          "Number of dominator trees computed from scratch for an analysis");
+
 bool llvm::VerifyDomInfo = false;
 static cl::opt<bool, true>
     VerifyDomInfoX("verify-dom-info", cl::location(VerifyDomInfo), cl::Hidden,
@@ -313,6 +319,7 @@ bool DominatorTree::isReachableFromEntry(const Use &U) const {
 
 DominatorTree DominatorTreeAnalysis::run(Function &F,
                                          FunctionAnalysisManager &) {
+  ++NumDomTreesComputed;
   DominatorTree DT;
   DT.recalculate(F);
   return DT;
@@ -357,6 +364,7 @@ INITIALIZE_PASS(DominatorTreeWrapperPass, "domtree",
                 "Dominator Tree Construction", true, true)
 
 bool DominatorTreeWrapperPass::runOnFunction(Function &F) {
+  ++NumDomTreesComputed;
   DT.recalculate(F);
   return false;
 }
@@ -121,12 +121,15 @@ void LLVMContext::setDiagnosticHandlerCallBack(
   pImpl->DiagHandler->DiagHandlerCallback = DiagnosticHandler;
   pImpl->DiagHandler->DiagnosticContext = DiagnosticContext;
   pImpl->RespectDiagnosticFilters = RespectFilters;
+  if (DiagnosticHandler)
+    pImpl->HasCustomDiagHandler = true;
 }
 
 void LLVMContext::setDiagnosticHandler(std::unique_ptr<DiagnosticHandler> &&DH,
                                       bool RespectFilters) {
   pImpl->DiagHandler = std::move(DH);
   pImpl->RespectDiagnosticFilters = RespectFilters;
+  pImpl->HasCustomDiagHandler = true;
 }
 
 void LLVMContext::setDiagnosticsHotnessRequested(bool Requested) {
@@ -247,6 +250,19 @@ void LLVMContext::diagnose(const DiagnosticInfo &DI) {
     exit(1);
 }
 
+bool LLVMContext::isRemarkDiscarded(
+    const DiagnosticInfoOptimizationBase &Remark) const {
+  if (const LLVMRemarkStreamer *RS = getLLVMRemarkStreamer())
+    if (RS->matchesFilter(Remark.getPassName()))
+      return false;
+  // A handler that does not respect the filters is given every remark.
+  if (pImpl->HasCustomDiagHandler && !pImpl->RespectDiagnosticFilters)
+    return false;
+  // Verbose remarks are also dropped without hotness, but the caller has not
+  // computed it yet.
+  return !Remark.isEnabled();
+}
+
 void LLVMContext::emitError(unsigned LocCookie, const Twine &ErrorStr) {
   diagnose(DiagnosticInfoInlineAsm(LocCookie, ErrorStr));
 }
@@ -326,6 +342,12 @@ void LLVMContext::setDiscardValueNames(bool Discard) {
   pImpl->DiscardValueNames = Discard;
 }
 
+bool LLVMContext::hasThreadSafeTypes() const { return pImpl->ThreadSafeTypes; }
+
+void LLVMContext::setThreadSafeTypes(bool ThreadSafe) {
+  pImpl->ThreadSafeTypes = ThreadSafe;
+}
+
 OptPassGate &LLVMContext::getOptPassGate() const {
   return pImpl->getOptPassGate();
 }
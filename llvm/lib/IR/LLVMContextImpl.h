@@ -47,6 +47,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -297,7 +298,16 @@ template <> struct MDNodeKeyImpl<DILocation> {
   }
 
   unsigned getHashValue() const {
-    return hash_combine(Line, Column, Scope, InlinedAt, ImplicitCode);
+    // DILocations are the most common uniqued nodes in -g builds, so mix the
+    // fields with a few multiplications instead of calling hash_combine().
+    // The column has already been clamped to 16 bits.
+    uint64_t H = (uint64_t(Line) << 32 | Column << 1 | ImplicitCode) *
+                 0x9E3779B97F4A7C15ULL;
+    H ^= reinterpret_cast<uintptr_t>(Scope) * 0xC2B2AE3D27D4EB4FULL;
+    H ^= reinterpret_cast<uintptr_t>(InlinedAt) * 0x165667B19E3779F9ULL;
+    H ^= H >> 29;
+    H *= 0xBF58476D1CE4E5B9ULL;
+    return unsigned(H ^ (H >> 32));
   }
 };
 
@@ -1264,6 +1274,9 @@ public:
 
   std::unique_ptr<DiagnosticHandler> DiagHandler;
   bool RespectDiagnosticFilters = false;
+  /// Whether a diagnostic handler or callback was installed. The default
+  /// handler prints nothing that is not enabled.
+  bool HasCustomDiagHandler = false;
   bool DiagnosticsHotnessRequested = false;
   uint64_t DiagnosticsHotnessThreshold = 0;
   /// The specialized remark streamer used by LLVM's OptimizationRemarkEmitter.
@@ -1417,6 +1430,18 @@ public:
   /// not.
   bool DiscardValueNames = false;
 
+  /// If set, the type uniquing tables, the named struct types and Alloc are
+  /// accessed under TypeMutex by the type factories. The mutex is recursive
+  /// because creating a literal struct type sets its body.
+  bool ThreadSafeTypes = false;
+  std::recursive_mutex TypeMutex;
+
+  std::unique_lock<std::recursive_mutex> lockTypes() {
+    if (!ThreadSafeTypes)
+      return std::unique_lock<std::recursive_mutex>();
+    return std::unique_lock<std::recursive_mutex>(TypeMutex);
+  }
+
   LLVMContextImpl(LLVMContext &C);
   ~LLVMContextImpl();
 
@@ -258,6 +258,7 @@ IntegerType *IntegerType::get(LLVMContext &C, unsigned NumBits) {
     break;
   }
 
+  auto Lock = C.pImpl->lockTypes();
   IntegerType *&Entry = C.pImpl->IntegerTypes[NumBits];
 
   if (!Entry)
@@ -304,6 +305,7 @@ FunctionType *FunctionType::get(Type *ReturnType,
   LLVMContextImpl *pImpl = ReturnType->getContext().pImpl;
   const FunctionTypeKeyInfo::KeyTy Key(ReturnType, Params, isVarArg);
   FunctionType *FT;
+  auto Lock = pImpl->lockTypes();
   // Since we only want to allocate a fresh function type in case none is found
   // and we don't want to perform two lookups (one for checking if existent and
   // one for inserting the newly allocated one), here we instead lookup based on
@@ -350,6 +352,7 @@ StructType *StructType::get(LLVMContext &Context, ArrayRef<Type*> ETypes,
   const AnonStructTypeKeyInfo::KeyTy Key(ETypes, isPacked);
 
   StructType *ST;
+  auto Lock = pImpl->lockTypes();
   // Since we only want to allocate a fresh struct type in case none is found
   // and we don't want to perform two lookups (one for checking if existent and
   // one for inserting the newly allocated one), here we instead lookup based on
@@ -385,10 +388,12 @@ void StructType::setBody(ArrayRef<Type*> Elements, bool isPacked) {
     return;
   }
 
+  auto Lock = getContext().pImpl->lockTypes();
   ContainedTys = Elements.copy(getContext().pImpl->Alloc).data();
 }
 
 void StructType::setName(StringRef Name) {
+  auto Lock = getContext().pImpl->lockTypes();
   if (Name == getName()) return;
 
   StringMap<StructType *> &SymbolTable = getContext().pImpl->NamedStructTypes;
@@ -440,6 +445,7 @@ void StructType::setName(StringRef Name) {
 // StructType Helper functions.
 
 StructType *StructType::create(LLVMContext &Context, StringRef Name) {
+  auto Lock = Context.pImpl->lockTypes();
   StructType *ST = new (Context.pImpl->Alloc) StructType(Context);
   if (!Name.empty())
     ST->setName(Name);
@@ -527,6 +533,7 @@ bool StructType::isLayoutIdentical(StructType *Other) const {
 }
 
 StructType *Module::getTypeByName(StringRef Name) const {
+  auto Lock = getContext().pImpl->lockTypes();
   return getContext().pImpl->NamedStructTypes.lookup(Name);
 }
 
@@ -563,6 +570,7 @@ ArrayType *ArrayType::get(Type *ElementType, uint64_t NumElements) {
   assert(isValidElementType(ElementType) && "Invalid type for array element!");
 
   LLVMContextImpl *pImpl = ElementType->getContext().pImpl;
+  auto Lock = pImpl->lockTypes();
   ArrayType *&Entry =
     pImpl->ArrayTypes[std::make_pair(ElementType, NumElements)];
 
@@ -597,6 +605,7 @@ VectorType *VectorType::get(Type *ElementType, ElementCount EC) {
                                             "pointer type.");
 
   LLVMContextImpl *pImpl = ElementType->getContext().pImpl;
+  auto Lock = pImpl->lockTypes();
   VectorType *&Entry = ElementType->getContext().pImpl
                                  ->VectorTypes[std::make_pair(ElementType, EC)];
   if (!Entry)
@@ -618,6 +627,7 @@ PointerType *PointerType::get(Type *EltTy, unsigned AddressSpace) {
   assert(isValidElementType(EltTy) && "Invalid type for pointer element!");
 
   LLVMContextImpl *CImpl = EltTy->getContext().pImpl;
+  auto Lock = CImpl->lockTypes();
 
   // Since AddressSpace #0 is the common case, we special case it.
   PointerType *&Entry = AddressSpace == 0 ? CImpl->PointerTypes[EltTy]
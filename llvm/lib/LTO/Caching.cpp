@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/LTO/Caching.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -27,6 +28,11 @@
 using namespace llvm;
 using namespace llvm::lto;
 
+#define DEBUG_TYPE "lto-cache"
+
+STATISTIC(NumCacheHits, "Number of native objects found in the cache");
+STATISTIC(NumCacheMisses, "Number of native objects added to the cache");
+
 Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                                             AddBufferFn AddBuffer) {
   if (std::error_code EC = sys::fs::create_directories(CacheDirectoryPath))
@@ -49,6 +55,7 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                                     /*RequiresNullTerminator=*/false);
       sys::fs::closeFile(*FDOrErr);
       if (MBOrErr) {
+        ++NumCacheHits;
         AddBuffer(Task, std::move(*MBOrErr));
         return AddStreamFn();
       }
@@ -67,6 +74,8 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       report_fatal_error(Twine("Failed to open cache file ") + EntryPath +
                          ": " + EC.message() + "\n");
 
+    ++NumCacheMisses;
+
     // This native object stream is responsible for commiting the resulting
     // file to the cache and calling AddBuffer to add it to the link.
     struct CacheStream : NativeObjectStream {
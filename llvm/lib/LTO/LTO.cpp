@@ -51,6 +51,7 @@
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <numeric>
 #include <set>
 
 using namespace llvm;
@@ -63,6 +64,13 @@ static cl::opt<bool>
     DumpThinCGSCCs("dump-thin-cg-sccs", cl::init(false), cl::Hidden,
                    cl::desc("Dump the SCCs in the ThinLTO index's callgraph"));
 
+static cl::opt<std::string> ThinLTOBackendCostsFile(
+    "thinlto-backend-costs", cl::init(""), cl::Hidden,
+    cl::value_desc("filename"),
+    cl::desc("Write the estimated cost of each ThinLTO backend to this file, "
+             "largest first, so that distributed builds can balance their "
+             "shards"));
+
 /// Enable global value internalization in LTO.
 cl::opt<bool> EnableLTOInternalization(
     "enable-lto-internalization", cl::init(true), cl::Hidden,
@@ -819,27 +827,30 @@ Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
     if (!Sym.getIRName().empty()) {
       auto GUID = GlobalValue::getGUID(GlobalValue::getGlobalIdentifier(
           Sym.getIRName(), GlobalValue::ExternalLinkage, ""));
-      if (Res.Prevailing) {
+      if (Res.Prevailing)
         ThinLTO.PrevailingModuleForGUID[GUID] = BM.getModuleIdentifier();
 
-        // For linker redefined symbols (via --wrap or --defsym) we want to
-        // switch the linkage to `weak` to prevent IPOs from happening.
-        // Find the summary in the module for this very GV and record the new
-        // linkage so that we can switch it when we import the GV.
-        if (Res.LinkerRedefined)
-          if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
-                  GUID, BM.getModuleIdentifier()))
-            S->setLinkage(GlobalValue::WeakAnyLinkage);
-      }
+      bool RedefinedPrevailing = Res.Prevailing && Res.LinkerRedefined;
+      if (!RedefinedPrevailing && !Res.FinalDefinitionInLinkageUnit)
+        continue;
+
+      // Look the summary of this very GV up once for both updates below; the
+      // combined index can hold millions of GUIDs.
+      GlobalValueSummary *S = ThinLTO.CombinedIndex.findSummaryInModule(
+          GUID, BM.getModuleIdentifier());
+      if (!S)
+        continue;
+
+      // For linker redefined symbols (via --wrap or --defsym) we want to
+      // switch the linkage to `weak` to prevent IPOs from happening.
+      // Record the new linkage so that we can switch it when we import the GV.
+      if (RedefinedPrevailing)
+        S->setLinkage(GlobalValue::WeakAnyLinkage);
 
       // If the linker resolved the symbol to a local definition then mark it
       // as local in the summary for the module we are adding.
-      if (Res.FinalDefinitionInLinkageUnit) {
-        if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
-                GUID, BM.getModuleIdentifier())) {
-          S->setDSOLocal(true);
-        }
-      }
+      if (Res.FinalDefinitionInLinkageUnit)
+        S->setDSOLocal(true);
     }
   }
 
@@ -1065,6 +1076,9 @@ public:
       const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
       MapVector<StringRef, BitcodeModule> &ModuleMap) = 0;
   virtual Error wait() = 0;
+  /// Returns true if the backends must be started in the order of the input
+  /// modules, e.g. because they list their outputs in that order.
+  virtual bool isSensitiveToInputOrder() { return false; }
 };
 
 namespace {
@@ -1230,6 +1244,11 @@ public:
         ShouldEmitImportsFiles(ShouldEmitImportsFiles),
         LinkedObjectsFile(LinkedObjectsFile), OnWrite(OnWrite) {}
 
+  bool isSensitiveToInputOrder() override {
+    // The linked objects file lists the modules in input order.
+    return true;
+  }
+
   Error start(
       unsigned Task, BitcodeModule BM,
       const FunctionImporter::ImportMapTy &ImportList,
@@ -1282,6 +1301,41 @@ ThinBackend lto::createWriteIndexesThinBackend(
   };
 }
 
+/// Returns a rough estimate of the time taken by the backend of a module: the
+/// number of instructions it defines plus the number it imports.
+static uint64_t
+estimateThinBackendCost(const ModuleSummaryIndex &Index,
+                        const GVSummaryMapTy &DefinedGVSummaries,
+                        const FunctionImporter::ImportMapTy &ImportList) {
+  uint64_t Cost = 0;
+  for (auto &DefinedGV : DefinedGVSummaries) {
+    // Count every definition, so that modules without functions are not free.
+    ++Cost;
+    if (auto *FS = dyn_cast<FunctionSummary>(DefinedGV.second))
+      Cost += FS->instCount();
+  }
+  for (auto &ImportedFrom : ImportList)
+    for (GlobalValue::GUID GUID : ImportedFrom.second)
+      if (auto *FS = dyn_cast_or_null<FunctionSummary>(
+              Index.findSummaryInModule(GUID, ImportedFrom.first())))
+        Cost += FS->instCount();
+  return Cost;
+}
+
+/// Writes one "<cost> <module>" line per ThinLTO backend, in \p Ordering.
+static Error
+writeThinBackendCosts(StringRef Path,
+                      const MapVector<StringRef, BitcodeModule> &ModuleMap,
+                      ArrayRef<uint64_t> Costs, ArrayRef<unsigned> Ordering) {
+  std::error_code EC;
+  raw_fd_ostream OS(Path, EC, sys::fs::OpenFlags::OF_Text);
+  if (EC)
+    return errorCodeToError(EC);
+  for (unsigned I : Ordering)
+    OS << Costs[I] << ' ' << ModuleMap.begin()[I].first << '\n';
+  return Error::success();
+}
+
 Error LTO::runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache,
                       const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols) {
   if (ThinLTO.ModuleMap.empty())
@@ -1391,15 +1445,42 @@ Error LTO::runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache,
       ThinLTO.Backend(Conf, ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries,
                       AddStream, Cache);
 
+  // Estimate the cost of each backend from the summaries of the functions it
+  // defines and imports.
+  std::vector<uint64_t> Costs;
+  Costs.reserve(ThinLTO.ModuleMap.size());
+  for (auto &Mod : ThinLTO.ModuleMap)
+    Costs.push_back(estimateThinBackendCost(
+        ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries[Mod.first],
+        ImportLists[Mod.first]));
+
+  // Start the most expensive backends first so that the longest one does not
+  // end up running alone at the end. This is purely a compile-time
+  // optimization: the task numbers, and thus the outputs, do not depend on it.
+  std::vector<unsigned> ModulesOrdering(ThinLTO.ModuleMap.size());
+  std::iota(ModulesOrdering.begin(), ModulesOrdering.end(), 0);
+  llvm::stable_sort(ModulesOrdering, [&](unsigned L, unsigned R) {
+    return Costs[L] > Costs[R];
+  });
+
+  if (!ThinLTOBackendCostsFile.empty())
+    if (Error E = writeThinBackendCosts(ThinLTOBackendCostsFile,
+                                        ThinLTO.ModuleMap, Costs,
+                                        ModulesOrdering))
+      return E;
+
+  if (BackendProc->isSensitiveToInputOrder())
+    std::iota(ModulesOrdering.begin(), ModulesOrdering.end(), 0);
+
   // Tasks 0 through ParallelCodeGenParallelismLevel-1 are reserved for combined
   // module and parallel code generation partitions.
-  unsigned Task = RegularLTO.ParallelCodeGenParallelismLevel;
-  for (auto &Mod : ThinLTO.ModuleMap) {
+  for (unsigned I : ModulesOrdering) {
+    auto &Mod = ThinLTO.ModuleMap.begin()[I];
+    unsigned Task = RegularLTO.ParallelCodeGenParallelismLevel + I;
     if (Error E = BackendProc->start(Task, Mod.second, ImportLists[Mod.first],
                                      ExportLists[Mod.first],
                                      ResolvedODR[Mod.first], ThinLTO.ModuleMap))
       return E;
-    ++Task;
   }
 
   return BackendProc->wait();
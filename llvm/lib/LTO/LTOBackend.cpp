@@ -397,7 +397,7 @@ void splitCodeGen(const Config &C, TargetMachine *TM, AddStreamFn AddStream,
 
         // Enqueue the task
         CodegenThreadPool.async(
-            [&](const SmallString<0> &BC, unsigned ThreadId) {
+            [&](SmallString<0> &BC, unsigned ThreadId) {
               LTOLLVMContext Ctx(C);
               Expected<std::unique_ptr<Module>> MOrErr = parseBitcodeFile(
                   MemoryBufferRef(StringRef(BC.data(), BC.size()), "ld-temp.o"),
@@ -406,6 +406,10 @@ void splitCodeGen(const Config &C, TargetMachine *TM, AddStreamFn AddStream,
                 report_fatal_error("Failed to read bitcode");
               std::unique_ptr<Module> MPartInCtx = std::move(MOrErr.get());
 
+              // The module is fully materialized, so free its bitcode now
+              // rather than keeping it alive during codegen.
+              BC = SmallString<0>();
+
               std::unique_ptr<TargetMachine> TM =
                   createTargetMachine(C, T, *MPartInCtx);
 
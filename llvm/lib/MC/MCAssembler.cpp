@@ -68,6 +68,8 @@ STATISTIC(FragmentLayouts, "Number of fragment layouts");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
+STATISTIC(SectionRelaxationPasses,
+          "Number of relaxation passes over a single section");
 
 } // end namespace stats
 } // end anonymous namespace
@@ -1139,6 +1141,7 @@ bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
   // When a fragment is relaxed, all the fragments following it should get
   // invalidated because their offset is going to change.
   MCFragment *FirstRelaxedFragment = nullptr;
+  ++stats::SectionRelaxationPasses;
 
   // Attempt to relax all the fragments in the section.
   for (MCFragment &Frag : Sec) {
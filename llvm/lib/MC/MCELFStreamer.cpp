@@ -513,6 +513,26 @@ void MCELFStreamer::EmitInstToData(const MCInst &Inst,
                                    const MCSubtargetInfo &STI) {
   MCAssembler &Assembler = getAssembler();
   SmallVector<MCFixup, 4> Fixups;
+
+  // Without bundling the instruction always ends up at the end of the current
+  // data fragment, so encode it straight into the fragment's contents instead
+  // of going through a temporary buffer.
+  if (!Assembler.isBundlingEnabled()) {
+    MCDataFragment *DF = getOrCreateDataFragment(&STI);
+    SmallVectorImpl<char> &Contents = DF->getContents();
+    size_t CodeOffset = Contents.size();
+    raw_svector_ostream VecOS(Contents);
+    Assembler.getEmitter().encodeInstruction(Inst, VecOS, Fixups, STI);
+
+    for (MCFixup &Fixup : Fixups) {
+      fixSymbolsInTLSFixups(Fixup.getValue());
+      Fixup.setOffset(Fixup.getOffset() + CodeOffset);
+      DF->getFixups().push_back(Fixup);
+    }
+    DF->setHasInstructions(STI);
+    return;
+  }
+
   SmallString<256> Code;
   raw_svector_ostream VecOS(Code);
   Assembler.getEmitter().encodeInstruction(Inst, VecOS, Fixups, STI);
@@ -520,13 +540,7 @@ void MCELFStreamer::EmitInstToData(const MCInst &Inst,
   for (unsigned i = 0, e = Fixups.size(); i != e; ++i)
     fixSymbolsInTLSFixups(Fixups[i].getValue());
 
-  // There are several possibilities here:
-  //
-  // If bundling is disabled, append the encoded instruction to the current data
-  // fragment (or create a new such fragment if the current fragment is not a
-  // data fragment, or the Subtarget has changed).
-  //
-  // If bundling is enabled:
+  // With bundling enabled there are several possibilities here:
   // - If we're not in a bundle-locked group, emit the instruction into a
   //   fragment of its own. If there are no fixups registered for the
   //   instruction, emit a MCCompactEncodedInstFragment. Otherwise, emit a
@@ -536,54 +550,50 @@ void MCELFStreamer::EmitInstToData(const MCInst &Inst,
   //   the same fragment. Be careful not to do that for the first instruction in
   //   the group, though.
   MCDataFragment *DF;
+  MCSection &Sec = *getCurrentSectionOnly();
 
-  if (Assembler.isBundlingEnabled()) {
-    MCSection &Sec = *getCurrentSectionOnly();
-    if (Assembler.getRelaxAll() && isBundleLocked()) {
-      // If the -mc-relax-all flag is used and we are bundle-locked, we re-use
-      // the current bundle group.
-      DF = BundleGroups.back();
-      CheckBundleSubtargets(DF->getSubtargetInfo(), &STI);
-    }
-    else if (Assembler.getRelaxAll() && !isBundleLocked())
-      // When not in a bundle-locked group and the -mc-relax-all flag is used,
-      // we create a new temporary fragment which will be later merged into
-      // the current fragment.
-      DF = new MCDataFragment();
-    else if (isBundleLocked() && !Sec.isBundleGroupBeforeFirstInst()) {
-      // If we are bundle-locked, we re-use the current fragment.
-      // The bundle-locking directive ensures this is a new data fragment.
-      DF = cast<MCDataFragment>(getCurrentFragment());
-      CheckBundleSubtargets(DF->getSubtargetInfo(), &STI);
-    }
-    else if (!isBundleLocked() && Fixups.size() == 0) {
-      // Optimize memory usage by emitting the instruction to a
-      // MCCompactEncodedInstFragment when not in a bundle-locked group and
-      // there are no fixups registered.
-      MCCompactEncodedInstFragment *CEIF = new MCCompactEncodedInstFragment();
-      insert(CEIF);
-      CEIF->getContents().append(Code.begin(), Code.end());
-      CEIF->setHasInstructions(STI);
-      return;
-    } else {
-      DF = new MCDataFragment();
-      insert(DF);
-    }
-    if (Sec.getBundleLockState() == MCSection::BundleLockedAlignToEnd) {
-      // If this fragment is for a group marked "align_to_end", set a flag
-      // in the fragment. This can happen after the fragment has already been
-      // created if there are nested bundle_align groups and an inner one
-      // is the one marked align_to_end.
-      DF->setAlignToBundleEnd(true);
-    }
-
-    // We're now emitting an instruction in a bundle group, so this flag has
-    // to be turned off.
-    Sec.setBundleGroupBeforeFirstInst(false);
+  if (Assembler.getRelaxAll() && isBundleLocked()) {
+    // If the -mc-relax-all flag is used and we are bundle-locked, we re-use
+    // the current bundle group.
+    DF = BundleGroups.back();
+    CheckBundleSubtargets(DF->getSubtargetInfo(), &STI);
+  }
+  else if (Assembler.getRelaxAll() && !isBundleLocked())
+    // When not in a bundle-locked group and the -mc-relax-all flag is used,
+    // we create a new temporary fragment which will be later merged into
+    // the current fragment.
+    DF = new MCDataFragment();
+  else if (isBundleLocked() && !Sec.isBundleGroupBeforeFirstInst()) {
+    // If we are bundle-locked, we re-use the current fragment.
+    // The bundle-locking directive ensures this is a new data fragment.
+    DF = cast<MCDataFragment>(getCurrentFragment());
+    CheckBundleSubtargets(DF->getSubtargetInfo(), &STI);
+  }
+  else if (!isBundleLocked() && Fixups.size() == 0) {
+    // Optimize memory usage by emitting the instruction to a
+    // MCCompactEncodedInstFragment when not in a bundle-locked group and
+    // there are no fixups registered.
+    MCCompactEncodedInstFragment *CEIF = new MCCompactEncodedInstFragment();
+    insert(CEIF);
+    CEIF->getContents().append(Code.begin(), Code.end());
+    CEIF->setHasInstructions(STI);
+    return;
   } else {
-    DF = getOrCreateDataFragment(&STI);
+    DF = new MCDataFragment();
+    insert(DF);
+  }
+  if (Sec.getBundleLockState() == MCSection::BundleLockedAlignToEnd) {
+    // If this fragment is for a group marked "align_to_end", set a flag
+    // in the fragment. This can happen after the fragment has already been
+    // created if there are nested bundle_align groups and an inner one
+    // is the one marked align_to_end.
+    DF->setAlignToBundleEnd(true);
   }
 
+  // We're now emitting an instruction in a bundle group, so this flag has
+  // to be turned off.
+  Sec.setBundleGroupBeforeFirstInst(false);
+
   // Add the fixups and data.
   for (unsigned i = 0, e = Fixups.size(); i != e; ++i) {
     Fixups[i].setOffset(Fixups[i].getOffset() + DF->getContents().size());
@@ -592,7 +602,7 @@ void MCELFStreamer::EmitInstToData(const MCInst &Inst,
   DF->setHasInstructions(STI);
   DF->getContents().append(Code.begin(), Code.end());
 
-  if (Assembler.isBundlingEnabled() && Assembler.getRelaxAll()) {
+  if (Assembler.getRelaxAll()) {
     if (!isBundleLocked()) {
       mergeFragment(getOrCreateDataFragment(&STI), DF);
       delete DF;
@@ -12,6 +12,8 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
@@ -25,6 +27,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
@@ -454,7 +457,32 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
-  for (const NewArchiveMember &M : NewMembers) {
+  // Reading the symbols of one member does not depend on any other, and for
+  // large archives it dominates the cost of writing them, so collect them in
+  // parallel. Each member gets its own name buffer with offsets relative to
+  // it; they are appended to SymNames in member order below.
+  struct MemberSymbols {
+    std::string Names;
+    Optional<Expected<std::vector<unsigned>>> Offsets;
+    bool HasObject = false;
+  };
+  std::vector<MemberSymbols> Symbols(NewMembers.size());
+  parallel::for_each_n(parallel::par, size_t(0), NewMembers.size(),
+                       [&](size_t I) {
+                         MemberSymbols &MS = Symbols[I];
+                         raw_string_ostream Names(MS.Names);
+                         MS.Offsets.emplace(
+                             getSymbols(NewMembers[I].Buf->getMemBufferRef(),
+                                        Names, MS.HasObject));
+                       });
+  // Make sure no result is left unchecked if we bail out early.
+  auto ConsumeSymbols = make_scope_exit([&] {
+    for (MemberSymbols &MS : Symbols)
+      consumeError(MS.Offsets->takeError());
+  });
+
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+    const NewArchiveMember &M = NewMembers[I];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -490,13 +518,18 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                       ModTime, Size);
     Out.flush();
 
-    Expected<std::vector<unsigned>> Symbols =
-        getSymbols(Buf, SymNames, HasObject);
-    if (auto E = Symbols.takeError())
+    MemberSymbols &MS = Symbols[I];
+    Expected<std::vector<unsigned>> &Offsets = *MS.Offsets;
+    if (auto E = Offsets.takeError())
       return std::move(E);
+    HasObject |= MS.HasObject;
+    uint64_t NamesBase = SymNames.tell();
+    for (unsigned &Offset : *Offsets)
+      Offset += NamesBase;
+    SymNames << MS.Names;
 
     Pos += Header.size() + Data.size() + Padding.size();
-    Ret.push_back({std::move(*Symbols), std::move(Header), Data, Padding});
+    Ret.push_back({std::move(*Offsets), std::move(Header), Data, Padding});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
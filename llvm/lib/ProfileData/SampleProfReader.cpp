@@ -559,7 +559,20 @@ std::error_code SampleProfileReaderExtBinary::readFuncProfiles() {
       if (std::error_code EC = readFuncProfile(FuncProfileAddr))
         return EC;
     }
+  } else if (!Remapper) {
+    // Look up each function of the module, rather than scanning the offset
+    // table, which usually covers far more functions than a module defines.
+    for (auto Name : FuncsToUse) {
+      auto iter = FuncOffsetTable.find(Name);
+      if (iter == FuncOffsetTable.end())
+        continue;
+      const uint8_t *FuncProfileAddr = Start + iter->second;
+      assert(FuncProfileAddr < End && "out of LBRProfile section");
+      if (std::error_code EC = readFuncProfile(FuncProfileAddr))
+        return EC;
+    }
   } else {
+    // Remapped names can only be matched by visiting every profiled name.
     for (auto NameOffset : FuncOffsetTable) {
       auto FuncName = NameOffset.first;
       if (!FuncsToUse.count(FuncName) &&
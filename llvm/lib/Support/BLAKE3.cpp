@@ -0,0 +1,402 @@
+//===- BLAKE3.cpp - BLAKE3 hash function ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the BLAKE3 hash function following the reference
+// implementation in the specification. Only the default hash mode with a
+// 256-bit output is provided.
+//
+// Whole chunks are hashed four at a time with SSE2 when it is available. Each
+// vector lane holds the state of one chunk.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Parallel.h"
+
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace llvm;
+using namespace llvm::support;
+
+enum : uint32_t {
+  CHUNK_START = 1 << 0,
+  CHUNK_END = 1 << 1,
+  PARENT = 1 << 2,
+  ROOT = 1 << 3,
+};
+
+static const size_t ChunkLength = 1024;
+
+static const uint32_t IV[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372,
+                               0xA54FF53A, 0x510E527F, 0x9B05688C,
+                               0x1F83D9AB, 0x5BE0CD19};
+
+// The message word permutation applied before each round.
+static const uint8_t MsgSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+static inline uint32_t rotr(uint32_t X, int N) {
+  return (X >> N) | (X << (32 - N));
+}
+
+static inline void g(uint32_t *V, int A, int B, int C, int D, uint32_t X,
+                     uint32_t Y) {
+  V[A] = V[A] + V[B] + X;
+  V[D] = rotr(V[D] ^ V[A], 16);
+  V[C] = V[C] + V[D];
+  V[B] = rotr(V[B] ^ V[C], 12);
+  V[A] = V[A] + V[B] + Y;
+  V[D] = rotr(V[D] ^ V[A], 8);
+  V[C] = V[C] + V[D];
+  V[B] = rotr(V[B] ^ V[C], 7);
+}
+
+// The BLAKE3 compression function. Only the first eight words of the output,
+// which are the chaining value, are computed.
+static void compress(const uint32_t CV[8], const uint32_t M[16],
+                     uint64_t Counter, uint32_t BlockLength, uint32_t Flags,
+                     uint32_t Out[8]) {
+  uint32_t V[16] = {CV[0],
+                    CV[1],
+                    CV[2],
+                    CV[3],
+                    CV[4],
+                    CV[5],
+                    CV[6],
+                    CV[7],
+                    IV[0],
+                    IV[1],
+                    IV[2],
+                    IV[3],
+                    static_cast<uint32_t>(Counter),
+                    static_cast<uint32_t>(Counter >> 32),
+                    BlockLength,
+                    Flags};
+  for (const uint8_t *S : MsgSchedule) {
+    g(V, 0, 4, 8, 12, M[S[0]], M[S[1]]);
+    g(V, 1, 5, 9, 13, M[S[2]], M[S[3]]);
+    g(V, 2, 6, 10, 14, M[S[4]], M[S[5]]);
+    g(V, 3, 7, 11, 15, M[S[6]], M[S[7]]);
+    g(V, 0, 5, 10, 15, M[S[8]], M[S[9]]);
+    g(V, 1, 6, 11, 12, M[S[10]], M[S[11]]);
+    g(V, 2, 7, 8, 13, M[S[12]], M[S[13]]);
+    g(V, 3, 4, 9, 14, M[S[14]], M[S[15]]);
+  }
+  for (int I = 0; I < 8; ++I)
+    Out[I] = V[I] ^ V[I + 8];
+}
+
+static void compressBlock(uint32_t CV[8], const uint8_t *Block,
+                          uint64_t Counter, uint32_t BlockLength,
+                          uint32_t Flags) {
+  uint32_t M[16];
+  for (int I = 0; I < 16; ++I)
+    M[I] = endian::read32le(Block + I * 4);
+  compress(CV, M, Counter, BlockLength, Flags, CV);
+}
+
+static void parentCV(const uint32_t Left[8], const uint32_t Right[8],
+                     uint32_t Out[8], uint32_t Flags = 0) {
+  uint32_t M[16];
+  memcpy(M, Left, 32);
+  memcpy(M + 8, Right, 32);
+  compress(IV, M, 0, 64, PARENT | Flags, Out);
+}
+
+// Computes the chaining value of a whole chunk.
+static void chunkCV(const uint8_t *Chunk, uint64_t Counter, uint32_t Out[8]) {
+  memcpy(Out, IV, 32);
+  for (int I = 0; I < 16; ++I)
+    compressBlock(Out, Chunk + I * 64, Counter, 64,
+                  (I == 0 ? CHUNK_START : 0) | (I == 15 ? CHUNK_END : 0));
+}
+
+#ifdef __SSE2__
+static inline __m128i add(__m128i A, __m128i B) { return _mm_add_epi32(A, B); }
+
+static inline __m128i rotr(__m128i X, int N) {
+  return _mm_or_si128(_mm_srli_epi32(X, N), _mm_slli_epi32(X, 32 - N));
+}
+
+static inline void g(__m128i *V, int A, int B, int C, int D, __m128i X,
+                     __m128i Y) {
+  V[A] = add(add(V[A], V[B]), X);
+  V[D] = rotr(_mm_xor_si128(V[D], V[A]), 16);
+  V[C] = add(V[C], V[D]);
+  V[B] = rotr(_mm_xor_si128(V[B], V[C]), 12);
+  V[A] = add(add(V[A], V[B]), Y);
+  V[D] = rotr(_mm_xor_si128(V[D], V[A]), 8);
+  V[C] = add(V[C], V[D]);
+  V[B] = rotr(_mm_xor_si128(V[B], V[C]), 7);
+}
+
+// Loads word I of block Offset of four consecutive chunks into the four lanes
+// of M[I].
+static inline void loadMessage(const uint8_t *Chunks, size_t Offset,
+                               __m128i M[16]) {
+  for (int I = 0; I < 16; I += 4) {
+    const uint8_t *P = Chunks + Offset + I * 4;
+    __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i *>(P));
+    __m128i B = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(P + ChunkLength));
+    __m128i C = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(P + 2 * ChunkLength));
+    __m128i D = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(P + 3 * ChunkLength));
+    __m128i AB0 = _mm_unpacklo_epi32(A, B);
+    __m128i CD0 = _mm_unpacklo_epi32(C, D);
+    __m128i AB1 = _mm_unpackhi_epi32(A, B);
+    __m128i CD1 = _mm_unpackhi_epi32(C, D);
+    M[I] = _mm_unpacklo_epi64(AB0, CD0);
+    M[I + 1] = _mm_unpackhi_epi64(AB0, CD0);
+    M[I + 2] = _mm_unpacklo_epi64(AB1, CD1);
+    M[I + 3] = _mm_unpackhi_epi64(AB1, CD1);
+  }
+}
+
+// Computes the chaining values of four consecutive whole chunks.
+static void chunkCV4(const uint8_t *Chunks, uint64_t Counter,
+                     uint32_t Out[4][8]) {
+  __m128i H[8];
+  for (int I = 0; I < 8; ++I)
+    H[I] = _mm_set1_epi32(IV[I]);
+  __m128i CounterLow = _mm_setr_epi32(
+      uint32_t(Counter), uint32_t(Counter + 1), uint32_t(Counter + 2),
+      uint32_t(Counter + 3));
+  __m128i CounterHigh = _mm_setr_epi32(
+      uint32_t(Counter >> 32), uint32_t((Counter + 1) >> 32),
+      uint32_t((Counter + 2) >> 32), uint32_t((Counter + 3) >> 32));
+
+  for (int Block = 0; Block < 16; ++Block) {
+    __m128i M[16];
+    loadMessage(Chunks, Block * 64, M);
+    uint32_t Flags =
+        (Block == 0 ? CHUNK_START : 0) | (Block == 15 ? CHUNK_END : 0);
+    __m128i V[16] = {H[0],
+                     H[1],
+                     H[2],
+                     H[3],
+                     H[4],
+                     H[5],
+                     H[6],
+                     H[7],
+                     _mm_set1_epi32(IV[0]),
+                     _mm_set1_epi32(IV[1]),
+                     _mm_set1_epi32(IV[2]),
+                     _mm_set1_epi32(IV[3]),
+                     CounterLow,
+                     CounterHigh,
+                     _mm_set1_epi32(64),
+                     _mm_set1_epi32(Flags)};
+    for (const uint8_t *S : MsgSchedule) {
+      g(V, 0, 4, 8, 12, M[S[0]], M[S[1]]);
+      g(V, 1, 5, 9, 13, M[S[2]], M[S[3]]);
+      g(V, 2, 6, 10, 14, M[S[4]], M[S[5]]);
+      g(V, 3, 7, 11, 15, M[S[6]], M[S[7]]);
+      g(V, 0, 5, 10, 15, M[S[8]], M[S[9]]);
+      g(V, 1, 6, 11, 12, M[S[10]], M[S[11]]);
+      g(V, 2, 7, 8, 13, M[S[12]], M[S[13]]);
+      g(V, 3, 4, 9, 14, M[S[14]], M[S[15]]);
+    }
+    for (int I = 0; I < 8; ++I)
+      H[I] = _mm_xor_si128(V[I], V[I + 8]);
+  }
+
+  for (int I = 0; I < 8; ++I) {
+    uint32_t Lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(Lanes), H[I]);
+    for (int Lane = 0; Lane < 4; ++Lane)
+      Out[Lane][I] = Lanes[Lane];
+  }
+}
+#else
+static void chunkCV4(const uint8_t *Chunks, uint64_t Counter,
+                     uint32_t Out[4][8]) {
+  for (int I = 0; I < 4; ++I)
+    chunkCV(Chunks + I * ChunkLength, Counter + I, Out[I]);
+}
+#endif
+
+// Computes the chaining value of a complete subtree of NumChunks whole chunks.
+// NumChunks must be a power of two.
+static void subtreeCV(const uint8_t *Data, size_t NumChunks, uint64_t Counter,
+                      uint32_t Out[8]) {
+  if (NumChunks == 1) {
+    chunkCV(Data, Counter, Out);
+    return;
+  }
+  if (NumChunks == 2) {
+    uint32_t CVs[2][8];
+    chunkCV(Data, Counter, CVs[0]);
+    chunkCV(Data + ChunkLength, Counter + 1, CVs[1]);
+    parentCV(CVs[0], CVs[1], Out);
+    return;
+  }
+  if (NumChunks == 4) {
+    uint32_t CVs[4][8];
+    chunkCV4(Data, Counter, CVs);
+    parentCV(CVs[0], CVs[1], CVs[0]);
+    parentCV(CVs[2], CVs[3], CVs[2]);
+    parentCV(CVs[0], CVs[2], Out);
+    return;
+  }
+  size_t Half = NumChunks / 2;
+  uint32_t Left[8], Right[8];
+  subtreeCV(Data, Half, Counter, Left);
+  subtreeCV(Data + Half * ChunkLength, Half, Counter + Half, Right);
+  parentCV(Left, Right, Out);
+}
+
+void BLAKE3::init() {
+  resetChunk(0);
+  CVStackLength = 0;
+}
+
+void BLAKE3::resetChunk(uint64_t Counter) {
+  memcpy(ChunkCV, IV, sizeof(ChunkCV));
+  ChunkCounter = Counter;
+  memset(Block, 0, sizeof(Block));
+  BlockLength = 0;
+  BlocksCompressed = 0;
+}
+
+// Adds the chaining value of a subtree whose size is a power of two, and
+// merges equal sized subtrees. TotalSubtrees is the number of subtrees of
+// that size added so far, which must be a multiple of the size of every
+// subtree on the stack.
+void BLAKE3::pushChainingValue(const uint32_t CV[8], uint64_t TotalSubtrees) {
+  uint32_t NewCV[8];
+  memcpy(NewCV, CV, sizeof(NewCV));
+  while ((TotalSubtrees & 1) == 0) {
+    parentCV(CVStack[--CVStackLength], NewCV, NewCV);
+    TotalSubtrees >>= 1;
+  }
+  memcpy(CVStack[CVStackLength++], NewCV, sizeof(NewCV));
+}
+
+void BLAKE3::update(ArrayRef<uint8_t> Data) {
+  while (!Data.empty()) {
+    // A chunk is finished only when more data arrives, because the last
+    // chunk is finalized differently if it is the root.
+    if (chunkLength() == CHUNK_LENGTH) {
+      uint32_t CV[8];
+      memcpy(CV, ChunkCV, sizeof(CV));
+      compressBlock(CV, Block, ChunkCounter, BLOCK_LENGTH,
+                    CHUNK_END | (BlocksCompressed == 0 ? CHUNK_START : 0));
+      pushChainingValue(CV, ChunkCounter + 1);
+      resetChunk(ChunkCounter + 1);
+    }
+
+    // Hash whole chunks directly from the input when nothing is buffered,
+    // keeping at least one byte for the last chunk.
+    if (chunkLength() == 0 && Data.size() > CHUNK_LENGTH) {
+      uint64_t Counter = ChunkCounter;
+      while (Data.size() > 4 * CHUNK_LENGTH) {
+        uint32_t CVs[4][8];
+        chunkCV4(Data.data(), Counter, CVs);
+        for (int I = 0; I < 4; ++I)
+          pushChainingValue(CVs[I], Counter + I + 1);
+        Counter += 4;
+        Data = Data.drop_front(4 * CHUNK_LENGTH);
+      }
+      while (Data.size() > CHUNK_LENGTH) {
+        uint32_t CV[8];
+        chunkCV(Data.data(), Counter, CV);
+        pushChainingValue(CV, ++Counter);
+        Data = Data.drop_front(CHUNK_LENGTH);
+      }
+      ChunkCounter = Counter;
+    }
+
+    // Compress the buffered block only when more data arrives, because the
+    // last block of a chunk is flagged.
+    if (BlockLength == BLOCK_LENGTH) {
+      compressBlock(ChunkCV, Block, ChunkCounter, BLOCK_LENGTH,
+                    BlocksCompressed == 0 ? CHUNK_START : 0);
+      ++BlocksCompressed;
+      memset(Block, 0, sizeof(Block));
+      BlockLength = 0;
+    }
+
+    size_t N = std::min<size_t>(BLOCK_LENGTH - BlockLength, Data.size());
+    memcpy(Block + BlockLength, Data.data(), N);
+    BlockLength += N;
+    Data = Data.drop_front(N);
+  }
+}
+
+std::array<uint8_t, 32> BLAKE3::final() const {
+  // The output of the last chunk, which becomes the root if it is the only
+  // chunk.
+  uint32_t CV[8];
+  memcpy(CV, ChunkCV, sizeof(CV));
+  uint32_t M[16];
+  for (int I = 0; I < 16; ++I)
+    M[I] = endian::read32le(Block + I * 4);
+  uint64_t Counter = ChunkCounter;
+  uint32_t Flags = CHUNK_END | (BlocksCompressed == 0 ? CHUNK_START : 0);
+  uint32_t Length = BlockLength;
+
+  for (unsigned I = CVStackLength; I != 0; --I) {
+    compress(CV, M, Counter, Length, Flags, M + 8);
+    memcpy(M, CVStack[I - 1], 32);
+    memcpy(CV, IV, sizeof(CV));
+    Counter = 0;
+    Flags = PARENT;
+    Length = BLOCK_LENGTH;
+  }
+
+  uint32_t Out[8];
+  compress(CV, M, 0, Length, Flags | ROOT, Out);
+  std::array<uint8_t, 32> Result;
+  for (int I = 0; I < 8; ++I)
+    endian::write32le(Result.data() + I * 4, Out[I]);
+  return Result;
+}
+
+std::array<uint8_t, 32> BLAKE3::hash(ArrayRef<uint8_t> Data) {
+  BLAKE3 Hash;
+  Hash.update(Data);
+  return Hash.final();
+}
+
+std::array<uint8_t, 32> BLAKE3::parallelHash(ArrayRef<uint8_t> Data) {
+  // Each task hashes a complete subtree of 256 KiB. The remaining data, which
+  // is at least one byte, is hashed on this thread.
+  const size_t SubtreeChunks = 256;
+  const size_t SubtreeLength = SubtreeChunks * CHUNK_LENGTH;
+  size_t NumSubtrees = Data.empty() ? 0 : (Data.size() - 1) / SubtreeLength;
+  if (NumSubtrees < 2)
+    return hash(Data);
+
+  std::vector<std::array<uint32_t, 8>> CVs(NumSubtrees);
+  parallel::for_each_n(parallel::par, size_t(0), NumSubtrees, [&](size_t I) {
+    subtreeCV(Data.data() + I * SubtreeLength, SubtreeChunks,
+              I * SubtreeChunks, CVs[I].data());
+  });
+
+  BLAKE3 Hash;
+  for (size_t I = 0; I != NumSubtrees; ++I)
+    Hash.pushChainingValue(CVs[I].data(), I + 1);
+  Hash.resetChunk(NumSubtrees * SubtreeChunks);
+  Hash.update(Data.drop_front(NumSubtrees * SubtreeLength));
+  return Hash.final();
+}
@@ -164,6 +164,25 @@ public:
   // This collects the different subcommands that have been registered.
   SmallPtrSet<SubCommand *, 4> RegisteredSubCommands;
 
+  // This collects named options of the top-level subcommand. Tools link in
+  // thousands of them, so they are only added to its OptionsMap once it is
+  // actually needed, e.g. when the command line is parsed.
+  std::vector<Option *> PendingOptions;
+
+  // Set once the pending options have been added. Options registered after
+  // that, e.g. by a plugin loaded while parsing, are added right away.
+  bool PendingOptionsAdded = false;
+
+  void addPendingOptions() {
+    PendingOptionsAdded = true;
+    if (PendingOptions.empty())
+      return;
+    std::vector<Option *> Options = std::move(PendingOptions);
+    PendingOptions.clear();
+    for (Option *O : Options)
+      addOption(O, &*TopLevelSubCommand);
+  }
+
   CommandLineParser() : ActiveSubCommand(nullptr) {
     registerSubCommand(&*TopLevelSubCommand);
     registerSubCommand(&*AllSubCommands);
@@ -258,6 +277,11 @@ public:
     }
 
     if (O->Subs.empty()) {
+      if (!PendingOptionsAdded && O->hasArgStr() && !O->isPositional() &&
+          !O->isSink() && !O->isConsumeAfter()) {
+        PendingOptions.push_back(O);
+        return;
+      }
       addOption(O, &*TopLevelSubCommand);
     } else {
       for (auto SC : O->Subs)
@@ -299,6 +323,7 @@ public:
   }
 
   void removeOption(Option *O) {
+    addPendingOptions();
     if (O->Subs.empty())
       removeOption(O, &*TopLevelSubCommand);
     else {
@@ -318,6 +343,8 @@ public:
   }
 
   bool hasOptions() const {
+    if (!PendingOptions.empty())
+      return true;
     for (const auto *S : RegisteredSubCommands) {
       if (hasOptions(*S))
         return true;
@@ -338,6 +365,7 @@ public:
   }
 
   void updateArgStr(Option *O, StringRef NewName) {
+    addPendingOptions();
     if (O->Subs.empty())
       updateArgStr(O, NewName, &*TopLevelSubCommand);
     else {
@@ -406,6 +434,8 @@ public:
 
     ResetAllOptionOccurrences();
     RegisteredSubCommands.clear();
+    PendingOptions.clear();
+    PendingOptionsAdded = false;
 
     TopLevelSubCommand->reset();
     AllSubCommands->reset();
@@ -1297,6 +1327,7 @@ bool cl::ParseCommandLineOptions(int argc, const char *const *argv,
 }
 
 void CommandLineParser::ResetAllOptionOccurrences() {
+  addPendingOptions();
   // So that we can parse different command lines multiple times in succession
   // we reset all option values to look like they have never been seen before.
   for (auto SC : RegisteredSubCommands) {
@@ -1311,6 +1342,7 @@ bool CommandLineParser::ParseCommandLineOptions(int argc,
                                                 raw_ostream *Errs,
                                                 bool LongOptionsUseDoubleDash) {
   assert(hasOptions() && "No options specified!");
+  addPendingOptions();
 
   // Expand response files.
   SmallVector<const char *, 20> newArgv(argv, argv + argc);
@@ -2161,6 +2193,7 @@ public:
   }
 
   void printHelp() {
+    GlobalParser->addPendingOptions();
     SubCommand *Sub = GlobalParser->getActiveSubCommand();
     auto &OptionsMap = Sub->OptionsMap;
     auto &PositionalOpts = Sub->PositionalOpts;
@@ -2420,6 +2453,7 @@ void CommandLineParser::printOptionValues() {
   if (!PrintOptions && !PrintAllOptions)
     return;
 
+  addPendingOptions();
   SmallVector<std::pair<const char *, Option *>, 128> Opts;
   sortOpts(ActiveSubCommand->OptionsMap, Opts, /*ShowHidden*/ true);
 
@@ -2550,6 +2584,7 @@ StringMap<Option *> &cl::getRegisteredOptions(SubCommand &Sub) {
   auto &Subs = GlobalParser->RegisteredSubCommands;
   (void)Subs;
   assert(is_contained(Subs, &Sub));
+  GlobalParser->addPendingOptions();
   return Sub.OptionsMap;
 }
 
@@ -2559,6 +2594,7 @@ cl::getRegisteredSubcommands() {
 }
 
 void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
+  GlobalParser->addPendingOptions();
   for (auto &I : Sub.OptionsMap) {
     for (auto &Cat : I.second->Categories) {
       if (Cat != &Category &&
@@ -2570,6 +2606,7 @@ void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
 
 void cl::HideUnrelatedOptions(ArrayRef<const cl::OptionCategory *> Categories,
                               SubCommand &Sub) {
+  GlobalParser->addPendingOptions();
   for (auto &I : Sub.OptionsMap) {
     for (auto &Cat : I.second->Categories) {
       if (find(Categories, Cat) == Categories.end() && Cat != &GenericCategory)
@@ -0,0 +1,115 @@
+//===- MappedFileCache.cpp - Shared buffers of unchanged files ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/MappedFileCache.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+using namespace llvm;
+
+/// The buffer of one file, shared by all SharedBuffers of the file.
+struct MappedFileCache::Entry {
+  MappedFileCache &Cache;
+  Key K;
+  std::unique_ptr<MemoryBuffer> Buffer;
+
+  Entry(MappedFileCache &Cache, const Key &K,
+        std::unique_ptr<MemoryBuffer> Buffer)
+      : Cache(Cache), K(K), Buffer(std::move(Buffer)) {}
+  ~Entry() { Cache.erase(K); }
+};
+
+class MappedFileCache::SharedBuffer : public MemoryBuffer {
+  std::shared_ptr<Entry> E;
+  std::string Name;
+
+public:
+  SharedBuffer(std::shared_ptr<Entry> E, const Twine &Name,
+               bool RequiresNullTerminator)
+      : E(std::move(E)), Name(Name.str()) {
+    init(this->E->Buffer->getBufferStart(), this->E->Buffer->getBufferEnd(),
+         RequiresNullTerminator);
+  }
+
+  StringRef getBufferIdentifier() const override { return Name; }
+
+  BufferKind getBufferKind() const override {
+    return E->Buffer->getBufferKind();
+  }
+};
+
+MappedFileCache::~MappedFileCache() {
+  assert(Entries.empty() && "buffers outlive their cache");
+}
+
+MappedFileCache &MappedFileCache::getProcessCache() {
+  // Never destroyed, so that buffers may be released during static
+  // destruction.
+  static MappedFileCache *Cache = new MappedFileCache();
+  return *Cache;
+}
+
+ErrorOr<std::unique_ptr<MemoryBuffer>>
+MappedFileCache::getOpenFile(sys::fs::file_t FD, const Twine &Filename,
+                             bool RequiresNullTerminator) {
+  sys::fs::file_status Status;
+  if (std::error_code EC = sys::fs::status(FD, Status))
+    return EC;
+  if (Status.type() != sys::fs::file_type::regular_file)
+    return MemoryBuffer::getOpenFile(FD, Filename, -1, RequiresNullTerminator);
+
+  Key K{Status.getUniqueID(), Status.getLastModificationTime(),
+        Status.getSize()};
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Entries.find(K);
+    if (It != Entries.end())
+      if (std::shared_ptr<Entry> E = It->second.lock())
+        return std::make_unique<SharedBuffer>(std::move(E), Filename,
+                                              RequiresNullTerminator);
+  }
+
+  // Read the file without holding the lock. The shared buffer is always null
+  // terminated so that it can serve either kind of request.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr = MemoryBuffer::getOpenFile(
+      FD, Filename, K.Size, /*RequiresNullTerminator=*/true);
+  if (!BufOrErr)
+    return BufOrErr.getError();
+  auto New = std::make_shared<Entry>(*this, K, std::move(*BufOrErr));
+
+  std::shared_ptr<Entry> E;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    std::weak_ptr<Entry> &Slot = Entries[K];
+    // Another thread may have read the file in the meantime.
+    E = Slot.lock();
+    if (!E) {
+      Slot = New;
+      E = New;
+    }
+  }
+  // If the new entry lost the race, it is destroyed here, outside the lock.
+  // Its destructor leaves the winner alone because that one is not expired.
+  New.reset();
+  return std::make_unique<SharedBuffer>(std::move(E), Filename,
+                                        RequiresNullTerminator);
+}
+
+size_t MappedFileCache::size() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Entries.size();
+}
+
+void MappedFileCache::erase(const Key &K) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  // The file may have been read again since the last reference to this
+  // entry was dropped.
+  auto It = Entries.find(K);
+  if (It != Entries.end() && It->second.expired())
+    Entries.erase(It);
+}
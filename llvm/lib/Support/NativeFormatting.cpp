@@ -17,15 +17,32 @@
 
 using namespace llvm;
 
+// The decimal digits of 0 to 99, so that numbers can be formatted two digits
+// per division.
+static const char DigitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
 template<typename T, std::size_t N>
 static int format_to_buffer(T Value, char (&Buffer)[N]) {
   char *EndPtr = std::end(Buffer);
   char *CurPtr = EndPtr;
 
-  do {
-    *--CurPtr = '0' + char(Value % 10);
-    Value /= 10;
-  } while (Value);
+  while (Value >= 100) {
+    const char *Pair = &DigitPairs[(Value % 100) * 2];
+    Value /= 100;
+    *--CurPtr = Pair[1];
+    *--CurPtr = Pair[0];
+  }
+  if (Value >= 10) {
+    CurPtr -= 2;
+    memcpy(CurPtr, &DigitPairs[Value * 2], 2);
+  } else {
+    *--CurPtr = '0' + char(Value);
+  }
   return EndPtr - CurPtr;
 }
 
@@ -53,24 +70,31 @@ static void write_unsigned_impl(raw_ostream &S, T N, size_t MinDigits,
   static_assert(std::is_unsigned<T>::value, "Value is not unsigned!");
 
   char NumberBuffer[128];
-  std::memset(NumberBuffer, '0', sizeof(NumberBuffer));
-
-  size_t Len = 0;
-  Len = format_to_buffer(N, NumberBuffer);
-
-  if (IsNegative)
-    S << '-';
-
-  if (Len < MinDigits && Style != IntegerStyle::Number) {
-    for (size_t I = Len; I < MinDigits; ++I)
-      S << '0';
-  }
+  size_t Len = format_to_buffer(N, NumberBuffer);
 
   if (Style == IntegerStyle::Number) {
+    if (IsNegative)
+      S << '-';
     writeWithCommas(S, ArrayRef<char>(std::end(NumberBuffer) - Len, Len));
-  } else {
-    S.write(std::end(NumberBuffer) - Len, Len);
+    return;
   }
+
+  // Put the sign and the padding in front of the digits so that the number
+  // is written with a single call. Only very wide padding does not fit.
+  char *Start = std::end(NumberBuffer) - Len;
+  size_t Pad = MinDigits > Len ? MinDigits - Len : 0;
+  size_t BufferPad = std::min(Pad, sizeof(NumberBuffer) - Len - 1);
+  Start -= BufferPad;
+  memset(Start, '0', BufferPad);
+  if (Pad != BufferPad) {
+    if (IsNegative)
+      S << '-';
+    for (size_t I = BufferPad; I < Pad; ++I)
+      S << '0';
+  } else if (IsNegative) {
+    *--Start = '-';
+  }
+  S.write(Start, std::end(NumberBuffer) - Start);
 }
 
 template <typename T>
@@ -145,17 +169,15 @@ void llvm::write_hex(raw_ostream &S, uint64_t N, HexPrintStyle Style,
   unsigned NumChars =
       std::max(static_cast<unsigned>(W), std::max(1u, Nibbles) + PrefixChars);
 
+  const char *Digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
   char NumberBuffer[kMaxWidth];
-  ::memset(NumberBuffer, '0', llvm::array_lengthof(NumberBuffer));
-  if (Prefix)
-    NumberBuffer[1] = 'x';
   char *EndPtr = NumberBuffer + NumChars;
   char *CurPtr = EndPtr;
-  while (N) {
-    unsigned char x = static_cast<unsigned char>(N) % 16;
-    *--CurPtr = hexdigit(x, !Upper);
-    N /= 16;
-  }
+  for (; N; N >>= 4)
+    *--CurPtr = Digits[N & 15];
+  ::memset(NumberBuffer, '0', CurPtr - NumberBuffer);
+  if (Prefix)
+    NumberBuffer[1] = 'x';
 
   S.write(NumberBuffer, NumChars);
 }
@@ -8,6 +8,7 @@
 
 #include "llvm/Support/Parallel.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/ManagedStatic.h"
 
 #if LLVM_ENABLE_THREADS
@@ -15,8 +16,8 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <future>
-#include <stack>
 #include <thread>
 #include <vector>
 
@@ -34,21 +35,31 @@ public:
   virtual ~Executor() = default;
   virtual void add(std::function<void()> func) = 0;
 
+  /// Runs one pending closure on the calling thread if the calling thread
+  /// is a worker of this executor. Returns false if nothing was run.
+  virtual bool runOne() = 0;
+
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Each worker has its own deque. Closures added by a worker are pushed to
+/// the back of its own deque and are popped from there in filo order, which
+/// keeps nested work on the thread that created it. Idle workers steal from
+/// the front of other deques. Closures added from other threads are
+/// distributed over the deques in round-robin order.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
-    unsigned ThreadCount = S.compute_thread_count();
+    ThreadCount = S.compute_thread_count();
+    Queues.reset(new WorkQueue[ThreadCount]);
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
     Threads.resize(1);
     std::lock_guard<std::mutex> Lock(Mutex);
-    Threads[0] = std::thread([this, ThreadCount, S] {
+    Threads[0] = std::thread([this, S] {
       for (unsigned I = 1; I < ThreadCount; ++I) {
         Threads.emplace_back([=] { work(S, I); });
         if (Stop)
@@ -88,36 +99,98 @@ public:
   };
 
   void add(std::function<void()> F) override {
+    unsigned I = CurrentExecutor == this ? CurrentWorker
+                                         : NextQueue++ % ThreadCount;
     {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push(F);
+      std::lock_guard<std::mutex> Lock(Queues[I].Mutex);
+      Queues[I].Tasks.push_back(std::move(F));
+    }
+
+    // Pending and Sleepers are sequentially consistent, so either a worker
+    // about to sleep sees the new task or we see the sleeping worker. This
+    // avoids taking the global mutex when all workers are busy.
+    ++Pending;
+    if (Sleepers > 0) {
+      { std::lock_guard<std::mutex> Lock(Mutex); }
+      Cond.notify_one();
     }
-    Cond.notify_one();
+  }
+
+  bool runOne() override {
+    if (CurrentExecutor != this)
+      return false;
+    std::function<void()> Task;
+    if (!pop(CurrentWorker, Task))
+      return false;
+    Task();
+    return true;
   }
 
 private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
+  // Takes a task from the back of the worker's own deque or, failing that,
+  // from the front of another worker's deque.
+  bool pop(unsigned Self, std::function<void()> &Task) {
+    if (Pending == 0)
+      return false;
+    for (unsigned N = 0; N != ThreadCount; ++N) {
+      WorkQueue &Q = Queues[(Self + N) % ThreadCount];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (Q.Tasks.empty())
+        continue;
+      if (N == 0) {
+        Task = std::move(Q.Tasks.back());
+        Q.Tasks.pop_back();
+      } else {
+        Task = std::move(Q.Tasks.front());
+        Q.Tasks.pop_front();
+      }
+      --Pending;
+      return true;
+    }
+    return false;
+  }
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    CurrentExecutor = this;
+    CurrentWorker = ThreadID;
+    while (!Stop) {
+      std::function<void()> Task;
+      if (pop(ThreadID, Task)) {
+        Task();
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
-      if (Stop)
-        break;
-      auto Task = WorkStack.top();
-      WorkStack.pop();
-      Lock.unlock();
-      Task();
+      ++Sleepers;
+      Cond.wait(Lock, [&] { return Stop || Pending > 0; });
+      --Sleepers;
     }
   }
 
+  static LLVM_THREAD_LOCAL ThreadPoolExecutor *CurrentExecutor;
+  static LLVM_THREAD_LOCAL unsigned CurrentWorker;
+
+  unsigned ThreadCount;
+  std::unique_ptr<WorkQueue[]> Queues;
+  std::atomic<unsigned> NextQueue{0};
+  std::atomic<size_t> Pending{0};
+  std::atomic<unsigned> Sleepers{0};
+
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
   std::vector<std::thread> Threads;
 };
 
+LLVM_THREAD_LOCAL ThreadPoolExecutor *ThreadPoolExecutor::CurrentExecutor;
+LLVM_THREAD_LOCAL unsigned ThreadPoolExecutor::CurrentWorker;
+
 Executor *Executor::getDefaultExecutor() {
   // The ManagedStatic enables the ThreadPoolExecutor to be stopped via
   // llvm_shutdown() which allows a "clean" fast exit, e.g. via _exit(). This
@@ -145,24 +218,28 @@ Executor *Executor::getDefaultExecutor() {
 }
 } // namespace
 
-static std::atomic<int> TaskGroupInstances;
-
-// Latch::sync() called by the dtor may cause one thread to block. If is a dead
-// lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the first TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
-TaskGroup::TaskGroup() : Parallel(TaskGroupInstances++ == 0) {}
-TaskGroup::~TaskGroup() { --TaskGroupInstances; }
+// Nested TaskGroups are parallel as well. A worker thread waiting for a
+// TaskGroup runs pending tasks instead of blocking, so waiting workers cannot
+// starve the tasks they wait for, and no extra threads are created. Threads
+// that are not workers block until the tasks are done.
+TaskGroup::~TaskGroup() { sync(); }
 
 void TaskGroup::spawn(std::function<void()> F) {
-  if (Parallel) {
-    L.inc();
-    Executor::getDefaultExecutor()->add([&, F] {
-      F();
-      L.dec();
-    });
-  } else {
+  L.inc();
+  Executor::getDefaultExecutor()->add([&, F] {
     F();
+    L.dec();
+  });
+}
+
+void TaskGroup::sync() const {
+  Executor *E = Executor::getDefaultExecutor();
+  while (!L.syncFor(std::chrono::microseconds(0))) {
+    // If there is nothing to run, the remaining tasks are running on other
+    // threads and may still spawn tasks of their own. Wait for a short while
+    // and look again.
+    if (!E->runOne() && L.syncFor(std::chrono::microseconds(100)))
+      return;
   }
 }
 
@@ -33,6 +33,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstring>
+#include <mutex>
 using namespace llvm;
 
 /// -stats - Command line option to cause transformations to emit stats about
@@ -86,6 +87,112 @@ public:
 static ManagedStatic<StatisticInfo> StatInfo;
 static ManagedStatic<sys::SmartMutex<true> > StatLock;
 
+namespace {
+/// The counters of one thread, indexed by TrackingStatistic::ShardIndex. Only
+/// the owning thread updates them, with plain loads and stores, and other
+/// threads read them when merging. Chunks are allocated by the owning thread
+/// on first use.
+struct StatisticShard {
+  enum : unsigned { ChunkSize = 256, MaxChunks = 64 };
+
+  std::atomic<std::atomic<unsigned> *> Chunks[MaxChunks];
+
+  StatisticShard() {
+    for (auto &C : Chunks)
+      C.store(nullptr, std::memory_order_relaxed);
+  }
+
+  std::atomic<unsigned> &getCounter(unsigned I) {
+    std::atomic<unsigned> *&Chunk = CachedChunks[I / ChunkSize];
+    if (LLVM_UNLIKELY(!Chunk)) {
+      Chunk = new std::atomic<unsigned>[ChunkSize]();
+      Chunks[I / ChunkSize].store(Chunk, std::memory_order_release);
+    }
+    return Chunk[I % ChunkSize];
+  }
+
+  /// Returns the counter of statistic \p I if this thread has touched its
+  /// chunk.
+  std::atomic<unsigned> *lookupCounter(unsigned I) const {
+    std::atomic<unsigned> *Chunk =
+        Chunks[I / ChunkSize].load(std::memory_order_acquire);
+    return Chunk ? &Chunk[I % ChunkSize] : nullptr;
+  }
+
+private:
+  /// The owning thread's copy of Chunks, which it can read without
+  /// synchronization.
+  std::atomic<unsigned> *CachedChunks[MaxChunks] = {};
+};
+
+/// All shards ever created. Threads do not notify us when they exit, so
+/// shards live until the end of the process; their counts remain part of
+/// the statistics. The registry is never destroyed so that statistics can
+/// still be merged while static destructors run.
+struct StatisticShardRegistry {
+  std::mutex Lock;
+  std::vector<StatisticShard *> Shards;
+};
+} // end anonymous namespace
+
+static StatisticShardRegistry &getShardRegistry() {
+  static StatisticShardRegistry *Registry = new StatisticShardRegistry();
+  return *Registry;
+}
+
+/// The number of shard indices assigned, protected by StatLock.
+static unsigned NumShardIndices;
+
+static LLVM_THREAD_LOCAL StatisticShard *CurrentShard;
+
+static StatisticShard &getCurrentShard() {
+  if (LLVM_LIKELY(CurrentShard))
+    return *CurrentShard;
+  CurrentShard = new StatisticShard();
+  StatisticShardRegistry &Registry = getShardRegistry();
+  std::lock_guard<std::mutex> Lock(Registry.Lock);
+  Registry.Shards.push_back(CurrentShard);
+  return *CurrentShard;
+}
+
+void TrackingStatistic::addToShard(unsigned V) {
+  unsigned I = ShardIndex.load(std::memory_order_relaxed);
+  if (I >= StatisticShard::ChunkSize * StatisticShard::MaxChunks) {
+    Value.fetch_add(V, std::memory_order_relaxed);
+    return;
+  }
+  std::atomic<unsigned> &Counter = getCurrentShard().getCounter(I);
+  Counter.store(Counter.load(std::memory_order_relaxed) + V,
+                std::memory_order_relaxed);
+}
+
+unsigned TrackingStatistic::getValue() const {
+  unsigned Sum = Value.load(std::memory_order_relaxed);
+  unsigned I = ShardIndex.load(std::memory_order_relaxed);
+  if (I >= StatisticShard::ChunkSize * StatisticShard::MaxChunks)
+    return Sum;
+  StatisticShardRegistry &Registry = getShardRegistry();
+  std::lock_guard<std::mutex> Lock(Registry.Lock);
+  for (const StatisticShard *Shard : Registry.Shards)
+    if (const std::atomic<unsigned> *Counter = Shard->lookupCounter(I))
+      Sum += Counter->load(std::memory_order_relaxed);
+  return Sum;
+}
+
+/// Sets a statistic to \p V by clearing its per-thread counts. Updates from
+/// other threads that happen concurrently may be lost.
+void TrackingStatistic::setValue(unsigned V) {
+  unsigned I = ShardIndex.load(std::memory_order_relaxed);
+  if (I < StatisticShard::ChunkSize * StatisticShard::MaxChunks) {
+    StatisticShardRegistry &Registry = getShardRegistry();
+    std::lock_guard<std::mutex> Lock(Registry.Lock);
+    for (StatisticShard *Shard : Registry.Shards)
+      if (std::atomic<unsigned> *Counter = Shard->lookupCounter(I))
+        Counter->store(0, std::memory_order_relaxed);
+  }
+  Value.store(V, std::memory_order_relaxed);
+}
+
 /// RegisterStatistic - The first time a statistic is bumped, this method is
 /// called.
 void TrackingStatistic::RegisterStatistic() {
@@ -107,6 +214,11 @@ void TrackingStatistic::RegisterStatistic() {
     if (EnableStats || Enabled)
       SI.addStatistic(this);
 
+    // Keep the shard index across ResetStatistics(), which other threads may
+    // race with.
+    if (ShardIndex.load(std::memory_order_relaxed) == NoShard)
+      ShardIndex.store(NumShardIndices++, std::memory_order_relaxed);
+
     // Remember we have been registered.
     Initialized.store(true, std::memory_order_release);
   }
@@ -156,7 +268,7 @@ void StatisticInfo::reset() {
     // Value updates to a statistic that complete before this statement in the
     // iteration for that statistic will be lost as intended.
     Stat->Initialized = false;
-    Stat->Value = 0;
+    Stat->setValue(0);
   }
 
   // Clear the registration list and release the lock once we're done. Any
@@ -15,10 +15,24 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/DJB.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/xxhash.h"
 #include <cassert>
 
 using namespace llvm;
 
+/// Returns the hash value of a key. Output such as symbol tables and
+/// diagnostics follows StringMap iteration order, so the Bernstein hash stays
+/// the default. LLVM_ENABLE_STRINGMAP_XXHASH selects xxHash, which consumes
+/// eight bytes per step and mixes all of them into the low bits that select a
+/// bucket, at the cost of a different iteration order.
+static unsigned hashKey(StringRef Key) {
+#ifdef LLVM_ENABLE_STRINGMAP_XXHASH
+  return (unsigned)xxHash64(Key);
+#else
+  return djbHash(Key, 0);
+#endif
+}
+
 /// Returns the number of buckets to allocate to ensure that the DenseMap can
 /// accommodate \p NumEntries without need to grow().
 static unsigned getMinBucketToReserveForEntries(unsigned NumEntries) {
@@ -80,7 +94,7 @@ unsigned StringMapImpl::LookupBucketFor(StringRef Name) {
     init(16);
     HTSize = NumBuckets;
   }
-  unsigned FullHashValue = djbHash(Name, 0);
+  unsigned FullHashValue = hashKey(Name);
   unsigned BucketNo = FullHashValue & (HTSize-1);
   unsigned *HashTable = (unsigned *)(TheTable + NumBuckets + 1);
 
@@ -134,7 +148,7 @@ unsigned StringMapImpl::LookupBucketFor(StringRef Name) {
 int StringMapImpl::FindKey(StringRef Key) const {
   unsigned HTSize = NumBuckets;
   if (HTSize == 0) return -1;  // Really empty table?
-  unsigned FullHashValue = djbHash(Key, 0);
+  unsigned FullHashValue = hashKey(Key);
   unsigned BucketNo = FullHashValue & (HTSize-1);
   unsigned *HashTable = (unsigned *)(TheTable + NumBuckets + 1);
 
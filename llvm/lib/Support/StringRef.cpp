@@ -13,8 +13,15 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/edit_distance.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MathExtras.h"
 #include <bitset>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 using namespace llvm;
 
 // MSVC emits references to this into the translation units which reference it.
@@ -125,6 +132,56 @@ std::string StringRef::upper() const {
 // String Searching
 //===----------------------------------------------------------------------===//
 
+// The searches below compare 16 bytes at a time where the target guarantees
+// a vector unit. A match mask has MaskBitsPerByte consecutive bits set for
+// each matching byte.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define LLVM_STRINGREF_VECTORIZED 1
+
+namespace {
+#ifdef __SSE2__
+typedef __m128i ByteVector;
+const unsigned MaskBitsPerByte = 1;
+
+ByteVector splat(char C) { return _mm_set1_epi8(C); }
+ByteVector load(const char *P) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(P));
+}
+ByteVector equal(ByteVector A, ByteVector B) { return _mm_cmpeq_epi8(A, B); }
+ByteVector both(ByteVector A, ByteVector B) { return _mm_and_si128(A, B); }
+ByteVector either(ByteVector A, ByteVector B) { return _mm_or_si128(A, B); }
+uint64_t toMask(ByteVector V) { return (unsigned)_mm_movemask_epi8(V); }
+#else
+typedef uint8x16_t ByteVector;
+const unsigned MaskBitsPerByte = 4;
+
+ByteVector splat(char C) { return vdupq_n_u8((uint8_t)C); }
+ByteVector load(const char *P) {
+  return vld1q_u8(reinterpret_cast<const uint8_t *>(P));
+}
+ByteVector equal(ByteVector A, ByteVector B) { return vceqq_u8(A, B); }
+ByteVector both(ByteVector A, ByteVector B) { return vandq_u8(A, B); }
+ByteVector either(ByteVector A, ByteVector B) { return vorrq_u8(A, B); }
+// NEON has no movemask. Narrowing each 16-bit lane by 4 bits keeps one
+// nibble of every byte.
+uint64_t toMask(ByteVector V) {
+  uint8x8_t Narrowed = vshrn_n_u16(vreinterpretq_u16_u8(V), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(Narrowed), 0);
+}
+#endif
+
+const size_t VectorSize = 16;
+
+/// Returns the index of the first matching byte in \p Mask and removes it
+/// from the mask.
+unsigned popFirstMatch(uint64_t &Mask) {
+  unsigned Bit = countTrailingZeros(Mask);
+  Mask &= ~((((uint64_t)1 << MaskBitsPerByte) - 1) << Bit);
+  return Bit / MaskBitsPerByte;
+}
+} // end anonymous namespace
+#endif
+
 
 /// find - Search for the first string \arg Str in the string.
 ///
@@ -150,6 +207,25 @@ size_t StringRef::find(StringRef Str, size_t From) const {
 
   const char *Stop = Start + (Size - N + 1);
 
+#ifdef LLVM_STRINGREF_VECTORIZED
+  // Look for blocks of candidate positions whose first and last characters
+  // both match, and compare the middle of the needle only at those.
+  ByteVector First = splat(Needle[0]);
+  ByteVector Last = splat(Needle[N - 1]);
+  for (; Start + VectorSize <= Stop; Start += VectorSize) {
+    uint64_t Mask = toMask(both(equal(load(Start), First),
+                                equal(load(Start + N - 1), Last)));
+    while (Mask) {
+      const char *P = Start + popFirstMatch(Mask);
+      if (std::memcmp(P + 1, Needle + 1, N - 2) == 0)
+        return P - Data;
+    }
+  }
+  for (; Start < Stop; ++Start)
+    if (std::memcmp(Start, Needle, N) == 0)
+      return Start - Data;
+  return npos;
+#else
   // For short haystacks or unsupported needles fall back to the naive algorithm
   if (Size < 16 || N > 255) {
     do {
@@ -177,6 +253,7 @@ size_t StringRef::find(StringRef Str, size_t From) const {
   } while (Start < Stop);
 
   return npos;
+#endif
 }
 
 size_t StringRef::find_lower(StringRef Str, size_t From) const {
@@ -235,6 +312,28 @@ size_t StringRef::rfind_lower(StringRef Str) const {
 /// Note: O(size() + Chars.size())
 StringRef::size_type StringRef::find_first_of(StringRef Chars,
                                               size_t From) const {
+#ifdef LLVM_STRINGREF_VECTORIZED
+  // Small sets, such as separators and quote characters, are compared
+  // against every character of a block at once.
+  if (!Chars.empty() && Chars.size() <= 4) {
+    ByteVector C[4];
+    for (size_t I = 0; I != 4; ++I)
+      C[I] = splat(Chars[std::min(I, Chars.size() - 1)]);
+    size_type I = std::min(From, Length);
+    for (; I + VectorSize <= Length; I += VectorSize) {
+      ByteVector V = load(Data + I);
+      uint64_t Mask = toMask(either(either(equal(V, C[0]), equal(V, C[1])),
+                                    either(equal(V, C[2]), equal(V, C[3]))));
+      if (Mask)
+        return I + popFirstMatch(Mask);
+    }
+    for (; I != Length; ++I)
+      if (Chars.find(Data[I]) != npos)
+        return I;
+    return npos;
+  }
+#endif
+
   std::bitset<1 << CHAR_BIT> CharBits;
   for (size_type i = 0; i != Chars.size(); ++i)
     CharBits.set((unsigned char)Chars[i]);
@@ -0,0 +1,91 @@
+//===- ThreadLocalBumpPtrAllocator.cpp - Per-thread bump allocation -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadLocalBumpPtrAllocator.h"
+#include "llvm/Support/Compiler.h"
+#include <atomic>
+
+using namespace llvm;
+
+static std::atomic<uint64_t> NextAllocatorID{1};
+
+// The allocator a thread used last and its arena.
+static LLVM_THREAD_LOCAL uint64_t CachedID;
+static LLVM_THREAD_LOCAL BumpPtrAllocator *CachedAllocator;
+
+ThreadLocalBumpPtrAllocator::ThreadLocalBumpPtrAllocator()
+    : ID(NextAllocatorID++) {}
+
+ThreadLocalBumpPtrAllocator::~ThreadLocalBumpPtrAllocator() {
+  // Identifiers are not reused, so stale cache entries of other threads can
+  // never match another allocator. Only clear our own.
+  if (CachedID == ID) {
+    CachedID = 0;
+    CachedAllocator = nullptr;
+  }
+}
+
+BumpPtrAllocator &ThreadLocalBumpPtrAllocator::getThreadAllocator() {
+  if (LLVM_LIKELY(CachedID == ID))
+    return *CachedAllocator;
+  return getThreadAllocatorSlow();
+}
+
+BumpPtrAllocator &ThreadLocalBumpPtrAllocator::getThreadAllocatorSlow() {
+  std::thread::id Self = std::this_thread::get_id();
+  std::lock_guard<std::mutex> Lock(Mutex);
+  BumpPtrAllocator *A = nullptr;
+  for (auto &P : Allocators)
+    if (P.first == Self)
+      A = P.second.get();
+  if (!A) {
+    Allocators.emplace_back(Self, std::make_unique<BumpPtrAllocator>());
+    A = Allocators.back().second.get();
+  }
+  CachedID = ID;
+  CachedAllocator = A;
+  return *A;
+}
+
+void ThreadLocalBumpPtrAllocator::Reset() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  for (auto &P : Allocators)
+    P.second->Reset();
+}
+
+size_t ThreadLocalBumpPtrAllocator::getTotalMemory() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  size_t Total = 0;
+  for (auto &P : Allocators)
+    Total += P.second->getTotalMemory();
+  return Total;
+}
+
+size_t ThreadLocalBumpPtrAllocator::getBytesAllocated() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  size_t Total = 0;
+  for (auto &P : Allocators)
+    Total += P.second->getBytesAllocated();
+  return Total;
+}
+
+unsigned ThreadLocalBumpPtrAllocator::getNumThreadAllocators() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Allocators.size();
+}
+
+void ThreadLocalBumpPtrAllocator::PrintStats() const {
+  size_t NumSlabs = 0;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    for (auto &P : Allocators)
+      NumSlabs += P.second->GetNumSlabs();
+  }
+  detail::printBumpPtrAllocatorStats(NumSlabs, getBytesAllocated(),
+                                     getTotalMemory());
+}
@@ -18,11 +18,84 @@
 
 using namespace llvm;
 
+ThreadPool::TaskRef ThreadPool::schedule(TaskTy F, ArrayRef<TaskRef> Deps,
+                                         Priority P) {
+  auto Node = std::make_shared<TaskNode>();
+#if LLVM_ENABLE_THREADS
+  Node->Task = PackagedTaskTy(std::move(F));
+  std::shared_future<void> Future = Node->Task.get_future().share();
+#else
+  // Without threads, a task runs when its future is waited for or in
+  // wait(), whichever comes first. Its dependencies are run before it.
+  std::vector<std::shared_future<void>> DepFutures;
+  for (const TaskRef &D : Deps)
+    DepFutures.push_back(D.Future);
+  std::shared_future<void> Future =
+      std::async(std::launch::deferred, [DepFutures, F] {
+        for (const std::shared_future<void> &D : DepFutures)
+          D.get();
+        F();
+      }).share();
+  Node->Task = PackagedTaskTy([Future] { Future.get(); });
+#endif
+  Node->P = P;
+
+  bool Ready;
+  {
+    std::unique_lock<std::mutex> LockGuard(QueueLock);
+#if LLVM_ENABLE_THREADS
+    // Don't allow enqueueing after disabling the pool
+    assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
+#endif
+    Node->Seq = NextSeq++;
+    for (const TaskRef &D : Deps) {
+      assert(D.Node && "dependency was not scheduled on a ThreadPool");
+      if (D.Node->Done)
+        continue;
+      D.Node->Successors.push_back(Node);
+      ++Node->PendingDeps;
+    }
+    ++Unfinished;
+    Ready = Node->PendingDeps == 0;
+    if (Ready)
+      Tasks.push(Node);
+  }
+  if (Ready)
+    QueueCondition.notify_one();
+  return TaskRef(std::move(Node), std::move(Future));
+}
+
+std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
+  return schedule(std::move(Task)).getFuture();
+}
+
+void ThreadPool::runTask(std::shared_ptr<TaskNode> Node) {
+  Node->Task();
+
+  size_t NumReady = 0;
+  {
+    std::unique_lock<std::mutex> LockGuard(QueueLock);
+    Node->Done = true;
+    for (std::shared_ptr<TaskNode> &Succ : Node->Successors) {
+      if (--Succ->PendingDeps == 0) {
+        Tasks.push(std::move(Succ));
+        ++NumReady;
+      }
+    }
+    Node->Successors.clear();
+    --Unfinished;
+  }
+  for (size_t I = 0; I < NumReady; ++I)
+    QueueCondition.notify_one();
+
+  // Notify task completion, in case someone waits on ThreadPool::wait()
+  CompletionCondition.notify_all();
+}
+
 #if LLVM_ENABLE_THREADS
 
 ThreadPool::ThreadPool(ThreadPoolStrategy S)
-    : ActiveThreads(0), EnableFlag(true),
-      ThreadCount(S.compute_thread_count()) {
+    : EnableFlag(true), ThreadCount(S.compute_thread_count()) {
   // Create ThreadCount threads that will loop forever, wait on QueueCondition
   // for tasks to be queued or the Pool to be destroyed.
   Threads.reserve(ThreadCount);
@@ -30,7 +103,7 @@ ThreadPool::ThreadPool(ThreadPoolStrategy S)
     Threads.emplace_back([S, ThreadID, this] {
       S.apply_thread_strategy(ThreadID);
       while (true) {
-        PackagedTaskTy Task;
+        std::shared_ptr<TaskNode> Node;
         {
           std::unique_lock<std::mutex> LockGuard(QueueLock);
           // Wait for tasks to be pushed in the queue
@@ -39,63 +112,31 @@ ThreadPool::ThreadPool(ThreadPoolStrategy S)
           // Exit condition
           if (!EnableFlag && Tasks.empty())
             return;
-          // Yeah, we have a task, grab it and release the lock on the queue
-
-          // We first need to signal that we are active before popping the queue
-          // in order for wait() to properly detect that even if the queue is
-          // empty, there is still a task in flight.
-          {
-            std::unique_lock<std::mutex> LockGuard(CompletionLock);
-            ++ActiveThreads;
-          }
-          Task = std::move(Tasks.front());
+          // Yeah, we have a task, grab it and release the lock on the queue.
+          // The task stays counted in Unfinished until it is done, so wait()
+          // properly detects that there is still a task in flight.
+          Node = Tasks.top();
           Tasks.pop();
         }
         // Run the task we just grabbed
-        Task();
-
-        {
-          // Adjust `ActiveThreads`, in case someone waits on ThreadPool::wait()
-          std::unique_lock<std::mutex> LockGuard(CompletionLock);
-          --ActiveThreads;
-        }
-
-        // Notify task completion, in case someone waits on ThreadPool::wait()
-        CompletionCondition.notify_all();
+        runTask(std::move(Node));
       }
     });
   }
 }
 
 void ThreadPool::wait() {
-  // Wait for all threads to complete and the queue to be empty
-  std::unique_lock<std::mutex> LockGuard(CompletionLock);
-  // The order of the checks for ActiveThreads and Tasks.empty() matters because
-  // any active threads might be modifying the Tasks queue, and this would be a
-  // race.
-  CompletionCondition.wait(LockGuard,
-                           [&] { return !ActiveThreads && Tasks.empty(); });
-}
-
-std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
-  /// Wrap the Task in a packaged_task to return a future object.
-  PackagedTaskTy PackagedTask(std::move(Task));
-  auto Future = PackagedTask.get_future();
-  {
-    // Lock the queue and push the new task
-    std::unique_lock<std::mutex> LockGuard(QueueLock);
-
-    // Don't allow enqueueing after disabling the pool
-    assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
-
-    Tasks.push(std::move(PackagedTask));
-  }
-  QueueCondition.notify_one();
-  return Future.share();
+  // Wait for all tasks to complete, including the ones waiting for their
+  // dependencies.
+  std::unique_lock<std::mutex> LockGuard(QueueLock);
+  CompletionCondition.wait(LockGuard, [&] { return Unfinished == 0; });
 }
 
 // The destructor joins all threads, waiting for completion.
 ThreadPool::~ThreadPool() {
+  // Tasks waiting for dependencies are only queued when the dependencies
+  // finish, so let them drain before asking the threads to exit.
+  wait();
   {
     std::unique_lock<std::mutex> LockGuard(QueueLock);
     EnableFlag = false;
@@ -109,7 +150,7 @@ ThreadPool::~ThreadPool() {
 
 // No threads are launched, issue a warning if ThreadCount is not 0
 ThreadPool::ThreadPool(ThreadPoolStrategy S)
-    : ActiveThreads(0), ThreadCount(S.compute_thread_count()) {
+    : ThreadCount(S.compute_thread_count()) {
   if (ThreadCount != 1) {
     errs() << "Warning: request a ThreadPool with " << ThreadCount
            << " threads, but LLVM_ENABLE_THREADS has been turned off\n";
@@ -119,22 +160,12 @@ ThreadPool::ThreadPool(ThreadPoolStrategy S)
 void ThreadPool::wait() {
   // Sequential implementation running the tasks
   while (!Tasks.empty()) {
-    auto Task = std::move(Tasks.front());
+    std::shared_ptr<TaskNode> Node = Tasks.top();
     Tasks.pop();
-    Task();
+    runTask(std::move(Node));
   }
 }
 
-std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
-  // Get a Future with launch::deferred execution using std::async
-  auto Future = std::async(std::launch::deferred, std::move(Task)).share();
-  // Wrap the future so that both ThreadPool::wait() can operate and the
-  // returned future can be sync'ed on.
-  PackagedTaskTy PackagedTask([Future]() { Future.get(); });
-  Tasks.push(std::move(PackagedTask));
-  return Future;
-}
-
 ThreadPool::~ThreadPool() { wait(); }
 
 #endif
@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/JSON.h"
 #include "llvm/Support/Path.h"
@@ -48,13 +50,14 @@ typedef std::pair<std::string, CountAndDurationType>
     NameAndCountAndDurationType;
 
 struct Entry {
-  const TimePointType Start;
+  TimePointType Start;
   TimePointType End;
-  const std::string Name;
-  const std::string Detail;
+  // Interned in the profiler's Names, so equal names have equal pointers.
+  StringRef Name;
+  std::string Detail;
 
-  Entry(TimePointType &&S, TimePointType &&E, std::string &&N, std::string &&Dt)
-      : Start(std::move(S)), End(std::move(E)), Name(std::move(N)),
+  Entry(TimePointType &&S, TimePointType &&E, StringRef N, std::string &&Dt)
+      : Start(std::move(S)), End(std::move(E)), Name(N),
         Detail(std::move(Dt)) {}
 
   // Calculate timings for FlameGraph. Cast time points to microsecond precision
@@ -73,13 +76,24 @@ struct Entry {
   }
 };
 
+struct CounterEntry {
+  const TimePointType Time;
+  const std::string Name;
+  const int64_t Value;
+};
+
 struct TimeTraceProfiler {
-  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
+  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "",
+                    size_t MaxEntries = 0)
       : StartTime(steady_clock::now()), ProcName(ProcName),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {}
-
-  void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
-    Stack.emplace_back(steady_clock::now(), TimePointType(), std::move(Name),
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        MaxEntries(MaxEntries) {}
+
+  void begin(StringRef Name, llvm::function_ref<std::string()> Detail) {
+    // Names are usually string literals, so interning them avoids allocating
+    // memory for each section.
+    StringRef Interned = Names.insert(Name).first->getKey();
+    Stack.emplace_back(steady_clock::now(), TimePointType(), Interned,
                        Detail());
   }
 
@@ -91,8 +105,8 @@ struct TimeTraceProfiler {
     // Check that end times monotonically increase.
     assert((Entries.empty() ||
             (E.getFlameGraphStartUs(StartTime) + E.getFlameGraphDurUs() >=
-             Entries.back().getFlameGraphStartUs(StartTime) +
-                 Entries.back().getFlameGraphDurUs())) &&
+             lastEntry().getFlameGraphStartUs(StartTime) +
+                 lastEntry().getFlameGraphDurUs())) &&
            "TimeProfiler scope ended earlier than previous scope");
 
     // Calculate duration at full precision for overall counts.
@@ -100,7 +114,7 @@ struct TimeTraceProfiler {
 
     // Only include sections longer or equal to TimeTraceGranularity msec.
     if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity)
-      Entries.emplace_back(E);
+      addEntry(std::move(E));
 
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
@@ -108,7 +122,7 @@ struct TimeTraceProfiler {
     // happens to be the ones that don't have any currently open entries above
     // itself.
     if (std::find_if(++Stack.rbegin(), Stack.rend(), [&](const Entry &Val) {
-          return Val.Name == E.Name;
+          return Val.Name.data() == E.Name.data();
         }) == Stack.rend()) {
       auto &CountAndTotal = CountAndTotalPerName[E.Name];
       CountAndTotal.first++;
@@ -118,6 +132,32 @@ struct TimeTraceProfiler {
     Stack.pop_back();
   }
 
+  // Records a finished section. If the number of entries is bounded, the
+  // entries form a ring buffer in which the oldest entry is overwritten.
+  void addEntry(Entry &&E) {
+    if (MaxEntries == 0 || Entries.size() < MaxEntries) {
+      Entries.push_back(std::move(E));
+      return;
+    }
+    Entries[Head] = std::move(E);
+    Head = (Head + 1) % MaxEntries;
+    ++DroppedEntries;
+  }
+
+  const Entry &lastEntry() const {
+    return Entries[(Head + Entries.size() - 1) % Entries.size()];
+  }
+
+  // Calls Fn for each recorded entry from the oldest to the newest.
+  template <typename Fn> void forEachEntry(Fn F) const {
+    for (size_t I = 0, E = Entries.size(); I != E; ++I)
+      F(Entries[(Head + I) % E]);
+  }
+
+  void counter(StringRef Name, int64_t Value) {
+    Counters.push_back({steady_clock::now(), std::string(Name), Value});
+  }
+
   // Write events from this TimeTraceProfilerInstance and
   // ThreadTimeTraceProfilerInstances.
   void Write(raw_pwrite_stream &OS) {
@@ -152,14 +192,29 @@ struct TimeTraceProfiler {
         }
       });
     };
-    for (const auto &E : Entries) {
-      writeEvent(E, this->Tid);
-    }
-    for (const auto &TTP : ThreadTimeTraceProfilerInstances) {
-      for (const auto &E : TTP->Entries) {
-        writeEvent(E, TTP->Tid);
-      }
-    }
+    forEachEntry([&](const Entry &E) { writeEvent(E, this->Tid); });
+    for (const auto &TTP : ThreadTimeTraceProfilerInstances)
+      TTP->forEachEntry([&](const Entry &E) { writeEvent(E, TTP->Tid); });
+
+    // Emit counters. Counters are per process in the Trace Event format, so
+    // all threads contribute to the same series.
+    auto writeCounter = [&](const CounterEntry &C) {
+      J.object([&] {
+        J.attribute("pid", 1);
+        J.attribute("tid", int64_t(this->Tid));
+        J.attribute("ph", "C");
+        J.attribute("ts", (time_point_cast<microseconds>(C.Time) -
+                           time_point_cast<microseconds>(StartTime))
+                              .count());
+        J.attribute("name", C.Name);
+        J.attributeObject("args", [&] { J.attribute("value", C.Value); });
+      });
+    };
+    for (const CounterEntry &C : Counters)
+      writeCounter(C);
+    for (const auto &TTP : ThreadTimeTraceProfilerInstances)
+      for (const CounterEntry &C : TTP->Counters)
+        writeCounter(C);
 
     // Emit totals by section name as additional "thread" events, sorted from
     // longest one.
@@ -233,11 +288,32 @@ struct TimeTraceProfiler {
 
     J.arrayEnd();
     J.attributeEnd();
+
+    // Report sections that were dropped from full ring buffers so that a
+    // truncated trace is not mistaken for a complete one.
+    uint64_t Dropped = DroppedEntries;
+    for (const auto &TTP : ThreadTimeTraceProfilerInstances)
+      Dropped += TTP->DroppedEntries;
+
+    if (!Metadata.empty() || Dropped) {
+      J.attributeObject("otherData", [&] {
+        for (const auto &KV : Metadata)
+          J.attribute(KV.first, KV.second);
+        if (Dropped)
+          J.attribute("droppedEvents", int64_t(Dropped));
+      });
+    }
     J.objectEnd();
   }
 
   SmallVector<Entry, 16> Stack;
   SmallVector<Entry, 128> Entries;
+  // The index of the oldest entry once a bounded Entries is full.
+  size_t Head = 0;
+  uint64_t DroppedEntries = 0;
+  StringSet<> Names;
+  std::vector<CounterEntry> Counters;
+  std::vector<std::pair<std::string, std::string>> Metadata;
   StringMap<CountAndDurationType> CountAndTotalPerName;
   const TimePointType StartTime;
   const std::string ProcName;
@@ -245,20 +321,24 @@ struct TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  // Maximum number of sections kept, or 0 if unbounded.
+  const size_t MaxEntries;
 };
 
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                 StringRef ProcName) {
+                                 StringRef ProcName, size_t MaxEntries) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
   TimeTraceProfilerInstance = new TimeTraceProfiler(
-      TimeTraceGranularity, llvm::sys::path::filename(ProcName));
+      TimeTraceGranularity, llvm::sys::path::filename(ProcName), MaxEntries);
 }
 
 // Removes all TimeTraceProfilerInstances.
 // Called from main thread.
 void timeTraceProfilerCleanup() {
   delete TimeTraceProfilerInstance;
+  TimeTraceProfilerInstance = nullptr;
   std::lock_guard<std::mutex> Lock(Mu);
   for (auto TTP : ThreadTimeTraceProfilerInstances)
     delete TTP;
@@ -301,14 +381,14 @@ Error timeTraceProfilerWrite(StringRef PreferredFileName,
 
 void timeTraceProfilerBegin(StringRef Name, StringRef Detail) {
   if (TimeTraceProfilerInstance != nullptr)
-    TimeTraceProfilerInstance->begin(std::string(Name),
+    TimeTraceProfilerInstance->begin(Name,
                                      [&]() { return std::string(Detail); });
 }
 
 void timeTraceProfilerBegin(StringRef Name,
                             llvm::function_ref<std::string()> Detail) {
   if (TimeTraceProfilerInstance != nullptr)
-    TimeTraceProfilerInstance->begin(std::string(Name), Detail);
+    TimeTraceProfilerInstance->begin(Name, Detail);
 }
 
 void timeTraceProfilerEnd() {
@@ -316,4 +396,22 @@ void timeTraceProfilerEnd() {
     TimeTraceProfilerInstance->end();
 }
 
+void timeTraceProfilerCounter(StringRef Name, int64_t Value) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->counter(Name, Value);
+}
+
+void timeTraceProfilerAddMetadata(StringRef Key, StringRef Value) {
+  if (TimeTraceProfilerInstance == nullptr)
+    return;
+  auto &Metadata = TimeTraceProfilerInstance->Metadata;
+  auto It = llvm::find_if(Metadata, [&](const auto &KV) {
+    return KV.first == Key;
+  });
+  if (It != Metadata.end())
+    It->second = std::string(Value);
+  else
+    Metadata.emplace_back(std::string(Key), std::string(Value));
+}
+
 } // namespace llvm
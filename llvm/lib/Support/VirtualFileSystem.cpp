@@ -32,6 +32,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MappedFileCache.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
@@ -175,11 +176,13 @@ class RealFile : public File {
   file_t FD;
   Status S;
   std::string RealName;
+  MappedFileCache *Cache;
 
-  RealFile(file_t RawFD, StringRef NewName, StringRef NewRealPathName)
+  RealFile(file_t RawFD, StringRef NewName, StringRef NewRealPathName,
+           MappedFileCache *Cache)
       : FD(RawFD), S(NewName, {}, {}, {}, {}, {},
                      llvm::sys::fs::file_type::status_error, {}),
-        RealName(NewRealPathName.str()) {
+        RealName(NewRealPathName.str()), Cache(Cache) {
     assert(FD != kInvalidFile && "Invalid or inactive file descriptor");
   }
 
@@ -218,6 +221,8 @@ ErrorOr<std::unique_ptr<MemoryBuffer>>
 RealFile::getBuffer(const Twine &Name, int64_t FileSize,
                     bool RequiresNullTerminator, bool IsVolatile) {
   assert(FD != kInvalidFile && "cannot get buffer for closed file");
+  if (Cache && !IsVolatile)
+    return Cache->getOpenFile(FD, Name, RequiresNullTerminator);
   return MemoryBuffer::getOpenFile(FD, Name, FileSize, RequiresNullTerminator,
                                    IsVolatile);
 }
@@ -240,7 +245,9 @@ namespace {
 /// This would enable the use of openat()-style functions on some platforms.
 class RealFileSystem : public FileSystem {
 public:
-  explicit RealFileSystem(bool LinkCWDToProcess) {
+  explicit RealFileSystem(bool LinkCWDToProcess,
+                          MappedFileCache *Cache = nullptr)
+      : Cache(Cache) {
     if (!LinkCWDToProcess) {
       SmallString<128> PWD, RealPWD;
       if (llvm::sys::fs::current_path(PWD))
@@ -280,6 +287,8 @@ private:
     SmallString<128> Resolved;
   };
   Optional<WorkingDirectory> WD;
+  // Shares the buffers of files that are not volatile, if set.
+  MappedFileCache *Cache;
 };
 
 } // namespace
@@ -301,7 +310,7 @@ RealFileSystem::openFileForRead(const Twine &Name) {
   if (!FDOrErr)
     return errorToErrorCode(FDOrErr.takeError());
   return std::unique_ptr<File>(
-      new RealFile(*FDOrErr, Name.str(), RealName.str()));
+      new RealFile(*FDOrErr, Name.str(), RealName.str(), Cache));
 }
 
 llvm::ErrorOr<std::string> RealFileSystem::getCurrentWorkingDirectory() const {
@@ -348,8 +357,9 @@ IntrusiveRefCntPtr<FileSystem> vfs::getRealFileSystem() {
   return FS;
 }
 
-std::unique_ptr<FileSystem> vfs::createPhysicalFileSystem() {
-  return std::make_unique<RealFileSystem>(false);
+std::unique_ptr<FileSystem>
+vfs::createPhysicalFileSystem(MappedFileCache *Cache) {
+  return std::make_unique<RealFileSystem>(false, Cache);
 }
 
 namespace {
@@ -1012,6 +1022,38 @@ static llvm::SmallString<256> canonicalize(llvm::StringRef Path) {
 } // anonymous namespace
 
 
+/// Returns \p Name lowercased, which is the key for looking up directory
+/// entries regardless of the case sensitivity of the file system.
+static StringRef getContentKey(StringRef Name, SmallVectorImpl<char> &Buffer) {
+  Buffer.resize(Name.size());
+  std::transform(Name.begin(), Name.end(), Buffer.begin(), toLower);
+  return StringRef(Buffer.data(), Buffer.size());
+}
+
+void RedirectingFileSystem::RedirectingDirectoryEntry::indexContent(
+    Entry *Content) {
+  StringRef Name = Content->getName();
+  // Empty names and separators are handled specially by lookupPath.
+  if (Name.empty() || Name == "/" || Name == "\\") {
+    HasUnindexedContents = true;
+    return;
+  }
+  SmallString<128> Buffer;
+  ContentsByName[getContentKey(Name, Buffer)].push_back(Content);
+}
+
+Optional<ArrayRef<RedirectingFileSystem::Entry *>>
+RedirectingFileSystem::RedirectingDirectoryEntry::lookupContents(
+    StringRef Name) const {
+  if (HasUnindexedContents || Name == "/" || Name == "\\")
+    return None;
+  SmallString<128> Buffer;
+  auto I = ContentsByName.find(getContentKey(Name, Buffer));
+  if (I == ContentsByName.end())
+    return ArrayRef<Entry *>();
+  return makeArrayRef(I->second);
+}
+
 RedirectingFileSystem::RedirectingFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
     : ExternalFS(std::move(FS)) {
   if (ExternalFS)
@@ -1276,13 +1318,24 @@ class llvm::vfs::RedirectingFileSystemParser {
     } else { // Advance to the next component
       auto *DE = dyn_cast<RedirectingFileSystem::RedirectingDirectoryEntry>(
           ParentEntry);
-      for (std::unique_ptr<RedirectingFileSystem::Entry> &Content :
-           llvm::make_range(DE->contents_begin(), DE->contents_end())) {
+      auto FindDirectory = [&](RedirectingFileSystem::Entry *Content)
+          -> RedirectingFileSystem::RedirectingDirectoryEntry * {
         auto *DirContent =
             dyn_cast<RedirectingFileSystem::RedirectingDirectoryEntry>(
-                Content.get());
+                Content);
         if (DirContent && Name.equals(Content->getName()))
           return DirContent;
+        return nullptr;
+      };
+      if (auto Candidates = DE->lookupContents(Name)) {
+        for (RedirectingFileSystem::Entry *Content : *Candidates)
+          if (auto *DirContent = FindDirectory(Content))
+            return DirContent;
+      } else {
+        for (std::unique_ptr<RedirectingFileSystem::Entry> &Content :
+             llvm::make_range(DE->contents_begin(), DE->contents_end()))
+          if (auto *DirContent = FindDirectory(Content.get()))
+            return DirContent;
       }
     }
 
@@ -1727,6 +1780,18 @@ RedirectingFileSystem::lookupPath(sys::path::const_iterator Start,
   if (!DE)
     return make_error_code(llvm::errc::not_a_directory);
 
+  // Entries with other names don't match the next component, so only the
+  // ones with the same name need to be searched.
+  if (auto Candidates = DE->lookupContents(*Start)) {
+    for (RedirectingFileSystem::Entry *DirEntry : *Candidates) {
+      ErrorOr<RedirectingFileSystem::Entry *> Result =
+          lookupPath(Start, End, DirEntry);
+      if (Result || Result.getError() != llvm::errc::no_such_file_or_directory)
+        return Result;
+    }
+    return make_error_code(llvm::errc::no_such_file_or_directory);
+  }
+
   for (const std::unique_ptr<RedirectingFileSystem::Entry> &DirEntry :
        llvm::make_range(DE->contents_begin(), DE->contents_end())) {
     ErrorOr<RedirectingFileSystem::Entry *> Result =
@@ -16,6 +16,7 @@
 
 #include "llvm/TableGen/Main.h"
 #include "TGParser.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
@@ -32,6 +33,11 @@ static cl::opt<std::string>
 OutputFilename("o", cl::desc("Output filename"), cl::value_desc("filename"),
                cl::init("-"));
 
+static cl::list<std::string>
+ExtraOutputFilenames("extra-output",
+                     cl::desc("Output filename for each additional action"),
+                     cl::value_desc("filename"));
+
 static cl::opt<std::string>
 DependFilename("d",
                cl::desc("Dependency filename"),
@@ -80,7 +86,43 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
-int llvm::TableGenMain(char *argv0, TableGenMainFn *MainFn) {
+/// Write the output of one action to Filename.
+static int writeOutput(const char *argv0, StringRef Filename,
+                       StringRef Contents) {
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_None);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ":" +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+
+  if (ErrorsPrinted > 0)
+    return reportError(argv0, Twine(ErrorsPrinted) + " errors.\n");
+
+  // Declare success.
+  OutFile.keep();
+  return 0;
+}
+
+static int
+TableGenMainImpl(char *argv0,
+                 function_ref<bool(raw_ostream &, RecordKeeper &, unsigned)>
+                     MainFn,
+                 unsigned NumActions) {
+  if (ExtraOutputFilenames.size() + 1 != NumActions)
+    return reportError(argv0, "expected " + Twine(NumActions - 1) +
+                                  " -extra-output files but got " +
+                                  Twine(ExtraOutputFilenames.size()) + "\n");
+
   RecordKeeper Records;
 
   // Parse the input file.
@@ -102,11 +144,16 @@ int llvm::TableGenMain(char *argv0, TableGenMainFn *MainFn) {
   if (Parser.ParseFile())
     return 1;
 
-  // Write output to memory.
-  std::string OutString;
-  raw_string_ostream Out(OutString);
-  if (MainFn(Out, Records))
-    return 1;
+  // Write output to memory. Every action shares the result of a single parse,
+  // so a backend that modifies the records must run last; the driver is
+  // responsible for ordering the actions.
+  std::vector<std::string> OutStrings(NumActions);
+  for (unsigned I = 0; I != NumActions; ++I) {
+    raw_string_ostream Out(OutStrings[I]);
+    if (MainFn(Out, Records, I))
+      return 1;
+    Out.flush();
+  }
 
   // Always write the depfile, even if the main output hasn't changed.
   // If it's missing, Ninja considers the output dirty.  If this was below
@@ -117,26 +164,25 @@ int llvm::TableGenMain(char *argv0, TableGenMainFn *MainFn) {
       return Ret;
   }
 
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr = MemoryBuffer::getFile(OutputFilename))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        return 0;
+  for (unsigned I = 0; I != NumActions; ++I) {
+    StringRef Filename = I == 0 ? StringRef(OutputFilename)
+                                : StringRef(ExtraOutputFilenames[I - 1]);
+    if (int Ret = writeOutput(argv0, Filename, OutStrings[I]))
+      return Ret;
   }
+  return 0;
+}
 
-  std::error_code EC;
-  ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_None);
-  if (EC)
-    return reportError(argv0, "error opening " + OutputFilename + ":" +
-                                  EC.message() + "\n");
-  OutFile.os() << Out.str();
-
-  if (ErrorsPrinted > 0)
-    return reportError(argv0, Twine(ErrorsPrinted) + " errors.\n");
+int llvm::TableGenMain(char *argv0, TableGenMainFn *MainFn) {
+  return TableGenMainImpl(
+      argv0,
+      [MainFn](raw_ostream &OS, RecordKeeper &Records, unsigned) {
+        return MainFn(OS, Records);
+      },
+      1);
+}
 
-  // Declare success.
-  OutFile.keep();
-  return 0;
+int llvm::TableGenMain(char *argv0, TableGenMultiMainFn *MainFn,
+                       unsigned NumActions) {
+  return TableGenMainImpl(argv0, MainFn, NumActions);
 }
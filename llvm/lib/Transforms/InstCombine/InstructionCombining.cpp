@@ -113,6 +113,16 @@ using namespace llvm::PatternMatch;
 
 #define DEBUG_TYPE "instcombine"
 
+STATISTIC(NumWorklistIterations,
+          "Number of instruction combining iterations performed");
+STATISTIC(NumOneIteration, "Number of functions with one iteration");
+STATISTIC(NumTwoIterations, "Number of functions with two iterations");
+STATISTIC(NumThreeIterations, "Number of functions with three iterations");
+STATISTIC(NumFourOrMoreIterations,
+          "Number of functions with four or more iterations");
+STATISTIC(NumMaxIterationsReached,
+          "Number of functions that did not reach a fixpoint");
+
 STATISTIC(NumCombined , "Number of insts combined");
 STATISTIC(NumConstProp, "Number of constant folds");
 STATISTIC(NumDeadInst , "Number of dead inst eliminated");
@@ -3786,12 +3796,20 @@ static bool combineInstructionsOverFunction(
       LLVM_DEBUG(dbgs() << "\n\n[IC] Iteration limit #" << MaxIterations
                         << " on " << F.getName()
                         << " reached; stopping before reaching a fixpoint\n");
+      ++NumMaxIterationsReached;
+      ORE.emit([&]() {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "MaxIterationsReached",
+                                        F.getSubprogram(), &F.getEntryBlock())
+               << "instruction combining did not reach a fixpoint after "
+               << ore::NV("MaxIterations", MaxIterations) << " iterations";
+      });
       break;
     }
 
     LLVM_DEBUG(dbgs() << "\n\nINSTCOMBINE ITERATION #" << Iteration << " on "
                       << F.getName() << "\n");
 
+    ++NumWorklistIterations;
     MadeIRChange |= prepareICWorklistFromFunction(F, DL, &TLI, Worklist);
 
     InstCombiner IC(Worklist, Builder, F.hasMinSize(), AA,
@@ -3804,6 +3822,17 @@ static bool combineInstructionsOverFunction(
     MadeIRChange = true;
   }
 
+  // When the limit was hit, the last increment did not run an iteration.
+  unsigned NumIterations = std::min(Iteration, MaxIterations);
+  if (NumIterations <= 1)
+    ++NumOneIteration;
+  else if (NumIterations == 2)
+    ++NumTwoIterations;
+  else if (NumIterations == 3)
+    ++NumThreeIterations;
+  else
+    ++NumFourOrMoreIterations;
+
   return MadeIRChange;
 }
 
@@ -1817,6 +1817,7 @@ static bool isOnlyReachableViaThisEdge(const BasicBlockEdge &E,
 
 void GVN::assignBlockRPONumber(Function &F) {
   BlockRPONumber.clear();
+  BlockRPONumber.reserve(F.size());
   uint32_t NextBlockNumber = 1;
   ReversePostOrderTraversal<Function *> RPOT(&F);
   for (BasicBlock *BB : RPOT)
@@ -107,6 +107,8 @@ using namespace slpvectorizer;
 #define DEBUG_TYPE "SLP"
 
 STATISTIC(NumVectorInstructions, "Number of vector instructions generated");
+STATISTIC(NumTreeBudgetExhausted,
+          "Number of functions that exhausted the SLP tree budget");
 
 cl::opt<bool>
     llvm::RunSLPVectorization("vectorize-slp", cl::init(false), cl::Hidden,
@@ -154,6 +156,13 @@ static cl::opt<unsigned> MinTreeSize(
     "slp-min-tree-size", cl::init(3), cl::Hidden,
     cl::desc("Only vectorize small trees if they are fully vectorizable"));
 
+// Limit the total number of tree entries built in a function. Every seed
+// bundle builds a new tree, and large straight-line functions have many seeds.
+static cl::opt<unsigned> FunctionTreeBudget(
+    "slp-function-tree-budget", cl::init(0), cl::Hidden,
+    cl::desc("Limit the number of vectorizable tree entries built per "
+             "function (0 = no limit)"));
+
 // The maximum depth that the look-ahead score heuristic will explore.
 // The higher this value, the higher the compilation time overhead.
 static cl::opt<int> LookAheadMaxDepth(
@@ -2231,6 +2240,10 @@ private:
   unsigned MaxVecRegSize; // This is set by TTI or overridden by cl::opt.
   unsigned MinVecRegSize; // Set by cl::opt (default: 128).
 
+  /// The number of tree entries built so far in this function, checked
+  /// against -slp-function-tree-budget.
+  unsigned NumTreeEntriesBuilt = 0;
+
   /// Instruction builder to construct the vectorized tree.
   IRBuilder<> Builder;
 
@@ -2375,7 +2388,18 @@ void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
   UserIgnoreList = UserIgnoreLst;
   if (!allSameType(Roots))
     return;
+  if (FunctionTreeBudget && NumTreeEntriesBuilt >= FunctionTreeBudget) {
+    if (NumTreeEntriesBuilt != std::numeric_limits<unsigned>::max()) {
+      LLVM_DEBUG(dbgs() << "SLP: Tree budget exhausted in "
+                        << F->getName() << ".\n");
+      ++NumTreeBudgetExhausted;
+      // Only report each function once.
+      NumTreeEntriesBuilt = std::numeric_limits<unsigned>::max();
+    }
+    return;
+  }
   buildTree_rec(Roots, 0, EdgeInfo());
+  NumTreeEntriesBuilt += VectorizableTree.size();
 
   // Collect the values that we need to extract from the tree.
   for (auto &TEPtr : VectorizableTree) {
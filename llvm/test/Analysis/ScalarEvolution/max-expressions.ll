@@ -0,0 +1,30 @@
+; RUN: opt -analyze -scalar-evolution < %s | FileCheck %s
+; RUN: opt -analyze -scalar-evolution -scalar-evolution-max-expressions=1 \
+; RUN:   < %s | FileCheck %s --check-prefix=BUDGET
+
+; Once the expression budget is exhausted, new values are modeled as unknown
+; and the backedge-taken count can no longer be computed from them.
+
+define void @f(i32 %n) {
+; CHECK-LABEL: Classifying expressions for: @f
+; CHECK:       %i = phi
+; CHECK-NEXT:  -->  {0,+,1}<{{.*}}%loop>
+; CHECK:       Loop %loop: backedge-taken count is (-1 + %n)
+
+; BUDGET-LABEL: Classifying expressions for: @f
+; BUDGET:       %i = phi
+; BUDGET-NEXT:  -->  %i U:
+; BUDGET-NOT:   {0,+,1}
+; BUDGET:       Loop %loop: Unpredictable backedge-taken count.
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %i.next = add i32 %i, 1
+  %c = icmp ne i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret void
+}
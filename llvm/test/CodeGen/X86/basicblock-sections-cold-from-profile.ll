@@ -0,0 +1,85 @@
+; Check that -bbsections-cold-from-profile moves the profile-cold blocks of a
+; function missing from the list into the cold section, and keeps the hot
+; blocks together in the function section.
+; RUN: echo '!bar' > %t
+; RUN: llc < %s -mtriple=x86_64-pc-linux -disable-block-placement -function-sections -basicblock-sections=%t -unique-bb-section-names -bbsections-cold-from-profile | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-pc-linux -disable-block-placement -function-sections -basicblock-sections=%t -unique-bb-section-names | FileCheck %s --check-prefix=NOPROFILE
+
+; Without block placement the cold block stays between the entry block and the
+; hot blocks, so the function section is made of blocks that were not
+; contiguous before sorting. It must still begin at the entry block and end
+; after the last hot block, without a section or size directive of its own for
+; any of them.
+define void @foo(i1 zeroext %c) !prof !14 {
+entry:
+  br i1 %c, label %cold, label %hot, !prof !15
+
+cold:
+  call void @cold_fn()
+  br label %exit
+
+hot:
+  call void @hot_fn()
+  br label %exit
+
+exit:
+  ret void
+}
+
+; A listed function is split as the list says, regardless of its profile.
+define void @bar(i1 zeroext %c) !prof !14 {
+entry:
+  br i1 %c, label %cold, label %exit, !prof !15
+
+cold:
+  call void @cold_fn()
+  br label %exit
+
+exit:
+  ret void
+}
+
+declare void @cold_fn()
+declare void @hot_fn()
+
+; CHECK:         .section .text.foo,"ax",@progbits
+; CHECK-LABEL:   foo:
+; CHECK-NOT:     .section
+; CHECK-NOT:     .size {{.*}}.BB.foo
+; CHECK:         callq hot_fn
+; CHECK-NOT:     .section
+; CHECK-NOT:     .size {{.*}}.BB.foo
+; CHECK:         .section .text.foo.unlikely,"ax",@progbits
+; CHECK-NEXT:    a.BB.foo:
+; CHECK:         callq cold_fn
+; CHECK:         .size a.BB.foo, {{.*}}-a.BB.foo
+; CHECK-NEXT:    .section .text.foo,"ax",@progbits
+; CHECK-NEXT:    .Lfunc_end0:
+; CHECK-NEXT:    .size foo, .Lfunc_end0-foo
+
+; CHECK:         .section .text.bar,"ax",@progbits
+; CHECK-LABEL:   bar:
+; CHECK:         .section .text.bar.a.BB.bar,"ax",@progbits,unique,
+; CHECK-NEXT:    a.BB.bar:
+; CHECK:         callq cold_fn
+; CHECK-NOT:     .unlikely
+
+; NOPROFILE-NOT: .unlikely
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 1, !"ProfileSummary", !1}
+!1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!2 = !{!"ProfileFormat", !"InstrProf"}
+!3 = !{!"TotalCount", i64 10000}
+!4 = !{!"MaxCount", i64 1000}
+!5 = !{!"MaxInternalCount", i64 1000}
+!6 = !{!"MaxFunctionCount", i64 1000}
+!7 = !{!"NumCounts", i64 8}
+!8 = !{!"NumFunctions", i64 2}
+!9 = !{!"DetailedSummary", !10}
+!10 = !{!11, !12, !13}
+!11 = !{i32 10000, i64 1000, i32 1}
+!12 = !{i32 999000, i64 100, i32 4}
+!13 = !{i32 999999, i64 1, i32 8}
+!14 = !{!"function_entry_count", i64 1000}
+!15 = !{!"branch_weights", i32 0, i32 1000}
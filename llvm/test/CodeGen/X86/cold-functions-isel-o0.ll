@@ -0,0 +1,51 @@
+; REQUIRES: asserts
+; RUN: llc < %s -mtriple=x86_64-pc-linux -cold-functions-isel-o0 \
+; RUN:   -debug-only=isel -o /dev/null 2>&1 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-pc-linux -debug-only=isel -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=DEFAULT
+
+; With -cold-functions-isel-o0, a function that the profile marks as cold is
+; selected at -O0, and the optimization level is restored afterwards.
+
+; CHECK-NOT:   Changing optimization level for Function hot
+; CHECK:       Changing optimization level for Function cold
+; CHECK-NEXT:  Before: -O2 ; After: -O0
+; CHECK-NEXT:  FastISel is enabled
+; CHECK:       Restoring optimization level for Function cold
+; CHECK-NEXT:  Before: -O0 ; After: -O2
+; CHECK-NOT:   Changing optimization level
+
+; DEFAULT-NOT: Changing optimization level
+
+define i32 @hot(i32 %a, i32 %b) !prof !14 {
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+define i32 @cold(i32 %a, i32 %b) !prof !15 {
+  %r = mul i32 %a, %b
+  ret i32 %r
+}
+
+define i32 @hot2(i32 %a, i32 %b) !prof !14 {
+  %r = sub i32 %a, %b
+  ret i32 %r
+}
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 1, !"ProfileSummary", !1}
+!1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!2 = !{!"ProfileFormat", !"InstrProf"}
+!3 = !{!"TotalCount", i64 10000}
+!4 = !{!"MaxCount", i64 1000}
+!5 = !{!"MaxInternalCount", i64 1000}
+!6 = !{!"MaxFunctionCount", i64 1000}
+!7 = !{!"NumCounts", i64 3}
+!8 = !{!"NumFunctions", i64 3}
+!9 = !{!"DetailedSummary", !10}
+!10 = !{!11, !12, !13}
+!11 = !{i32 10000, i64 1000, i32 1}
+!12 = !{i32 999000, i64 100, i32 2}
+!13 = !{i32 999999, i64 1, i32 3}
+!14 = !{!"function_entry_count", i64 1000}
+!15 = !{!"function_entry_count", i64 0}
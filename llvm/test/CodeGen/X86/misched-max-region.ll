@@ -0,0 +1,28 @@
+; REQUIRES: asserts
+; RUN: llc < %s -mtriple=x86_64-pc-linux -enable-misched -misched-max-region=2 \
+; RUN:   -debug-only=machine-scheduler -o /dev/null 2>&1 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-pc-linux -enable-misched \
+; RUN:   -debug-only=machine-scheduler -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=DEFAULT
+
+; With -misched-max-region=2, the block is scheduled as a series of regions of
+; at most two instructions each. Without it, it is a single larger region.
+
+; CHECK:     ********** MI Scheduling **********
+; CHECK:     RegionInstrs: 2
+; CHECK-NOT: RegionInstrs: {{[3-9]|[1-9][0-9]}}
+
+; DEFAULT:   ********** MI Scheduling **********
+; DEFAULT:   RegionInstrs: {{[3-9]|[1-9][0-9]}}
+
+define i32 @f(i32 %a, i32 %b, i32 %c, i32 %d) {
+  %x0 = add i32 %a, %b
+  %x1 = xor i32 %c, %d
+  %x2 = mul i32 %x0, %c
+  %x3 = sub i32 %x1, %a
+  %x4 = mul i32 %x2, %x3
+  %x5 = xor i32 %x4, %b
+  %x6 = add i32 %x5, %d
+  %x7 = mul i32 %x6, %x1
+  ret i32 %x7
+}
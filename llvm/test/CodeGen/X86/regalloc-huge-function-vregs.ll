@@ -0,0 +1,27 @@
+; RUN: llc < %s -mtriple=x86_64-pc-linux -regalloc-huge-function-vregs=1 \
+; RUN:   -pass-remarks-analysis=regalloc -o /dev/null 2>&1 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-pc-linux -regalloc-huge-function-vregs=1000 \
+; RUN:   -pass-remarks-analysis=regalloc -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=SMALL --allow-empty
+
+; Region splitting is skipped, and reported, only in functions with more
+; virtual registers than -regalloc-huge-function-vregs.
+
+; CHECK:     remark: {{.*}} region splitting disabled in function with {{[0-9]+}} virtual registers
+; CHECK-NOT: region splitting disabled
+; SMALL-NOT: region splitting disabled
+
+define i32 @f(i32 %a, i32 %b, i32 %c) {
+entry:
+  %cmp = icmp sgt i32 %a, %b
+  br i1 %cmp, label %then, label %exit
+
+then:
+  %x = mul i32 %a, %c
+  br label %exit
+
+exit:
+  %r = phi i32 [ %x, %then ], [ %b, %entry ]
+  %s = add i32 %r, %a
+  ret i32 %s
+}
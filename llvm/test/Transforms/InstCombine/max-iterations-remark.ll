@@ -0,0 +1,26 @@
+; RUN: opt < %s -instcombine -instcombine-max-iterations=1 \
+; RUN:   -pass-remarks-missed=instcombine -S 2>&1 | FileCheck %s
+; RUN: opt < %s -passes=instcombine -instcombine-max-iterations=1 \
+; RUN:   -pass-remarks-missed=instcombine -S 2>&1 | FileCheck %s
+
+; A function that is still changing when the iteration limit is reached gets a
+; missed-optimization remark. A function that is already at a fixpoint does
+; not.
+
+; CHECK:     remark: <unknown>:0:0: instruction combining did not reach a fixpoint after 1 iterations
+; CHECK-NOT: remark:
+
+; CHECK-LABEL: @changed(
+; CHECK-NEXT:    ret i32 %a
+define i32 @changed(i32 %a) {
+  %x = add i32 %a, 0
+  ret i32 %x
+}
+
+; CHECK-LABEL: @fixpoint(
+; CHECK-NEXT:    [[X:%.*]] = add i32 %a, %b
+; CHECK-NEXT:    ret i32 [[X]]
+define i32 @fixpoint(i32 %a, i32 %b) {
+  %x = add i32 %a, %b
+  ret i32 %x
+}
@@ -0,0 +1,39 @@
+; RUN: opt < %s -slp-vectorizer -mtriple=x86_64-unknown-linux -S | FileCheck %s
+; RUN: opt < %s -slp-vectorizer -mtriple=x86_64-unknown-linux \
+; RUN:   -slp-function-tree-budget=1 -S | FileCheck %s --check-prefix=BUDGET
+
+; Both store chains are vectorized without a budget. With a budget of one
+; tree entry, the first tree exhausts it and the second chain stays scalar.
+
+define void @f(double* noalias %a, double* noalias %b, double* noalias %c,
+               double* noalias %d) {
+; CHECK-LABEL: @f(
+; CHECK:         store <2 x double> {{.*}}, <2 x double>* {{.*}}
+; CHECK:         store <2 x double> {{.*}}, <2 x double>* {{.*}}
+; CHECK:         ret void
+;
+; BUDGET-LABEL: @f(
+; BUDGET:         store <2 x double> {{.*}}, <2 x double>* {{.*}}
+; BUDGET-NOT:     store <2 x double>
+; BUDGET:         store double {{.*}}, double* %d
+; BUDGET:         store double {{.*}}, double* %d1
+; BUDGET:         ret void
+entry:
+  %b1 = getelementptr inbounds double, double* %b, i64 1
+  %c1 = getelementptr inbounds double, double* %c, i64 1
+  %a1 = getelementptr inbounds double, double* %a, i64 1
+  %d1 = getelementptr inbounds double, double* %d, i64 1
+  %b0v = load double, double* %b, align 8
+  %b1v = load double, double* %b1, align 8
+  %c0v = load double, double* %c, align 8
+  %c1v = load double, double* %c1, align 8
+  %add0 = fadd double %b0v, %c0v
+  %add1 = fadd double %b1v, %c1v
+  store double %add0, double* %a, align 8
+  store double %add1, double* %a1, align 8
+  %mul0 = fmul double %b0v, %c0v
+  %mul1 = fmul double %b1v, %c1v
+  store double %mul0, double* %d, align 8
+  store double %mul1, double* %d1, align 8
+  ret void
+}
@@ -419,8 +419,15 @@ static int compileModule(char **argv, LLVMContext &Context) {
                                     setMIRFunctionAttributes);
       if (MIR)
         M = MIR->parseIRModule();
-    } else
+    } else {
+      // The module is materialized completely rather than lazily. Module
+      // passes in the codegen pipeline, such as pre-ISel intrinsic lowering,
+      // visit the users of values across all function bodies, and code
+      // emission checks isDeclaration() on every function after its body has
+      // been compiled, so bodies can neither be loaded on demand nor deleted
+      // early.
       M = parseIRFile(InputFilename, Err, Context, false);
+    }
     if (!M) {
       Err.print(argv[0], WithColor::error(errs(), argv[0]));
       return 1;
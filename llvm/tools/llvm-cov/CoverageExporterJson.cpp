@@ -49,7 +49,7 @@
 #include "llvm/Support/Threading.h"
 #include <algorithm>
 #include <limits>
-#include <mutex>
+#include <numeric>
 #include <utility>
 
 /// The semantic version combined as a string.
@@ -159,42 +159,49 @@ json::Object renderFile(const coverage::CoverageMapping &Coverage,
   return File;
 }
 
-json::Array renderFiles(const coverage::CoverageMapping &Coverage,
-                        ArrayRef<std::string> SourceFiles,
-                        ArrayRef<FileCoverageSummary> FileReports,
-                        const CoverageViewOptions &Options) {
+/// Render the files in order of their names and write them to \p J. Files are
+/// rendered in parallel, one batch of as many files as there are threads at a
+/// time, so only a batch of file objects is materialized at once.
+void renderFiles(json::OStream &J, const coverage::CoverageMapping &Coverage,
+                 ArrayRef<std::string> SourceFiles,
+                 ArrayRef<FileCoverageSummary> FileReports,
+                 const CoverageViewOptions &Options) {
+  std::vector<unsigned> FileOrder(SourceFiles.size());
+  std::iota(FileOrder.begin(), FileOrder.end(), 0);
+  std::stable_sort(FileOrder.begin(), FileOrder.end(),
+                   [&](unsigned A, unsigned B) {
+                     return SourceFiles[A] < SourceFiles[B];
+                   });
+
   auto NumThreads = Options.NumThreads;
   if (NumThreads == 0)
     NumThreads = SourceFiles.size();
   ThreadPool Pool(heavyweight_hardware_concurrency(NumThreads));
-  json::Array FileArray;
-  std::mutex FileArrayMutex;
-
-  for (unsigned I = 0, E = SourceFiles.size(); I < E; ++I) {
-    auto &SourceFile = SourceFiles[I];
-    auto &FileReport = FileReports[I];
-    Pool.async([&] {
-      auto File = renderFile(Coverage, SourceFile, FileReport, Options);
-      {
-        std::lock_guard<std::mutex> Lock(FileArrayMutex);
-        FileArray.push_back(std::move(File));
-      }
-    });
+  // Each task owns its slot, so no locking is needed.
+  std::vector<json::Object> Batch(std::max(Pool.getThreadCount(), 1u));
+
+  for (size_t Begin = 0, E = FileOrder.size(); Begin < E;
+       Begin += Batch.size()) {
+    size_t End = std::min(E, Begin + Batch.size());
+    for (size_t I = Begin; I < End; ++I) {
+      auto &SourceFile = SourceFiles[FileOrder[I]];
+      auto &FileReport = FileReports[FileOrder[I]];
+      auto &File = Batch[I - Begin];
+      Pool.async([&] {
+        File = renderFile(Coverage, SourceFile, FileReport, Options);
+      });
+    }
+    Pool.wait();
+    for (size_t I = Begin; I < End; ++I)
+      J.value(std::move(Batch[I - Begin]));
   }
-  Pool.wait();
-  return FileArray;
 }
 
-json::Array renderFunctions(
-    const iterator_range<coverage::FunctionRecordIterator> &Functions) {
-  json::Array FunctionArray;
-  for (const auto &F : Functions)
-    FunctionArray.push_back(
-        json::Object({{"name", F.Name},
-                      {"count", clamp_uint64_to_int64(F.ExecutionCount)},
-                      {"regions", renderRegions(F.CountedRegions)},
-                      {"filenames", json::Array(F.Filenames)}}));
-  return FunctionArray;
+json::Object renderFunction(const coverage::FunctionRecord &F) {
+  return json::Object({{"name", F.Name},
+                       {"count", clamp_uint64_to_int64(F.ExecutionCount)},
+                       {"regions", renderRegions(F.CountedRegions)},
+                       {"filenames", json::Array(F.Filenames)}});
 }
 
 } // end anonymous namespace
@@ -212,27 +219,28 @@ void CoverageExporterJson::renderRoot(ArrayRef<std::string> SourceFiles) {
   FileCoverageSummary Totals = FileCoverageSummary("Totals");
   auto FileReports = CoverageReport::prepareFileReports(Coverage, Totals,
                                                         SourceFiles, Options);
-  auto Files = renderFiles(Coverage, SourceFiles, FileReports, Options);
-  // Sort files in order of their names.
-  std::sort(Files.begin(), Files.end(),
-    [](const json::Value &A, const json::Value &B) {
-      const json::Object *ObjA = A.getAsObject();
-      const json::Object *ObjB = B.getAsObject();
-      assert(ObjA != nullptr && "Value A was not an Object");
-      assert(ObjB != nullptr && "Value B was not an Object");
-      const StringRef FilenameA = ObjA->getString("filename").getValue();
-      const StringRef FilenameB = ObjB->getString("filename").getValue();
-      return FilenameA.compare(FilenameB) < 0;
-    });
-  auto Export = json::Object(
-      {{"files", std::move(Files)}, {"totals", renderSummary(Totals)}});
-  // Skip functions-level information  if necessary.
-  if (!Options.ExportSummaryOnly && !Options.SkipFunctions)
-    Export["functions"] = renderFunctions(Coverage.getCoveredFunctions());
-
-  auto ExportArray = json::Array({std::move(Export)});
 
-  OS << json::Object({{"version", LLVM_COVERAGE_EXPORT_JSON_STR},
-                      {"type", LLVM_COVERAGE_EXPORT_JSON_TYPE_STR},
-                      {"data", std::move(ExportArray)}});
+  // Stream the export rather than building it as a single json::Value, so that
+  // only a batch of file records or one function record is materialized at a
+  // time. Attributes are written in sorted order to match json::Object's
+  // serialization.
+  json::OStream J(OS);
+  J.object([&] {
+    J.attributeArray("data", [&] {
+      J.object([&] {
+        J.attributeArray("files", [&] {
+          renderFiles(J, Coverage, SourceFiles, FileReports, Options);
+        });
+        // Skip functions-level information if necessary.
+        if (!Options.ExportSummaryOnly && !Options.SkipFunctions)
+          J.attributeArray("functions", [&] {
+            for (const auto &F : Coverage.getCoveredFunctions())
+              J.value(renderFunction(F));
+          });
+        J.attribute("totals", renderSummary(Totals));
+      });
+    });
+    J.attribute("type", LLVM_COVERAGE_EXPORT_JSON_TYPE_STR);
+    J.attribute("version", LLVM_COVERAGE_EXPORT_JSON_STR);
+  });
 }
@@ -13,6 +13,7 @@
 #include "llvm/Support/Host.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -71,11 +72,31 @@ static bool shouldStripUnderscore() {
     return false;
   // If none of them are set, use the default value for platform.
   // macho has symbols prefix with "_" so strip by default.
-  return Triple(sys::getProcessTriple()).isOSBinFormatMachO();
+  static const bool IsMachO =
+      Triple(sys::getProcessTriple()).isOSBinFormatMachO();
+  return IsMachO;
 }
 
-static std::string demangle(const std::string &Mangled) {
+// The buffer that itaniumDemangle prints into. It is kept across calls, so
+// that demangling a symbol doesn't allocate a new one every time.
+static char *DemangleBuf = nullptr;
+static size_t DemangleBufSize = 0;
+
+static const char *itaniumDemangleReusingBuffer(const char *MangledName) {
+  // itaniumDemangle sets the size to the length of the output, not to the
+  // size of the buffer, so pass it a copy. The buffer is at least as large as
+  // the longest output so far, since it only ever grows.
+  size_t Size = DemangleBufSize;
   int Status;
+  char *Undecorated = itaniumDemangle(MangledName, DemangleBuf, &Size, &Status);
+  if (Undecorated) {
+    DemangleBuf = Undecorated;
+    DemangleBufSize = std::max(DemangleBufSize, Size);
+  }
+  return Undecorated;
+}
+
+static std::string demangle(const std::string &Mangled) {
   std::string Prefix;
 
   const char *DecoratedStr = Mangled.c_str();
@@ -84,22 +105,20 @@ static std::string demangle(const std::string &Mangled) {
       ++DecoratedStr;
   size_t DecoratedLength = strlen(DecoratedStr);
 
-  char *Undecorated = nullptr;
+  const char *Undecorated = nullptr;
 
   if (Types ||
       ((DecoratedLength >= 2 && strncmp(DecoratedStr, "_Z", 2) == 0) ||
        (DecoratedLength >= 4 && strncmp(DecoratedStr, "___Z", 4) == 0)))
-    Undecorated = itaniumDemangle(DecoratedStr, nullptr, nullptr, &Status);
+    Undecorated = itaniumDemangleReusingBuffer(DecoratedStr);
 
   if (!Undecorated &&
       (DecoratedLength > 6 && strncmp(DecoratedStr, "__imp_", 6) == 0)) {
     Prefix = "import thunk for ";
-    Undecorated = itaniumDemangle(DecoratedStr + 6, nullptr, nullptr, &Status);
+    Undecorated = itaniumDemangleReusingBuffer(DecoratedStr + 6);
   }
 
-  std::string Result(Undecorated ? Prefix + Undecorated : Mangled);
-  free(Undecorated);
-  return Result;
+  return Undecorated ? Prefix + Undecorated : Mangled;
 }
 
 // Split 'Source' on any character that fails to pass 'IsLegalChar'.  The
@@ -149,7 +168,10 @@ static void demangleLine(llvm::raw_ostream &OS, StringRef Mangled, bool Split) {
   } else
     Result = ::demangle(std::string(Mangled));
   OS << Result << '\n';
-  OS.flush();
+  // Flush every line read from stdin, so that llvm-cxxfilt can be used
+  // interactively, e.g. as a coprocess.
+  if (Split)
+    OS.flush();
 }
 
 int main(int argc, char **argv) {
@@ -164,5 +186,6 @@ int main(int argc, char **argv) {
     for (const auto &Symbol : Decorated)
       demangleLine(llvm::outs(), Symbol, false);
 
+  free(DemangleBuf);
   return EXIT_SUCCESS;
 }
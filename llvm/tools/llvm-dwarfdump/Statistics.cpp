@@ -517,9 +517,14 @@ bool collectStatsForObjectFile(ObjectFile &Obj, DWARFContext &DICtx,
   LocationStats LocStats;
   StringMap<PerFunctionStats> Statistics;
   for (const auto &CU : static_cast<DWARFContext *>(&DICtx)->compile_units())
-    if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE(false))
+    if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE(false)) {
       collectStatsRecursive(CUDie, "/", "g", 0, 0, Statistics, GlobalStats,
                             LocStats);
+      // Only the CU DIE is needed once the unit has been visited, so drop the
+      // rest to keep memory bounded on large inputs.
+      CUDie.getDwarfUnit()->clearDIEs(/*KeepCUDie=*/true);
+      CU->clearDIEs(/*KeepCUDie=*/true);
+    }
 
   /// Collect the sizes of debug sections.
   SectionSizes Sizes;
@@ -286,26 +286,19 @@ static bool filterArch(ObjectFile &Obj) {
 using HandlerFn = std::function<bool(ObjectFile &, DWARFContext &DICtx,
                                      const Twine &, raw_ostream &)>;
 
-/// Print only DIEs that have a certain name.
-static bool filterByName(const StringSet<> &Names, DWARFDie Die,
-                         StringRef NameRef, raw_ostream &OS) {
-  std::string Name =
-      (IgnoreCase && !UseRegex) ? NameRef.lower() : NameRef.str();
+/// Print only DIEs that have a certain name. \p Patterns holds the compiled
+/// form of \p Names when --regex is in effect.
+static bool filterByName(const StringSet<> &Names, ArrayRef<Regex> Patterns,
+                         DWARFDie Die, StringRef NameRef, raw_ostream &OS) {
   if (UseRegex) {
     // Match regular expression.
-    for (auto Pattern : Names.keys()) {
-      Regex RE(Pattern, IgnoreCase ? Regex::IgnoreCase : Regex::NoFlags);
-      std::string Error;
-      if (!RE.isValid(Error)) {
-        errs() << "error in regular expression: " << Error << "\n";
-        exit(1);
-      }
-      if (RE.match(Name)) {
+    for (const Regex &RE : Patterns) {
+      if (RE.match(NameRef)) {
         Die.dump(OS, 0, getDumpOpts());
         return true;
       }
     }
-  } else if (Names.count(Name)) {
+  } else if (IgnoreCase ? Names.count(NameRef.lower()) : Names.count(NameRef)) {
     // Match full text.
     Die.dump(OS, 0, getDumpOpts());
     return true;
@@ -314,17 +307,17 @@ static bool filterByName(const StringSet<> &Names, DWARFDie Die,
 }
 
 /// Print only DIEs that have a certain name.
-static void filterByName(const StringSet<> &Names,
+static void filterByName(const StringSet<> &Names, ArrayRef<Regex> Patterns,
                          DWARFContext::unit_iterator_range CUs,
                          raw_ostream &OS) {
   for (const auto &CU : CUs)
     for (const auto &Entry : CU->dies()) {
       DWARFDie Die = {CU.get(), &Entry};
       if (const char *Name = Die.getName(DINameKind::ShortName))
-        if (filterByName(Names, Die, Name, OS))
+        if (filterByName(Names, Patterns, Die, Name, OS))
           continue;
       if (const char *Name = Die.getName(DINameKind::LinkageName))
-        filterByName(Names, Die, Name, OS);
+        filterByName(Names, Patterns, Die, Name, OS);
     }
 }
 
@@ -439,8 +432,22 @@ static bool dumpObjectFile(ObjectFile &Obj, DWARFContext &DICtx,
     for (auto name : Name)
       Names.insert((IgnoreCase && !UseRegex) ? StringRef(name).lower() : name);
 
-    filterByName(Names, DICtx.normal_units(), OS);
-    filterByName(Names, DICtx.dwo_units(), OS);
+    // Compile the patterns once rather than for every DIE name.
+    std::vector<Regex> Patterns;
+    if (UseRegex) {
+      for (auto Pattern : Names.keys()) {
+        Regex RE(Pattern, IgnoreCase ? Regex::IgnoreCase : Regex::NoFlags);
+        std::string Error;
+        if (!RE.isValid(Error)) {
+          errs() << "error in regular expression: " << Error << "\n";
+          exit(1);
+        }
+        Patterns.push_back(std::move(RE));
+      }
+    }
+
+    filterByName(Names, Patterns, DICtx.normal_units(), OS);
+    filterByName(Names, Patterns, DICtx.dwo_units(), OS);
     return true;
   }
 
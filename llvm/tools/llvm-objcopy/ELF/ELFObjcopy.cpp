@@ -33,6 +33,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -41,6 +42,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -574,13 +576,28 @@ static Error replaceAndRemoveSections(const CopyConfig &Config, Object &Obj) {
     };
   }
 
-  if (Config.CompressionType != DebugCompressionType::None)
-    replaceDebugSections(Obj, RemovePred, isCompressable, 
-                         [&Config, &Obj](const SectionBase *S) {
-                           return &Obj.addSection<CompressedSection>(
-                                *S, Config.CompressionType);
-                        });
-  else if (Config.DecompressDebugSections)
+  if (Config.CompressionType != DebugCompressionType::None) {
+    std::vector<CompressedSection *> Compressed;
+    replaceDebugSections(Obj, RemovePred, isCompressable,
+                         [&Config, &Obj, &Compressed](const SectionBase *S) {
+                           Compressed.push_back(
+                               &Obj.addSection<CompressedSection>(
+                                   *S, Config.CompressionType));
+                           return Compressed.back();
+                         });
+    // The sections are independent, so compress them concurrently.
+    std::mutex ErrMu;
+    Error Err = Error::success();
+    parallel::for_each_n(parallel::par, size_t(0), Compressed.size(),
+                         [&](size_t I) {
+                           if (Error E = Compressed[I]->compress()) {
+                             std::lock_guard<std::mutex> Lock(ErrMu);
+                             Err = joinErrors(std::move(Err), std::move(E));
+                           }
+                         });
+    if (Err)
+      return Err;
+  } else if (Config.DecompressDebugSections)
     replaceDebugSections(
         Obj, RemovePred,
         [](const SectionBase &S) { return isa<CompressedSection>(&S); },
@@ -504,26 +504,31 @@ CompressedSection::CompressedSection(const SectionBase &Sec,
                                      DebugCompressionType CompressionType)
     : SectionBase(Sec), CompressionType(CompressionType),
       DecompressedSize(Sec.OriginalData.size()), DecompressedAlign(Sec.Align) {
+  if (CompressionType == DebugCompressionType::GNU)
+    Name = ".z" + Sec.Name.substr(1);
+  else
+    Flags |= ELF::SHF_COMPRESSED;
+  Align = 8;
+}
+
+Error CompressedSection::compress() {
   if (Error E = zlib::compress(
           StringRef(reinterpret_cast<const char *>(OriginalData.data()),
                     OriginalData.size()),
           CompressedData))
-    reportError(Name, std::move(E));
+    return createFileError(Name, std::move(E));
 
   size_t ChdrSize;
-  if (CompressionType == DebugCompressionType::GNU) {
-    Name = ".z" + Sec.Name.substr(1);
+  if (CompressionType == DebugCompressionType::GNU)
     ChdrSize = sizeof("ZLIB") - 1 + sizeof(uint64_t);
-  } else {
-    Flags |= ELF::SHF_COMPRESSED;
+  else
     ChdrSize =
         std::max(std::max(sizeof(object::Elf_Chdr_Impl<object::ELF64LE>),
                           sizeof(object::Elf_Chdr_Impl<object::ELF64BE>)),
                  std::max(sizeof(object::Elf_Chdr_Impl<object::ELF32LE>),
                           sizeof(object::Elf_Chdr_Impl<object::ELF32BE>)));
-  }
   Size = ChdrSize + CompressedData.size();
-  Align = 8;
+  return Error::success();
 }
 
 CompressedSection::CompressedSection(ArrayRef<uint8_t> CompressedData,
@@ -529,6 +529,11 @@ public:
   CompressedSection(ArrayRef<uint8_t> CompressedData, uint64_t DecompressedSize,
                     uint64_t DecompressedAlign);
 
+  /// Compresses the original section data and sets the final size. This is
+  /// kept out of the constructor so that sections can be compressed in
+  /// parallel once they have all been added to the object.
+  Error compress();
+
   uint64_t getDecompressedSize() const { return DecompressedSize; }
   uint64_t getDecompressedAlign() const { return DecompressedAlign; }
 
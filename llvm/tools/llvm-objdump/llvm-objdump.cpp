@@ -649,7 +649,7 @@ void SourcePrinter::printSourceLine(raw_ostream &OS,
     printLines(OS, LineInfo, Delimiter);
   if (PrintSource)
     printSources(OS, LineInfo, ObjectFilename, Delimiter);
-  OldLineInfo = LineInfo;
+  OldLineInfo = std::move(LineInfo);
 }
 
 void SourcePrinter::printLines(raw_ostream &OS, const DILineInfo &LineInfo,
@@ -31,6 +31,7 @@
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <atomic>
 
 using namespace llvm;
 
@@ -325,12 +326,15 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   } else {
     ThreadPool Pool(hardware_concurrency(NumThreads));
 
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
-    for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
-    }
+    // Load the inputs in parallel. Each task owns one writer context and
+    // pulls the next input from a shared counter, so uneven input sizes do
+    // not leave threads blocked on a context another thread is filling.
+    std::atomic<size_t> NextInput(0);
+    for (unsigned I = 0; I < NumThreads; ++I)
+      Pool.async([&, WC = Contexts[I].get()] {
+        for (size_t J; (J = NextInput++) < Inputs.size();)
+          loadInput(Inputs[J], Remapper, WC);
+      });
     Pool.wait();
 
     // Merge the writer contexts together (~ lg(NumThreads) serial steps).
@@ -15,6 +15,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
+#include <map>
 #include <vector>
 
 namespace llvm {
@@ -35,10 +36,17 @@ public:
 
   void setProgram(std::unique_ptr<Module> P) { Program = std::move(P); }
 
+  /// Returns the results of the tests run so far, keyed by the MD5 of the
+  /// textual form of the tested module.
+  std::map<std::pair<uint64_t, uint64_t>, bool> &getResultCache() {
+    return ResultCache;
+  }
+
 private:
   StringRef TestName;
   const std::vector<std::string> &TestArgs;
   std::unique_ptr<Module> Program;
+  std::map<std::pair<uint64_t, uint64_t>, bool> ResultCache;
 };
 
 } // namespace llvm
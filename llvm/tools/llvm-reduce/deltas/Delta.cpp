@@ -14,45 +14,92 @@
 
 #include "Delta.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Transforms/Utils/Cloning.h"
-#include <fstream>
 #include <set>
 
 using namespace llvm;
 
-bool IsReduced(Module &M, TestRunner &Test, SmallString<128> &CurrentFilepath) {
-  // Write Module to tmp file
+static cl::opt<unsigned> NumJobs(
+    "j", cl::init(1),
+    cl::desc("Maximum number of interesting-ness tests to run in parallel"));
+
+namespace {
+/// A reduced version of the program, written to a temporary file so that it
+/// can be tested.
+struct Candidate {
+  /// The index of the chunk that was ignored to get this candidate.
+  int ChunkIdx = -1;
+  std::unique_ptr<Module> M;
+  /// The temporary file, removed once the candidate is destroyed.
+  std::unique_ptr<ToolOutputFile> File;
+  SmallString<128> Filepath;
+  MD5::MD5Result Hash;
+  size_t Lines = 0;
+  bool Interesting = false;
+};
+} // namespace
+
+/// Writes \p M to a temporary file for the interesting-ness test.
+static Candidate writeCandidate(Module &M) {
+  std::string Text;
+  raw_string_ostream OS(Text);
+  M.print(OS, /*AnnotationWriter=*/nullptr);
+  OS.flush();
+
+  Candidate C;
+  MD5 Hasher;
+  Hasher.update(Text);
+  Hasher.final(C.Hash);
+  C.Lines = llvm::count(Text, '\n');
+
   int FD;
   std::error_code EC =
-      sys::fs::createTemporaryFile("llvm-reduce", "ll", FD, CurrentFilepath);
+      sys::fs::createTemporaryFile("llvm-reduce", "ll", FD, C.Filepath);
   if (EC) {
     errs() << "Error making unique filename: " << EC.message() << "!\n";
     exit(1);
   }
 
-  ToolOutputFile Out(CurrentFilepath, FD);
-  M.print(Out.os(), /*AnnotationWriter=*/nullptr);
-  Out.os().close();
-  if (Out.os().has_error()) {
-    errs() << "Error emitting bitcode to file '" << CurrentFilepath << "'!\n";
+  C.File = std::make_unique<ToolOutputFile>(C.Filepath, FD);
+  C.File->os() << Text;
+  C.File->os().close();
+  if (C.File->os().has_error()) {
+    errs() << "Error emitting bitcode to file '" << C.Filepath << "'!\n";
     exit(1);
   }
-
-  // Current Chunks aren't interesting
-  return Test.run(CurrentFilepath);
+  return C;
 }
 
-/// Counts the amount of lines for a given file
-static int getLines(StringRef Filepath) {
-  int Lines = 0;
-  std::string CurrLine;
-  std::ifstream FileStream{std::string(Filepath)};
+/// Runs the interesting-ness test on all \p Candidates, in parallel if
+/// allowed. Modules that were tested before aren't tested again.
+static void testCandidates(TestRunner &Test,
+                           MutableArrayRef<Candidate> Candidates) {
+  auto &Cache = Test.getResultCache();
+  std::vector<Candidate *> ToRun;
+  for (Candidate &C : Candidates) {
+    auto It = Cache.find(C.Hash.words());
+    if (It != Cache.end())
+      C.Interesting = It->second;
+    else
+      ToRun.push_back(&C);
+  }
 
-  while (std::getline(FileStream, CurrLine))
-    ++Lines;
+  if (ToRun.size() <= 1) {
+    for (Candidate *C : ToRun)
+      C->Interesting = Test.run(C->Filepath);
+  } else {
+    ThreadPool Pool(hardware_concurrency(NumJobs));
+    for (Candidate *C : ToRun)
+      Pool.async([&Test, C] { C->Interesting = Test.run(C->Filepath); });
+    Pool.wait();
+  }
 
-  return Lines;
+  for (Candidate *C : ToRun)
+    Cache[C->Hash.words()] = C->Interesting;
 }
 
 /// Splits Chunks in half and prints them.
@@ -98,8 +145,9 @@ void llvm::runDeltaPass(
   }
 
   if (Module *Program = Test.getProgram()) {
-    SmallString<128> CurrentFilepath;
-    if (!IsReduced(*Program, Test, CurrentFilepath)) {
+    Candidate Input = writeCandidate(*Program);
+    testCandidates(Test, Input);
+    if (!Input.Interesting) {
       errs() << "\nInput isn't interesting! Verify interesting-ness test\n";
       exit(1);
     }
@@ -116,37 +164,51 @@ void llvm::runDeltaPass(
 
   do {
     UninterestingChunks = {};
-    for (int I = Chunks.size() - 1; I >= 0; --I) {
-      std::vector<Chunk> CurrentChunks;
-
-      for (auto C : Chunks)
-        if (!UninterestingChunks.count(C) && C != Chunks[I])
-          CurrentChunks.push_back(C);
-
-      if (CurrentChunks.empty())
-        continue;
-
-      // Clone module before hacking it up..
-      std::unique_ptr<Module> Clone = CloneModule(*Test.getProgram());
-      // Generate Module with only Targets inside Current Chunks
-      ExtractChunksFromModule(CurrentChunks, Clone.get());
+    for (int I = Chunks.size() - 1; I >= 0;) {
+      // Prepare up to NumJobs candidates at once, each of them ignoring one
+      // more chunk on top of the ones known to be uninteresting so far, and
+      // test them together. The first interesting one wins, as if they had
+      // been tested one at a time; the ones after it are tested again.
+      std::vector<Candidate> Batch;
+      for (; I >= 0 && Batch.size() < std::max(1u, unsigned(NumJobs)); --I) {
+        std::vector<Chunk> CurrentChunks;
+
+        for (auto C : Chunks)
+          if (!UninterestingChunks.count(C) && C != Chunks[I])
+            CurrentChunks.push_back(C);
+
+        if (CurrentChunks.empty())
+          continue;
+
+        // Clone module before hacking it up..
+        std::unique_ptr<Module> Clone = CloneModule(*Test.getProgram());
+        // Generate Module with only Targets inside Current Chunks
+        ExtractChunksFromModule(CurrentChunks, Clone.get());
+
+        Batch.push_back(writeCandidate(*Clone));
+        Batch.back().ChunkIdx = I;
+        Batch.back().M = std::move(Clone);
+      }
 
-      errs() << "Ignoring: ";
-      Chunks[I].print();
-      for (auto C : UninterestingChunks)
-        C.print();
+      testCandidates(Test, Batch);
 
+      for (Candidate &Cand : Batch) {
+        errs() << "Ignoring: ";
+        Chunks[Cand.ChunkIdx].print();
+        for (auto C : UninterestingChunks)
+          C.print();
 
+        if (!Cand.Interesting) {
+          errs() << "\n";
+          continue;
+        }
 
-      SmallString<128> CurrentFilepath;
-      if (!IsReduced(*Clone, Test, CurrentFilepath)) {
-        errs() << "\n";
-        continue;
+        UninterestingChunks.insert(Chunks[Cand.ChunkIdx]);
+        ReducedProgram = std::move(Cand.M);
+        errs() << " **** SUCCESS | lines: " << Cand.Lines << "\n";
+        I = Cand.ChunkIdx - 1;
+        break;
       }
-
-      UninterestingChunks.insert(Chunks[I]);
-      ReducedProgram = std::move(Clone);
-      errs() << " **** SUCCESS | lines: " << getLines(CurrentFilepath) << "\n";
     }
     // Delete uninteresting chunks
     erase_if(Chunks, [&UninterestingChunks](const Chunk &C) {
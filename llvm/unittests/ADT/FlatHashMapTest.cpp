@@ -0,0 +1,165 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<unsigned, unsigned> M;
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(0u, M.size());
+  EXPECT_TRUE(M.begin() == M.end());
+  EXPECT_EQ(0u, M.count(0));
+  EXPECT_TRUE(M.find(0) == M.end());
+  EXPECT_EQ(0u, M.lookup(0));
+  EXPECT_FALSE(M.erase(0));
+  M.clear();
+  EXPECT_TRUE(M.empty());
+}
+
+// Unlike DenseMap, FlatHashMap has no reserved keys.
+TEST(FlatHashMapTest, ReservedKeys) {
+  FlatHashMap<unsigned, unsigned> M;
+  unsigned Empty = DenseMapInfo<unsigned>::getEmptyKey();
+  unsigned Tombstone = DenseMapInfo<unsigned>::getTombstoneKey();
+  M[Empty] = 1;
+  M[Tombstone] = 2;
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(1u, M.lookup(Empty));
+  EXPECT_EQ(2u, M.lookup(Tombstone));
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<unsigned, unsigned> M;
+  auto R = M.insert({1, 10});
+  EXPECT_TRUE(R.second);
+  EXPECT_EQ(1u, R.first->first);
+  EXPECT_EQ(10u, R.first->second);
+
+  R = M.insert({1, 20});
+  EXPECT_FALSE(R.second);
+  EXPECT_EQ(10u, R.first->second);
+
+  EXPECT_TRUE(M.try_emplace(2, 30).second);
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(30u, M.find(2)->second);
+  EXPECT_EQ(1u, M.count(1));
+
+  EXPECT_TRUE(M.erase(1));
+  EXPECT_FALSE(M.erase(1));
+  EXPECT_EQ(0u, M.count(1));
+  EXPECT_EQ(1u, M.size());
+
+  M.erase(M.find(2));
+  EXPECT_TRUE(M.empty());
+  EXPECT_TRUE(M.begin() == M.end());
+}
+
+// Grow the map well beyond one group and compare it with a DenseMap, with
+// interleaved erasure to exercise deleted buckets.
+TEST(FlatHashMapTest, ManyEntries) {
+  FlatHashMap<unsigned, unsigned> M;
+  DenseMap<unsigned, unsigned> Ref;
+  for (unsigned I = 0; I < 10000; ++I) {
+    unsigned Key = I * 2654435761u;
+    M[Key] = I;
+    Ref[Key] = I;
+    if (I % 3 == 0) {
+      unsigned Old = (I / 2) * 2654435761u;
+      EXPECT_EQ(Ref.erase(Old), M.erase(Old));
+    }
+  }
+  EXPECT_EQ(Ref.size(), M.size());
+  for (auto &KV : Ref)
+    EXPECT_EQ(KV.second, M.lookup(KV.first));
+  unsigned Visited = 0;
+  for (auto &KV : M) {
+    EXPECT_EQ(Ref.lookup(KV.first), KV.second);
+    ++Visited;
+  }
+  EXPECT_EQ(M.size(), Visited);
+}
+
+// Repeated insertion and erasure must reuse deleted buckets instead of
+// growing the table without bound. A table that is more than half full may
+// grow once when it runs out of empty buckets.
+TEST(FlatHashMapTest, Churn) {
+  FlatHashMap<unsigned, unsigned> M;
+  for (unsigned I = 0; I < 100; ++I)
+    M[I] = I;
+  size_t Size = M.getMemorySize();
+  for (unsigned I = 100; I < 100000; ++I) {
+    M.erase(I - 100);
+    M[I] = I;
+  }
+  EXPECT_EQ(100u, M.size());
+  EXPECT_LE(M.getMemorySize(), 2 * Size);
+  for (unsigned I = 99900; I < 100000; ++I)
+    EXPECT_EQ(I, M.lookup(I));
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<int *, int> M;
+  M.reserve(1000);
+  size_t Size = M.getMemorySize();
+  std::unique_ptr<int[]> Ints(new int[1000]);
+  for (int I = 0; I < 1000; ++I)
+    M[&Ints[I]] = I;
+  EXPECT_EQ(Size, M.getMemorySize());
+  for (int I = 0; I < 1000; ++I)
+    EXPECT_EQ(I, M.lookup(&Ints[I]));
+}
+
+TEST(FlatHashMapTest, CopyAndMove) {
+  FlatHashMap<unsigned, std::string> M;
+  for (unsigned I = 0; I < 100; ++I)
+    M[I] = std::to_string(I);
+
+  FlatHashMap<unsigned, std::string> Copy(M);
+  EXPECT_EQ(100u, Copy.size());
+  EXPECT_EQ("42", Copy.lookup(42));
+  Copy[42] = "x";
+  EXPECT_EQ("42", M.lookup(42));
+
+  FlatHashMap<unsigned, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_EQ("x", Moved.lookup(42));
+  EXPECT_TRUE(Copy.empty());
+
+  Copy = Moved;
+  EXPECT_EQ("x", Copy.lookup(42));
+  Moved = std::move(M);
+  EXPECT_EQ("42", Moved.lookup(42));
+
+  Moved.clear();
+  EXPECT_TRUE(Moved.empty());
+  EXPECT_EQ(0u, Moved.count(42));
+  Moved[1] = "1";
+  EXPECT_EQ(1u, Moved.size());
+}
+
+TEST(FlatHashMapTest, ConstIterator) {
+  FlatHashMap<unsigned, unsigned> M = {{1, 2}, {3, 4}};
+  const FlatHashMap<unsigned, unsigned> &CM = M;
+  unsigned Sum = 0;
+  for (auto &KV : CM)
+    Sum += KV.first + KV.second;
+  EXPECT_EQ(10u, Sum);
+  FlatHashMap<unsigned, unsigned>::const_iterator I = M.find(1);
+  EXPECT_EQ(2u, I->second);
+  EXPECT_TRUE(CM.find(5) == CM.end());
+}
+
+} // end anonymous namespace
@@ -9,6 +9,8 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <thread>
+#include <vector>
 using namespace llvm;
 
 using OptionalStatistic = Optional<std::pair<StringRef, unsigned>>;
@@ -168,4 +170,31 @@ TEST(StatisticTest, API) {
 #endif
 }
 
+#if LLVM_ENABLE_THREADS
+// Counts from several threads are merged, also after the threads have exited,
+// and assignment replaces all of them.
+TEST(StatisticTest, Threads) {
+  EnableStatistics();
+
+  AlwaysCounter = 0;
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < 4; ++I)
+    Threads.emplace_back([] {
+      for (unsigned J = 0; J < 1000; ++J)
+        ++AlwaysCounter;
+      AlwaysCounter += 10;
+      AlwaysCounter -= 20;
+      AlwaysCounter--;
+    });
+  for (std::thread &T : Threads)
+    T.join();
+  EXPECT_EQ(AlwaysCounter, 4 * 989u);
+
+  AlwaysCounter = 5;
+  EXPECT_EQ(AlwaysCounter, 5u);
+  ++AlwaysCounter;
+  EXPECT_EQ(AlwaysCounter, 6u);
+}
+#endif
+
 } // end anonymous namespace
@@ -510,6 +510,43 @@ TEST(StringRefTest, Find) {
   EXPECT_EQ(StringRef::npos, Str.find_last_not_of("helo"));
 }
 
+// Compare the searches with a naive search for every haystack length and
+// offset so that matches inside, across and after 16-byte blocks are covered.
+TEST(StringRefTest, FindLong) {
+  std::string Text;
+  for (unsigned I = 0; I < 100; ++I)
+    Text += I % 13 == 12 ? 'd' : "abc"[I % 3];
+  Text += "xyz";
+  StringRef Needles[] = {"ab", "ca",     "bcab",        "dab",
+                         "yz", "cabcd",  "abcabcabcab", "zz"};
+  StringRef CharSets[] = {"d", "zd", "cx", "xyz", "qrst", "abcd", "qrstuvwx"};
+
+  auto NaiveFind = [](StringRef Str, StringRef S, size_t From) -> size_t {
+    for (size_t I = From; I + S.size() <= Str.size(); ++I)
+      if (Str.substr(I, S.size()) == S)
+        return I;
+    return StringRef::npos;
+  };
+  auto NaiveFindFirstOf = [](StringRef Str, StringRef Chars,
+                             size_t From) -> size_t {
+    for (size_t I = From; I < Str.size(); ++I)
+      if (Chars.find(Str[I]) != StringRef::npos)
+        return I;
+    return StringRef::npos;
+  };
+
+  for (size_t Len = 0; Len <= Text.size(); ++Len) {
+    StringRef Str = StringRef(Text).take_front(Len);
+    for (size_t From = 0; From <= Len; ++From) {
+      for (StringRef S : Needles)
+        EXPECT_EQ(NaiveFind(Str, S, From), Str.find(S, From));
+      for (StringRef Chars : CharSets)
+        EXPECT_EQ(NaiveFindFirstOf(Str, Chars, From),
+                  Str.find_first_of(Chars, From));
+    }
+  }
+}
+
 TEST(StringRefTest, Count) {
   StringRef Str("hello");
   EXPECT_EQ(2U, Str.count('l'));
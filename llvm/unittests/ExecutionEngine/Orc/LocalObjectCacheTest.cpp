@@ -0,0 +1,89 @@
+//===- LocalObjectCacheTest.cpp - Unit tests for the on-disk object cache -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class LocalObjectCacheTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(
+        sys::fs::createUniqueDirectory("orc-object-cache", CacheDir));
+  }
+  void TearDown() override { sys::fs::remove_directories(CacheDir); }
+
+  std::unique_ptr<LocalObjectCache> createCache(StringRef ConfigKey) {
+    auto Cache = LocalObjectCache::Create(CacheDir, ConfigKey);
+    EXPECT_THAT_EXPECTED(Cache, Succeeded());
+    return Cache ? std::move(*Cache) : nullptr;
+  }
+
+  static std::unique_ptr<Module> createModule(LLVMContext &Ctx,
+                                              StringRef FnName) {
+    auto M = std::make_unique<Module>("M", Ctx);
+    Function::Create(FunctionType::get(Type::getVoidTy(Ctx), false),
+                     GlobalValue::ExternalLinkage, FnName, *M);
+    return M;
+  }
+
+  SmallString<128> CacheDir;
+};
+
+TEST_F(LocalObjectCacheTest, ObjectsPersistAcrossInstances) {
+  LLVMContext Ctx;
+  auto M = createModule(Ctx, "foo");
+  {
+    auto Cache = createCache("x86_64");
+    ASSERT_TRUE(Cache);
+    EXPECT_EQ(Cache->getObject(M.get()), nullptr);
+    auto Obj = MemoryBuffer::getMemBuffer("object contents");
+    Cache->notifyObjectCompiled(M.get(), Obj->getMemBufferRef());
+  }
+
+  auto Cache = createCache("x86_64");
+  ASSERT_TRUE(Cache);
+  std::unique_ptr<MemoryBuffer> Cached = Cache->getObject(M.get());
+  ASSERT_NE(Cached, nullptr);
+  EXPECT_EQ(Cached->getBuffer(), "object contents");
+}
+
+TEST_F(LocalObjectCacheTest, KeyedByContentAndConfig) {
+  LLVMContext Ctx;
+  auto M = createModule(Ctx, "foo");
+  auto Cache = createCache("x86_64");
+  ASSERT_TRUE(Cache);
+  auto Obj = MemoryBuffer::getMemBuffer("object contents");
+  Cache->notifyObjectCompiled(M.get(), Obj->getMemBufferRef());
+
+  // A module with identical contents hits, even in another context.
+  LLVMContext OtherCtx;
+  auto Same = createModule(OtherCtx, "foo");
+  EXPECT_NE(Cache->getObject(Same.get()), nullptr);
+
+  // Different IR misses.
+  auto Different = createModule(Ctx, "bar");
+  EXPECT_EQ(Cache->getObject(Different.get()), nullptr);
+
+  // So does the same IR compiled for a different configuration.
+  auto OtherConfig = createCache("aarch64");
+  ASSERT_TRUE(OtherConfig);
+  EXPECT_EQ(OtherConfig->getObject(M.get()), nullptr);
+}
+
+} // namespace
@@ -8,7 +8,9 @@
 
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/Threading.h"
 #include "gtest/gtest.h"
+#include <thread>
 using namespace llvm;
 
 namespace {
@@ -34,4 +36,36 @@ TEST(TypesTest, LayoutIdenticalEmptyStructs) {
   EXPECT_TRUE(Foo->isLayoutIdentical(Bar));
 }
 
+#if LLVM_ENABLE_THREADS
+TEST(TypesTest, ThreadSafeTypes) {
+  LLVMContext C;
+  C.setThreadSafeTypes(true);
+
+  // Every thread creates the same types, which must be uniqued to the same
+  // objects.
+  const int NumThreads = 4;
+  std::vector<Type *> Types[NumThreads];
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&C, &Types, T] {
+      for (unsigned I = 1; I <= 200; ++I) {
+        IntegerType *Int = IntegerType::get(C, I + 200);
+        Type *Vec = VectorType::get(Int, I);
+        Type *Arr = ArrayType::get(Vec, I);
+        Type *Ptr = PointerType::get(Arr, I % 3);
+        Type *Struct = StructType::get(C, {Int, Ptr});
+        Type *Fn = FunctionType::get(Struct, {Int, Arr}, false);
+        Types[T].insert(Types[T].end(), {Int, Vec, Arr, Ptr, Struct, Fn});
+        StructType::create(C, {Int}, "named");
+      }
+    });
+  }
+  for (std::thread &T : Threads)
+    T.join();
+
+  for (int T = 1; T < NumThreads; ++T)
+    EXPECT_EQ(Types[0], Types[T]);
+}
+#endif
+
 }  // end anonymous namespace
@@ -0,0 +1,122 @@
+//===- llvm/unittest/Support/BLAKE3Test.cpp - BLAKE3 tests ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements unit tests for the BLAKE3 functions.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/ADT/StringExtras.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+std::string toHex(const std::array<uint8_t, 32> &Hash) {
+  return llvm::toHex(makeArrayRef(Hash), /*LowerCase=*/true);
+}
+
+// The input of the official test vectors: the byte at offset I is I % 251.
+std::vector<uint8_t> getInput(size_t Size) {
+  std::vector<uint8_t> Input(Size);
+  for (size_t I = 0; I != Size; ++I)
+    Input[I] = I % 251;
+  return Input;
+}
+
+TEST(BLAKE3Test, TestVectors) {
+  EXPECT_EQ("af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262",
+            toHex(BLAKE3::hash(getInput(0))));
+  EXPECT_EQ("2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213",
+            toHex(BLAKE3::hash(getInput(1))));
+  EXPECT_EQ("42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7",
+            toHex(BLAKE3::hash(getInput(1024))));
+  EXPECT_EQ("6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85",
+            toHex(BLAKE3::hash(arrayRefFromStringRef("abc"))));
+}
+
+TEST(BLAKE3Test, MultiChunkTestVectors) {
+  // The official test vectors for inputs of more than one 1024-byte chunk,
+  // which exercise the tree of parent nodes, including the lengths on either
+  // side of chunk and subtree boundaries. Both hash() and parallelHash() are
+  // checked.
+  static const struct {
+    size_t Size;
+    const char *Hash;
+  } Vectors[] = {
+      {1025,
+       "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+      {2048,
+       "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"},
+      {2049,
+       "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030"},
+      {3072,
+       "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2"},
+      {3073,
+       "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+      {4096,
+       "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969"},
+      {4097,
+       "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995"},
+      {5120,
+       "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833"},
+      {5121,
+       "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff"},
+      {6144,
+       "3e2e5b74e048f3add6d21faab3f83aa44d3b2278afb83b80b3c35164ebeca205"},
+      {6145,
+       "f1323a8631446cc50536a9f705ee5cb619424d46887f3c376c695b70e0f0507f"},
+      {7168,
+       "61da957ec2499a95d6b8023e2b0e604ec7f6b50e80a9678b89d2628e99ada77a"},
+      {7169,
+       "a003fc7a51754a9b3c7fae0367ab3d782dccf28855a03d435f8cfe74605e7817"},
+      {8192,
+       "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63"},
+      {8193,
+       "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+      {16384,
+       "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4"},
+      {31744,
+       "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+      {102400,
+       "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"},
+  };
+  for (const auto &V : Vectors) {
+    std::vector<uint8_t> Input = getInput(V.Size);
+    EXPECT_EQ(V.Hash, toHex(BLAKE3::hash(Input))) << V.Size;
+    EXPECT_EQ(V.Hash, toHex(BLAKE3::parallelHash(Input))) << V.Size;
+  }
+}
+
+TEST(BLAKE3Test, Incremental) {
+  // Feeding the input in pieces of any size must not change the hash, which
+  // also checks that whole chunks hashed directly from the input match
+  // buffered ones.
+  for (size_t Size : {63, 64, 65, 1023, 1024, 1025, 4096, 4097, 9000}) {
+    std::vector<uint8_t> Input = getInput(Size);
+    std::array<uint8_t, 32> Expected = BLAKE3::hash(Input);
+    for (size_t Step : {1, 7, 64, 1000, 1024, 4100}) {
+      BLAKE3 Hash;
+      for (size_t I = 0; I < Size; I += Step)
+        Hash.update(makeArrayRef(Input).slice(I, std::min(Step, Size - I)));
+      EXPECT_EQ(toHex(Expected), toHex(Hash.final())) << Size << " " << Step;
+    }
+  }
+}
+
+TEST(BLAKE3Test, Parallel) {
+  for (size_t Size : {0, 1, 512 * 1024, 512 * 1024 + 1, 768 * 1024 + 5000,
+                      3 * 1024 * 1024 + 1}) {
+    std::vector<uint8_t> Input = getInput(Size);
+    EXPECT_EQ(toHex(BLAKE3::hash(Input)), toHex(BLAKE3::parallelHash(Input)))
+        << Size;
+  }
+}
+} // end anonymous namespace
@@ -1786,6 +1786,39 @@ TEST(CommandLineTest, Callback) {
   cl::ResetAllOptionOccurrences();
 }
 
+TEST(CommandLineTest, OptionRegisteredWhileParsing) {
+  cl::ResetCommandLineParser();
+
+  // Like a plugin loaded by -load, whose static constructors register options
+  // that later arguments on the same command line use.
+  std::unique_ptr<StackOption<bool>> Late;
+  StackOption<bool> Load(
+      "load", cl::desc("registers -late"), cl::callback([&](const bool &) {
+        Late = std::make_unique<StackOption<bool>>("late");
+      }));
+
+  const char *args1[] = {"prog", "-load", "-late"};
+  std::string Errs;
+  raw_string_ostream OS(Errs);
+  EXPECT_TRUE(cl::ParseCommandLineOptions(3, args1, StringRef(), &OS));
+  OS.flush();
+  EXPECT_TRUE(Errs.empty()) << Errs;
+  ASSERT_TRUE(Late);
+  EXPECT_TRUE(*Late);
+
+  // An option registered after parsing is found by the next parse.
+  cl::ResetAllOptionOccurrences();
+  StackOption<bool> Later("later");
+  const char *args2[] = {"prog", "-later"};
+  EXPECT_TRUE(cl::ParseCommandLineOptions(2, args2, StringRef(), &OS));
+  OS.flush();
+  EXPECT_TRUE(Errs.empty()) << Errs;
+  EXPECT_TRUE(Later);
+
+  Late.reset();
+  cl::ResetAllOptionOccurrences();
+}
+
 enum Enum { Val1, Val2 };
 static cl::bits<Enum> ExampleBits(
     cl::desc("An example cl::bits to ensure it compiles"),
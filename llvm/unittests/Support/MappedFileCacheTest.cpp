@@ -0,0 +1,94 @@
+//===- llvm/unittest/Support/MappedFileCacheTest.cpp ----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/MappedFileCache.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+void writeFile(StringRef Path, StringRef Contents) {
+  std::error_code EC;
+  raw_fd_ostream OS(Path, EC);
+  ASSERT_FALSE(EC);
+  OS << Contents;
+}
+
+ErrorOr<std::unique_ptr<MemoryBuffer>> getFile(MappedFileCache &Cache,
+                                               StringRef Path) {
+  Expected<sys::fs::file_t> FD = sys::fs::openNativeFileForRead(Path);
+  if (!FD)
+    return errorToErrorCode(FD.takeError());
+  auto Buf = Cache.getOpenFile(*FD, Path);
+  sys::fs::closeFile(*FD);
+  return Buf;
+}
+
+TEST(MappedFileCacheTest, Share) {
+  SmallString<64> Path;
+  int FD;
+  ASSERT_FALSE(sys::fs::createTemporaryFile("MappedFileCacheTest", "temp", FD,
+                                            Path));
+  sys::fs::closeFile(FD);
+  FileRemover Cleanup(Path);
+  writeFile(Path, "contents");
+
+  MappedFileCache Cache;
+  {
+    auto A = getFile(Cache, Path);
+    ASSERT_TRUE(bool(A));
+    auto B = getFile(Cache, Path);
+    ASSERT_TRUE(bool(B));
+    EXPECT_EQ("contents", (*A)->getBuffer());
+    EXPECT_EQ((*A)->getBufferStart(), (*B)->getBufferStart());
+    EXPECT_EQ(Path, (*B)->getBufferIdentifier());
+    EXPECT_EQ(1u, Cache.size());
+
+    // Rewriting the file changes its size, so it is read again.
+    writeFile(Path, "new contents");
+    auto C = getFile(Cache, Path);
+    ASSERT_TRUE(bool(C));
+    EXPECT_EQ("new contents", (*C)->getBuffer());
+    EXPECT_EQ(2u, Cache.size());
+  }
+  // The cache does not keep buffers alive.
+  EXPECT_EQ(0u, Cache.size());
+}
+
+TEST(MappedFileCacheTest, PhysicalFileSystem) {
+  SmallString<64> Path;
+  int FD;
+  ASSERT_FALSE(sys::fs::createTemporaryFile("MappedFileCacheTest", "temp", FD,
+                                            Path));
+  sys::fs::closeFile(FD);
+  FileRemover Cleanup(Path);
+  writeFile(Path, "contents");
+
+  MappedFileCache Cache;
+  std::unique_ptr<vfs::FileSystem> FS = vfs::createPhysicalFileSystem(&Cache);
+  auto A = FS->getBufferForFile(Path);
+  ASSERT_TRUE(bool(A));
+  auto B = FS->getBufferForFile(Path, -1, /*RequiresNullTerminator=*/false);
+  ASSERT_TRUE(bool(B));
+  EXPECT_EQ("contents", (*B)->getBuffer());
+  EXPECT_EQ((*A)->getBufferStart(), (*B)->getBufferStart());
+
+  // Volatile files are not shared.
+  auto C = FS->getBufferForFile(Path, -1, true, /*IsVolatile=*/true);
+  ASSERT_TRUE(bool(C));
+  EXPECT_NE((*A)->getBufferStart(), (*C)->getBufferStart());
+  EXPECT_EQ(1u, Cache.size());
+}
+
+} // end anonymous namespace
@@ -160,6 +160,32 @@ TEST(NativeFormatTest, IntegerTests) {
   EXPECT_EQ("1234567890", format_number(1234567890, IntegerStyle::Integer));
 }
 
+TEST(NativeFormatTest, DigitsTests) {
+  // Cover every digit count and both the 32-bit and the 64-bit paths.
+  EXPECT_EQ("0", format_number(0ULL, IntegerStyle::Integer));
+  uint64_t N = 0;
+  std::string Expected;
+  for (int I = 1; I < 20; ++I) {
+    N = N * 10 + I % 10;
+    Expected += char('0' + I % 10);
+    EXPECT_EQ(Expected, format_number(N, IntegerStyle::Integer));
+  }
+}
+
+TEST(NativeFormatTest, MinDigitsTests) {
+  auto Format = [](long long N, size_t MinDigits) {
+    std::string S;
+    llvm::raw_string_ostream Str(S);
+    write_integer(Str, N, MinDigits, IntegerStyle::Integer);
+    return Str.str();
+  };
+  EXPECT_EQ("00042", Format(42, 5));
+  EXPECT_EQ("-00042", Format(-42, 5));
+  EXPECT_EQ("12345", Format(12345, 3));
+  EXPECT_EQ("-" + std::string(197, '0') + "123", Format(-123, 200));
+  EXPECT_EQ(std::string(197, '0') + "123", Format(123, 200));
+}
+
 TEST(NativeFormatTest, CommaTests) {
   EXPECT_EQ("0", format_number(0, IntegerStyle::Number));
   EXPECT_EQ("10", format_number(10, IntegerStyle::Number));
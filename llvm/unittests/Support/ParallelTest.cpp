@@ -14,6 +14,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -49,4 +50,41 @@ TEST(Parallel, parallel_for) {
   ASSERT_EQ(range[2049], 1u);
 }
 
+TEST(Parallel, parallel_for_grain_size) {
+  std::vector<std::atomic<uint32_t>> range(10000);
+  for_each_n(
+      parallel::par, 0, 9999, [&range](size_t I) { ++range[I]; }, 1000);
+  for (size_t I = 0; I < 9999; ++I)
+    ASSERT_EQ(range[I], 1u);
+  ASSERT_EQ(range[9999], 0u);
+}
+
+TEST(Parallel, nested_parallel_for) {
+  // Nested loops run on the same executor. Workers waiting for an inner loop
+  // run pending tasks, so this must neither deadlock nor lose iterations.
+  std::atomic<uint32_t> count{0};
+  for_each_n(parallel::par, 0, 64, [&count](size_t) {
+    for_each_n(parallel::par, 0, 64, [&count](size_t) {
+      for_each_n(parallel::par, 0, 64, [&count](size_t) { ++count; });
+    });
+  });
+  ASSERT_EQ(count, 64u * 64u * 64u);
+}
+
+TEST(Parallel, nested_sort) {
+  std::vector<std::vector<uint32_t>> vecs(64);
+  std::mt19937 randEngine;
+  std::uniform_int_distribution<uint32_t> dist;
+  for (std::vector<uint32_t> &v : vecs)
+    for (size_t I = 0; I < 4096; ++I)
+      v.push_back(dist(randEngine));
+
+  for_each(parallel::par, vecs.begin(), vecs.end(),
+           [](std::vector<uint32_t> &v) {
+             sort(parallel::par, v.begin(), v.end());
+           });
+  for (std::vector<uint32_t> &v : vecs)
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+}
+
 #endif
@@ -0,0 +1,90 @@
+//===- llvm/unittest/Support/ThreadLocalBumpPtrAllocatorTest.cpp ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadLocalBumpPtrAllocator.h"
+#include "llvm/Config/llvm-config.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ThreadLocalBumpPtrAllocatorTest, Basics) {
+  ThreadLocalBumpPtrAllocator Alloc;
+  int *a = Alloc.Allocate<int>();
+  int *b = Alloc.Allocate<int>(10);
+  *a = 1;
+  b[0] = 2;
+  b[9] = 2;
+  EXPECT_EQ(1, *a);
+  EXPECT_EQ(2, b[0]);
+  EXPECT_EQ(2, b[9]);
+  EXPECT_EQ(1U, Alloc.getNumThreadAllocators());
+  EXPECT_EQ(&Alloc.getThreadAllocator(), &Alloc.getThreadAllocator());
+  EXPECT_EQ(11 * sizeof(int), Alloc.getBytesAllocated());
+}
+
+// Allocators used alternately by the same thread must not share an arena.
+TEST(ThreadLocalBumpPtrAllocatorTest, SeveralAllocators) {
+  ThreadLocalBumpPtrAllocator Alloc1, Alloc2;
+  Alloc1.Allocate<char>(10);
+  Alloc2.Allocate<char>(20);
+  Alloc1.Allocate<char>(30);
+  EXPECT_NE(&Alloc1.getThreadAllocator(), &Alloc2.getThreadAllocator());
+  EXPECT_EQ(40U, Alloc1.getBytesAllocated());
+  EXPECT_EQ(20U, Alloc2.getBytesAllocated());
+}
+
+TEST(ThreadLocalBumpPtrAllocatorTest, Reset) {
+  ThreadLocalBumpPtrAllocator Alloc;
+  BumpPtrAllocator *Arena = &Alloc.getThreadAllocator();
+  Alloc.Allocate(100, 8);
+  Alloc.Reset();
+  EXPECT_EQ(0U, Alloc.getBytesAllocated());
+  EXPECT_EQ(Arena, &Alloc.getThreadAllocator());
+  Alloc.Allocate(100, 8);
+  EXPECT_EQ(100U, Alloc.getBytesAllocated());
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(ThreadLocalBumpPtrAllocatorTest, Threads) {
+  const unsigned NumThreads = 4;
+  const unsigned NumAllocs = 1000;
+  ThreadLocalBumpPtrAllocator Alloc;
+  std::vector<std::vector<unsigned *>> Ptrs(NumThreads);
+  std::vector<BumpPtrAllocator *> Arenas(NumThreads);
+
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < NumThreads; ++I)
+    Threads.emplace_back([&, I] {
+      Arenas[I] = &Alloc.getThreadAllocator();
+      for (unsigned J = 0; J < NumAllocs; ++J) {
+        unsigned *P = Alloc.Allocate<unsigned>();
+        *P = I;
+        Ptrs[I].push_back(P);
+      }
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  EXPECT_EQ(NumThreads, Alloc.getNumThreadAllocators());
+  EXPECT_EQ(NumThreads * NumAllocs * sizeof(unsigned),
+            Alloc.getBytesAllocated());
+  for (unsigned I = 0; I < NumThreads; ++I) {
+    for (unsigned J = I + 1; J < NumThreads; ++J)
+      EXPECT_NE(Arenas[I], Arenas[J]);
+    for (unsigned *P : Ptrs[I])
+      EXPECT_EQ(I, *P);
+  }
+}
+#endif
+
+} // anonymous namespace
@@ -167,6 +167,89 @@ TEST_F(ThreadPoolTest, PoolDestruction) {
   ASSERT_EQ(5, checked_in);
 }
 
+TEST_F(ThreadPoolTest, Priorities) {
+  CHECK_UNSUPPORTED();
+  ThreadPool Pool(hardware_concurrency(1));
+  std::mutex Lock;
+  std::vector<int> Order;
+  auto Record = [&](int I) {
+    return [&, I] {
+      std::lock_guard<std::mutex> Guard(Lock);
+      Order.push_back(I);
+    };
+  };
+  // Keep the only thread busy until all tasks have been queued.
+  Pool.async([this] { waitForMainThread(); });
+  Pool.schedule(Record(0), {}, ThreadPool::Priority::Low);
+  Pool.schedule(Record(1), {}, ThreadPool::Priority::Normal);
+  Pool.schedule(Record(2), {}, ThreadPool::Priority::High);
+  Pool.schedule(Record(3), {}, ThreadPool::Priority::Normal);
+  Pool.schedule(Record(4), {}, ThreadPool::Priority::High);
+  setMainThreadReady();
+  Pool.wait();
+  ASSERT_EQ(std::vector<int>({2, 4, 1, 3, 0}), Order);
+}
+
+TEST_F(ThreadPoolTest, Dependencies) {
+  CHECK_UNSUPPORTED();
+  ThreadPool Pool;
+  std::atomic_int A{0}, B{0}, C{0};
+  std::atomic_bool Ok{true};
+
+  ThreadPool::TaskRef First = Pool.schedule([this, &A] {
+    waitForMainThread();
+    A = 1;
+  });
+  ThreadPool::TaskRef Left = Pool.then(First, [&] {
+    if (A != 1)
+      Ok = false;
+    B = 1;
+  });
+  ThreadPool::TaskRef Right = Pool.then(First, [&] {
+    if (A != 1)
+      Ok = false;
+    C = 1;
+  });
+  ThreadPool::TaskRef Last = Pool.schedule(
+      [&] {
+        if (B != 1 || C != 1)
+          Ok = false;
+      },
+      {Left, Right});
+
+  ASSERT_EQ(0, B.load());
+  ASSERT_EQ(0, C.load());
+  setMainThreadReady();
+  Last.wait();
+  ASSERT_TRUE(Ok);
+  ASSERT_EQ(1, B.load());
+  ASSERT_EQ(1, C.load());
+}
+
+TEST_F(ThreadPoolTest, DependencyOnFinishedTask) {
+  CHECK_UNSUPPORTED();
+  ThreadPool Pool;
+  std::atomic_int I{0};
+  ThreadPool::TaskRef First = Pool.schedule([&] { ++I; });
+  First.wait();
+  Pool.then(First, [&] { ++I; });
+  Pool.wait();
+  ASSERT_EQ(2, I.load());
+}
+
+TEST_F(ThreadPoolTest, WaitForBlockedTasks) {
+  CHECK_UNSUPPORTED();
+  std::atomic_int I{0};
+  {
+    ThreadPool Pool;
+    ThreadPool::TaskRef Prev = Pool.schedule([this] { waitForMainThread(); });
+    for (int J = 0; J < 10; ++J)
+      Prev = Pool.then(Prev, [&] { ++I; });
+    setMainThreadReady();
+  }
+  ASSERT_EQ(10, I.load());
+}
+
 #if LLVM_ENABLE_THREADS == 1
 
 void ThreadPoolTest::TestAllThreads(ThreadPoolStrategy S) {
@@ -0,0 +1,97 @@
+//===- unittests/TimeProfilerTest.cpp - Time profiler tests ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/JSON.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+json::Value writeTrace() {
+  SmallString<1024> Buf;
+  raw_svector_ostream OS(Buf);
+  timeTraceProfilerWrite(OS);
+  timeTraceProfilerCleanup();
+  Expected<json::Value> V = json::parse(Buf);
+  EXPECT_TRUE(bool(V));
+  return V ? std::move(*V) : json::Value(nullptr);
+}
+
+TEST(TimeProfiler, Counter) {
+  timeTraceProfilerInitialize(0, "test");
+  { TimeTraceScope Scope("scope"); }
+  timeTraceProfilerCounter("bytes", 7);
+  timeTraceProfilerCounter("bytes", 42);
+
+  json::Value V = writeTrace();
+  const json::Array *Events = V.getAsObject()->getArray("traceEvents");
+  ASSERT_TRUE(Events);
+
+  std::vector<int64_t> Values;
+  for (const json::Value &E : *Events) {
+    const json::Object *O = E.getAsObject();
+    if (O->getString("ph") != StringRef("C"))
+      continue;
+    EXPECT_EQ(StringRef("bytes"), *O->getString("name"));
+    Values.push_back(*O->getObject("args")->getInteger("value"));
+  }
+  EXPECT_EQ(std::vector<int64_t>({7, 42}), Values);
+}
+
+TEST(TimeProfiler, MaxEntries) {
+  timeTraceProfilerInitialize(0, "test", 3);
+  for (int I = 0; I < 5; ++I)
+    TimeTraceScope Scope("scope", [=] { return std::to_string(I); });
+
+  json::Value V = writeTrace();
+  const json::Array *Events = V.getAsObject()->getArray("traceEvents");
+  ASSERT_TRUE(Events);
+
+  // Only the newest entries are kept, but the total covers all of them.
+  std::vector<std::string> Details;
+  int64_t TotalCount = 0;
+  for (const json::Value &E : *Events) {
+    const json::Object *O = E.getAsObject();
+    if (O->getString("name") == StringRef("scope"))
+      Details.push_back(
+          std::string(*O->getObject("args")->getString("detail")));
+    else if (O->getString("name") == StringRef("Total scope"))
+      TotalCount = *O->getObject("args")->getInteger("count");
+  }
+  EXPECT_EQ(std::vector<std::string>({"2", "3", "4"}), Details);
+  EXPECT_EQ(5, TotalCount);
+
+  const json::Object *Data = V.getAsObject()->getObject("otherData");
+  ASSERT_TRUE(Data);
+  EXPECT_EQ(2, *Data->getInteger("droppedEvents"));
+}
+
+TEST(TimeProfiler, Metadata) {
+  timeTraceProfilerInitialize(0, "test");
+  timeTraceProfilerAddMetadata("a", "1");
+  timeTraceProfilerAddMetadata("b", "2");
+  timeTraceProfilerAddMetadata("a", "3");
+
+  json::Value V = writeTrace();
+  const json::Object *Data = V.getAsObject()->getObject("otherData");
+  ASSERT_TRUE(Data);
+  EXPECT_EQ(2u, Data->size());
+  EXPECT_EQ(StringRef("3"), *Data->getString("a"));
+  EXPECT_EQ(StringRef("2"), *Data->getString("b"));
+}
+
+TEST(TimeProfiler, NoMetadata) {
+  timeTraceProfilerInitialize(0, "test");
+  json::Value V = writeTrace();
+  EXPECT_EQ(nullptr, V.getAsObject()->get("otherData"));
+}
+
+} // namespace
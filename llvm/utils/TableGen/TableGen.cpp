@@ -12,6 +12,7 @@
 
 #include "TableGenBackends.h" // Declares all backends.
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Signals.h"
@@ -69,7 +70,9 @@ cl::opt<bool> EmitLongStrLiterals(
 } // end namespace llvm
 
 namespace {
-cl::opt<ActionType> Action(
+// More than one action may be given; they all share a single parse of the
+// input, and the outputs after the first go to the -extra-output files.
+cl::list<ActionType> Action(
     cl::desc("Action to perform:"),
     cl::values(
         clEnumValN(PrintRecords, "print-records",
@@ -140,8 +143,9 @@ cl::opt<bool, true>
                    cl::desc("Time regions of tablegens execution"),
                    cl::location(TimeRegions));
 
-bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
-  switch (Action) {
+bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records,
+                      unsigned ActionIdx) {
+  switch (Action.empty() ? PrintRecords : Action[ActionIdx]) {
   case PrintRecords:
     OS << Records;           // No argument, dump all contents
     break;
@@ -259,6 +263,50 @@ bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
 }
 }
 
+/// Returns true if the backend for \p A does not modify the records, so that
+/// other actions may run after it on the same parse. Backends are listed
+/// explicitly so that a new one has to be classified here.
+static bool onlyReadsRecords(ActionType A) {
+  switch (A) {
+  case PrintRecords:
+  case DumpJSON:
+  case GenRegisterInfo:
+  case GenInstrInfo:
+  case GenInstrDocs:
+  case GenCallingConv:
+  case GenAsmWriter:
+  case GenAsmMatcher:
+  case GenPseudoLowering:
+  case GenCompressInst:
+  case GenDAGISel:
+  case GenDFAPacketizer:
+  case GenFastISel:
+  case GenSubtarget:
+  case GenIntrinsicEnums:
+  case GenIntrinsicImpl:
+  case GenOptParserDefs:
+  case GenOptRST:
+  case PrintEnums:
+  case PrintSets:
+  case GenCTags:
+  case GenAttributes:
+  case GenSearchableTables:
+  case GenGlobalISel:
+  case GenGICombiner:
+  case GenRegisterBank:
+  case GenX86EVEX2VEXTables:
+  case GenX86FoldTables:
+  case GenExegesis:
+  case GenAutomata:
+    return true;
+  // Both reverse the bits of little-endian instruction encodings in place.
+  case GenEmitter:
+  case GenDisassembler:
+    return false;
+  }
+  llvm_unreachable("unknown action");
+}
+
 int main(int argc, char **argv) {
   sys::PrintStackTraceOnErrorSignal(argv[0]);
   PrettyStackTraceProgram X(argc, argv);
@@ -266,7 +314,18 @@ int main(int argc, char **argv) {
 
   llvm_shutdown_obj Y;
 
-  return TableGenMain(argv[0], &LLVMTableGenMain);
+  // Every action but the last must leave the shared records as it found them.
+  for (unsigned I = 0, E = Action.size(); I + 1 < E; ++I) {
+    if (!onlyReadsRecords(Action[I])) {
+      errs() << argv[0] << ": -"
+             << (Action[I] == GenEmitter ? "gen-emitter" : "gen-disassembler")
+             << " modifies the records and must be the last action\n";
+      return 1;
+    }
+  }
+
+  return TableGenMain(argv[0], &LLVMTableGenMain,
+                      std::max<unsigned>(Action.size(), 1));
 }
 
 #ifndef __has_feature
@@ -151,6 +151,13 @@ Optional<TiledLinalgOp> tileLinalgOpToParallelLoops(
     OpBuilder &b, LinalgOp op, ArrayRef<int64_t> tileSizes,
     ArrayRef<unsigned> permutation = {}, OperationFolder *folder = nullptr);
 
+/// Returns tile sizes for the loops of `op` such that the tiles of all its
+/// operands fit in a cache of `cacheSizeInBytes` bytes. Every loop gets the
+/// same tile size, which is the largest power of two for which the estimated
+/// footprint fits, and at least 1.
+SmallVector<int64_t, 8> computeTileSizesForCache(LinalgOp op,
+                                                 uint64_t cacheSizeInBytes);
+
 template <typename... Args>
 Optional<TiledLinalgOp> tileLinalgOperation(OpBuilder &b, Operation *op,
                                             Args... args) {
@@ -63,6 +63,17 @@ void populateVectorContractLoweringPatterns(
     OwningRewritePatternList &patterns, MLIRContext *context,
     VectorTransformsOptions vectorTransformOptions = VectorTransformsOptions());
 
+/// Collect a set of patterns that unroll the ops named in `opNames` to vectors
+/// that fit in a native vector register of `nativeVectorBitWidth` bits, e.g.
+/// 128 for NEON or 256 for AVX2. Supports elementwise ops, e.g. "std.addf",
+/// and "vector.contract", which is unrolled into native size outer products.
+/// The unrolled ops are joined with vector slices ops, which
+/// populateVectorToVectorTransformationPatterns folds with the unrolled
+/// transfer ops.
+void populateVectorUnrollToNativeSizePatterns(
+    OwningRewritePatternList &patterns, MLIRContext *context,
+    ArrayRef<StringRef> opNames, unsigned nativeVectorBitWidth);
+
 /// Returns the integer type required for subscripts in the vector dialect.
 IntegerType getVectorSubscriptType(Builder &builder);
 
@@ -432,8 +432,8 @@ private:
   void operator=(const RewritePatternMatcher &) = delete;
 
   /// The group of patterns that are matched for optimization through this
-  /// matcher.
-  std::vector<RewritePattern *> patterns;
+  /// matcher, grouped by root operation and sorted by benefit.
+  DenseMap<OperationName, SmallVector<RewritePattern *, 2>> patterns;
 };
 
 /// Rewrite the regions of the specified operation, which must be isolated from
@@ -444,11 +444,20 @@ private:
 /// Note: These methods also perform folding and simple dead-code elimination
 ///       before attempting to match any of the provided patterns.
 ///
+/// Each iteration visits every nested operation. If `onlyRevisitChangedOps` is
+/// set, only the first iteration does; later iterations visit just the
+/// operations the rewriter was notified about: those created, replaced or
+/// updated in place, and their users and operand producers. This is faster,
+/// but patterns that depend on IR other than the operations they rewrite, or
+/// that modify IR without notifying the rewriter, may then stop before
+/// reaching the fixpoint.
 bool applyPatternsGreedily(Operation *op,
-                           const OwningRewritePatternList &patterns);
+                           const OwningRewritePatternList &patterns,
+                           bool onlyRevisitChangedOps = false);
 /// Rewrite the given regions, which must be isolated from above.
 bool applyPatternsGreedily(MutableArrayRef<Region> regions,
-                           const OwningRewritePatternList &patterns);
+                           const OwningRewritePatternList &patterns,
+                           bool onlyRevisitChangedOps = false);
 } // end namespace mlir
 
 #endif // MLIR_PATTERN_MATCH_H
@@ -236,6 +236,12 @@ public:
   /// unintentionally included in the timing results.
   void enableTiming(PassDisplayMode displayMode = PassDisplayMode::Pipeline);
 
+  /// Add an instrumentation that records each execution of a pass, along with
+  /// the operation it ran on and the number of operations nested within it
+  /// before and after. The executions are written to `outputFile` in the
+  /// Chrome trace event format, which can be viewed in chrome://tracing.
+  void enableTimingTrace(StringRef outputFile);
+
   /// Prompts the pass manager to print the statistics collected for each of the
   /// held passes after each call to 'run'.
   void
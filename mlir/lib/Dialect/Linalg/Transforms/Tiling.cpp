@@ -21,12 +21,16 @@
 #include "mlir/IR/AffineExpr.h"
 #include "mlir/IR/AffineExprVisitor.h"
 #include "mlir/IR/AffineMap.h"
+#include "mlir/IR/TypeUtilities.h"
 #include "mlir/Support/Functional.h"
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/STLExtras.h"
 #include "mlir/Transforms/FoldUtils.h"
 
+#include "llvm/ADT/SmallBitVector.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MathExtras.h"
+#include <cmath>
 
 using namespace mlir;
 using namespace mlir::edsc;
@@ -486,15 +490,56 @@ Optional<TiledLinalgOp> mlir::linalg::tileLinalgOpToParallelLoops(
                                             folder);
 }
 
+SmallVector<int64_t, 8>
+mlir::linalg::computeTileSizesForCache(LinalgOp op, uint64_t cacheSizeInBytes) {
+  // For each operand, count the loops its indexing map depends on, since a
+  // tile of size T along each loop touches about T^numDims of its elements.
+  SmallVector<std::pair<unsigned, unsigned>, 4> dimsAndElementBytes;
+  for (unsigned i = 0, e = op.getNumInputsAndOutputs(); i < e; ++i) {
+    llvm::SmallBitVector dims(op.getNumLoops());
+    AffineMap map = op.getIndexingMap(i);
+    for (AffineExpr expr : map.getResults())
+      expr.walk([&](AffineExpr subExpr) {
+        if (auto dimExpr = subExpr.dyn_cast<AffineDimExpr>())
+          dims.set(dimExpr.getPosition());
+      });
+
+    // Assume 8 bytes for element types without a bit width, e.g. index.
+    Type elementType = getElementTypeOrSelf(op.getOperation()->getOperand(i));
+    unsigned elementBytes = elementType.isIntOrFloat()
+                                ? llvm::divideCeil(
+                                      elementType.getIntOrFloatBitWidth(), 8)
+                                : 8;
+    dimsAndElementBytes.emplace_back(dims.count(), std::max(elementBytes, 1u));
+  }
+
+  // Use floating point for the footprint, as T^numDims can overflow.
+  auto fits = [&](int64_t tileSize) {
+    double footprint = 0;
+    for (auto it : dimsAndElementBytes)
+      footprint += std::pow(double(tileSize), it.first) * it.second;
+    return footprint <= double(cacheSizeInBytes);
+  };
+  int64_t tileSize = 1;
+  while (tileSize < (int64_t(1) << 30) && fits(tileSize * 2))
+    tileSize *= 2;
+  return SmallVector<int64_t, 8>(op.getNumLoops(), tileSize);
+}
+
 template <typename LoopTy>
-static void tileLinalgOps(FuncOp f, ArrayRef<int64_t> tileSizes) {
+static void tileLinalgOps(FuncOp f, ArrayRef<int64_t> tileSizes,
+                          uint64_t cacheSizeInBytes) {
   OpBuilder b(f);
   OperationFolder folder(f.getContext());
-  f.walk([tileSizes, &b, &folder](LinalgOp op) {
+  f.walk([tileSizes, cacheSizeInBytes, &b, &folder](LinalgOp op) {
     if (!op.hasBufferSemantics())
       return;
-    auto opLoopsPair =
-        tileLinalgOpImpl<LoopTy>(b, op, tileSizes, /*permutation=*/{}, &folder);
+    SmallVector<int64_t, 8> cacheTileSizes;
+    if (tileSizes.empty() && cacheSizeInBytes != 0)
+      cacheTileSizes = computeTileSizesForCache(op, cacheSizeInBytes);
+    auto opLoopsPair = tileLinalgOpImpl<LoopTy>(
+        b, op, cacheTileSizes.empty() ? tileSizes : cacheTileSizes,
+        /*permutation=*/{}, &folder);
     // If tiling occurred successfully, erase old op.
     if (opLoopsPair)
       op.erase();
@@ -511,7 +556,7 @@ struct LinalgTilingPass : public LinalgTilingBase<LinalgTilingPass> {
   LinalgTilingPass(ArrayRef<int64_t> sizes) { tileSizes = sizes; }
 
   void runOnFunction() override {
-    tileLinalgOps<loop::ForOp>(getFunction(), tileSizes);
+    tileLinalgOps<loop::ForOp>(getFunction(), tileSizes, cacheSizeInBytes);
   }
 };
 
@@ -523,7 +568,8 @@ struct LinalgTilingToParallelLoopsPass
   }
 
   void runOnFunction() override {
-    tileLinalgOps<loop::ParallelOp>(getFunction(), tileSizes);
+    tileLinalgOps<loop::ParallelOp>(getFunction(), tileSizes,
+                                    cacheSizeInBytes);
   }
 };
 
@@ -34,6 +34,7 @@
 
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 #define DEBUG_TYPE "vector-to-vector"
@@ -1519,6 +1520,89 @@ public:
 
 } // namespace
 
+/// Returns the number of elements of `elementType` that fit in a vector
+/// register of `nativeVectorBitWidth` bits, or 0 if it has no bit width.
+static int64_t getNumNativeLanes(Type elementType,
+                                 unsigned nativeVectorBitWidth) {
+  if (!elementType.isIntOrFloat())
+    return 0;
+  unsigned bitWidth = elementType.getIntOrFloatBitWidth();
+  return bitWidth == 0 ? 0 : std::max(nativeVectorBitWidth / bitWidth, 1u);
+}
+
+namespace {
+
+/// Unrolls a single result vector op to vectors that fit in a native vector
+/// register. The innermost dimension is unrolled to the largest number of
+/// lanes that fits and divides it, and all outer dimensions to 1. An
+/// elementwise op is unrolled along its result shape, and a ContractionOp
+/// along its iteration space, keeping only the iterator that indexes the
+/// innermost result dimension, so that each unrolled contraction is a native
+/// size outer product.
+class UnrollVectorToNativeSizePattern : public RewritePattern {
+public:
+  UnrollVectorToNativeSizePattern(StringRef opName, MLIRContext *context,
+                                  unsigned nativeVectorBitWidth)
+      : RewritePattern(opName, /*benefit=*/1, context),
+        nativeVectorBitWidth(nativeVectorBitWidth) {}
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    if (op->getNumResults() != 1)
+      return failure();
+    auto resultType = op->getResult(0).getType().dyn_cast<VectorType>();
+    if (!resultType || resultType.getRank() == 0)
+      return failure();
+    int64_t numLanes =
+        getNumNativeLanes(resultType.getElementType(), nativeVectorBitWidth);
+    if (numLanes == 0)
+      return failure();
+    int64_t innerSize = resultType.getShape().back();
+    int64_t innerTargetSize = llvm::GreatestCommonDivisor64(innerSize, numLanes);
+
+    SmallVector<int64_t, 4> targetShape;
+    if (auto contractionOp = dyn_cast<vector::ContractionOp>(op)) {
+      contractionOp.getIterationBounds(targetShape);
+      AffineMap resultMap = contractionOp.getIndexingMaps().back();
+      unsigned innerIterator =
+          resultMap.getResults().back().cast<AffineDimExpr>().getPosition();
+      for (unsigned i = 0, e = targetShape.size(); i < e; ++i)
+        targetShape[i] = i == innerIterator ? innerTargetSize : 1;
+      SmallVector<int64_t, 4> iterationBounds;
+      contractionOp.getIterationBounds(iterationBounds);
+      if (targetShape == iterationBounds)
+        return failure();
+    } else {
+      // Only unroll elementwise ops, i.e. ops whose operands all have the
+      // result type.
+      if (llvm::any_of(op->getOperandTypes(),
+                       [&](Type type) { return type != resultType; }))
+        return failure();
+      targetShape.assign(resultType.getRank() - 1, 1);
+      targetShape.push_back(innerTargetSize);
+      if (resultType.getShape() == llvm::makeArrayRef(targetShape))
+        return failure();
+    }
+
+    rewriter.replaceOp(
+        op, vector::unrollSingleResultOpMatchingType(rewriter, op, targetShape));
+    return success();
+  }
+
+private:
+  unsigned nativeVectorBitWidth;
+};
+
+} // namespace
+
+void mlir::vector::populateVectorUnrollToNativeSizePatterns(
+    OwningRewritePatternList &patterns, MLIRContext *context,
+    ArrayRef<StringRef> opNames, unsigned nativeVectorBitWidth) {
+  for (StringRef opName : opNames)
+    patterns.insert<UnrollVectorToNativeSizePattern>(opName, context,
+                                                     nativeVectorBitWidth);
+}
+
 // TODO(andydavis) Add pattern to rewrite ExtractSlices(ConstantMaskOp).
 // TODO(andydavis) Add this as DRR pattern.
 void mlir::vector::populateVectorToVectorTransformationPatterns(
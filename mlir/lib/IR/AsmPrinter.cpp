@@ -1453,8 +1453,14 @@ void ModulePrinter::printDenseElementsAttr(DenseElementsAttr attr,
   if (allowHex && printElementsAttrWithHexIfLarger != -1 &&
       numElements > printElementsAttrWithHexIfLarger) {
     ArrayRef<char> rawData = attr.getRawData();
-    os << '"' << "0x" << llvm::toHex(StringRef(rawData.data(), rawData.size()))
-       << "\"";
+    os << '"' << "0x";
+    // Convert the data in chunks, rather than building a copy of the whole
+    // string, as these attributes can be very large.
+    const size_t chunkSize = 4096;
+    for (size_t i = 0, e = rawData.size(); i < e; i += chunkSize)
+      os << llvm::toHex(StringRef(rawData.data() + i,
+                                  std::min(chunkSize, e - i)));
+    os << '"';
     return;
   }
 
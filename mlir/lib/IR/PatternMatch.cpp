@@ -10,9 +10,15 @@
 #include "mlir/IR/BlockAndValueMapping.h"
 #include "mlir/IR/Operation.h"
 #include "mlir/IR/Value.h"
+#include "llvm/ADT/Statistic.h"
 
 using namespace mlir;
 
+#define DEBUG_TYPE "pattern-matcher"
+
+STATISTIC(NumMatchAttempts, "Number of patterns tried against an operation");
+STATISTIC(NumMatchSuccesses, "Number of patterns successfully applied");
+
 PatternBenefit::PatternBenefit(unsigned benefit) : representation(benefit) {
   assert(representation == benefit && benefit != ImpossibleToMatchSentinel &&
          "This pattern match benefit is too large to represent");
@@ -173,29 +179,36 @@ void PatternRewriter::cloneRegionBefore(Region &region, Block *before) {
 
 RewritePatternMatcher::RewritePatternMatcher(
     const OwningRewritePatternList &patterns) {
+  // Group the patterns by root operation, so that matching only considers the
+  // patterns for the operation at hand. Patterns that are impossible to match
+  // are dropped here.
   for (auto &pattern : patterns)
-    this->patterns.push_back(pattern.get());
+    if (!pattern->getBenefit().isImpossibleToMatch())
+      this->patterns[pattern->getRootKind()].push_back(pattern.get());
 
   // Sort the patterns by benefit to simplify the matching logic.
-  std::stable_sort(this->patterns.begin(), this->patterns.end(),
-                   [](RewritePattern *l, RewritePattern *r) {
-                     return r->getBenefit() < l->getBenefit();
-                   });
+  for (auto &it : this->patterns)
+    std::stable_sort(it.second.begin(), it.second.end(),
+                     [](RewritePattern *l, RewritePattern *r) {
+                       return r->getBenefit() < l->getBenefit();
+                     });
 }
 
 /// Try to match the given operation to a pattern and rewrite it.
 bool RewritePatternMatcher::matchAndRewrite(Operation *op,
                                             PatternRewriter &rewriter) {
-  for (auto *pattern : patterns) {
-    // Ignore patterns that are for the wrong root or are impossible to match.
-    if (pattern->getRootKind() != op->getName() ||
-        pattern->getBenefit().isImpossibleToMatch())
-      continue;
+  auto it = patterns.find(op->getName());
+  if (it == patterns.end())
+    return false;
 
+  for (auto *pattern : it->second) {
     // Try to match and rewrite this pattern. The patterns are sorted by
     // benefit, so if we match we can immediately rewrite and return.
-    if (succeeded(pattern->matchAndRewrite(op, rewriter)))
+    ++NumMatchAttempts;
+    if (succeeded(pattern->matchAndRewrite(op, rewriter))) {
+      ++NumMatchSuccesses;
       return true;
+    }
   }
   return false;
 }
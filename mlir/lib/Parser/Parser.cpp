@@ -1848,12 +1848,19 @@ Attribute Parser::parseDecOrHexAttr(Type type, bool isNegative) {
 /// stored into 'result'.
 static ParseResult parseElementAttrHexValues(Parser &parser, Token tok,
                                              std::string &result) {
-  std::string val = tok.getStringValue();
-  if (val.size() < 2 || val[0] != '0' || val[1] != 'x')
+  // Hex strings can be very large, so avoid copying them when they contain no
+  // escapes.
+  std::string escapedVal;
+  StringRef val = tok.getSpelling().drop_front().drop_back();
+  if (val.contains('\\')) {
+    escapedVal = tok.getStringValue();
+    val = escapedVal;
+  }
+  if (!val.startswith("0x"))
     return parser.emitError(tok.getLoc(),
                             "elements hex string should start with '0x'");
 
-  StringRef hexValues = StringRef(val).drop_front(2);
+  StringRef hexValues = val.drop_front(2);
   if (!llvm::all_of(hexValues, llvm::isHexDigit))
     return parser.emitError(tok.getLoc(),
                             "elements hex string only contains hex digits");
@@ -74,6 +74,10 @@ struct PassManagerOptions {
                      "display the results in a list sorted by total time"),
           clEnumValN(PassDisplayMode::Pipeline, "pipeline",
                      "display the results with a nested pipeline view"))};
+  llvm::cl::opt<std::string> passTimingTrace{
+      "pass-timing-trace",
+      llvm::cl::desc("Write each execution of a pass, and the operation it ran "
+                     "on, to the given file as a Chrome trace")};
 
   //===--------------------------------------------------------------------===//
   // Pass Statistics
@@ -140,6 +144,8 @@ void PassManagerOptions::addPrinterInstrumentation(PassManager &pm) {
 
 /// Add a pass timing instrumentation if enabled by 'pass-timing' flags.
 void PassManagerOptions::addTimingInstrumentation(PassManager &pm) {
+  if (passTimingTrace.getNumOccurrences())
+    pm.enableTimingTrace(passTimingTrace);
   if (passTiming)
     pm.enableTiming(passTimingDisplayMode);
 }
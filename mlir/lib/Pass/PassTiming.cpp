@@ -7,14 +7,18 @@
 //===----------------------------------------------------------------------===//
 
 #include "PassDetail.h"
+#include "mlir/IR/SymbolTable.h"
 #include "mlir/Pass/PassManager.h"
+#include "mlir/Support/FileUtilities.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/ToolOutputFile.h"
 #include <chrono>
 
 using namespace mlir;
@@ -449,6 +453,145 @@ void PassTiming::printResultsAsPipeline(raw_ostream &os, Timer *root,
     printTimer(0, topLevelTimer.second.get());
 }
 
+//===----------------------------------------------------------------------===//
+// PassTimingTrace
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// An instrumentation that records every execution of a pass on an operation,
+/// and writes them out in the Chrome trace event format. Each event also
+/// records the operation the pass ran on, and the number of operations nested
+/// within it before and after the pass.
+struct PassTimingTrace : public PassInstrumentation {
+  PassTimingTrace(StringRef outputFile)
+      : outputFile(outputFile), startTime(std::chrono::steady_clock::now()) {}
+  ~PassTimingTrace() override { print(); }
+
+  void runBeforePass(Pass *pass, Operation *op) override;
+  void runAfterPass(Pass *pass, Operation *op) override;
+  void runAfterPassFailed(Pass *pass, Operation *op) override {
+    runAfterPass(pass, op);
+  }
+
+  /// Write out and clear the recorded events.
+  void print();
+
+  /// Returns the number of microseconds since the instrumentation was created.
+  int64_t now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - startTime)
+        .count();
+  }
+
+  /// Returns the number of operations nested within `op`, including itself.
+  static unsigned countOps(Operation *op) {
+    unsigned numOps = 0;
+    op->walk([&](Operation *) { ++numOps; });
+    return numOps;
+  }
+
+  /// A pass execution that has started on a thread.
+  struct ActiveEvent {
+    int64_t start;
+    unsigned numOpsBefore;
+  };
+
+  /// A completed pass execution.
+  struct Event {
+    std::string passName, opName, symbolName;
+    uint64_t tid;
+    int64_t start, duration;
+    unsigned numOpsBefore, numOpsAfter;
+  };
+
+  /// The file to write the trace to.
+  std::string outputFile;
+
+  /// The time that event timestamps are relative to.
+  std::chrono::steady_clock::time_point startTime;
+
+  /// A stack of the currently running passes per thread.
+  DenseMap<uint64_t, SmallVector<ActiveEvent, 4>> activeThreadEvents;
+
+  /// The completed events.
+  std::vector<Event> events;
+};
+} // end anonymous namespace
+
+void PassTimingTrace::runBeforePass(Pass *pass, Operation *op) {
+  // Adaptor passes only dispatch to their held pipelines, whose passes are
+  // recorded individually.
+  if (isAdaptorPass(pass))
+    return;
+  // Count the ops first so that the walk is not part of the pass's duration.
+  unsigned numOpsBefore = countOps(op);
+  activeThreadEvents[llvm::get_threadid()].push_back({now(), numOpsBefore});
+}
+
+void PassTimingTrace::runAfterPass(Pass *pass, Operation *op) {
+  if (isAdaptorPass(pass))
+    return;
+  auto tid = llvm::get_threadid();
+  auto &activeEvents = activeThreadEvents[tid];
+  assert(!activeEvents.empty() && "expected active event");
+  ActiveEvent active = activeEvents.pop_back_val();
+
+  Event event;
+  event.passName = std::string(pass->getName());
+  event.opName = op->getName().getStringRef().str();
+  if (auto symbolName =
+          op->getAttrOfType<StringAttr>(SymbolTable::getSymbolAttrName()))
+    event.symbolName = symbolName.getValue().str();
+  event.tid = tid;
+  event.start = active.start;
+  event.duration = now() - active.start;
+  event.numOpsBefore = active.numOpsBefore;
+  event.numOpsAfter = countOps(op);
+  events.push_back(std::move(event));
+}
+
+void PassTimingTrace::print() {
+  if (events.empty())
+    return;
+
+  std::string error;
+  std::unique_ptr<llvm::ToolOutputFile> output =
+      openOutputFile(outputFile, &error);
+  if (!output) {
+    llvm::errs() << "<MLIR-PassManager-Timing-Trace>: " << error << "\n";
+    return;
+  }
+
+  llvm::json::OStream json(output->os());
+  json.object([&] {
+    json.attributeArray("traceEvents", [&] {
+      for (const Event &event : events) {
+        json.object([&] {
+          json.attribute("name", event.passName);
+          json.attribute("cat", "pass");
+          json.attribute("ph", "X");
+          json.attribute("pid", 0);
+          json.attribute("tid", int64_t(event.tid));
+          json.attribute("ts", event.start);
+          json.attribute("dur", event.duration);
+          json.attributeObject("args", [&] {
+            json.attribute("op", event.opName);
+            if (!event.symbolName.empty())
+              json.attribute("symbol", event.symbolName);
+            json.attribute("opsBefore", int64_t(event.numOpsBefore));
+            json.attribute("opsAfter", int64_t(event.numOpsAfter));
+          });
+        });
+      }
+    });
+  });
+  output->os() << "\n";
+  output->keep();
+
+  events.clear();
+  activeThreadEvents.clear();
+}
+
 //===----------------------------------------------------------------------===//
 // PassManager
 //===----------------------------------------------------------------------===//
@@ -462,3 +605,9 @@ void PassManager::enableTiming(PassDisplayMode displayMode) {
   addInstrumentation(std::make_unique<PassTiming>(displayMode));
   passTiming = true;
 }
+
+/// Add an instrumentation to record each execution of a pass, and write them
+/// to the given file as a Chrome trace.
+void PassManager::enableTimingTrace(StringRef outputFile) {
+  addInstrumentation(std::make_unique<PassTimingTrace>(outputFile));
+}
@@ -9,6 +9,7 @@
 #include "mlir/Support/StorageUniquer.h"
 
 #include "mlir/Support/LLVM.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/RWMutex.h"
 
 using namespace mlir;
@@ -46,27 +47,28 @@ struct StorageUniquerImpl {
               function_ref<bool(const BaseStorage *)> isEqual,
               function_ref<BaseStorage *(StorageAllocator &)> ctorFn) {
     LookupKey lookupKey{kind, hashValue, isEqual};
+    Shard &shard = getShard(hashValue);
 
     // Check for an existing instance in read-only mode.
     {
-      llvm::sys::SmartScopedReader<true> typeLock(mutex);
-      auto it = storageTypes.find_as(lookupKey);
-      if (it != storageTypes.end())
+      llvm::sys::SmartScopedReader<true> typeLock(shard.mutex);
+      auto it = shard.storageTypes.find_as(lookupKey);
+      if (it != shard.storageTypes.end())
         return it->storage;
     }
 
     // Acquire a writer-lock so that we can safely create the new type instance.
-    llvm::sys::SmartScopedWriter<true> typeLock(mutex);
+    llvm::sys::SmartScopedWriter<true> typeLock(shard.mutex);
 
     // Check for an existing instance again here, because another writer thread
     // may have already created one.
-    auto existing = storageTypes.insert_as({}, lookupKey);
+    auto existing = shard.storageTypes.insert_as({}, lookupKey);
     if (!existing.second)
       return existing.first->storage;
 
     // Otherwise, construct and initialize the derived storage for this type
     // instance.
-    BaseStorage *storage = initializeStorage(kind, ctorFn);
+    BaseStorage *storage = initializeStorage(kind, shard.allocator, ctorFn);
     *existing.first = HashedStorage{hashValue, storage};
     return storage;
   }
@@ -77,14 +79,14 @@ struct StorageUniquerImpl {
               function_ref<BaseStorage *(StorageAllocator &)> ctorFn) {
     // Check for an existing instance in read-only mode.
     {
-      llvm::sys::SmartScopedReader<true> typeLock(mutex);
+      llvm::sys::SmartScopedReader<true> typeLock(simpleTypesMutex);
       auto it = simpleTypes.find(kind);
       if (it != simpleTypes.end())
         return it->second;
     }
 
     // Acquire a writer-lock so that we can safely create the new type instance.
-    llvm::sys::SmartScopedWriter<true> typeLock(mutex);
+    llvm::sys::SmartScopedWriter<true> typeLock(simpleTypesMutex);
 
     // Check for an existing instance again here, because another writer thread
     // may have already created one.
@@ -93,7 +95,7 @@ struct StorageUniquerImpl {
       return result;
 
     // Otherwise, create and return a new storage instance.
-    return result = initializeStorage(kind, ctorFn);
+    return result = initializeStorage(kind, simpleTypesAllocator, ctorFn);
   }
 
   /// Erase an instance of a complex derived type.
@@ -101,16 +103,17 @@ struct StorageUniquerImpl {
              function_ref<bool(const BaseStorage *)> isEqual,
              function_ref<void(BaseStorage *)> cleanupFn) {
     LookupKey lookupKey{kind, hashValue, isEqual};
+    Shard &shard = getShard(hashValue);
 
     // Acquire a writer-lock so that we can safely erase the type instance.
-    llvm::sys::SmartScopedWriter<true> typeLock(mutex);
-    auto existing = storageTypes.find_as(lookupKey);
-    if (existing == storageTypes.end())
+    llvm::sys::SmartScopedWriter<true> typeLock(shard.mutex);
+    auto existing = shard.storageTypes.find_as(lookupKey);
+    if (existing == shard.storageTypes.end())
       return;
 
     // Cleanup the storage and remove it from the map.
     cleanupFn(existing->storage);
-    storageTypes.erase(existing);
+    shard.storageTypes.erase(existing);
   }
 
   //===--------------------------------------------------------------------===//
@@ -119,7 +122,7 @@ struct StorageUniquerImpl {
 
   /// Utility to create and initialize a storage instance.
   BaseStorage *
-  initializeStorage(unsigned kind,
+  initializeStorage(unsigned kind, StorageAllocator &allocator,
                     function_ref<BaseStorage *(StorageAllocator &)> ctorFn) {
     BaseStorage *storage = ctorFn(allocator);
     storage->kind = kind;
@@ -154,16 +157,32 @@ struct StorageUniquerImpl {
 
   // Unique types with specific hashing or storage constraints.
   using StorageTypeSet = DenseSet<HashedStorage, StorageKeyInfo>;
-  StorageTypeSet storageTypes;
 
-  // Unique types with just the kind.
-  DenseMap<unsigned, BaseStorage *> simpleTypes;
+  /// Types with complex storage are split by hash into shards, each with its
+  /// own lock and allocator, so that threads getting unrelated instances do
+  /// not contend on a single lock.
+  struct Shard {
+    StorageTypeSet storageTypes;
+
+    // Allocator to use when constructing derived type instances.
+    StorageAllocator allocator;
+
+    // A mutex to keep type uniquing thread-safe.
+    llvm::sys::SmartRWMutex<true> mutex;
+  };
+  static constexpr unsigned numShards = 32;
+  Shard shards[numShards];
 
-  // Allocator to use when constructing derived type instances.
-  StorageUniquer::StorageAllocator allocator;
+  /// Returns the shard holding the instances with the given hash. The hash is
+  /// mixed again, since the hash sets of a shard index by its low bits.
+  Shard &getShard(unsigned hashValue) {
+    return shards[llvm::hash_value(hashValue) % numShards];
+  }
 
-  // A mutex to keep type uniquing thread-safe.
-  llvm::sys::SmartRWMutex<true> mutex;
+  // Unique types with just the kind.
+  DenseMap<unsigned, BaseStorage *> simpleTypes;
+  StorageAllocator simpleTypesAllocator;
+  llvm::sys::SmartRWMutex<true> simpleTypesMutex;
 };
 } // end namespace detail
 } // namespace mlir
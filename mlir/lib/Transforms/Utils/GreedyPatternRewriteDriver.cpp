@@ -15,6 +15,7 @@
 #include "mlir/Transforms/FoldUtils.h"
 #include "mlir/Transforms/RegionUtils.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -32,8 +33,10 @@ namespace {
 class GreedyPatternRewriteDriver : public PatternRewriter {
 public:
   explicit GreedyPatternRewriteDriver(MLIRContext *ctx,
-                                      const OwningRewritePatternList &patterns)
-      : PatternRewriter(ctx), matcher(patterns), folder(ctx) {
+                                      const OwningRewritePatternList &patterns,
+                                      bool onlyRevisitChangedOps)
+      : PatternRewriter(ctx), matcher(patterns), folder(ctx),
+        onlyRevisitChangedOps(onlyRevisitChangedOps) {
     worklist.reserve(64);
   }
 
@@ -86,10 +89,16 @@ protected:
     addToWorklist(op->getOperands());
     op->walk([this](Operation *operation) {
       removeFromWorklist(operation);
+      revisitSet.erase(operation);
       folder.notifyRemoval(operation);
+      if (operation == currentOp)
+        currentOpErased = true;
     });
   }
 
+  // An operation updated in place, and its users, may simplify further.
+  void finalizeRootUpdate(Operation *op) override { addToRevisitList(op); }
+
   // When the root of a pattern is about to be replaced, it can trigger
   // simplifications to its users - make sure to add them to the worklist
   // before the root is changed.
@@ -100,6 +109,19 @@ protected:
   }
 
 private:
+  /// Add the given operation and the users of its results to the operations
+  /// to revisit in the next iteration.
+  void addToRevisitList(Operation *op) {
+    if (!onlyRevisitChangedOps)
+      return;
+    if (revisitSet.insert(op).second)
+      revisitList.push_back(op);
+    for (auto result : op->getResults())
+      for (auto *user : result.getUsers())
+        if (revisitSet.insert(user).second)
+          revisitList.push_back(user);
+  }
+
   // Look over the provided operands for any defining operations that should
   // be re-added to the worklist. This function should be called when an
   // operation is modified or removed, as it may trigger further
@@ -128,8 +150,23 @@ private:
   std::vector<Operation *> worklist;
   DenseMap<Operation *, unsigned> worklistMap;
 
+  /// The operations that were updated in place, along with their users. Only
+  /// these are revisited after the first iteration, as the operations affected
+  /// by any other change are added to the worklist when the change is made.
+  /// Erased operations are removed from the set but not from the list.
+  std::vector<Operation *> revisitList;
+  DenseSet<Operation *> revisitSet;
+
+  /// The operation being simplified, and whether it has been erased.
+  Operation *currentOp = nullptr;
+  bool currentOpErased = false;
+
   /// Non-pattern based folder for operations.
   OperationFolder folder;
+
+  /// Whether iterations after the first only visit the changed operations
+  /// instead of walking the regions again.
+  bool onlyRevisitChangedOps;
 };
 } // end anonymous namespace
 
@@ -140,11 +177,23 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
   auto collectOps = [this](Operation *op) { addToWorklist(op); };
 
   bool changed = false;
+  bool visitAll = true;
   int i = 0;
   do {
-    // Add all nested operations to the worklist.
-    for (auto &region : regions)
-      region.walk(collectOps);
+    // Add all nested operations to the worklist. When only changed operations
+    // are revisited, do so only on the first iteration or after the regions
+    // were simplified, and otherwise add the operations updated in place.
+    if (visitAll) {
+      for (auto &region : regions)
+        region.walk(collectOps);
+      visitAll = !onlyRevisitChangedOps;
+    } else {
+      for (auto *op : revisitList)
+        if (revisitSet.count(op))
+          addToWorklist(op);
+    }
+    revisitList.clear();
+    revisitSet.clear();
 
     // These are scratch vectors used in the folding loop below.
     SmallVector<Value, 8> originalOperands, resultValues;
@@ -183,7 +232,12 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
       };
 
       // Try to fold this op.
+      currentOp = op;
+      currentOpErased = false;
       if (succeeded(folder.tryToFold(op, collectOps, preReplaceAction))) {
+        // If the op was folded in place, revisit it in the next iteration.
+        if (!currentOpErased)
+          addToRevisitList(op);
         changed = true;
         continue;
       }
@@ -192,15 +246,22 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
       setInsertionPoint(op);
 
       // Try to match one of the patterns. The rewriter is automatically
-      // notified of any necessary changes, so there is nothing else to do here.
-      changed |= matcher.matchAndRewrite(op, *this);
+      // notified of any necessary changes, except for a root that is updated
+      // in place without `updateRootInPlace`, which is revisited if it is
+      // still alive.
+      if (matcher.matchAndRewrite(op, *this)) {
+        if (!currentOpErased)
+          addToRevisitList(op);
+        changed = true;
+      }
     }
+    currentOp = nullptr;
 
     // After applying patterns, make sure that the CFG of each of the regions is
     // kept up to date.
     if (succeeded(simplifyRegions(regions))) {
       folder.clear();
-      changed = true;
+      changed = visitAll = true;
     }
   } while (changed && ++i < maxIterations);
   // Whether the rewrite converges, i.e. wasn't changed in the last iteration.
@@ -214,13 +275,16 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
 /// Note: This does not apply patterns to the top-level operation itself.
 ///
 bool mlir::applyPatternsGreedily(Operation *op,
-                                 const OwningRewritePatternList &patterns) {
-  return applyPatternsGreedily(op->getRegions(), patterns);
+                                 const OwningRewritePatternList &patterns,
+                                 bool onlyRevisitChangedOps) {
+  return applyPatternsGreedily(op->getRegions(), patterns,
+                               onlyRevisitChangedOps);
 }
 
 /// Rewrite the given regions, which must be isolated from above.
 bool mlir::applyPatternsGreedily(MutableArrayRef<Region> regions,
-                                 const OwningRewritePatternList &patterns) {
+                                 const OwningRewritePatternList &patterns,
+                                 bool onlyRevisitChangedOps) {
   if (regions.empty())
     return true;
 
@@ -235,7 +299,8 @@ bool mlir::applyPatternsGreedily(MutableArrayRef<Region> regions,
          "patterns can only be applied to operations IsolatedFromAbove");
 
   // Start the pattern driver.
-  GreedyPatternRewriteDriver driver(regions[0].getContext(), patterns);
+  GreedyPatternRewriteDriver driver(regions[0].getContext(), patterns,
+                                    onlyRevisitChangedOps);
   bool converged = driver.simplify(regions, maxPatternMatchIterations);
   LLVM_DEBUG(if (!converged) {
     llvm::dbgs() << "The pattern rewrite doesn't converge after scanning "
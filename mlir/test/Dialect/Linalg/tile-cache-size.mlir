@@ -0,0 +1,60 @@
+// RUN: mlir-opt %s -linalg-tile="linalg-tile-cache-size=32768" | FileCheck %s
+// RUN: mlir-opt %s -linalg-tile-to-parallel-loops="linalg-tile-cache-size=32768" | FileCheck %s --check-prefix=PARALLEL
+// RUN: mlir-opt %s -linalg-tile="linalg-tile-sizes=2,3,4 linalg-tile-cache-size=32768" | FileCheck %s --check-prefix=SIZES
+
+// Three 2-D f32 tiles of 32x32 take 12 KiB, and of 64x64 48 KiB, so the
+// matmul is tiled by 32 along every loop.
+
+// CHECK-LABEL: func @matmul(
+//   CHECK-DAG:   %[[C32:.*]] = constant 32 : index
+//   CHECK-NOT:   constant 64 : index
+//       CHECK:   loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C32]] {
+//       CHECK:     loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C32]] {
+//       CHECK:       loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C32]] {
+//       CHECK:         linalg.matmul(
+
+// PARALLEL-LABEL: func @matmul(
+//   PARALLEL-DAG:   %[[C32:.*]] = constant 32 : index
+//       PARALLEL:   loop.parallel (%{{.*}}, %{{.*}}, %{{.*}}) = (%{{.*}}, %{{.*}}, %{{.*}}) to (%{{.*}}, %{{.*}}, %{{.*}}) step (%[[C32]], %[[C32]], %[[C32]]) {
+//       PARALLEL:     linalg.matmul(
+
+// Explicit tile sizes take precedence over the cache size.
+
+// SIZES-LABEL: func @matmul(
+//   SIZES-DAG:   %[[C2:.*]] = constant 2 : index
+//   SIZES-DAG:   %[[C3:.*]] = constant 3 : index
+//   SIZES-DAG:   %[[C4:.*]] = constant 4 : index
+//   SIZES-NOT:   constant 32 : index
+//       SIZES:   loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C2]] {
+//       SIZES:     loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C3]] {
+//       SIZES:       loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C4]] {
+//       SIZES:         linalg.matmul(
+func @matmul(%A: memref<?x?xf32>, %B: memref<?x?xf32>, %C: memref<?x?xf32>) {
+  linalg.matmul(%A, %B, %C)
+    : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+// The vectors grow linearly with the tile size: a 64x64 f64 matrix tile and
+// two vector tiles take 33 KiB, so the f64 matvec is tiled by 32, whereas the
+// f32 one, at 16.5 KiB for 64, is tiled by 64.
+
+// CHECK-LABEL: func @matvec_f64(
+//   CHECK-DAG:   %[[C32:.*]] = constant 32 : index
+//       CHECK:   loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C32]] {
+//       CHECK:     loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C32]] {
+//       CHECK:       linalg.matvec(
+func @matvec_f64(%A: memref<?x?xf64>, %x: memref<?xf64>, %y: memref<?xf64>) {
+  linalg.matvec(%A, %x, %y) : memref<?x?xf64>, memref<?xf64>, memref<?xf64>
+  return
+}
+
+// CHECK-LABEL: func @matvec_f32(
+//   CHECK-DAG:   %[[C64:.*]] = constant 64 : index
+//       CHECK:   loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C64]] {
+//       CHECK:     loop.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C64]] {
+//       CHECK:       linalg.matvec(
+func @matvec_f32(%A: memref<?x?xf32>, %x: memref<?xf32>, %y: memref<?xf32>) {
+  linalg.matvec(%A, %x, %y) : memref<?x?xf32>, memref<?xf32>, memref<?xf32>
+  return
+}
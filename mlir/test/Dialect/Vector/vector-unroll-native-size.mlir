@@ -0,0 +1,132 @@
+// RUN: mlir-opt %s -test-vector-to-vector-conversion=native-vector-bitwidth=128 | FileCheck %s --check-prefix=W128
+// RUN: mlir-opt %s -test-vector-to-vector-conversion=native-vector-bitwidth=256 | FileCheck %s --check-prefix=W256
+
+// The innermost dimension is unrolled to the number of lanes in a register,
+// and the outer dimensions to 1.
+
+// W128-LABEL: func @addf_4x8
+// W128:         vector.extract_slices %{{.*}}, [1, 4], [1, 1] : vector<4x8xf32> into tuple<
+// W128:         vector.extract_slices %{{.*}}, [1, 4], [1, 1] : vector<4x8xf32> into tuple<
+// W128-COUNT-8: addf %{{.*}}, %{{.*}} : vector<1x4xf32>
+// W128-NOT:     addf
+// W128:         %[[R:.*]] = vector.insert_slices %{{.*}}, [1, 4], [1, 1] : tuple<{{.*}}> into vector<4x8xf32>
+// W128-NEXT:    return %[[R]] : vector<4x8xf32>
+
+// W256-LABEL: func @addf_4x8
+// W256:         vector.extract_slices %{{.*}}, [1, 8], [1, 1] : vector<4x8xf32> into tuple<
+// W256:         vector.extract_slices %{{.*}}, [1, 8], [1, 1] : vector<4x8xf32> into tuple<
+// W256-COUNT-4: addf %{{.*}}, %{{.*}} : vector<1x8xf32>
+// W256-NOT:     addf
+// W256:         %[[R:.*]] = vector.insert_slices %{{.*}}, [1, 8], [1, 1] : tuple<{{.*}}> into vector<4x8xf32>
+// W256-NEXT:    return %[[R]] : vector<4x8xf32>
+func @addf_4x8(%arg0: vector<4x8xf32>, %arg1: vector<4x8xf32>) -> vector<4x8xf32> {
+  %0 = addf %arg0, %arg1 : vector<4x8xf32>
+  return %0 : vector<4x8xf32>
+}
+
+// A dimension that is not a multiple of the lane count is unrolled to the
+// largest lane count that divides it.
+
+// W128-LABEL: func @mulf_6
+// W128-COUNT-3: mulf %{{.*}}, %{{.*}} : vector<2xf32>
+// W128-NOT:     mulf
+// W128:         vector.insert_slices %{{.*}}, [2], [1] : tuple<{{.*}}> into vector<6xf32>
+
+// W256-LABEL: func @mulf_6
+// W256-COUNT-3: mulf %{{.*}}, %{{.*}} : vector<2xf32>
+// W256-NOT:     mulf
+// W256:         vector.insert_slices %{{.*}}, [2], [1] : tuple<{{.*}}> into vector<6xf32>
+func @mulf_6(%arg0: vector<6xf32>, %arg1: vector<6xf32>) -> vector<6xf32> {
+  %0 = mulf %arg0, %arg1 : vector<6xf32>
+  return %0 : vector<6xf32>
+}
+
+// Ops that already fit in a register are left alone.
+
+// W128-LABEL: func @addf_native
+// W128-NEXT:    %[[R:.*]] = addf %{{.*}}, %{{.*}} : vector<4xf32>
+// W128-NEXT:    return %[[R]] : vector<4xf32>
+
+// W256-LABEL: func @addf_native
+// W256-NEXT:    %[[R:.*]] = addf %{{.*}}, %{{.*}} : vector<4xf32>
+// W256-NEXT:    return %[[R]] : vector<4xf32>
+func @addf_native(%arg0: vector<4xf32>, %arg1: vector<4xf32>) -> vector<4xf32> {
+  %0 = addf %arg0, %arg1 : vector<4xf32>
+  return %0 : vector<4xf32>
+}
+
+#matmul_accesses = [
+  affine_map<(i, j, k) -> (i, k)>,
+  affine_map<(i, j, k) -> (k, j)>,
+  affine_map<(i, j, k) -> (i, j)>
+]
+#matmul_trait = {
+  indexing_maps = #matmul_accesses,
+  iterator_types = ["parallel", "parallel", "reduction"]
+}
+
+// A contraction is unrolled along its iteration space into outer products of
+// a native size row of the result.
+
+// W128-LABEL: func @contract_matmul
+// W128:          vector.extract_slices %{{.*}}, [1, 1], [1, 1] : vector<2x4xf32> into tuple<
+// W128:          vector.extract_slices %{{.*}}, [1, 4], [1, 1] : vector<4x8xf32> into tuple<
+// W128:          vector.extract_slices %{{.*}}, [1, 4], [1, 1] : vector<2x8xf32> into tuple<
+// W128-COUNT-16: vector.contract {{.*}} : vector<1x1xf32>, vector<1x4xf32> into vector<1x4xf32>
+// W128-NOT:      vector.contract
+// W128:          %[[R:.*]] = vector.insert_slices %{{.*}}, [1, 4], [1, 1] : tuple<{{.*}}> into vector<2x8xf32>
+// W128-NEXT:     return %[[R]] : vector<2x8xf32>
+
+// W256-LABEL: func @contract_matmul
+// W256-COUNT-8: vector.contract {{.*}} : vector<1x1xf32>, vector<1x8xf32> into vector<1x8xf32>
+// W256-NOT:     vector.contract
+// W256:         %[[R:.*]] = vector.insert_slices %{{.*}}, [1, 8], [1, 1] : tuple<{{.*}}> into vector<2x8xf32>
+// W256-NEXT:    return %[[R]] : vector<2x8xf32>
+func @contract_matmul(%arg0: vector<2x4xf32>, %arg1: vector<4x8xf32>,
+                      %arg2: vector<2x8xf32>) -> vector<2x8xf32> {
+  %0 = vector.contract #matmul_trait %arg0, %arg1, %arg2
+    : vector<2x4xf32>, vector<4x8xf32> into vector<2x8xf32>
+  return %0 : vector<2x8xf32>
+}
+
+// A contraction that is already a native size outer product is left alone.
+
+// W128-LABEL: func @contract_native
+// W128-NEXT:    %[[R:.*]] = vector.contract {{.*}} : vector<1x1xf32>, vector<1x4xf32> into vector<1x4xf32>
+// W128-NEXT:    return %[[R]] : vector<1x4xf32>
+
+// W256-LABEL: func @contract_native
+// W256-NEXT:    %[[R:.*]] = vector.contract {{.*}} : vector<1x1xf32>, vector<1x4xf32> into vector<1x4xf32>
+// W256-NEXT:    return %[[R]] : vector<1x4xf32>
+func @contract_native(%arg0: vector<1x1xf32>, %arg1: vector<1x4xf32>,
+                      %arg2: vector<1x4xf32>) -> vector<1x4xf32> {
+  %0 = vector.contract #matmul_trait %arg0, %arg1, %arg2
+    : vector<1x1xf32>, vector<1x4xf32> into vector<1x4xf32>
+  return %0 : vector<1x4xf32>
+}
+
+#dot_accesses = [
+  affine_map<(i) -> (i)>,
+  affine_map<(i) -> (i)>,
+  affine_map<(i) -> ()>
+]
+#dot_trait = {
+  indexing_maps = #dot_accesses,
+  iterator_types = ["reduction"]
+}
+
+// A contraction with a scalar result is not unrolled.
+
+// W128-LABEL: func @contract_dot
+// W128-NEXT:    %[[R:.*]] = vector.contract {{.*}} : vector<16xf32>, vector<16xf32> into f32
+// W128-NEXT:    return %[[R]] : f32
+
+// W256-LABEL: func @contract_dot
+// W256-NEXT:    %[[R:.*]] = vector.contract {{.*}} : vector<16xf32>, vector<16xf32> into f32
+// W256-NEXT:    return %[[R]] : f32
+func @contract_dot(%arg0: vector<16xf32>, %arg1: vector<16xf32>,
+                   %arg2: f32) -> f32 {
+  %0 = vector.contract #dot_trait %arg0, %arg1, %arg2
+    : vector<16xf32>, vector<16xf32> into f32
+  return %0 : f32
+}
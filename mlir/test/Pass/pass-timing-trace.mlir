@@ -0,0 +1,30 @@
+// RUN: mlir-opt %s -disable-pass-threading -pass-pipeline='func(cse,canonicalize)' -pass-timing-trace=%t.json -o /dev/null
+// RUN: FileCheck %s < %t.json
+
+// Every execution of a non-adaptor pass is an "X" event of the Chrome trace
+// format, with the anchor operation and its size before and after the pass
+// in the arguments. The func adaptor itself is not recorded.
+
+// CHECK:      {"traceEvents":[
+// CHECK-SAME: {"name":"CSE","cat":"pass","ph":"X","pid":0,"tid":[[TID:[0-9]+]],"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func","symbol":"a","opsBefore":5,"opsAfter":4}},
+// CHECK-SAME: {"name":"Canonicalizer","cat":"pass","ph":"X","pid":0,"tid":[[TID]],"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func","symbol":"a","opsBefore":4,"opsAfter":{{[0-9]+}}}},
+// CHECK-SAME: {"name":"CSE","cat":"pass","ph":"X","pid":0,"tid":[[TID]],"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func","symbol":"b","opsBefore":5,"opsAfter":5}},
+// CHECK-SAME: {"name":"Canonicalizer","cat":"pass","ph":"X","pid":0,"tid":[[TID]],"ts":{{[0-9]+}},"dur":{{[0-9]+}},"args":{"op":"func","symbol":"b","opsBefore":5,"opsAfter":3}}
+// CHECK-SAME: ]}
+// CHECK-NOT:  OpToOpPassAdaptor
+
+// CSE removes the second addi.
+func @a(%arg0: i32) -> i32 {
+  %0 = addi %arg0, %arg0 : i32
+  %1 = addi %arg0, %arg0 : i32
+  %2 = muli %0, %1 : i32
+  return %2 : i32
+}
+
+// The canonicalizer folds the addi and erases the constants it used.
+func @b() -> i32 {
+  %c1 = constant 1 : i32
+  %c2 = constant 2 : i32
+  %0 = addi %c1, %c2 : i32
+  return %0 : i32
+}
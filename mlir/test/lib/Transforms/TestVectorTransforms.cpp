@@ -22,10 +22,25 @@ namespace {
 
 struct TestVectorToVectorConversion
     : public PassWrapper<TestVectorToVectorConversion, FunctionPass> {
+  TestVectorToVectorConversion() = default;
+  TestVectorToVectorConversion(const TestVectorToVectorConversion &pass) {}
+
+  Option<unsigned> nativeVectorBitWidth{
+      *this, "native-vector-bitwidth",
+      llvm::cl::desc("Unroll std.addf, std.mulf and vector.contract to "
+                     "vectors of this many bits instead of applying the "
+                     "generated unroll patterns"),
+      llvm::cl::init(0)};
+
   void runOnFunction() override {
     OwningRewritePatternList patterns;
     auto *context = &getContext();
-    populateWithGenerated(context, &patterns);
+    if (nativeVectorBitWidth)
+      populateVectorUnrollToNativeSizePatterns(
+          patterns, context, {"std.addf", "std.mulf", "vector.contract"},
+          nativeVectorBitWidth);
+    else
+      populateWithGenerated(context, &patterns);
     populateVectorToVectorCanonicalizationPatterns(patterns, context);
     populateVectorToVectorTransformationPatterns(patterns, context);
     applyPatternsGreedily(getFunction(), patterns);
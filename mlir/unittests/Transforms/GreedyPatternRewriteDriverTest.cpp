@@ -0,0 +1,91 @@
+//===- GreedyPatternRewriteDriverTest.cpp - Greedy rewriter unit tests ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/Module.h"
+#include "mlir/IR/PatternMatch.h"
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+namespace {
+/// Replaces "test.b" with "test.marker".
+struct CreateMarker : public RewritePattern {
+  CreateMarker(MLIRContext *context) : RewritePattern("test.b", 1, context) {}
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    rewriter.createOperation(OperationState(op->getLoc(), "test.marker"));
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
+/// Erases "test.a" once a "test.marker" exists in the same block. This depends
+/// on IR other than the operation it rewrites.
+struct EraseAfterMarker : public RewritePattern {
+  EraseAfterMarker(MLIRContext *context)
+      : RewritePattern("test.a", 1, context) {}
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    for (Operation &other : *op->getBlock()) {
+      if (other.getName().getStringRef() == "test.marker") {
+        rewriter.eraseOp(op);
+        return success();
+      }
+    }
+    return failure();
+  }
+};
+
+class GreedyPatternRewriteDriverTest : public testing::Test {
+protected:
+  GreedyPatternRewriteDriverTest()
+      : module(ModuleOp::create(UnknownLoc::get(&context))) {
+    context.allowUnregisteredDialects();
+    patterns.insert<CreateMarker, EraseAfterMarker>(&context);
+
+    // "test.a" is visited before "test.b", so it can only be erased in a
+    // later iteration.
+    OpBuilder builder(module->getBody()->getTerminator());
+    Location loc = builder.getUnknownLoc();
+    builder.createOperation(OperationState(loc, "test.b"));
+    builder.createOperation(OperationState(loc, "test.a"));
+  }
+
+  unsigned countOps(StringRef name) {
+    unsigned count = 0;
+    module->walk([&](Operation *op) {
+      if (op->getName().getStringRef() == name)
+        ++count;
+    });
+    return count;
+  }
+
+  MLIRContext context;
+  OwningModuleRef module;
+  OwningRewritePatternList patterns;
+};
+
+TEST_F(GreedyPatternRewriteDriverTest, RevisitsAllOps) {
+  EXPECT_TRUE(applyPatternsGreedily(*module, patterns));
+  EXPECT_EQ(countOps("test.b"), 0u);
+  EXPECT_EQ(countOps("test.marker"), 1u);
+  EXPECT_EQ(countOps("test.a"), 0u);
+}
+
+TEST_F(GreedyPatternRewriteDriverTest, OnlyRevisitsChangedOps) {
+  EXPECT_TRUE(applyPatternsGreedily(*module, patterns,
+                                    /*onlyRevisitChangedOps=*/true));
+  EXPECT_EQ(countOps("test.b"), 0u);
+  EXPECT_EQ(countOps("test.marker"), 1u);
+  // Nothing notified the driver that "test.a" can now be rewritten.
+  EXPECT_EQ(countOps("test.a"), 1u);
+}
+} // end anonymous namespace
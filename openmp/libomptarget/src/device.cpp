@@ -16,31 +16,72 @@
 
 #include <cassert>
 #include <climits>
+#include <cstdlib>
 #include <string>
 
 /// Map between Device ID (i.e. openmp device id) and its DeviceTy.
 DevicesTy Devices;
 
+namespace {
+// Largest allocation served from the device memory pool. Zero disables the
+// pool.
+size_t getMemoryPoolThreshold() {
+  static const size_t Threshold = []() -> size_t {
+    if (char *envStr = getenv("LIBOMPTARGET_MEMORY_POOL_THRESHOLD"))
+      return std::stoull(envStr);
+    return 1 << 20;
+  }();
+  return Threshold;
+}
+
+// Most bytes of free blocks the device memory pool keeps per device.
+size_t getMemoryPoolCacheLimit() {
+  static const size_t Limit = []() -> size_t {
+    if (char *envStr = getenv("LIBOMPTARGET_MEMORY_POOL_CACHE_LIMIT"))
+      return std::stoull(envStr);
+    return 256 << 20;
+  }();
+  return Limit;
+}
+
+// Pool blocks are powers of two of at least 256 bytes, which is also the
+// alignment device allocators usually guarantee.
+const unsigned MinSizeClassLog2 = 8;
+
+unsigned getSizeClass(size_t Size) {
+  unsigned SizeClass = 0;
+  while (((size_t)1 << (SizeClass + MinSizeClassLog2)) < Size)
+    ++SizeClass;
+  return SizeClass;
+}
+
+size_t getSizeClassBytes(unsigned SizeClass) {
+  return (size_t)1 << (SizeClass + MinSizeClassLog2);
+}
+
+bool isPooledSize(int64_t Size) {
+  return Size > 0 && (size_t)Size <= getMemoryPoolThreshold();
+}
+} // namespace
+
 int DeviceTy::associatePtr(void *HstPtrBegin, void *TgtPtrBegin, int64_t Size) {
   DataMapMtx.lock();
 
   // Check if entry exists
-  for (auto &HT : HostDataToTargetMap) {
-    if ((uintptr_t)HstPtrBegin == HT.HstPtrBegin) {
-      // Mapping already exists
-      bool isValid = HT.HstPtrBegin == (uintptr_t) HstPtrBegin &&
-                     HT.HstPtrEnd == (uintptr_t) HstPtrBegin + Size &&
-                     HT.TgtPtrBegin == (uintptr_t) TgtPtrBegin;
-      DataMapMtx.unlock();
-      if (isValid) {
-        DP("Attempt to re-associate the same device ptr+offset with the same "
-            "host ptr, nothing to do\n");
-        return OFFLOAD_SUCCESS;
-      } else {
-        DP("Not allowed to re-associate a different device ptr+offset with the "
-            "same host ptr\n");
-        return OFFLOAD_FAIL;
-      }
+  auto search = HostDataToTargetMap.find((uintptr_t)HstPtrBegin);
+  if (search != HostDataToTargetMap.end()) {
+    // Mapping already exists
+    bool isValid = search->HstPtrEnd == (uintptr_t) HstPtrBegin + Size &&
+                   search->TgtPtrBegin == (uintptr_t) TgtPtrBegin;
+    DataMapMtx.unlock();
+    if (isValid) {
+      DP("Attempt to re-associate the same device ptr+offset with the same "
+          "host ptr, nothing to do\n");
+      return OFFLOAD_SUCCESS;
+    } else {
+      DP("Not allowed to re-associate a different device ptr+offset with the "
+          "same host ptr\n");
+      return OFFLOAD_FAIL;
     }
   }
 
@@ -55,7 +96,7 @@ int DeviceTy::associatePtr(void *HstPtrBegin, void *TgtPtrBegin, int64_t Size) {
       DPxMOD ", TgtBegin=" DPxMOD "\n", DPxPTR(newEntry.HstPtrBase),
       DPxPTR(newEntry.HstPtrBegin), DPxPTR(newEntry.HstPtrEnd),
       DPxPTR(newEntry.TgtPtrBegin));
-  HostDataToTargetMap.push_front(newEntry);
+  HostDataToTargetMap.insert(newEntry);
 
   DataMapMtx.unlock();
 
@@ -66,20 +107,17 @@ int DeviceTy::disassociatePtr(void *HstPtrBegin) {
   DataMapMtx.lock();
 
   // Check if entry exists
-  for (HostDataToTargetListTy::iterator ii = HostDataToTargetMap.begin();
-      ii != HostDataToTargetMap.end(); ++ii) {
-    if ((uintptr_t)HstPtrBegin == ii->HstPtrBegin) {
-      // Mapping exists
-      if (ii->isRefCountInf()) {
-        DP("Association found, removing it\n");
-        HostDataToTargetMap.erase(ii);
-        DataMapMtx.unlock();
-        return OFFLOAD_SUCCESS;
-      } else {
-        DP("Trying to disassociate a pointer which was not mapped via "
-            "omp_target_associate_ptr\n");
-        break;
-      }
+  auto search = HostDataToTargetMap.find((uintptr_t)HstPtrBegin);
+  if (search != HostDataToTargetMap.end()) {
+    // Mapping exists
+    if (search->isRefCountInf()) {
+      DP("Association found, removing it\n");
+      HostDataToTargetMap.erase(search);
+      DataMapMtx.unlock();
+      return OFFLOAD_SUCCESS;
+    } else {
+      DP("Trying to disassociate a pointer which was not mapped via "
+          "omp_target_associate_ptr\n");
     }
   }
 
@@ -95,11 +133,13 @@ uint64_t DeviceTy::getMapEntryRefCnt(void *HstPtrBegin) {
   uint64_t RefCnt = 0;
 
   DataMapMtx.lock();
-  for (auto &HT : HostDataToTargetMap) {
+  // The only entry that can contain hp is the last one starting at or before it.
+  auto upper = HostDataToTargetMap.upper_bound(hp);
+  if (upper != HostDataToTargetMap.begin()) {
+    auto &HT = *std::prev(upper);
     if (hp >= HT.HstPtrBegin && hp < HT.HstPtrEnd) {
       DP("DeviceTy::getMapEntry: requested entry found\n");
       RefCnt = HT.getRefCount();
-      break;
     }
   }
   DataMapMtx.unlock();
@@ -117,23 +157,35 @@ LookupResult DeviceTy::lookupMapping(void *HstPtrBegin, int64_t Size) {
 
   DP("Looking up mapping(HstPtrBegin=" DPxMOD ", Size=%ld)...\n", DPxPTR(hp),
       Size);
-  for (lr.Entry = HostDataToTargetMap.begin();
-      lr.Entry != HostDataToTargetMap.end(); ++lr.Entry) {
-    auto &HT = *lr.Entry;
+  // HostDataToTargetMap is sorted by HstPtrBegin and its regions do not
+  // overlap, so only the last region starting at or before hp and the first
+  // one starting after it can intersect [hp, hp+Size).
+  lr.Entry = HostDataToTargetMap.upper_bound(hp);
+  if (lr.Entry != HostDataToTargetMap.begin()) {
+    auto prev = std::prev(lr.Entry);
+    auto &HT = *prev;
     // Is it contained?
     lr.Flags.IsContained = hp >= HT.HstPtrBegin && hp < HT.HstPtrEnd &&
         (hp+Size) <= HT.HstPtrEnd;
+    // Does it extend beyond the mapped region?
+    lr.Flags.ExtendsAfter = hp < HT.HstPtrEnd && (hp+Size) > HT.HstPtrEnd;
+    if (lr.Flags.IsContained || lr.Flags.ExtendsAfter)
+      lr.Entry = prev;
+  }
+
+  if (!lr.Flags.IsContained && !lr.Flags.ExtendsAfter &&
+      lr.Entry != HostDataToTargetMap.end()) {
+    auto &HT = *lr.Entry;
     // Does it extend into an already mapped region?
     lr.Flags.ExtendsBefore = hp < HT.HstPtrBegin && (hp+Size) > HT.HstPtrBegin;
     // Does it extend beyond the mapped region?
     lr.Flags.ExtendsAfter = hp < HT.HstPtrEnd && (hp+Size) > HT.HstPtrEnd;
-
-    if (lr.Flags.IsContained || lr.Flags.ExtendsBefore ||
-        lr.Flags.ExtendsAfter) {
-      break;
-    }
   }
 
+  if (!lr.Flags.IsContained && !lr.Flags.ExtendsBefore &&
+      !lr.Flags.ExtendsAfter)
+    lr.Entry = HostDataToTargetMap.end();
+
   if (lr.Flags.ExtendsBefore) {
     DP("WARNING: Pointer is not mapped but section extends into already "
         "mapped data\n");
@@ -198,12 +250,12 @@ void *DeviceTy::getOrAllocTgtPtr(void *HstPtrBegin, void *HstPtrBase,
     } else {
       // If it is not contained and Size > 0 we should create a new entry for it.
       IsNew = true;
-      uintptr_t tp = (uintptr_t)RTL->data_alloc(RTLDeviceID, Size, HstPtrBegin);
+      uintptr_t tp = (uintptr_t)allocData(Size, HstPtrBegin);
       DP("Creating new map entry: HstBase=" DPxMOD ", HstBegin=" DPxMOD ", "
          "HstEnd=" DPxMOD ", TgtBegin=" DPxMOD "\n", DPxPTR(HstPtrBase),
          DPxPTR(HstPtrBegin), DPxPTR((uintptr_t)HstPtrBegin + Size), DPxPTR(tp));
-      HostDataToTargetMap.push_front(HostDataToTargetTy((uintptr_t)HstPtrBase,
-          (uintptr_t)HstPtrBegin, (uintptr_t)HstPtrBegin + Size, tp));
+      HostDataToTargetMap.emplace((uintptr_t)HstPtrBase,
+          (uintptr_t)HstPtrBegin, (uintptr_t)HstPtrBegin + Size, tp);
       rc = (void *)tp;
     }
   }
@@ -265,7 +317,8 @@ void *DeviceTy::getTgtPtrBegin(void *HstPtrBegin, int64_t Size) {
 }
 
 int DeviceTy::deallocTgtPtr(void *HstPtrBegin, int64_t Size, bool ForceDelete,
-                            bool HasCloseModifier) {
+                            bool HasCloseModifier,
+                            __tgt_async_info *AsyncInfoPtr) {
   if (RTLs->RequiresFlags & OMP_REQ_UNIFIED_SHARED_MEMORY && !HasCloseModifier)
     return OFFLOAD_SUCCESS;
   // Check if the pointer is contained in any sub-nodes.
@@ -279,7 +332,8 @@ int DeviceTy::deallocTgtPtr(void *HstPtrBegin, int64_t Size, bool ForceDelete,
     if (HT.decRefCount() == 0) {
       DP("Deleting tgt data " DPxMOD " of size %ld\n",
           DPxPTR(HT.TgtPtrBegin), Size);
-      RTL->data_delete(RTLDeviceID, (void *)HT.TgtPtrBegin);
+      deleteData((void *)HT.TgtPtrBegin, HT.HstPtrEnd - HT.HstPtrBegin,
+                 AsyncInfoPtr);
       DP("Removing%s mapping with HstPtrBegin=" DPxMOD ", TgtPtrBegin=" DPxMOD
           ", Size=%ld\n", (ForceDelete ? " (forced)" : ""),
           DPxPTR(HT.HstPtrBegin), DPxPTR(HT.TgtPtrBegin), Size);
@@ -296,6 +350,64 @@ int DeviceTy::deallocTgtPtr(void *HstPtrBegin, int64_t Size, bool ForceDelete,
   return rc;
 }
 
+void *DeviceTy::allocData(int64_t Size, void *HstPtr) {
+  if (!isPooledSize(Size))
+    return RTL->data_alloc(RTLDeviceID, Size, HstPtr);
+
+  unsigned SizeClass = getSizeClass(Size);
+  size_t BlockSize = getSizeClassBytes(SizeClass);
+  std::lock_guard<std::mutex> LG(MemoryPoolMtx);
+  if (SizeClass < FreeBlocks.size() && !FreeBlocks[SizeClass].empty()) {
+    void *Ptr = FreeBlocks[SizeClass].back();
+    FreeBlocks[SizeClass].pop_back();
+    CachedBytes -= BlockSize;
+    DP("Reusing pooled device block " DPxMOD " of size %zu for %ld bytes\n",
+       DPxPTR(Ptr), BlockSize, Size);
+    return Ptr;
+  }
+
+  void *Ptr = RTL->data_alloc(RTLDeviceID, BlockSize, HstPtr);
+  if (!Ptr && CachedBytes) {
+    // Give the cached blocks back to the plugin and try again.
+    DP("Releasing %zu bytes of pooled device memory\n", CachedBytes);
+    for (std::vector<void *> &Blocks : FreeBlocks) {
+      for (void *Block : Blocks)
+        RTL->data_delete(RTLDeviceID, Block);
+      Blocks.clear();
+    }
+    CachedBytes = 0;
+    Ptr = RTL->data_alloc(RTLDeviceID, BlockSize, HstPtr);
+  }
+  return Ptr;
+}
+
+int32_t DeviceTy::deleteData(void *TgtPtrBegin, int64_t Size,
+                             __tgt_async_info *AsyncInfoPtr) {
+  if (!isPooledSize(Size))
+    return RTL->data_delete(RTLDeviceID, TgtPtrBegin);
+
+  unsigned SizeClass = getSizeClass(Size);
+  std::lock_guard<std::mutex> LG(MemoryPoolMtx);
+  if (AsyncInfoPtr && AsyncInfoPtr->Queue) {
+    // Operations still in flight on the queue may use the block.
+    PendingBlocks[AsyncInfoPtr->Queue].emplace_back(TgtPtrBegin, SizeClass);
+    return OFFLOAD_SUCCESS;
+  }
+  return releaseBlock(TgtPtrBegin, SizeClass);
+}
+
+int32_t DeviceTy::releaseBlock(void *TgtPtrBegin, unsigned SizeClass) {
+  size_t BlockSize = getSizeClassBytes(SizeClass);
+  if (CachedBytes + BlockSize > getMemoryPoolCacheLimit())
+    return RTL->data_delete(RTLDeviceID, TgtPtrBegin);
+
+  if (SizeClass >= FreeBlocks.size())
+    FreeBlocks.resize(SizeClass + 1);
+  FreeBlocks[SizeClass].push_back(TgtPtrBegin);
+  CachedBytes += BlockSize;
+  return OFFLOAD_SUCCESS;
+}
+
 /// Init device, should not be called directly.
 void DeviceTy::init() {
   // Make call to init_requires if it exists for this plugin.
@@ -365,6 +477,39 @@ int32_t DeviceTy::run_team_region(void *TgtEntryPtr, void **TgtVarsPtr,
                               AsyncInfo);
 }
 
+// Synchronize with the device and make the pool blocks freed on the queue
+// reusable.
+int32_t DeviceTy::synchronize(__tgt_async_info *AsyncInfoPtr) {
+  // Queues are shared between host threads, so other threads may park more
+  // blocks on this queue while it is being synchronized, for operations that
+  // are still running afterwards. Only the blocks parked before the
+  // synchronization started are known to be unused once it returns.
+  std::vector<std::pair<void *, unsigned>> Blocks;
+  void *Queue = AsyncInfoPtr->Queue;
+  {
+    std::lock_guard<std::mutex> LG(MemoryPoolMtx);
+    auto It = PendingBlocks.find(Queue);
+    if (It != PendingBlocks.end()) {
+      Blocks.swap(It->second);
+      PendingBlocks.erase(It);
+    }
+  }
+
+  int32_t rc = RTL->synchronize(RTLDeviceID, AsyncInfoPtr);
+
+  std::lock_guard<std::mutex> LG(MemoryPoolMtx);
+  if (rc != OFFLOAD_SUCCESS) {
+    // The blocks may still be in use, so keep them parked.
+    std::vector<std::pair<void *, unsigned>> &Pending = PendingBlocks[Queue];
+    Pending.insert(Pending.end(), Blocks.begin(), Blocks.end());
+    return rc;
+  }
+  for (auto &Block : Blocks)
+    if (releaseBlock(Block.first, Block.second) != OFFLOAD_SUCCESS)
+      rc = OFFLOAD_FAIL;
+  return rc;
+}
+
 /// Check whether a device has an associated RTL and initialize it if it's not
 /// already initialized.
 bool device_is_ready(int device_num) {
@@ -18,6 +18,7 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 #include <vector>
 
 // Forward declarations.
@@ -35,7 +36,9 @@ struct HostDataToTargetTy {
   uintptr_t TgtPtrBegin; // target info.
 
 private:
-  uint64_t RefCount;
+  /// The ref count is not part of the ordering, so it may be updated through
+  /// the const references handed out by the map.
+  mutable uint64_t RefCount;
   static const uint64_t INFRefCount = ~(uint64_t)0;
 
 public:
@@ -48,14 +51,14 @@ public:
     return RefCount;
   }
 
-  uint64_t resetRefCount() {
+  uint64_t resetRefCount() const {
     if (RefCount != INFRefCount)
       RefCount = 1;
 
     return RefCount;
   }
 
-  uint64_t incRefCount() {
+  uint64_t incRefCount() const {
     if (RefCount != INFRefCount) {
       ++RefCount;
       assert(RefCount < INFRefCount && "refcount overflow");
@@ -64,7 +67,7 @@ public:
     return RefCount;
   }
 
-  uint64_t decRefCount() {
+  uint64_t decRefCount() const {
     if (RefCount != INFRefCount) {
       assert(RefCount > 0 && "refcount underflow");
       --RefCount;
@@ -78,7 +81,21 @@ public:
   }
 };
 
-typedef std::list<HostDataToTargetTy> HostDataToTargetListTy;
+typedef uintptr_t HstPtrBeginTy;
+inline bool operator<(const HostDataToTargetTy &lhs, const HstPtrBeginTy &rhs) {
+  return lhs.HstPtrBegin < rhs;
+}
+inline bool operator<(const HstPtrBeginTy &lhs, const HostDataToTargetTy &rhs) {
+  return lhs < rhs.HstPtrBegin;
+}
+inline bool operator<(const HostDataToTargetTy &lhs,
+                      const HostDataToTargetTy &rhs) {
+  return lhs.HstPtrBegin < rhs.HstPtrBegin;
+}
+
+/// Mapped regions never overlap, so ordering them by HstPtrBegin lets lookups
+/// find the candidate regions around a host address in logarithmic time.
+typedef std::set<HostDataToTargetTy, std::less<>> HostDataToTargetListTy;
 
 struct LookupResult {
   struct {
@@ -124,6 +141,16 @@ struct DeviceTy {
 
   std::mutex DataMapMtx, PendingGlobalsMtx, ShadowMtx;
 
+  // Device memory pool, see allocData and deleteData. FreeBlocks holds the
+  // cached blocks of each size class. PendingBlocks holds the blocks freed while
+  // operations on a queue may still use them, with their size class; they are
+  // cached once a synchronization of that queue that started after they were
+  // freed has completed.
+  std::mutex MemoryPoolMtx;
+  std::vector<std::vector<void *>> FreeBlocks;
+  std::map<void *, std::vector<std::pair<void *, unsigned>>> PendingBlocks;
+  size_t CachedBytes;
+
   // NOTE: Once libomp gains full target-task support, this state should be
   // moved into the target task in libomp.
   std::map<int32_t, uint64_t> LoopTripCnt;
@@ -131,7 +158,8 @@ struct DeviceTy {
   DeviceTy(RTLInfoTy *RTL)
       : DeviceID(-1), RTL(RTL), RTLDeviceID(-1), IsInit(false), InitFlag(),
         HasPendingGlobals(false), HostDataToTargetMap(), PendingCtorsDtors(),
-        ShadowPtrMap(), DataMapMtx(), PendingGlobalsMtx(), ShadowMtx() {}
+        ShadowPtrMap(), DataMapMtx(), PendingGlobalsMtx(), ShadowMtx(),
+        MemoryPoolMtx(), FreeBlocks(), PendingBlocks(), CachedBytes(0) {}
 
   // The existence of mutexes makes DeviceTy non-copyable. We need to
   // provide a copy constructor and an assignment operator explicitly.
@@ -140,8 +168,9 @@ struct DeviceTy {
         IsInit(d.IsInit), InitFlag(), HasPendingGlobals(d.HasPendingGlobals),
         HostDataToTargetMap(d.HostDataToTargetMap),
         PendingCtorsDtors(d.PendingCtorsDtors), ShadowPtrMap(d.ShadowPtrMap),
-        DataMapMtx(), PendingGlobalsMtx(), ShadowMtx(),
-        LoopTripCnt(d.LoopTripCnt) {}
+        DataMapMtx(), PendingGlobalsMtx(), ShadowMtx(), MemoryPoolMtx(),
+        FreeBlocks(d.FreeBlocks), PendingBlocks(d.PendingBlocks),
+        CachedBytes(d.CachedBytes), LoopTripCnt(d.LoopTripCnt) {}
 
   DeviceTy& operator=(const DeviceTy &d) {
     DeviceID = d.DeviceID;
@@ -152,6 +181,9 @@ struct DeviceTy {
     HostDataToTargetMap = d.HostDataToTargetMap;
     PendingCtorsDtors = d.PendingCtorsDtors;
     ShadowPtrMap = d.ShadowPtrMap;
+    FreeBlocks = d.FreeBlocks;
+    PendingBlocks = d.PendingBlocks;
+    CachedBytes = d.CachedBytes;
     LoopTripCnt = d.LoopTripCnt;
 
     return *this;
@@ -166,10 +198,22 @@ struct DeviceTy {
   void *getTgtPtrBegin(void *HstPtrBegin, int64_t Size, bool &IsLast,
       bool UpdateRefCount, bool &IsHostPtr);
   int deallocTgtPtr(void *TgtPtrBegin, int64_t Size, bool ForceDelete,
-                    bool HasCloseModifier = false);
+                    bool HasCloseModifier = false,
+                    __tgt_async_info *AsyncInfoPtr = nullptr);
   int associatePtr(void *HstPtrBegin, void *TgtPtrBegin, int64_t Size);
   int disassociatePtr(void *HstPtrBegin);
 
+  // Allocate and free device memory for data the runtime manages itself.
+  // Allocations of up to LIBOMPTARGET_MEMORY_POOL_THRESHOLD bytes are rounded
+  // up to a size class and freed blocks are cached for reuse, up to
+  // LIBOMPTARGET_MEMORY_POOL_CACHE_LIMIT bytes per device, instead of going to
+  // the plugin every time. deleteData must be passed the size given to
+  // allocData. When AsyncInfoPtr is not nullptr, the block is not reused before
+  // a call to synchronize for its queue that starts after this one returns.
+  void *allocData(int64_t Size, void *HstPtr = nullptr);
+  int32_t deleteData(void *TgtPtrBegin, int64_t Size,
+                     __tgt_async_info *AsyncInfoPtr = nullptr);
+
   // calls to RTL
   int32_t initOnce();
   __tgt_target_table *load_binary(void *Img);
@@ -189,9 +233,16 @@ struct DeviceTy {
                           int32_t NumTeams, int32_t ThreadLimit,
                           uint64_t LoopTripCount, __tgt_async_info *AsyncInfo);
 
+  // Wait for the operations on AsyncInfoPtr to complete.
+  int32_t synchronize(__tgt_async_info *AsyncInfoPtr);
+
 private:
   // Call to RTL
   void init(); // To be called only via DeviceTy::initOnce()
+
+  // Cache a free pool block or give it back to the plugin, must be called with
+  // MemoryPoolMtx held.
+  int32_t releaseBlock(void *TgtPtrBegin, unsigned SizeClass);
 };
 
 /// Map between Device ID (i.e. openmp device id) and its DeviceTy.
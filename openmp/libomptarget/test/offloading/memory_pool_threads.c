@@ -0,0 +1,50 @@
+// RUN: %libomptarget-compile-aarch64-unknown-linux-gnu && env OMP_NUM_THREADS=16 %libomptarget-run-aarch64-unknown-linux-gnu | %fcheck-aarch64-unknown-linux-gnu
+// RUN: %libomptarget-compile-powerpc64-ibm-linux-gnu && env OMP_NUM_THREADS=16 %libomptarget-run-powerpc64-ibm-linux-gnu | %fcheck-powerpc64-ibm-linux-gnu
+// RUN: %libomptarget-compile-powerpc64le-ibm-linux-gnu && env OMP_NUM_THREADS=16 %libomptarget-run-powerpc64le-ibm-linux-gnu | %fcheck-powerpc64le-ibm-linux-gnu
+// RUN: %libomptarget-compile-x86_64-pc-linux-gnu && env OMP_NUM_THREADS=16 %libomptarget-run-x86_64-pc-linux-gnu | %fcheck-x86_64-pc-linux-gnu
+// RUN: %libomptarget-compile-x86_64-pc-linux-gnu && env OMP_NUM_THREADS=16 LIBOMPTARGET_MEMORY_POOL_CACHE_LIMIT=4096 %libomptarget-run-x86_64-pc-linux-gnu | %fcheck-x86_64-pc-linux-gnu
+
+// Many host threads offloading at once share the device queues, and the
+// pooled blocks they free are handed out again to the other threads. Each
+// region must still see only its own data.
+
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+  const int num_threads = 64, num_iters = 32, N = 256;
+  int errors = 0;
+
+#pragma omp parallel for reduction(+ : errors)
+  for (int i = 0; i < num_threads; ++i) {
+    for (int iter = 0; iter < num_iters; ++iter) {
+      int in[N], out[N];
+      int priv[N / 2];
+      const int seed = i * num_iters + iter;
+
+      for (int j = 0; j < N; ++j) {
+        in[j] = seed + j;
+        out[j] = -1;
+      }
+      for (int j = 0; j < N / 2; ++j)
+        priv[j] = seed;
+
+#pragma omp target teams distribute parallel for map(to : in) \
+    map(from : out) firstprivate(priv)
+      for (int j = 0; j < N; ++j)
+        out[j] = in[j] + priv[j / 2];
+
+      for (int j = 0; j < N; ++j)
+        if (out[j] != 2 * seed + j)
+          ++errors;
+    }
+  }
+
+  if (errors)
+    printf("FAIL: %d errors\n", errors);
+  else
+    printf("PASS\n");
+
+  return 0;
+}
+
+// CHECK: PASS
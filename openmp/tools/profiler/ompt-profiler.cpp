@@ -0,0 +1,383 @@
+/*
+ * ompt-profiler.cpp -- OMPT tool that prints an OpenMP profile summary at exit
+ */
+
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <inttypes.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "omp-tools.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+uint64_t nanosecondsSince(Clock::time_point Start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              Start)
+      .count();
+}
+
+const Clock::time_point ToolStart = Clock::now();
+
+/// Totals for all instances of one parallel region, identified by its return
+/// address. Entries are never freed, so implicit tasks can keep pointing to
+/// them after the region ended.
+struct RegionStats {
+  const void *Codeptr;
+  std::atomic<uint64_t> Count{0};
+  std::atomic<uint64_t> TotalNs{0};
+  // Implicit tasks run for the region, summed over all instances.
+  std::atomic<uint64_t> ImplicitTasks{0};
+  // Time the implicit tasks spent in implicit barriers before the region ended.
+  std::atomic<uint64_t> ImbalanceNs{0};
+  // End of the last instance, in nanoseconds since ToolStart.
+  std::atomic<uint64_t> LastEndNs{0};
+
+  explicit RegionStats(const void *Codeptr) : Codeptr(Codeptr) {}
+};
+
+/// Counters of one OpenMP thread. Only the owning thread updates them; they
+/// are read at finalization.
+struct ThreadStats {
+  ompt_thread_t Type;
+  uint64_t Id;
+  uint64_t BarrierWaits = 0;
+  uint64_t BarrierNs = 0;
+  uint64_t TaskWaits = 0;
+  uint64_t TaskWaitNs = 0;
+  uint64_t TasksCreated = 0;
+  uint64_t TasksCompleted = 0;
+  uint64_t TaskNs = 0;
+
+  ThreadStats(ompt_thread_t Type, uint64_t Id) : Type(Type), Id(Id) {}
+};
+
+// The runtime finalizes the tool after the static destructors of the tool
+// library ran, so the statistics are allocated and never freed.
+std::mutex StatsMtx;
+std::unordered_map<const void *, RegionStats *> &Regions =
+    *new std::unordered_map<const void *, RegionStats *>();
+std::vector<ThreadStats *> &Threads = *new std::vector<ThreadStats *>();
+
+/// Per-thread state for the callbacks.
+struct ThreadState {
+  ThreadStats *Stats = nullptr;
+  // Start times of the parallel regions this thread encountered.
+  std::vector<Clock::time_point> ParallelStarts;
+  // The sync region waits this thread is in, with their start time and the
+  // thread's explicit task time at that point. Waits nest when a thread runs a
+  // task while waiting.
+  std::vector<std::pair<Clock::time_point, uint64_t>> WaitStarts;
+  // Start of the current explicit task, if the thread is running one.
+  Clock::time_point TaskStart;
+  bool InExplicitTask = false;
+  // Last region looked up, parallel regions are often entered repeatedly.
+  RegionStats *LastRegion = nullptr;
+};
+
+thread_local ThreadState State;
+
+ThreadStats &getThreadStats(ompt_thread_t Type = ompt_thread_other) {
+  if (!State.Stats) {
+    std::lock_guard<std::mutex> Lock(StatsMtx);
+    State.Stats = new ThreadStats(Type, Threads.size());
+    Threads.push_back(State.Stats);
+  }
+  return *State.Stats;
+}
+
+RegionStats *getRegionStats(const void *Codeptr) {
+  if (State.LastRegion && State.LastRegion->Codeptr == Codeptr)
+    return State.LastRegion;
+
+  std::lock_guard<std::mutex> Lock(StatsMtx);
+  RegionStats *&Stats = Regions[Codeptr];
+  if (!Stats)
+    Stats = new RegionStats(Codeptr);
+  State.LastRegion = Stats;
+  return Stats;
+}
+
+// Marks the task data of explicit tasks, whose time the tool measures, and of
+// explicit tasks waiting in a sync region, whose time is counted as waiting.
+const uint64_t ExplicitTaskMark = 1;
+const uint64_t WaitingTaskMark = 2;
+
+bool isExplicitTask(const ompt_data_t *task_data) {
+  return task_data && (task_data->value == ExplicitTaskMark ||
+                       task_data->value == WaitingTaskMark);
+}
+
+void ompt_profiler_thread_begin(ompt_thread_t thread_type,
+                                ompt_data_t *thread_data) {
+  getThreadStats(thread_type).Type = thread_type;
+}
+
+void ompt_profiler_parallel_begin(ompt_data_t *encountering_task_data,
+                                  const ompt_frame_t *encountering_task_frame,
+                                  ompt_data_t *parallel_data,
+                                  unsigned int requested_team_size, int flag,
+                                  const void *codeptr_ra) {
+  parallel_data->ptr = getRegionStats(codeptr_ra);
+  State.ParallelStarts.push_back(Clock::now());
+}
+
+void ompt_profiler_parallel_end(ompt_data_t *parallel_data,
+                                ompt_data_t *task_data, int flag,
+                                const void *codeptr_ra) {
+  RegionStats *Stats = static_cast<RegionStats *>(parallel_data->ptr);
+  if (!Stats || State.ParallelStarts.empty())
+    return;
+  Stats->LastEndNs.store(nanosecondsSince(ToolStart), std::memory_order_relaxed);
+  Stats->TotalNs.fetch_add(nanosecondsSince(State.ParallelStarts.back()),
+                           std::memory_order_relaxed);
+  Stats->Count.fetch_add(1, std::memory_order_relaxed);
+  State.ParallelStarts.pop_back();
+}
+
+void ompt_profiler_implicit_task(ompt_scope_endpoint_t endpoint,
+                                 ompt_data_t *parallel_data,
+                                 ompt_data_t *task_data,
+                                 unsigned int team_size,
+                                 unsigned int thread_num, int flags) {
+  if (endpoint != ompt_scope_begin)
+    return;
+  if (flags & ompt_task_initial) {
+    task_data->ptr = nullptr;
+    return;
+  }
+  // The parallel data is not passed to all later events of the implicit task,
+  // so remember the region in the task data.
+  RegionStats *Stats = static_cast<RegionStats *>(parallel_data->ptr);
+  task_data->ptr = Stats;
+  if (Stats)
+    Stats->ImplicitTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ompt_profiler_sync_region_wait(ompt_sync_region_t kind,
+                                    ompt_scope_endpoint_t endpoint,
+                                    ompt_data_t *parallel_data,
+                                    ompt_data_t *task_data,
+                                    const void *codeptr_ra) {
+  if (kind == ompt_sync_region_reduction)
+    return;
+  ThreadStats &Stats = getThreadStats();
+  if (endpoint == ompt_scope_begin) {
+    if (task_data && task_data->value == ExplicitTaskMark) {
+      if (State.InExplicitTask)
+        Stats.TaskNs += nanosecondsSince(State.TaskStart);
+      State.InExplicitTask = false;
+      task_data->value = WaitingTaskMark;
+    }
+    State.WaitStarts.emplace_back(Clock::now(), Stats.TaskNs);
+    return;
+  }
+  if (State.WaitStarts.empty())
+    return;
+  // Tasks run while waiting are not part of the wait.
+  Clock::time_point WaitStart = State.WaitStarts.back().first;
+  uint64_t TaskNs = Stats.TaskNs - State.WaitStarts.back().second;
+  uint64_t WaitNs = nanosecondsSince(WaitStart);
+  WaitNs -= std::min(WaitNs, TaskNs);
+  State.WaitStarts.pop_back();
+  if (task_data && task_data->value == WaitingTaskMark) {
+    task_data->value = ExplicitTaskMark;
+    State.TaskStart = Clock::now();
+    State.InExplicitTask = true;
+  }
+
+  switch (kind) {
+  case ompt_sync_region_taskwait:
+  case ompt_sync_region_taskgroup:
+    ++Stats.TaskWaits;
+    Stats.TaskWaitNs += WaitNs;
+    break;
+  default:
+    ++Stats.BarrierWaits;
+    Stats.BarrierNs += WaitNs;
+    if (kind != ompt_sync_region_barrier_explicit && task_data &&
+        task_data->ptr && !isExplicitTask(task_data)) {
+      // Worker threads only see the end of the barrier that ends a region when
+      // they are released into the next one, so stop counting at the end of
+      // the region.
+      RegionStats *Region = static_cast<RegionStats *>(task_data->ptr);
+      uint64_t StartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             WaitStart - ToolStart)
+                             .count();
+      uint64_t EndNs = Region->LastEndNs.load(std::memory_order_relaxed);
+      if (EndNs >= StartNs)
+        WaitNs = std::min(WaitNs, EndNs - StartNs);
+      Region->ImbalanceNs.fetch_add(WaitNs, std::memory_order_relaxed);
+    }
+    break;
+  }
+}
+
+void ompt_profiler_task_create(ompt_data_t *encountering_task_data,
+                               const ompt_frame_t *encountering_task_frame,
+                               ompt_data_t *new_task_data, int flags,
+                               int has_dependences, const void *codeptr_ra) {
+  if (!(flags & ompt_task_explicit))
+    return;
+  new_task_data->value = ExplicitTaskMark;
+  ++getThreadStats().TasksCreated;
+}
+
+void ompt_profiler_task_schedule(ompt_data_t *first_task_data,
+                                 ompt_task_status_t prior_task_status,
+                                 ompt_data_t *second_task_data) {
+  ThreadStats &Stats = getThreadStats();
+  if (State.InExplicitTask) {
+    Stats.TaskNs += nanosecondsSince(State.TaskStart);
+    State.InExplicitTask = false;
+  }
+  if (prior_task_status == ompt_task_complete &&
+      isExplicitTask(first_task_data))
+    ++Stats.TasksCompleted;
+  if (second_task_data && second_task_data->value == ExplicitTaskMark) {
+    State.TaskStart = Clock::now();
+    State.InExplicitTask = true;
+  }
+}
+
+double toSeconds(uint64_t Ns) { return Ns / 1e9; }
+
+const char *getThreadTypeName(ompt_thread_t Type) {
+  switch (Type) {
+  case ompt_thread_initial:
+    return "initial";
+  case ompt_thread_worker:
+    return "worker";
+  default:
+    return "other";
+  }
+}
+
+void printRegionName(FILE *Out, const void *Codeptr) {
+  Dl_info Info;
+  if (Codeptr && dladdr(Codeptr, &Info) && Info.dli_sname)
+    fprintf(Out, "%s+0x%" PRIxPTR, Info.dli_sname,
+            (uintptr_t)Codeptr - (uintptr_t)Info.dli_saddr);
+  else
+    fprintf(Out, "%p", Codeptr);
+}
+
+void printSummary(FILE *Out) {
+  std::lock_guard<std::mutex> Lock(StatsMtx);
+
+  std::vector<RegionStats *> SortedRegions;
+  for (auto &Entry : Regions)
+    SortedRegions.push_back(Entry.second);
+  std::sort(SortedRegions.begin(), SortedRegions.end(),
+            [](const RegionStats *A, const RegionStats *B) {
+              return A->TotalNs > B->TotalNs;
+            });
+
+  fprintf(Out, "OpenMP profile\n\nParallel regions (imbalance is the share of "
+               "thread time spent in implicit barriers):\n");
+  fprintf(Out, "%10s %12s %12s %8s %10s  %s\n", "calls", "total(s)",
+          "avg(us)", "threads", "imbalance", "region");
+  for (const RegionStats *R : SortedRegions) {
+    uint64_t Count = R->Count, TotalNs = R->TotalNs, Tasks = R->ImplicitTasks;
+    if (!Count)
+      continue;
+    double AvgThreads = (double)Tasks / Count;
+    double Imbalance =
+        TotalNs && Tasks ? R->ImbalanceNs / (TotalNs * AvgThreads) : 0;
+    fprintf(Out, "%10" PRIu64 " %12.6f %12.3f %8.1f %9.1f%%  ", Count,
+            toSeconds(TotalNs), TotalNs / 1e3 / Count, AvgThreads,
+            100 * std::min(Imbalance, 1.0));
+    printRegionName(Out, R->Codeptr);
+    fprintf(Out, "\n");
+  }
+
+  fprintf(Out, "\nThreads (wait times exclude tasks run while waiting; for "
+               "workers they include the time between parallel regions):\n");
+  fprintf(Out, "%6s %8s %10s %12s %10s %12s %10s %10s %12s\n", "thread",
+          "type", "barriers", "barrier(s)", "taskwaits", "taskwait(s)",
+          "created", "completed", "tasks(s)");
+  for (const ThreadStats *T : Threads)
+    fprintf(Out,
+            "%6" PRIu64 " %8s %10" PRIu64 " %12.6f %10" PRIu64 " %12.6f %10" PRIu64
+            " %10" PRIu64 " %12.6f\n",
+            T->Id, getThreadTypeName(T->Type), T->BarrierWaits,
+            toSeconds(T->BarrierNs), T->TaskWaits, toSeconds(T->TaskWaitNs),
+            T->TasksCreated, T->TasksCompleted, toSeconds(T->TaskNs));
+}
+
+} // namespace
+
+#define SET_CALLBACK_T(event, type)                                            \
+  do {                                                                         \
+    ompt_callback_##type##_t profiler_##event = &ompt_profiler_##event;        \
+    if (ompt_set_callback(ompt_callback_##event,                               \
+                          (ompt_callback_t)profiler_##event) <                 \
+        ompt_set_sometimes)                                                    \
+      fprintf(stderr, "OMPT profiler: callback '" #event                       \
+                      "' is not supported, its statistics are missing\n");     \
+  } while (0)
+
+#define SET_CALLBACK(event) SET_CALLBACK_T(event, event)
+
+static int ompt_profiler_initialize(ompt_function_lookup_t lookup,
+                                    int device_num, ompt_data_t *tool_data) {
+  ompt_set_callback_t ompt_set_callback =
+      (ompt_set_callback_t)lookup("ompt_set_callback");
+  if (ompt_set_callback == NULL) {
+    fprintf(stderr, "OMPT profiler: could not set callbacks, disabled\n");
+    return 0;
+  }
+
+  SET_CALLBACK(thread_begin);
+  SET_CALLBACK(parallel_begin);
+  SET_CALLBACK(parallel_end);
+  SET_CALLBACK(implicit_task);
+  SET_CALLBACK_T(sync_region_wait, sync_region);
+  SET_CALLBACK(task_create);
+  SET_CALLBACK(task_schedule);
+  return 1; // success
+}
+
+static void ompt_profiler_finalize(ompt_data_t *tool_data) {
+  FILE *Out = stderr;
+  const char *OutputPath = getenv("OMP_PROFILER_OUTPUT");
+  if (OutputPath && *OutputPath) {
+    Out = fopen(OutputPath, "w");
+    if (!Out) {
+      fprintf(stderr, "OMPT profiler: cannot open '%s', using stderr\n",
+              OutputPath);
+      Out = stderr;
+    }
+  }
+  printSummary(Out);
+  if (Out != stderr)
+    fclose(Out);
+}
+
+extern "C" ompt_start_tool_result_t *
+ompt_start_tool(unsigned int omp_version, const char *runtime_version) {
+  static ompt_start_tool_result_t ompt_start_tool_result = {
+      &ompt_profiler_initialize, &ompt_profiler_finalize, {0}};
+  return &ompt_start_tool_result;
+}
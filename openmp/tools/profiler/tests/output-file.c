@@ -0,0 +1,39 @@
+/*
+ * output-file.c -- OMPT profiler testcase
+ */
+
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %libompprofiler-compile
+// RUN: rm -f %t.profile
+// RUN: env OMP_PROFILER_OUTPUT=%t.profile %libompprofiler-run 2>&1 | \
+// RUN:   FileCheck %s --check-prefix=STDERR --allow-empty
+// RUN: FileCheck %s < %t.profile
+
+// An unwritable output file falls back to stderr.
+// RUN: env OMP_PROFILER_OUTPUT=%t.nonexistent/profile %libompprofiler-run \
+// RUN:   2>&1 | FileCheck %s --check-prefix=FALLBACK
+#include <omp.h>
+
+int main(int argc, char *argv[]) {
+  int sum = 0;
+#pragma omp parallel num_threads(2) reduction(+ : sum)
+  sum += omp_get_thread_num();
+  return sum == 1 ? 0 : 1;
+}
+
+// STDERR-NOT: OpenMP profile
+
+// CHECK:     OpenMP profile
+// CHECK:     {{^ +}}1 {{[0-9.]+}} {{[0-9.]+}} 2.0 {{[0-9.]+}}% main+0x{{[0-9a-f]+$}}
+// CHECK:     {{^ +}}0 initial
+// CHECK:     {{^ +}}1 worker
+
+// FALLBACK:  OMPT profiler: cannot open '{{.*}}nonexistent/profile', using stderr
+// FALLBACK:  OpenMP profile
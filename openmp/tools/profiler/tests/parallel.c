@@ -0,0 +1,60 @@
+/*
+ * parallel.c -- OMPT profiler testcase
+ */
+
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %libompprofiler-compile-and-run 2>&1 | FileCheck %s
+#include <omp.h>
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+  int sum = 0;
+
+  // One region run three times by two threads.
+  for (int i = 0; i < 3; ++i) {
+#pragma omp parallel num_threads(2) reduction(+ : sum)
+    sum += omp_get_thread_num();
+  }
+
+  // One region run once by four threads, where the initial thread creates
+  // four explicit tasks and waits for them.
+#pragma omp parallel num_threads(4) shared(sum)
+#pragma omp master
+  {
+    for (int i = 0; i < 4; ++i) {
+#pragma omp task shared(sum)
+      {
+#pragma omp atomic
+        sum += i;
+      }
+    }
+#pragma omp taskwait
+  }
+
+  // The profile is printed at exit, after this.
+  printf("sum = %d\n", sum);
+  fflush(stdout);
+  return 0;
+}
+
+// CHECK: sum = 9
+
+// CHECK:      OpenMP profile
+// CHECK-EMPTY:
+// CHECK-NEXT: Parallel regions (imbalance is the share of thread time spent in implicit barriers):
+// CHECK-NEXT: calls total(s) avg(us) threads imbalance region
+// CHECK-DAG:  {{^ +}}3 {{[0-9.]+}} {{[0-9.]+}} 2.0 {{[0-9.]+}}% main+0x{{[0-9a-f]+$}}
+// CHECK-DAG:  {{^ +}}1 {{[0-9.]+}} {{[0-9.]+}} 4.0 {{[0-9.]+}}% main+0x{{[0-9a-f]+$}}
+// CHECK-EMPTY:
+// CHECK-NEXT: Threads (wait times exclude tasks run while waiting; for workers they include the time between parallel regions):
+// CHECK-NEXT: thread type barriers barrier(s) taskwaits taskwait(s) created completed tasks(s)
+// CHECK-NEXT: {{^ +}}0 initial {{[1-9][0-9]*}} {{[0-9.]+}} {{[1-9][0-9]*}} {{[0-9.]+}} 4 {{[0-9]+}} {{[0-9.]+$}}
+// CHECK-COUNT-3: {{^ +}}{{[1-3]}} worker {{[1-9][0-9]*}} {{[0-9.]+}} {{[0-9]+}} {{[0-9.]+}} 0 {{[0-9]+}} {{[0-9.]+$}}
+// CHECK-NOT:  {{.}}
@@ -25,6 +25,7 @@
 #include "polly/ScopInfo.h"
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLTools.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 #include "isl/aff.h"
 #include "isl/ctx.h"
@@ -46,6 +47,10 @@ static cl::opt<int> OptComputeOut(
              "computational steps (0 means no bound)"),
     cl::Hidden, cl::init(500000), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+STATISTIC(DependenceComputeOuts,
+          "Number of dependence computations that exceeded their "
+          "computational step budget");
+
 static cl::opt<bool> LegalityCheckDisabled(
     "disable-polly-legality", cl::desc("Disable polly legality check"),
     cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
@@ -479,6 +484,7 @@ void Dependences::calculateDependences(Scop &S) {
   }
 
   if (isl_ctx_last_error(IslCtx.get()) == isl_error_quota) {
+    DependenceComputeOuts++;
     isl_union_map_free(RAW);
     isl_union_map_free(WAW);
     isl_union_map_free(WAR);
@@ -54,6 +54,7 @@
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
 #include "polly/Simplify.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
@@ -261,6 +262,12 @@ static cl::opt<bool>
                 cl::desc("Perform optimizations based on pattern matching"),
                 cl::init(true), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<int> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by a maximal amount of computational steps "
+             "(0 means no bound)"),
+    cl::Hidden, cl::init(300000), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool> OptimizedScops(
     "polly-optimized-scops",
     cl::desc("Polly - Dump polyhedral description of Scops optimized with "
@@ -271,6 +278,9 @@ static cl::opt<bool> OptimizedScops(
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
+STATISTIC(ScheduleComputeOuts,
+          "Number of scops not rescheduled because of the scheduler's "
+          "computational step budget");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
 STATISTIC(NumBoxedLoopsOptimized, "Number of boxed loops optimized");
@@ -1594,7 +1604,17 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   SC = SC.set_proximity(Proximity);
   SC = SC.set_validity(Validity);
   SC = SC.set_coincidence(Validity);
-  auto Schedule = SC.compute_schedule();
+  isl::schedule Schedule;
+  {
+    IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+    Schedule = SC.compute_schedule();
+
+    if (MaxOpGuard.hasQuotaExceeded()) {
+      LLVM_DEBUG(dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+      ScheduleComputeOuts++;
+      Schedule = nullptr;
+    }
+  }
   isl_options_set_on_error(Ctx, OnErrorStatus);
 
   walkScheduleTreeForStatistics(Schedule, 1);
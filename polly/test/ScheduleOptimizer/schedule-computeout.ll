@@ -0,0 +1,53 @@
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-opt-isl -polly-ast \
+; RUN:   -analyze < %s | FileCheck %s
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-opt-isl -polly-ast \
+; RUN:   -polly-schedule-computeout=1 -analyze < %s | \
+; RUN:   FileCheck %s --check-prefix=COMPUTEOUT
+;
+; When the isl scheduler exceeds -polly-schedule-computeout, the SCoP keeps its
+; original schedule and is not tiled.
+;
+;    for (i = 0; i < 1024; i++)
+;      for (j = 0; j < 1024; j++)
+;        A[i][j] += 1;
+;
+; CHECK:      // 1st level tiling - Tiles
+; CHECK-NEXT: for (int c0 = 0; c0 <= 31; c0 += 1)
+; CHECK-NEXT:   for (int c1 = 0; c1 <= 31; c1 += 1) {
+; CHECK-NEXT:     // 1st level tiling - Points
+; CHECK-NEXT:     for (int c2 = 0; c2 <= 31; c2 += 1)
+; CHECK-NEXT:       for (int c3 = 0; c3 <= 31; c3 += 1)
+; CHECK-NEXT:         Stmt_for_j(32 * c0 + c2, 32 * c1 + c3);
+; CHECK-NEXT:   }
+;
+; COMPUTEOUT-NOT:  tiling
+; COMPUTEOUT:      for (int c0 = 0; c0 <= 1023; c0 += 1)
+; COMPUTEOUT-NEXT:   for (int c1 = 0; c1 <= 1023; c1 += 1)
+; COMPUTEOUT-NEXT:     Stmt_for_j(c0, c1);
+
+define void @f([1024 x float]* %A) {
+entry:
+  br label %for.i
+
+for.i:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.i.latch ]
+  br label %for.j
+
+for.j:
+  %j = phi i64 [ 0, %for.i ], [ %j.next, %for.j ]
+  %p = getelementptr inbounds [1024 x float], [1024 x float]* %A, i64 %i, i64 %j
+  %v = load float, float* %p, align 4
+  %add = fadd float %v, 1.000000e+00
+  store float %add, float* %p, align 4
+  %j.next = add nuw nsw i64 %j, 1
+  %cj = icmp ne i64 %j.next, 1024
+  br i1 %cj, label %for.j, label %for.i.latch
+
+for.i.latch:
+  %i.next = add nuw nsw i64 %i, 1
+  %ci = icmp ne i64 %i.next, 1024
+  br i1 %ci, label %for.i, label %exit
+
+exit:
+  ret void
+}